@@ -73,8 +73,21 @@ struct eth_context {
 #if defined(CONFIG_ETH_NATIVE_TAP_PTP_CLOCK)
 	const struct device *ptp_clock;
 #endif
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_BENCHMARK)
+	struct {
+		int64_t period_start;
+		uint64_t cycles;
+		uint32_t max_cycles;
+		uint32_t pkts;
+	} rx_bench;
+#endif
 };
 
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_PAGE_POOL)
+NET_PKT_PAGE_POOL_DEFINE(rx_page_pool, CONFIG_ETH_NATIVE_TAP_RX_PAGE_COUNT,
+			 NET_ETH_MTU + ETH_HDR_LEN);
+#endif
+
 static const char *if_name_cmd_opt;
 static const char *mac_addr_cmd_opt;
 #ifdef CONFIG_NET_IPV4
@@ -234,19 +247,97 @@ static struct net_pkt *prepare_pkt(struct eth_context *ctx,
 	return pkt;
 }
 
-static int read_data(struct eth_context *ctx, int fd)
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_PAGE_POOL)
+static struct net_pkt *prepare_pkt_on_page(struct eth_context *ctx, int fd,
+					   uint8_t *page, int *status)
 {
-	struct net_if *iface = ctx->iface;
-	struct net_pkt *pkt = NULL;
-	int status;
+	struct net_pkt *pkt;
+	int count;
+
+	count = nsi_host_read(fd, page, rx_page_pool.page_size);
+	if (count <= 0) {
+		net_pkt_page_put(&rx_page_pool, page);
+		return NULL;
+	}
+
+	pkt = net_pkt_rx_alloc_on_page(&rx_page_pool, ctx->iface, page, count,
+				       NET_BUF_TIMEOUT);
+	if (!pkt) {
+		net_pkt_page_put(&rx_page_pool, page);
+		*status = -ENOMEM;
+		return NULL;
+	}
+
+	LOG_DBG("Recv pkt %p len %d on page %p", pkt, count, page);
+
+	return pkt;
+}
+#endif
+
+static struct net_pkt *read_pkt(struct eth_context *ctx, int fd, int *status)
+{
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_PAGE_POOL)
+	uint8_t *page;
+#endif
 	int count;
 
+	*status = 0;
+
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_PAGE_POOL)
+	/* Fall back to copying if all the pages are in use */
+	page = net_pkt_page_get(&rx_page_pool, K_NO_WAIT);
+	if (page != NULL) {
+		return prepare_pkt_on_page(ctx, fd, page, status);
+	}
+#endif
+
 	count = nsi_host_read(fd, ctx->recv, sizeof(ctx->recv));
 	if (count <= 0) {
-		return 0;
+		return NULL;
+	}
+
+	return prepare_pkt(ctx, count, status);
+}
+
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_BENCHMARK)
+static void rx_bench_update(struct eth_context *ctx, uint32_t start)
+{
+	uint32_t cycles = k_cycle_get_32() - start;
+	int64_t now = k_uptime_get();
+	int64_t elapsed;
+
+	ctx->rx_bench.pkts++;
+	ctx->rx_bench.cycles += cycles;
+	ctx->rx_bench.max_cycles = MAX(ctx->rx_bench.max_cycles, cycles);
+
+	elapsed = now - ctx->rx_bench.period_start;
+	if (elapsed < MSEC_PER_SEC) {
+		return;
 	}
 
-	pkt = prepare_pkt(ctx, count, &status);
+	LOG_INF("%s: RX %u pps, latency avg %u ns max %u ns", ctx->if_name,
+		(uint32_t)(ctx->rx_bench.pkts * MSEC_PER_SEC / elapsed),
+		(uint32_t)k_cyc_to_ns_floor64(ctx->rx_bench.cycles /
+					      ctx->rx_bench.pkts),
+		(uint32_t)k_cyc_to_ns_floor64(ctx->rx_bench.max_cycles));
+
+	ctx->rx_bench.period_start = now;
+	ctx->rx_bench.cycles = 0;
+	ctx->rx_bench.max_cycles = 0;
+	ctx->rx_bench.pkts = 0;
+}
+#endif
+
+static int read_data(struct eth_context *ctx, int fd)
+{
+	struct net_if *iface = ctx->iface;
+	struct net_pkt *pkt = NULL;
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_BENCHMARK)
+	uint32_t start = k_cycle_get_32();
+#endif
+	int status;
+
+	pkt = read_pkt(ctx, fd, &status);
 	if (!pkt) {
 		return status;
 	}
@@ -255,8 +346,13 @@ static int read_data(struct eth_context *ctx, int fd)
 
 	if (net_recv_data(iface, pkt) < 0) {
 		net_pkt_unref(pkt);
+		return 0;
 	}
 
+#if defined(CONFIG_ETH_NATIVE_TAP_RX_BENCHMARK)
+	rx_bench_update(ctx, start);
+#endif
+
 	return 0;
 }
 
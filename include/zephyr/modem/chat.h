@@ -203,6 +203,25 @@ enum modem_chat_script_send_state {
 	MODEM_CHAT_SCRIPT_SEND_STATE_DELIMITER,
 };
 
+#if CONFIG_MODEM_CHAT_UNSOL_TRIE
+/* Maximum number of trie nodes matching received data simultaneously */
+#define MODEM_CHAT_UNSOL_TRIE_STATES_MAX (4)
+
+/* Unsolicited match trie node */
+struct modem_chat_trie_node {
+	/* Index of first child node, 0 if none */
+	uint16_t child;
+	/* Index of next sibling node, 0 if none */
+	uint16_t sibling;
+	/* Index + 1 of first match ending at node, 0 if none */
+	uint16_t match;
+	/* Byte matched by node */
+	uint8_t byte;
+	/* Node matches any byte */
+	bool wildcard;
+};
+#endif
+
 /**
  * @brief Chat instance internal context
  * @warning Do not modify any members of this struct directly
@@ -245,6 +264,18 @@ struct modem_chat {
 	const struct modem_chat_match *matches[3];
 	uint16_t matches_size[3];
 
+#if CONFIG_MODEM_CHAT_UNSOL_TRIE
+	/* Unsolicited matches trie, node 0 is the root, unused if size is 0 */
+	struct modem_chat_trie_node unsol_trie[CONFIG_MODEM_CHAT_UNSOL_TRIE_NODES];
+	uint16_t unsol_trie_size;
+
+	/* Unsolicited matches trie nodes matching received data */
+	uint16_t unsol_trie_states[MODEM_CHAT_UNSOL_TRIE_STATES_MAX];
+	uint8_t unsol_trie_states_len;
+	bool unsol_trie_states_overrun;
+	uint16_t unsol_trie_pos;
+#endif
+
 	/* Script execution */
 	const struct modem_chat_script *script;
 	const struct modem_chat_script *pending_script;
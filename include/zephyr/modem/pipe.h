@@ -29,6 +29,14 @@ enum modem_pipe_event {
 	MODEM_PIPE_EVENT_CLOSED,
 };
 
+/** Modem pipe scatter-gather buffer */
+struct modem_pipe_iov {
+	/** Pointer to data */
+	const uint8_t *buf;
+	/** Number of bytes of data */
+	size_t size;
+};
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -54,11 +62,22 @@ typedef int (*modem_pipe_api_receive)(void *data, uint8_t *buf, size_t size);
 
 typedef int (*modem_pipe_api_close)(void *data);
 
+typedef int (*modem_pipe_api_transmit_iov)(void *data, const struct modem_pipe_iov *iov,
+					   size_t iovcnt);
+
+typedef int (*modem_pipe_api_receive_claim)(void *data, uint8_t **buf, size_t size);
+
+typedef int (*modem_pipe_api_receive_finish)(void *data, size_t size);
+
 struct modem_pipe_api {
 	modem_pipe_api_open open;
 	modem_pipe_api_transmit transmit;
 	modem_pipe_api_receive receive;
 	modem_pipe_api_close close;
+	/* Optional */
+	modem_pipe_api_transmit_iov transmit_iov;
+	modem_pipe_api_receive_claim receive_claim;
+	modem_pipe_api_receive_finish receive_finish;
 };
 
 struct modem_pipe {
@@ -153,6 +172,60 @@ int modem_pipe_transmit(struct modem_pipe *pipe, const uint8_t *buf, size_t size
  */
 int modem_pipe_receive(struct modem_pipe *pipe, uint8_t *buf, size_t size);
 
+/**
+ * @brief Transmit scattered data through pipe
+ *
+ * @details The buffers are transmitted in order, as if they were concatenated and
+ * passed to modem_pipe_transmit(). Backends which support it take all buffers in
+ * a single call, others are given one buffer at a time until one is only partially
+ * accepted.
+ *
+ * @param pipe Pipe to transmit through
+ * @param iov Array of buffers to transmit
+ * @param iovcnt Number of buffers in array
+ *
+ * @retval Number of bytes placed in pipe
+ * @retval -EPERM if pipe is closed
+ * @retval -errno code on error
+ *
+ * @warning This call must be non-blocking
+ */
+int modem_pipe_transmit_iov(struct modem_pipe *pipe, const struct modem_pipe_iov *iov,
+			    size_t iovcnt);
+
+/**
+ * @brief Claim received data in place
+ *
+ * @details Provides a pointer to contiguous received data inside the backend's own
+ * receive buffer, avoiding the copy made by modem_pipe_receive(). The data must be
+ * released using modem_pipe_receive_finish() before data is received from the pipe
+ * again.
+ *
+ * @param pipe Pipe to receive from
+ * @param buf Destination for pointer to received data
+ * @param size Maximum number of bytes to claim
+ *
+ * @retval Number of bytes claimed
+ * @retval -EPERM if pipe is closed
+ * @retval -ENOTSUP if pipe does not support claiming received data,
+ * modem_pipe_receive() must be used instead
+ * @retval -errno code on error
+ *
+ * @warning This call must be non-blocking
+ */
+int modem_pipe_receive_claim(struct modem_pipe *pipe, uint8_t **buf, size_t size);
+
+/**
+ * @brief Release received data claimed with modem_pipe_receive_claim()
+ *
+ * @param pipe Pipe to release claimed data of
+ * @param size Number of claimed bytes which have been consumed
+ *
+ * @retval 0 if successful
+ * @retval -errno code otherwise
+ */
+int modem_pipe_receive_finish(struct modem_pipe *pipe, size_t size);
+
 /**
  * @brief Clear callback
  *
@@ -13,6 +13,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_CAPTURE_H_
 #define ZEPHYR_INCLUDE_NET_CAPTURE_H_
 
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 
@@ -372,6 +373,98 @@ static inline void net_capture_foreach(net_capture_cb_t cb, void *user_data)
 
 /** @endcond */
 
+/** Statistics of the capture ring */
+struct net_capture_ring_stats {
+	/** Packets copied into the ring */
+	uint32_t captured;
+	/** Captured packets that were longer than the snapshot length */
+	uint32_t truncated;
+	/** Packets dropped because the ring was full */
+	uint32_t dropped;
+	/** Captured packets that the tunnel or the sink failed to process */
+	uint32_t sink_errors;
+};
+
+/**
+ * @typedef net_capture_ring_sink_t
+ * @brief Callback that receives the captured packets in pcapng format.
+ *
+ * @details The callback is called from the capture ring consumer thread.
+ *          The first call contains the section header block followed by
+ *          interface description blocks, one for every network interface
+ *          in interface index order. After that each call contains one
+ *          enhanced packet block. The data can be written as is to a
+ *          file, a socket or a shell.
+ *
+ * @param data pcapng formatted data
+ * @param len Length of the data
+ * @param user_data User supplied data
+ *
+ * @return 0 if ok, <0 if the data could not be written
+ */
+typedef int (*net_capture_ring_sink_t)(const uint8_t *data, size_t len,
+				       void *user_data);
+
+/**
+ * @brief Start writing captured packets in pcapng format to a sink.
+ *
+ * @details Requires CONFIG_NET_CAPTURE_RING. The packets are copied
+ *          into the capture ring in the RX/TX path and passed to the
+ *          sink from the ring consumer thread.
+ *
+ * @param iface Network interface to capture, or NULL to capture all
+ *              network interfaces.
+ * @param sink Callback that receives the pcapng data
+ * @param user_data User supplied data passed to the sink
+ *
+ * @return 0 if ok, -EALREADY if a sink is already set, <0 on other errors
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_start(struct net_if *iface, net_capture_ring_sink_t sink,
+			   void *user_data);
+#else
+static inline int net_capture_ring_start(struct net_if *iface,
+					 net_capture_ring_sink_t sink,
+					 void *user_data)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(sink);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Stop writing captured packets to the sink.
+ *
+ * @details Packets still in the capture ring are not passed to the sink.
+ *
+ * @return 0 if ok, -EALREADY if there was no sink set
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_stop(void);
+#else
+static inline int net_capture_ring_stop(void)
+{
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the capture ring statistics.
+ *
+ * @param stats Statistics are returned here.
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats);
+#else
+static inline void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+}
+#endif
+
 /**
  * @}
  */
@@ -91,6 +91,8 @@ enum coap_method {
 
 #define COAP_OBSERVE_MAX_AGE 0xFFFFFF
 
+#define COAP_OBSERVE_FIRST_OFFSET 2
+
 /** @endcond */
 
 /**
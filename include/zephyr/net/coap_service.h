@@ -47,6 +47,17 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+#if CONFIG_COAP_SERVICE_OBSERVER_HASH_SIZE > 0
+	/* Observers chained by token hash, entries are observer index + 1 */
+	uint16_t observer_buckets[CONFIG_COAP_SERVICE_OBSERVER_HASH_SIZE];
+	uint16_t observer_next[CONFIG_COAP_SERVICE_OBSERVERS];
+#endif
+#if CONFIG_COAP_SERVICE_RESOURCE_HASH_SIZE > 0
+	/* Open addressed table of resources by path hash, entries are resource index + 1 */
+	uint16_t resource_slots[CONFIG_COAP_SERVICE_RESOURCE_HASH_SIZE];
+	bool resource_wildcards;
+	bool resource_overflow;
+#endif
 };
 
 struct coap_service {
@@ -348,6 +359,38 @@ int coap_resource_remove_observer_by_addr(struct coap_resource *resource,
 int coap_resource_remove_observer_by_token(struct coap_resource *resource,
 					   const uint8_t *token, uint8_t token_len);
 
+/**
+ * @brief Callback to encode a notification for all observers of a resource.
+ *
+ * @param resource Pointer to CoAP resource being notified
+ * @param cpkt CoAP packet, initialized with the notification type, the 2.05 Content code and an
+ *             empty token. Options and payload are appended by the callback.
+ * @param user_data User data passed to @ref coap_resource_notify_observers
+ * @return 0 in case of success or negative in case of error.
+ */
+typedef int (*coap_notification_encode_t)(struct coap_resource *resource,
+					  struct coap_packet *cpkt, void *user_data);
+
+/**
+ * @brief Send one notification to all observers of the provided @p resource .
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The resource age is incremented as in @ref coap_resource_notify, then @p encode is called
+ * once to build the notification, including the Observe option with the new age. For every
+ * observer only the token and the message ID are patched before the packet is sent.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param type Message type of the notification, @ref COAP_TYPE_CON or @ref COAP_TYPE_NON_CON
+ * @param encode Callback encoding the options and payload of the notification
+ * @param user_data User data passed to @p encode
+ * @param params Pointer to transmission parameters structure or NULL to use default values.
+ * @return the number of observers notified in case of success or negative in case of error.
+ */
+int coap_resource_notify_observers(struct coap_resource *resource, enum coap_msgtype type,
+				   coap_notification_encode_t encode, void *user_data,
+				   const struct coap_transmission_parameters *params);
+
 /**
  * @}
  */
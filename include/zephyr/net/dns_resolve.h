@@ -658,6 +658,33 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/** DNS resolver cache statistics */
+struct dns_resolve_cache_stats {
+	/** Lookups answered with cached addresses */
+	uint32_t hits;
+	/** Lookups answered with a cached negative answer */
+	uint32_t negative_hits;
+	/** Lookups not found in the cache */
+	uint32_t misses;
+	/** Background refreshes of entries about to expire */
+	uint32_t prefetches;
+	/** Entries removed to make room for new ones */
+	uint32_t evictions;
+	/** Number of entries currently in use */
+	uint16_t entries;
+	/** Total number of entries */
+	uint16_t size;
+};
+
+/**
+ * @brief Get DNS resolver cache statistics.
+ *
+ * @param stats Statistics are stored here.
+ *
+ * @return 0 if ok, -ENOTSUP if the DNS resolver cache is not enabled.
+ */
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats);
+
 /**
  * @}
  */
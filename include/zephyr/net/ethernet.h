@@ -208,6 +208,9 @@ enum ethernet_hw_caps {
 
 	/** 5 Gbits link supported */
 	ETHERNET_LINK_5000BASE	= BIT(22),
+
+	/** TCP segmentation offload (TSO) supported */
+	ETHERNET_HW_TX_TSO		= BIT(23),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -100,12 +101,55 @@ enum http_hpack_static_key {
 
 #if defined(CONFIG_HTTP_SERVER)
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE CONFIG_HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE
+#define HTTP_SERVER_HPACK_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE
 #else
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
+#define HTTP_SERVER_HPACK_TABLE_SIZE 0
 #endif
 
+/* Number of static table entries, the dynamic table indexes follow. */
+#define HTTP_HPACK_STATIC_TABLE_LEN HTTP_SERVER_HPACK_WWW_AUTHENTICATE
+
+/* Size overhead of a dynamic table entry, RFC7541 ch. 4.1 */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+
+/* Default dynamic table size of a peer, RFC7540 ch. 6.5.2 */
+#define HTTP_HPACK_DEFAULT_TABLE_SIZE 4096
+
 /** @endcond */
 
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+/** HPACK dynamic table (RFC7541 ch. 2.3.2) of one direction of a connection. */
+struct http_hpack_dynamic_table {
+	/** Names and values of the entries, from the oldest to the newest. */
+	uint8_t data[HTTP_SERVER_HPACK_TABLE_SIZE];
+
+	/** Location of each entry within the data buffer. */
+	struct {
+		uint16_t offset;
+		uint16_t name_len;
+		uint16_t value_len;
+	} entries[HTTP_SERVER_HPACK_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD];
+
+	/** Number of entries in the table. */
+	uint16_t count;
+
+	/** Length of the data in the data buffer. */
+	uint16_t data_len;
+
+	/** Size of the table, as defined in RFC7541 ch. 4.1. */
+	uint32_t size;
+
+	/** Maximum size of the table. */
+	uint32_t max_size;
+
+	/** Maximum size changed, encoder needs to signal it to the peer. */
+	bool size_update;
+};
+#else
+struct http_hpack_dynamic_table;
+#endif
+
 /** HTTP2 header field with decoding buffer. */
 struct http_hpack_header_buf {
 	/** A pointer to the decoded header field name. */
@@ -137,6 +181,14 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 			     struct http_hpack_header_buf *header);
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header);
+int http_hpack_decode_header_table(const uint8_t *buf, size_t datalen,
+				   struct http_hpack_dynamic_table *table,
+				   struct http_hpack_header_buf *header);
+int http_hpack_encode_header_table(uint8_t *buf, size_t buflen,
+				   struct http_hpack_dynamic_table *table,
+				   struct http_hpack_header_buf *header);
+void http_hpack_table_init(struct http_hpack_dynamic_table *table, size_t max_size);
+void http_hpack_table_resize(struct http_hpack_dynamic_table *table, size_t max_size);
 
 /** @endcond */
 
@@ -440,6 +440,14 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	/** HPACK dynamic table used to decode the request headers. */
+	struct http_hpack_dynamic_table hpack_decoder;
+
+	/** HPACK dynamic table used to encode the response headers. */
+	struct http_hpack_dynamic_table hpack_encoder;
+#endif
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -490,6 +498,11 @@ struct http_client_ctx {
 	IF_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION, (uint8_t supported_compression));
 /** @endcond */
 
+/** @cond INTERNAL_HIDDEN */
+	/** Action to take once a worker thread is done with the client. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_WORKER_POOL, (uint8_t worker_action));
+/** @endcond */
+
 	/** Flag indicating that HTTP2 preface was sent. */
 	bool preface_sent : 1;
 
@@ -513,6 +526,9 @@ struct http_client_ctx {
 
 	/** The next frame on the stream is expectd to be a continuation frame. */
 	bool expect_continuation : 1;
+
+	/** Flag indicating the client is being processed by a worker thread. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_WORKER_POOL, (bool worker_busy : 1));
 };
 
 /**
@@ -67,6 +67,8 @@ struct http_resource_desc {
 
 struct http_service_runtime_data {
 	int num_clients;
+	/* Root of the resource routing trie, 0 if not built */
+	uint16_t trie_root;
 };
 
 struct http_service_desc {
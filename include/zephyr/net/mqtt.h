@@ -858,6 +858,22 @@ struct mqtt_transport {
 #endif
 };
 
+#if (CONFIG_MQTT_INFLIGHT_WINDOW > 0) || defined(__DOXYGEN__)
+/** @brief Outgoing QoS 1/QoS 2 publication awaiting acknowledgment. */
+struct mqtt_inflight {
+	/** Copy of the publish parameters, used for retransmission. Topic and
+	 *  payload still point to application memory.
+	 */
+	struct mqtt_publish_param param;
+
+	/** Wall clock value (in milliseconds) of the last transmission. */
+	uint32_t timestamp;
+
+	/** Acknowledgment state of the entry. */
+	uint8_t state;
+};
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW > 0 */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -884,6 +900,14 @@ struct mqtt_internal {
 	/** Internal. MQTT 5.0 disconnect reason set in case of processing errors. */
 	enum mqtt_disconnect_reason_code disconnect_reason;
 #endif /* CONFIG_MQTT_VERSION_5_0 */
+
+#if (CONFIG_MQTT_INFLIGHT_WINDOW > 0) || defined(__DOXYGEN__)
+	/** Internal. Publications awaiting PUBACK, PUBREC or PUBCOMP. */
+	struct mqtt_inflight inflight[CONFIG_MQTT_INFLIGHT_WINDOW];
+
+	/** Internal. Last message id assigned by the client. */
+	uint16_t last_message_id;
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW > 0 */
 };
 
 /**
@@ -1071,12 +1095,24 @@ int mqtt_connect(struct mqtt_client *client);
 /**
  * @brief API to publish messages on topics.
  *
+ * The payload is sent directly from the application memory, only the fixed
+ * and variable headers are encoded into the client's TX buffer.
+ *
  * @param[in] client Client instance for which the procedure is requested.
  *                   Shall not be NULL.
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
+ * @note If @kconfig{CONFIG_MQTT_INFLIGHT_WINDOW} is enabled, QoS 1 and QoS 2
+ *       publications are tracked by the client until acknowledged. A message
+ *       id of 0 requests the client to assign one, which is then reported in
+ *       the acknowledgment events. The topic and payload memory shall remain valid
+ *       until the publication is acknowledged, as it is used for
+ *       retransmissions.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         With the in-flight window enabled, -EAGAIN is returned if the
+ *         window is full and -EBUSY if the message id is already in use.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
@@ -1224,6 +1260,9 @@ int mqtt_abort(struct mqtt_client *client);
  *        makes it possible to respect the Keep Alive time agreed with the
  *        broker on connection. @ref mqtt_connect for details on Keep Alive
  *        time.
+ * @note  With @kconfig{CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT} set, this function
+ *        also retransmits MQTT 3.1.1 publications that were not acknowledged
+ *        in time.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
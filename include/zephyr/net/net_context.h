@@ -296,6 +296,14 @@ __net_socket struct net_context {
 	void *offload_context;
 #endif /* CONFIG_NET_OFFLOAD */
 
+#if defined(CONFIG_NET_CONTEXT_NBR_CACHE)
+	/** ARP or IPv6 neighbor entry used for the previous sent packet */
+	void *nbr_cache;
+
+	/** Neighbor table generation when nbr_cache was stored */
+	uint32_t nbr_cache_gen;
+#endif /* CONFIG_NET_CONTEXT_NBR_CACHE */
+
 #if defined(CONFIG_NET_SOCKETS_CAN)
 	int can_filter_id;
 #endif /* CONFIG_NET_SOCKETS_CAN */
@@ -330,6 +330,25 @@ struct net_offload;
 #endif
 /* @endcond */
 
+#if defined(CONFIG_NET_IF_IPV6_SRC_ADDR_CACHE)
+/** @cond INTERNAL_HIDDEN */
+/** Result of the last IPv6 source address selection on an interface */
+struct net_if_ipv6_src_cache {
+	/** Destination address the source was selected for */
+	struct in6_addr dst;
+
+	/** Selected source address, NULL if the entry is empty */
+	const struct in6_addr *src;
+
+	/** Address configuration generation the entry is valid for */
+	uint32_t gen;
+
+	/** Source address preference flags used for the selection */
+	int flags;
+};
+/** @endcond */
+#endif /* CONFIG_NET_IF_IPV6_SRC_ADDR_CACHE */
+
 /** IPv6 configuration */
 struct net_if_ipv6 {
 	/** Unicast IP addresses */
@@ -379,6 +398,11 @@ struct net_if_ipv6 {
 	uint8_t rs_count;
 #endif
 
+#if defined(CONFIG_NET_IF_IPV6_SRC_ADDR_CACHE)
+	/** Source address selection cache */
+	struct net_if_ipv6_src_cache src_cache;
+#endif
+
 	/** IPv6 hop limit */
 	uint8_t hop_limit;
 
@@ -632,7 +656,8 @@ struct net_traffic_class {
 	struct k_fifo fifo;
 
 #if NET_TC_COUNT > 1 || defined(CONFIG_NET_TC_TX_SKIP_FOR_HIGH_PRIO) \
-	|| defined(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO)
+	|| defined(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO) \
+	|| defined(CONFIG_NET_TC_RX_FLOW_STEERING)
 	/** Semaphore for tracking the available slots in the fifo */
 	struct k_sem fifo_slot;
 #endif
@@ -720,6 +745,11 @@ struct net_if {
 	/** Network statistics related to this network interface */
 	struct net_stats stats;
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	/** Per CPU counters, summed up into @ref stats when read */
+	struct net_stats_per_cpu stats_per_cpu[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 	/** Promethus collector for this network interface */
 	IF_ENABLED(CONFIG_NET_STATISTICS_VIA_PROMETHEUS,
 		   (struct prometheus_collector *collector);)
@@ -360,6 +360,13 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Segment size to use when splitting a TCP GSO super-segment,
+	 * 0 if this is a normal packet.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 	/* @endcond */
 };
 
@@ -872,6 +879,31 @@ static inline void net_pkt_set_ipv4_pmtu(struct net_pkt *pkt, bool value)
 }
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
 static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
 {
@@ -1468,6 +1500,103 @@ static inline void *net_pkt_cb(struct net_pkt *pkt)
 #define NET_IPV6_HDR(pkt) ((struct net_ipv6_hdr *)net_pkt_ip_data(pkt))
 #define NET_IPV4_HDR(pkt) ((struct net_ipv4_hdr *)net_pkt_ip_data(pkt))
 
+/**
+ * @brief Check if a network packet consists of a single buffer
+ *
+ * @param pkt Network packet.
+ *
+ * @return True if all the packet data is in one buffer, false otherwise.
+ */
+static inline bool net_pkt_is_single_buf(struct net_pkt *pkt)
+{
+	return pkt->buffer != NULL && pkt->buffer->frags == NULL;
+}
+
+/**
+ * @brief Get a pointer to data located in the first buffer of a packet
+ *
+ * @details This is a fast path for header access which neither uses nor
+ *          moves the packet cursor and never copies data. Callers should
+ *          fall back to the cursor based net_pkt_get_data() when NULL is
+ *          returned.
+ *
+ * @param pkt    Network packet.
+ * @param offset Offset of the data from the start of the packet.
+ * @param len    Length of the data that must be contiguous.
+ *
+ * @return Pointer to the data, NULL if the range is not within the first
+ *         buffer.
+ */
+static inline void *net_pkt_head_data(struct net_pkt *pkt, size_t offset,
+				      size_t len)
+{
+	if (pkt->buffer == NULL || offset + len > pkt->buffer->len) {
+		return NULL;
+	}
+
+	return pkt->buffer->data + offset;
+}
+
+/**
+ * @brief Get the IPv4 header of a packet without copying it
+ *
+ * @param pkt Network packet, with the IPv4 header at the start.
+ *
+ * @return Pointer to the header, NULL if it is not in the first buffer.
+ */
+static inline struct net_ipv4_hdr *net_pkt_ipv4_hdr(struct net_pkt *pkt)
+{
+	return (struct net_ipv4_hdr *)net_pkt_head_data(pkt, 0,
+							sizeof(struct net_ipv4_hdr));
+}
+
+/**
+ * @brief Get the IPv6 header of a packet without copying it
+ *
+ * @param pkt Network packet, with the IPv6 header at the start.
+ *
+ * @return Pointer to the header, NULL if it is not in the first buffer.
+ */
+static inline struct net_ipv6_hdr *net_pkt_ipv6_hdr(struct net_pkt *pkt)
+{
+	return (struct net_ipv6_hdr *)net_pkt_head_data(pkt, 0,
+							sizeof(struct net_ipv6_hdr));
+}
+
+/**
+ * @brief Get the UDP header of a packet without copying it
+ *
+ * @details The header is located using the IP header and options length
+ *          of the packet.
+ *
+ * @param pkt Network packet.
+ *
+ * @return Pointer to the header, NULL if it is not in the first buffer.
+ */
+static inline struct net_udp_hdr *net_pkt_udp_hdr(struct net_pkt *pkt)
+{
+	return (struct net_udp_hdr *)net_pkt_head_data(
+		pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt),
+		sizeof(struct net_udp_hdr));
+}
+
+/**
+ * @brief Get the TCP header of a packet without copying it
+ *
+ * @details The header is located using the IP header and options length
+ *          of the packet. TCP options are not included.
+ *
+ * @param pkt Network packet.
+ *
+ * @return Pointer to the header, NULL if it is not in the first buffer.
+ */
+static inline struct net_tcp_hdr *net_pkt_tcp_hdr(struct net_pkt *pkt)
+{
+	return (struct net_tcp_hdr *)net_pkt_head_data(
+		pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt),
+		sizeof(struct net_tcp_hdr));
+}
+
 static inline void net_pkt_set_src_ipv6_addr(struct net_pkt *pkt)
 {
 	net_if_ipv6_select_src_addr(net_context_get_iface(
@@ -2155,6 +2284,109 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
  */
 void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer);
 
+/**
+ * @brief RX page pool
+ *
+ * A pool of fixed-size pages owned by a network driver. The driver
+ * receives a frame directly into a page and attaches the page to a
+ * net_pkt as external buffer data, so the frame is not copied. When the
+ * net_pkt is freed, the page goes back to the same pool and is handed out
+ * again, most recently freed first. Use NET_PKT_PAGE_POOL_DEFINE() to
+ * define the pool.
+ */
+struct net_pkt_page_pool {
+	/** Free pages */
+	struct k_mem_slab *pages;
+	/** Buffers pointing to the pages */
+	struct net_buf_pool *bufs;
+	/** Size of one page */
+	size_t page_size;
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+void net_pkt_page_pool_recycle(struct k_mem_slab *pages, struct net_buf *buf);
+
+/** @endcond */
+
+/**
+ * @brief Statically define and initialize an RX page pool.
+ *
+ * @param _name Name of the page pool variable.
+ * @param _count Number of pages in the pool.
+ * @param _page_size Size of one page, should fit a full frame.
+ */
+#define NET_PKT_PAGE_POOL_DEFINE(_name, _count, _page_size)		\
+	K_MEM_SLAB_DEFINE_STATIC(_name##_pages,				\
+				 ROUND_UP(_page_size, sizeof(void *)),	\
+				 _count, sizeof(void *));		\
+	static void _name##_recycle(struct net_buf *buf)		\
+	{								\
+		net_pkt_page_pool_recycle(&_name##_pages, buf);		\
+	}								\
+	NET_BUF_POOL_FIXED_DEFINE(_name##_bufs, _count, 0, 0,		\
+				  _name##_recycle);			\
+	static struct net_pkt_page_pool _name = {			\
+		.pages = &_name##_pages,				\
+		.bufs = &_name##_bufs,					\
+		.page_size = _page_size,				\
+	}
+
+/**
+ * @brief Get a free page from an RX page pool.
+ *
+ * @param pool Page pool
+ * @param timeout How long to wait for a free page
+ *
+ * @return Pointer to a page of pool->page_size bytes, NULL if none is free.
+ */
+static inline uint8_t *net_pkt_page_get(struct net_pkt_page_pool *pool,
+					k_timeout_t timeout)
+{
+	void *page;
+
+	if (k_mem_slab_alloc(pool->pages, &page, timeout) < 0) {
+		return NULL;
+	}
+
+	return page;
+}
+
+/**
+ * @brief Return an unused page to its RX page pool.
+ *
+ * @details Only needed for pages that were not attached to a net_pkt
+ *          with net_pkt_rx_alloc_on_page().
+ *
+ * @param pool Page pool
+ * @param page Page returned by net_pkt_page_get()
+ */
+static inline void net_pkt_page_put(struct net_pkt_page_pool *pool,
+				    uint8_t *page)
+{
+	k_mem_slab_free(pool->pages, page);
+}
+
+/**
+ * @brief Allocate an RX packet on top of a received page.
+ *
+ * @details The page is attached to the packet without copying. It returns
+ *          to the page pool when the packet is freed. On failure the
+ *          caller still owns the page.
+ *
+ * @param pool Page pool the page was taken from
+ * @param iface The network interface the packet was received on
+ * @param page Page returned by net_pkt_page_get()
+ * @param len Length of the received data in the page
+ * @param timeout Maximum time to wait for an allocation
+ *
+ * @return a pointer to a newly allocated net_pkt on success, NULL otherwise.
+ */
+struct net_pkt *net_pkt_rx_alloc_on_page(struct net_pkt_page_pool *pool,
+					 struct net_if *iface,
+					 uint8_t *page, size_t len,
+					 k_timeout_t timeout);
+
 /**
  * @brief Get available buffer space from a pkt
  *
@@ -2313,6 +2545,29 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 		 struct net_pkt *pkt_src,
 		 size_t length);
 
+/**
+ * @brief Append data from a packet to another one without copying it.
+ *
+ * @details The data is appended to the end of the destination packet as
+ *          buffers which reference the data of the source packet. This
+ *          requires buffers with variable data size, as fixed size buffers
+ *          cannot share their data. The source cursor should be properly
+ *          initialized and, if needed, positioned using net_pkt_skip. It
+ *          will be updated after the operation.
+ *
+ * @param pkt_dst Destination network packet.
+ * @param pkt_src Source network packet.
+ * @param length  Length of data to be appended.
+ * @param timeout Timeout to wait for a free buffer
+ *
+ * @return 0 on success, -ENOTSUP if the data cannot be shared (nothing is
+ *         done in that case), other negative errno code otherwise.
+ */
+int net_pkt_share_data(struct net_pkt *pkt_dst,
+		       struct net_pkt *pkt_src,
+		       size_t length,
+		       k_timeout_t timeout);
+
 /**
  * @brief Clone pkt and its buffer. The cloned packet will be allocated on
  *        the same pool as the original one.
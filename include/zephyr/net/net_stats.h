@@ -219,6 +219,26 @@ struct net_stats_ipv6_pmtu {
 	net_stats_t sent;
 };
 
+/**
+ * @brief IPv6 routing table statistics
+ */
+struct net_stats_route {
+	/** Number of routing table lookups. */
+	net_stats_t lookup;
+
+	/** Number of lookups served from the last destination cache. */
+	net_stats_t cache_hit;
+
+	/** Number of lookups that did not find a route. */
+	net_stats_t no_route;
+
+	/** Number of added routes. */
+	net_stats_t added;
+
+	/** Number of deleted routes. */
+	net_stats_t deleted;
+};
+
 /**
  * @brief IPv4 Path MTU Discovery statistics
  */
@@ -357,6 +377,23 @@ struct net_stats_tc {
 };
 
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+/**
+ * @brief RX flow steering statistics
+ */
+struct net_stats_rx_flow {
+	/** Statistics for each RX flow steering queue */
+	struct {
+		/** Number of packets steered to this queue */
+		net_stats_t pkts;
+		/** Number of packets dropped because this queue was full */
+		net_stats_t dropped;
+		/** Number of bytes steered to this queue */
+		net_stats_t bytes;
+	} queue[CONFIG_NET_TC_RX_FLOW_QUEUES];
+};
+#endif
+
 /**
  * @brief Power management statistics
  */
@@ -455,6 +492,11 @@ struct net_stats {
 	struct net_stats_ipv6_pmtu ipv6_pmtu;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_ROUTE)
+	/** IPv6 routing table statistics */
+	struct net_stats_route route;
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_IPV4_PMTU)
 	/** IPv4 Path MTU Discovery statistics */
 	struct net_stats_ipv4_pmtu ipv4_pmtu;
@@ -480,6 +522,11 @@ struct net_stats {
 	struct net_stats_tc tc;
 #endif
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+	/** RX flow steering statistics */
+	struct net_stats_rx_flow rx_flow;
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
@@ -505,6 +552,20 @@ struct net_stats {
 #endif
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* Private copy of the statistics counters updated by a single CPU. Only
+ * the plain net_stats_t counters are updated here, the copies are summed
+ * up into the shared struct net_stats when the statistics are read.
+ */
+struct net_stats_per_cpu {
+	struct net_stats stats;
+};
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
+/** @endcond */
+
 /**
  * @brief Ethernet error statistics
  */
@@ -758,6 +819,7 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_WIFI,
 	NET_REQUEST_STATS_CMD_RESET_WIFI,
 	NET_REQUEST_STATS_CMD_GET_VPN,
+	NET_REQUEST_STATS_CMD_GET_ROUTE,
 };
 
 /** @endcond */
@@ -835,6 +897,16 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_PMTU);
 /** @endcond */
 #endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
 
+#if defined(CONFIG_NET_STATISTICS_ROUTE)
+/** Request IPv6 routing table statistics */
+#define NET_REQUEST_STATS_GET_ROUTE				\
+	(NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_ROUTE)
+
+/** @cond INTERNAL_HIDDEN */
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_ROUTE);
+/** @endcond */
+#endif /* CONFIG_NET_STATISTICS_ROUTE */
+
 #if defined(CONFIG_NET_STATISTICS_IPV4_PMTU)
 /** Request IPv4 Path MTU Discovery statistics */
 #define NET_REQUEST_STATS_GET_IPV4_PMTU				\
@@ -49,6 +49,93 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 				 size_t buffer_size, int *written);
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_PROMETHEUS)
+#define PROMETHEUS_FORMAT_LINE_SIZE CONFIG_PROMETHEUS_FORMATTER_LINE_SIZE
+#else
+#define PROMETHEUS_FORMAT_LINE_SIZE 128
+#endif /* CONFIG_PROMETHEUS */
+
+enum prometheus_format_stream_state {
+	PROMETHEUS_FORMAT_STREAM_START,
+	PROMETHEUS_FORMAT_STREAM_RUNNING,
+	PROMETHEUS_FORMAT_STREAM_DONE,
+};
+
+struct prometheus_format_stream {
+	struct prometheus_collector *collector;
+	struct prometheus_metric *metric;
+	struct prometheus_metric *next;
+	enum prometheus_format_stream_state state;
+	int line;
+	size_t prefix_len;
+	size_t line_len;
+	size_t line_pos;
+	char line_buf[PROMETHEUS_FORMAT_LINE_SIZE];
+};
+
+/** @endcond */
+
+/**
+ * @brief Initialize a streaming formatter for a collector.
+ *
+ * @param stream Pointer to the stream context.
+ * @param collector Pointer to the collector to format.
+ *
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_format_stream_init(struct prometheus_format_stream *stream,
+				  struct prometheus_collector *collector);
+
+/**
+ * @brief Format the next chunk of exposition data for Prometheus
+ *
+ * Fills the buffer with as much of the exposition as fits, lines may be split
+ * between chunks. The output is not NUL terminated. No buffer needs to hold
+ * the whole exposition, so the chunks can be passed directly to an HTTP
+ * response.
+ *
+ * The collector lock is taken on the first call and held until the whole
+ * exposition has been produced, an error is returned or the stream is
+ * aborted, so all chunks describe a consistent set of metrics. All calls
+ * must therefore be made from the same thread.
+ *
+ * @param stream Pointer to the stream context.
+ * @param buffer Pointer to the buffer for the chunk.
+ * @param buffer_size Size of the buffer.
+ *
+ * @return Number of bytes written, negative errno on error. Use
+ *         prometheus_format_stream_done() to check whether this was the
+ *         last chunk.
+ * @retval -ENOMEM A single exposition line does not fit into
+ *         @kconfig{CONFIG_PROMETHEUS_FORMATTER_LINE_SIZE} bytes.
+ */
+int prometheus_format_stream(struct prometheus_format_stream *stream, char *buffer,
+			     size_t buffer_size);
+
+/**
+ * @brief Check whether the streaming formatter has produced everything.
+ *
+ * @param stream Pointer to the stream context.
+ *
+ * @return true if the exposition is complete and the collector unlocked.
+ */
+static inline bool prometheus_format_stream_done(const struct prometheus_format_stream *stream)
+{
+	return stream->state == PROMETHEUS_FORMAT_STREAM_DONE;
+}
+
+/**
+ * @brief Stop a streaming formatter before it is complete.
+ *
+ * Releases the collector lock if it is held, for example when the HTTP
+ * client went away in the middle of a scrape.
+ *
+ * @param stream Pointer to the stream context.
+ */
+void prometheus_format_stream_abort(struct prometheus_format_stream *stream);
+
 /**
  * @}
  */
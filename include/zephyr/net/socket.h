@@ -189,6 +189,11 @@ extern "C" {
 /** Socket option to control TLS session caching on a socket. Accepted values:
  *  - 0 - Disabled.
  *  - 1 - Enabled.
+ *
+ *  On a client socket, the session is stored after a successful handshake
+ *  and offered to the same peer on the next connection. When set on a
+ *  listening socket, connections accepted on it look up and store sessions
+ *  in the server-side session cache (requires MBEDTLS_SSL_CACHE_C).
  */
 #define TLS_SESSION_CACHE 12
 /** Write-only socket option to purge session cache immediately.
@@ -260,6 +265,25 @@ extern "C" {
  *  Kconfig option is enabled.
  */
 #define TLS_CERT_VERIFY_CALLBACK 20
+/** Socket option to control RFC 5077 session tickets on a socket.
+ *  Accepted values:
+ *  - 0 - Disabled.
+ *  - 1 - Enabled.
+ *
+ *  When enabled on a listening socket, connections accepted on it issue
+ *  session tickets and accept them for session resumption, so that no
+ *  per-client state has to be kept on the server. Ticket keys are shared by
+ *  all server sockets and are rotated with @ref TLS_SESSION_CACHE_PURGE.
+ *  On a client socket, the option controls whether session tickets are
+ *  requested from the server; @ref TLS_SESSION_CACHE needs to be enabled as
+ *  well to store the received ticket for later connections. If not set,
+ *  the TLS backend default is used on a client socket, and tickets are
+ *  disabled on a server socket.
+ *
+ *  The option is only available if CONFIG_MBEDTLS_TLS_SESSION_TICKETS
+ *  Kconfig option is enabled.
+ */
+#define TLS_SESSION_TICKETS 21
 
 /* Valid values for @ref TLS_PEER_VERIFY option */
 #define TLS_PEER_VERIFY_NONE 0     /**< Peer verification disabled. */
@@ -278,6 +302,10 @@ extern "C" {
 #define TLS_SESSION_CACHE_DISABLED 0 /**< Disable TLS session caching. */
 #define TLS_SESSION_CACHE_ENABLED 1 /**< Enable TLS session caching. */
 
+/* Valid values for @ref TLS_SESSION_TICKETS option */
+#define TLS_SESSION_TICKETS_DISABLED 0 /**< Disable TLS session tickets. */
+#define TLS_SESSION_TICKETS_ENABLED 1 /**< Enable TLS session tickets. */
+
 /* Valid values for @ref TLS_DTLS_CID (Connection ID) option */
 #define TLS_DTLS_CID_DISABLED		0 /**< CID is disabled  */
 #define TLS_DTLS_CID_SUPPORTED		1 /**< CID is supported */
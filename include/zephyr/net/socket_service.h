@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <zephyr/types.h>
+#include <zephyr/kernel.h>
 #include <zephyr/net/socket.h>
 
 #ifdef __cplusplus
@@ -57,6 +58,34 @@ struct net_socket_service_event {
 	struct net_socket_service_desc *svc;
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+/** Poll context of a socket service dispatcher thread. */
+struct net_socket_service_poller {
+	/** Poll array, the first entry is the eventfd used to wake up the thread */
+	struct zsock_pollfd *events;
+	/** Service owning each entry of the poll array, NULL if there is only one */
+	const struct net_socket_service_desc **owners;
+	/** The only service of the poller, if owners is NULL */
+	const struct net_socket_service_desc *svc;
+	/** Length of the poll array */
+	int count;
+	/** Range of the poll array entries changed since the last update */
+	int dirty_start;
+	int dirty_end;
+	/** Dispatcher thread status */
+	int status;
+#if defined(CONFIG_NET_SOCKETS_SERVICE_THREADS)
+	/** Dedicated dispatcher thread */
+	struct k_thread thread;
+	k_thread_stack_t *stack;
+	size_t stack_size;
+	int prio;
+#endif
+};
+
+/** @endcond */
+
 /**
  * Main structure holding socket service configuration information.
  * The k_work item is created so that when there is data coming
@@ -81,6 +110,13 @@ struct net_socket_service_desc {
 	int pev_len;
 	/** Where are my pollfd entries in the global list */
 	int *idx;
+#if defined(CONFIG_NET_SOCKETS_SERVICE_THREADS)
+	/**
+	 * Dedicated dispatcher thread of the service, NULL if the service
+	 * is handled by the common socket service thread.
+	 */
+	struct net_socket_service_poller *poller;
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -96,6 +132,9 @@ struct net_socket_service_desc {
 #endif
 
 #define __z_net_socket_service_define(_name, _cb, _count, ...) \
+	__z_net_socket_service_define_poller(_name, _cb, _count, NULL, __VA_ARGS__)
+
+#define __z_net_socket_service_define_poller(_name, _cb, _count, _poller, ...) \
 	static int __z_net_socket_svc_get_idx(_name);			\
 	static struct net_socket_service_event				\
 			__z_net_socket_svc_get_name(_name)[_count] = {	\
@@ -110,8 +149,27 @@ struct net_socket_service_desc {
 		.pev = __z_net_socket_svc_get_name(_name),		\
 		.pev_len = (_count),					\
 		.idx = &__z_net_socket_svc_get_idx(_name),		\
+		IF_ENABLED(CONFIG_NET_SOCKETS_SERVICE_THREADS,		\
+			   (.poller = _poller,))			\
 	}
 
+#define __z_net_socket_svc_get_poller(_svc_id) __z_net_socket_service_poller_##_svc_id
+#define __z_net_socket_svc_get_events(_svc_id) __z_net_socket_service_events_##_svc_id
+#define __z_net_socket_svc_get_stack(_svc_id) __z_net_socket_service_stack_##_svc_id
+
+#define __z_net_socket_service_thread_define(_name, _cb, _count, _stack_size, _prio, ...) \
+	static K_THREAD_STACK_DEFINE(__z_net_socket_svc_get_stack(_name), _stack_size); \
+	static struct zsock_pollfd __z_net_socket_svc_get_events(_name)[(_count) + 1]; \
+	static struct net_socket_service_poller __z_net_socket_svc_get_poller(_name) = { \
+		.events = __z_net_socket_svc_get_events(_name),		\
+		.count = (_count) + 1,					\
+		.stack = __z_net_socket_svc_get_stack(_name),		\
+		.stack_size = K_THREAD_STACK_SIZEOF(__z_net_socket_svc_get_stack(_name)), \
+		.prio = (_prio),					\
+	};								\
+	__z_net_socket_service_define_poller(_name, _cb, _count,	\
+				&__z_net_socket_svc_get_poller(_name), __VA_ARGS__)
+
 /** @endcond */
 
 /**
@@ -148,6 +206,45 @@ struct net_socket_service_desc {
 #define NET_SOCKET_SERVICE_SYNC_DEFINE_STATIC(name, cb, count)	\
 	__z_net_socket_service_define(name, cb, count, static)
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_THREADS) || defined(__DOXYGEN__)
+/**
+ * @brief Statically define a network socket service with its own dispatcher thread.
+ *        The sockets of the service are polled by a dedicated thread instead of
+ *        the common socket service thread, so a slow callback of another
+ *        service does not delay this one. The user callback is called
+ *        synchronously from that thread.
+ *
+ * The socket service can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct net_socket_service_desc <name>; @endcode
+ *
+ * @note This macro cannot be used together with a static keyword.
+ *       If such a use-case is desired, use NET_SOCKET_SERVICE_THREAD_DEFINE_STATIC
+ *       instead.
+ *
+ * @param name Name of the service.
+ * @param cb Callback function that is called for socket activity.
+ * @param count How many pollable sockets is needed for this service.
+ * @param stack_size Stack size of the dispatcher thread.
+ * @param prio Priority of the dispatcher thread.
+ */
+#define NET_SOCKET_SERVICE_THREAD_DEFINE(name, cb, count, stack_size, prio) \
+	__z_net_socket_service_thread_define(name, cb, count, stack_size, prio)
+
+/**
+ * @brief Statically define a network socket service with its own dispatcher
+ *        thread in a private (static) scope.
+ *
+ * @param name Name of the service.
+ * @param cb Callback function that is called for socket activity.
+ * @param count How many pollable sockets is needed for this service.
+ * @param stack_size Stack size of the dispatcher thread.
+ * @param prio Priority of the dispatcher thread.
+ */
+#define NET_SOCKET_SERVICE_THREAD_DEFINE_STATIC(name, cb, count, stack_size, prio) \
+	__z_net_socket_service_thread_define(name, cb, count, stack_size, prio, static)
+#endif
+
 /**
  * @brief Register pollable sockets.
  *
@@ -154,11 +154,36 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		       enum websocket_opcode opcode, bool mask, bool final,
 		       int32_t timeout);
 
+/**
+ * @brief Send a websocket frame gathered from multiple buffers.
+ *
+ * @details The function will automatically add websocket header to the
+ * message. The header and the payload buffers are passed to the socket in a
+ * single sendmsg() call, so the payload is not copied. If @p mask is set, the
+ * payload buffers are masked in place and hold the masked data on return.
+ *
+ * @param ws_sock Websocket id returned by websocket_connect().
+ * @param message Payload buffers of the frame. At most 4 buffers are
+ *        supported.
+ * @param opcode Operation code (text, binary, ping, pong, close)
+ * @param mask Mask the data in place, see RFC 6455 for details
+ * @param final Is this final message for this message send. See
+ *        websocket_send_msg() for details.
+ * @param timeout How long to try to send the message. The value is in
+ *        milliseconds. Value SYS_FOREVER_MS means to wait forever.
+ *
+ * @return <0 if error, >=0 amount of payload bytes sent
+ */
+int websocket_sendmsg(int ws_sock, const struct msghdr *message,
+		      enum websocket_opcode opcode, bool mask, bool final,
+		      int32_t timeout);
+
 /**
  * @brief Receive websocket msg from peer.
  *
  * @details The function will automatically remove websocket header from the
- * message.
+ * message. Payload that is not already buffered is read directly into
+ * @p buf, and masked payload is unmasked in place.
  *
  * @param ws_sock Websocket id returned by websocket_connect().
  * @param buf Buffer where websocket data is read.
@@ -67,6 +67,7 @@ struct zperf_upload_params {
 		bool wait_for_start;
 #endif
 		uint32_t report_interval_ms;
+		uint8_t num_streams;
 	} options;
 };
 
@@ -90,6 +91,24 @@ struct zperf_results {
 	uint64_t client_time_in_us;   /**< Client connection time in microseconds */
 	uint32_t packet_size;         /**< Packet size */
 	uint32_t nb_packets_errors;   /**< Number of packet errors */
+	uint16_t cpu_load;            /**< CPU load in per mille, valid with CONFIG_CPU_LOAD */
+	uint8_t nb_streams;           /**< Number of parallel streams used */
+};
+
+/** Request/response latency results */
+struct zperf_latency_results {
+	uint32_t nb_requests;         /**< Number of requests sent */
+	uint32_t nb_responses;        /**< Number of matching responses received */
+	uint32_t nb_timeouts;         /**< Number of requests that timed out */
+	uint32_t packet_size;         /**< Request and response size */
+	uint64_t time_in_us;          /**< Total time of the test in microseconds */
+	uint32_t min_us;              /**< Smallest round-trip time */
+	uint32_t avg_us;              /**< Average round-trip time */
+	uint32_t max_us;              /**< Largest round-trip time */
+	uint32_t p50_us;              /**< Median round-trip time */
+	uint32_t p90_us;              /**< 90th percentile round-trip time */
+	uint32_t p99_us;              /**< 99th percentile round-trip time */
+	uint16_t cpu_load;            /**< CPU load in per mille, valid with CONFIG_CPU_LOAD */
 };
 
 /**
@@ -157,6 +176,40 @@ int zperf_udp_upload_async(const struct zperf_upload_params *param,
 int zperf_tcp_upload_async(const struct zperf_upload_params *param,
 			   zperf_callback callback, void *user_data);
 
+/**
+ * @brief Synchronous TCP request/response latency test.
+ *
+ * Sends requests of @a param packet_size bytes on a single connection and
+ * waits for the peer to echo each one back before sending the next. The peer
+ * must run an echo service, for example the echo_server sample. Percentiles
+ * are taken from a log-linear histogram and are accurate to about 25%.
+ *
+ * @note Only one latency test can be performed at a time.
+ *
+ * @param param Upload parameters, the rate and stream count are ignored.
+ * @param result Latency results.
+ *
+ * @return 0 if test completed successfully, a negative error code otherwise.
+ */
+int zperf_tcp_latency(const struct zperf_upload_params *param,
+		      struct zperf_latency_results *result);
+
+/**
+ * @brief Synchronous UDP request/response latency test.
+ *
+ * Same as zperf_tcp_latency() but each request is a single datagram. Lost
+ * requests or responses are counted as timeouts.
+ *
+ * @note Only one latency test can be performed at a time.
+ *
+ * @param param Upload parameters, the rate and stream count are ignored.
+ * @param result Latency results.
+ *
+ * @return 0 if test completed successfully, a negative error code otherwise.
+ */
+int zperf_udp_latency(const struct zperf_upload_params *param,
+		      struct zperf_latency_results *result);
+
 /**
  * @brief Start UDP server.
  *
@@ -1423,6 +1423,39 @@ struct net_buf * __must_check net_buf_alloc_with_data(struct net_buf_pool *pool,
 						      k_timeout_t timeout);
 #endif
 
+/**
+ * @brief Allocate several buffers from a pool as a fragment chain.
+ *
+ * Allocate @a count buffers, each with at least @a size bytes of data,
+ * and link them together using the fragments list. All the buffers that
+ * are available in the pool without waiting are taken in a single
+ * critical section. The allocation is all or nothing: if some buffer
+ * cannot be allocated before the timeout expires, the buffers already
+ * taken are returned to the pool.
+ *
+ * @param pool Which pool to allocate the buffers from.
+ * @param size Amount of data each buffer must be able to fit.
+ * @param count Number of buffers to allocate. Must not be larger than
+ *        the number of buffers in the pool.
+ * @param timeout Affects the action taken should the pool not have
+ *        enough free buffers. See net_buf_alloc_len() for details.
+ *
+ * @return First buffer of the fragment chain or NULL if out of buffers.
+ */
+#if defined(CONFIG_NET_BUF_LOG)
+struct net_buf * __must_check net_buf_alloc_bulk_debug(struct net_buf_pool *pool,
+						       size_t size, size_t count,
+						       k_timeout_t timeout,
+						       const char *func, int line);
+#define net_buf_alloc_bulk(_pool, _size, _count, _timeout)		\
+	net_buf_alloc_bulk_debug(_pool, _size, _count, _timeout,	\
+				 __func__, __LINE__)
+#else
+struct net_buf * __must_check net_buf_alloc_bulk(struct net_buf_pool *pool,
+						 size_t size, size_t count,
+						 k_timeout_t timeout);
+#endif
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1497,6 +1530,24 @@ void net_buf_unref_debug(struct net_buf *buf, const char *func, int line);
 void net_buf_unref(struct net_buf *buf);
 #endif
 
+/**
+ * @brief Decrements the reference count of a fragment chain.
+ *
+ * Works like net_buf_unref() but the buffers whose reference count reaches
+ * zero are put back into their pool in one operation per pool instead of
+ * one operation per buffer. Buffers from pools with a custom destroy
+ * callback are still destroyed one by one.
+ *
+ * @param buf A valid pointer on the first buffer of the chain
+ */
+#if defined(CONFIG_NET_BUF_LOG)
+void net_buf_unref_chain_debug(struct net_buf *buf, const char *func, int line);
+#define	net_buf_unref_chain(_buf) \
+	net_buf_unref_chain_debug(_buf, __func__, __LINE__)
+#else
+void net_buf_unref_chain(struct net_buf *buf);
+#endif
+
 /**
  * @brief Increment the reference count of a buffer.
  *
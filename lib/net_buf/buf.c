@@ -388,6 +388,151 @@ struct net_buf *net_buf_alloc_with_data(struct net_buf_pool *pool,
 	return buf;
 }
 
+static void bulk_release_raw(struct net_buf *raw)
+{
+	while (raw) {
+		struct net_buf *next = raw->frags;
+
+		raw->__buf = NULL;
+		raw->frags = NULL;
+		net_buf_destroy(raw);
+
+		raw = next;
+	}
+}
+
+#if defined(CONFIG_NET_BUF_LOG)
+struct net_buf *net_buf_alloc_bulk_debug(struct net_buf_pool *pool,
+					 size_t size, size_t count,
+					 k_timeout_t timeout,
+					 const char *func, int line)
+#else
+struct net_buf *net_buf_alloc_bulk(struct net_buf_pool *pool,
+				   size_t size, size_t count,
+				   k_timeout_t timeout)
+#endif
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct net_buf *raw = NULL;
+	struct net_buf *first = NULL;
+	struct net_buf *last = NULL;
+	struct net_buf *buf;
+	bool lifo_empty = false;
+	k_spinlock_key_t key;
+	size_t got = 0;
+
+	__ASSERT_NO_MSG(pool);
+
+	NET_BUF_DBG("%s():%d: pool %p size %zu count %zu", func, line, pool,
+		    size, count);
+
+	if (count == 0 || count > pool->buf_count) {
+		return NULL;
+	}
+
+	/* Take everything that is available right away in one go. The raw
+	 * buffers are linked through the frags pointer until they are
+	 * initialized.
+	 */
+	key = k_spin_lock(&pool->lock);
+
+	while (got < count) {
+		buf = NULL;
+
+		if (!lifo_empty && pool->uninit_count < pool->buf_count) {
+			buf = k_lifo_get(&pool->free, K_NO_WAIT);
+			lifo_empty = (buf == NULL);
+		}
+
+		if (buf == NULL) {
+			if (pool->uninit_count == 0) {
+				break;
+			}
+
+			buf = pool_get_uninit(pool, pool->uninit_count--);
+			buf->__buf = NULL;
+		}
+
+		buf->frags = raw;
+		raw = buf;
+		got++;
+	}
+
+	k_spin_unlock(&pool->lock, key);
+
+	/* Wait for the rest one by one */
+	while (got < count) {
+		buf = k_lifo_get(&pool->free, sys_timepoint_timeout(end));
+		if (!buf) {
+			NET_BUF_ERR("%s():%d: Failed to get %zu free buffers",
+				    func, line, count);
+			bulk_release_raw(raw);
+			return NULL;
+		}
+
+		buf->frags = raw;
+		raw = buf;
+		got++;
+	}
+
+	while (raw) {
+		size_t buf_size = size;
+
+		buf = raw;
+		raw = buf->frags;
+
+		if (size) {
+			buf->__buf = data_alloc(buf, &buf_size,
+						sys_timepoint_timeout(end));
+			if (!buf->__buf) {
+				NET_BUF_ERR("%s():%d: Failed to allocate data",
+					    func, line);
+				buf->frags = raw;
+				bulk_release_raw(buf);
+
+				if (first) {
+					net_buf_unref_chain(first);
+				}
+
+				return NULL;
+			}
+
+			NET_BUF_ASSERT(size <= buf_size);
+		} else {
+			buf->__buf = NULL;
+		}
+
+		buf->ref   = 1U;
+		buf->flags = 0U;
+		buf->frags = NULL;
+		buf->size  = buf_size;
+		memset(buf->user_data, 0, buf->user_data_size);
+		net_buf_reset(buf);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+		atomic_dec(&pool->avail_count);
+		__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
+#endif
+
+		if (last) {
+			last->frags = buf;
+		} else {
+			first = buf;
+		}
+
+		last = buf;
+	}
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	pool->max_used = MAX(pool->max_used,
+			     pool->buf_count - atomic_get(&pool->avail_count));
+#endif
+
+	NET_BUF_DBG("allocated %zu bufs starting from %p", count, first);
+
+	return first;
+}
+
 static struct k_spinlock net_buf_slist_lock;
 
 void net_buf_slist_put(sys_slist_t *list, struct net_buf *buf)
@@ -464,6 +609,91 @@ void net_buf_unref(struct net_buf *buf)
 	}
 }
 
+/* Put a list of buffers linked through their node back into the pool */
+static void pool_put_list(struct net_buf_pool *pool, struct net_buf *head,
+			  struct net_buf *tail)
+{
+	if (head) {
+		(void)k_queue_append_list(&pool->free._queue, head, tail);
+	}
+}
+
+#if defined(CONFIG_NET_BUF_LOG)
+void net_buf_unref_chain_debug(struct net_buf *buf, const char *func, int line)
+#else
+void net_buf_unref_chain(struct net_buf *buf)
+#endif
+{
+	struct net_buf_pool *pool = NULL;
+	struct net_buf *head = NULL;
+	struct net_buf *tail = NULL;
+
+	__ASSERT_NO_MSG(buf);
+
+	while (buf) {
+		struct net_buf *frags = buf->frags;
+		struct net_buf_pool *buf_pool;
+
+#if defined(CONFIG_NET_BUF_LOG)
+		if (!buf->ref) {
+			NET_BUF_ERR("%s():%d: buf %p double free", func, line,
+				    buf);
+			break;
+		}
+#endif
+		NET_BUF_DBG("buf %p ref %u pool_id %u frags %p", buf, buf->ref,
+			    buf->pool_id, buf->frags);
+
+		if (--buf->ref > 0) {
+			break;
+		}
+
+		buf->data = NULL;
+		buf->frags = NULL;
+
+		buf_pool = net_buf_pool_get(buf->pool_id);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+		atomic_inc(&buf_pool->avail_count);
+		__ASSERT_NO_MSG(atomic_get(&buf_pool->avail_count) <=
+				buf_pool->buf_count);
+#endif
+
+		if (buf_pool->destroy) {
+			buf_pool->destroy(buf);
+			buf = frags;
+			continue;
+		}
+
+		if (buf->__buf) {
+			if (!(buf->flags & NET_BUF_EXTERNAL_DATA)) {
+				buf_pool->alloc->cb->unref(buf, buf->__buf);
+			}
+
+			buf->__buf = NULL;
+		}
+
+		if (buf_pool != pool) {
+			pool_put_list(pool, head, tail);
+			pool = buf_pool;
+			head = NULL;
+		}
+
+		buf->node.next = NULL;
+
+		if (head) {
+			tail->node.next = &buf->node;
+		} else {
+			head = buf;
+		}
+
+		tail = buf;
+		buf = frags;
+	}
+
+	pool_put_list(pool, head, tail);
+}
+
 struct net_buf *net_buf_ref(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf);
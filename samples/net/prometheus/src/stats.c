@@ -30,38 +30,45 @@ extern struct http_service_desc test_http_service;
 
 static struct prometheus_counter *http_request_counter;
 static struct prometheus_collector *stats_collector;
-static struct prometheus_collector_walk_context walk_ctx;
+static struct prometheus_format_stream stats_stream;
 
 static int stats_handler(struct http_client_ctx *client, enum http_data_status status,
 			 const struct http_request_ctx *request_ctx,
 			 struct http_response_ctx *response_ctx, void *user_data)
 {
+	struct prometheus_format_stream *stream = user_data;
+	static uint8_t prom_buffer[256];
 	int ret;
-	static uint8_t prom_buffer[1024];
 
-	if (status == HTTP_SERVER_DATA_FINAL) {
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		/* Release the collector if the client went away mid-scrape */
+		prometheus_format_stream_abort(stream);
+		(void)prometheus_format_stream_init(stream, stats_collector);
+		return 0;
+	}
 
-		/* incrase counter per request */
-		prometheus_counter_inc(http_request_counter);
+	if (status == HTTP_SERVER_DATA_FINAL) {
 
-		(void)memset(prom_buffer, 0, sizeof(prom_buffer));
+		if (stream->state == PROMETHEUS_FORMAT_STREAM_START) {
+			/* incrase counter per request */
+			prometheus_counter_inc(http_request_counter);
+		}
 
-		ret = prometheus_collector_walk_metrics(user_data,
-							prom_buffer,
-							sizeof(prom_buffer));
-		if (ret < 0 && ret != -EAGAIN) {
+		ret = prometheus_format_stream(stream, prom_buffer, sizeof(prom_buffer));
+		if (ret < 0) {
 			LOG_ERR("Cannot format exposition data (%d)", ret);
+			(void)prometheus_format_stream_init(stream, stats_collector);
 			return ret;
 		}
 
 		response_ctx->body = prom_buffer;
-		response_ctx->body_len = strlen(prom_buffer);
+		response_ctx->body_len = ret;
 
-		if (ret == 0) {
+		if (prometheus_format_stream_done(stream)) {
 			response_ctx->final_chunk = true;
-			ret = prometheus_collector_walk_init(&walk_ctx, stats_collector);
+			ret = prometheus_format_stream_init(stream, stats_collector);
 			if (ret < 0) {
-				LOG_ERR("Cannot initialize walk context (%d)", ret);
+				LOG_ERR("Cannot initialize format stream (%d)", ret);
 			}
 		}
 	}
@@ -76,7 +83,7 @@ struct http_resource_detail_dynamic stats_resource_detail = {
 			.content_type = "text/plain",
 	},
 	.cb = stats_handler,
-	.user_data = &walk_ctx,
+	.user_data = &stats_stream,
 };
 
 HTTP_RESOURCE_DEFINE(stats_resource, test_http_service, "/statistics", &stats_resource_detail);
@@ -90,7 +97,7 @@ int init_stats(struct prometheus_counter *counter)
 		return -EINVAL;
 	}
 
-	(void)prometheus_collector_walk_init(&walk_ctx, stats_collector);
+	(void)prometheus_format_stream_init(&stats_stream, stats_collector);
 
 	http_request_counter = counter;
 
@@ -223,6 +223,38 @@ static int modem_backend_uart_isr_receive(void *data, uint8_t *buf, size_t size)
 	return (int)read_bytes;
 }
 
+static int modem_backend_uart_isr_receive_claim(void *data, uint8_t **buf, size_t size)
+{
+	struct modem_backend_uart *backend = (struct modem_backend_uart *)data;
+	uint8_t receive_rdb_unused;
+
+#if CONFIG_MODEM_STATS
+	advertise_receive_buf_stats(backend);
+#endif
+
+	receive_rdb_unused = (backend->isr.receive_rdb_used == 1) ? 0 : 1;
+
+	/* The unused ring double buffer is never written by the ISR, so it can be claimed */
+	if (ring_buf_is_empty(&backend->isr.receive_rdb[receive_rdb_unused]) == true) {
+		uart_irq_rx_disable(backend->uart);
+		backend->isr.receive_rdb_used = receive_rdb_unused;
+		uart_irq_rx_enable(backend->uart);
+
+		receive_rdb_unused = (backend->isr.receive_rdb_used == 1) ? 0 : 1;
+	}
+
+	return (int)ring_buf_get_claim(&backend->isr.receive_rdb[receive_rdb_unused], buf, size);
+}
+
+static int modem_backend_uart_isr_receive_finish(void *data, size_t size)
+{
+	struct modem_backend_uart *backend = (struct modem_backend_uart *)data;
+	uint8_t receive_rdb_unused;
+
+	receive_rdb_unused = (backend->isr.receive_rdb_used == 1) ? 0 : 1;
+	return ring_buf_get_finish(&backend->isr.receive_rdb[receive_rdb_unused], size);
+}
+
 static int modem_backend_uart_isr_close(void *data)
 {
 	struct modem_backend_uart *backend = (struct modem_backend_uart *)data;
@@ -238,6 +270,8 @@ static const struct modem_pipe_api modem_backend_uart_isr_api = {
 	.transmit = modem_backend_uart_isr_transmit,
 	.receive = modem_backend_uart_isr_receive,
 	.close = modem_backend_uart_isr_close,
+	.receive_claim = modem_backend_uart_isr_receive_claim,
+	.receive_finish = modem_backend_uart_isr_receive_finish,
 };
 
 #if CONFIG_MODEM_STATS
@@ -385,6 +385,14 @@ static void modem_chat_parse_reset(struct modem_chat *chat)
 	chat->delimiter_match_len = 0;
 	chat->argc = 0;
 	chat->parse_match = NULL;
+
+#if CONFIG_MODEM_CHAT_UNSOL_TRIE
+	/* Restart matching received data from root of trie */
+	chat->unsol_trie_states[0] = 0;
+	chat->unsol_trie_states_len = 1;
+	chat->unsol_trie_states_overrun = false;
+	chat->unsol_trie_pos = 0;
+#endif
 }
 
 /* Exact match is stored at end of receive buffer */
@@ -426,10 +434,161 @@ static bool modem_chat_match_matches_received(struct modem_chat *chat,
 	return true;
 }
 
+#if CONFIG_MODEM_CHAT_UNSOL_TRIE
+static uint16_t modem_chat_unsol_trie_find_child(struct modem_chat *chat, uint16_t node,
+						 uint8_t byte, bool wildcard)
+{
+	for (uint16_t i = chat->unsol_trie[node].child; i != 0; i = chat->unsol_trie[i].sibling) {
+		if ((chat->unsol_trie[i].byte == byte) &&
+		    (chat->unsol_trie[i].wildcard == wildcard)) {
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+static int modem_chat_unsol_trie_insert(struct modem_chat *chat, uint16_t index)
+{
+	const struct modem_chat_match *match = &chat->matches[MODEM_CHAT_MATCHES_INDEX_UNSOL][index];
+	uint16_t node = 0;
+	uint16_t child;
+	bool wildcard;
+
+	for (uint16_t i = 0; i < match->match_size; i++) {
+		wildcard = (match->wildcards == true) && (match->match[i] == '?');
+		child = modem_chat_unsol_trie_find_child(chat, node, match->match[i], wildcard);
+
+		if (child == 0) {
+			if (chat->unsol_trie_size == ARRAY_SIZE(chat->unsol_trie)) {
+				return -ENOMEM;
+			}
+
+			/* Prepend new node to children of node */
+			child = chat->unsol_trie_size++;
+			chat->unsol_trie[child].child = 0;
+			chat->unsol_trie[child].sibling = chat->unsol_trie[node].child;
+			chat->unsol_trie[child].match = 0;
+			chat->unsol_trie[child].byte = match->match[i];
+			chat->unsol_trie[child].wildcard = wildcard;
+			chat->unsol_trie[node].child = child;
+		}
+
+		node = child;
+	}
+
+	/* First of identical matches takes precedence */
+	if (chat->unsol_trie[node].match == 0) {
+		chat->unsol_trie[node].match = index + 1;
+	}
+
+	return 0;
+}
+
+static void modem_chat_unsol_trie_build(struct modem_chat *chat)
+{
+	/* Create root */
+	memset(&chat->unsol_trie[0], 0x00, sizeof(chat->unsol_trie[0]));
+	chat->unsol_trie_size = 1;
+
+	for (uint16_t i = 0; i < chat->matches_size[MODEM_CHAT_MATCHES_INDEX_UNSOL]; i++) {
+		if (modem_chat_unsol_trie_insert(chat, i) < 0) {
+			LOG_WRN("unsolicited matches exceed trie nodes, matching linearly");
+			chat->unsol_trie_size = 0;
+			return;
+		}
+	}
+}
+
+static void modem_chat_unsol_trie_advance(struct modem_chat *chat, uint8_t byte)
+{
+	uint16_t states[MODEM_CHAT_UNSOL_TRIE_STATES_MAX];
+	uint8_t states_len = 0;
+	uint16_t node;
+
+	for (uint8_t i = 0; i < chat->unsol_trie_states_len; i++) {
+		node = chat->unsol_trie[chat->unsol_trie_states[i]].child;
+
+		for (; node != 0; node = chat->unsol_trie[node].sibling) {
+			if ((chat->unsol_trie[node].wildcard == false) &&
+			    (chat->unsol_trie[node].byte != byte)) {
+				continue;
+			}
+
+			/* Too many wildcard paths to track, fall back to linear matching */
+			if (states_len == ARRAY_SIZE(states)) {
+				chat->unsol_trie_states_overrun = true;
+				return;
+			}
+
+			states[states_len++] = node;
+		}
+	}
+
+	memcpy(chat->unsol_trie_states, states, states_len * sizeof(states[0]));
+	chat->unsol_trie_states_len = states_len;
+}
+
+/*
+ * Returns index of first unsolicited match matching received data, -ENOENT if none matches
+ * or -ENOTSUP if the trie can't be used to find it.
+ */
+static int modem_chat_unsol_trie_find_match(struct modem_chat *chat)
+{
+	uint16_t match = 0;
+
+	if ((chat->unsol_trie_size == 0) || (chat->unsol_trie_states_overrun == true)) {
+		return -ENOTSUP;
+	}
+
+	/* Feed bytes received since last lookup */
+	while ((chat->unsol_trie_pos < chat->receive_buf_len) &&
+	       (chat->unsol_trie_states_len > 0)) {
+		modem_chat_unsol_trie_advance(chat, chat->receive_buf[chat->unsol_trie_pos]);
+		chat->unsol_trie_pos++;
+
+		if (chat->unsol_trie_states_overrun == true) {
+			return -ENOTSUP;
+		}
+	}
+
+	if ((chat->unsol_trie_pos < chat->receive_buf_len) ||
+	    (chat->unsol_trie_states_len == 0)) {
+		return -ENOENT;
+	}
+
+	for (uint8_t i = 0; i < chat->unsol_trie_states_len; i++) {
+		uint16_t node_match = chat->unsol_trie[chat->unsol_trie_states[i]].match;
+
+		if ((node_match != 0) && ((match == 0) || (node_match < match))) {
+			match = node_match;
+		}
+	}
+
+	return (match == 0) ? -ENOENT : (match - 1);
+}
+#endif
+
 static bool modem_chat_parse_find_match(struct modem_chat *chat)
 {
 	/* Find in all matches types */
 	for (uint16_t i = 0; i < ARRAY_SIZE(chat->matches); i++) {
+#if CONFIG_MODEM_CHAT_UNSOL_TRIE
+		if (i == MODEM_CHAT_MATCHES_INDEX_UNSOL) {
+			int ret = modem_chat_unsol_trie_find_match(chat);
+
+			if (ret >= 0) {
+				chat->parse_match = &chat->matches[i][ret];
+				chat->parse_match_type = i;
+				return true;
+			}
+
+			if (ret == -ENOENT) {
+				continue;
+			}
+		}
+#endif
+
 		/* Find in all matches of matches type */
 		for (uint16_t u = 0; u < chat->matches_size[i]; u++) {
 			/* Validate match size matches received data length */
@@ -818,6 +977,9 @@ int modem_chat_init(struct modem_chat *chat, const struct modem_chat_config *con
 	chat->filter_size = config->filter_size;
 	chat->matches[MODEM_CHAT_MATCHES_INDEX_UNSOL] = config->unsol_matches;
 	chat->matches_size[MODEM_CHAT_MATCHES_INDEX_UNSOL] = config->unsol_matches_size;
+#if CONFIG_MODEM_CHAT_UNSOL_TRIE
+	modem_chat_unsol_trie_build(chat);
+#endif
 	atomic_set(&chat->script_state, 0);
 	k_sem_init(&chat->script_stopped_sem, 0, 1);
 	k_work_init(&chat->receive_work, modem_chat_process_handler);
@@ -263,13 +263,17 @@ static void modem_cmux_bus_callback(struct modem_pipe *pipe, enum modem_pipe_eve
 	}
 }
 
-static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
-					  const struct modem_cmux_frame *frame)
+/* Wrap data scattered across iov in a single frame, frame->data_len is the total length */
+static uint16_t modem_cmux_transmit_frame_iov(struct modem_cmux *cmux,
+					      const struct modem_cmux_frame *frame,
+					      const struct modem_pipe_iov *iov, size_t iovcnt)
 {
 	uint8_t buf[MODEM_CMUX_FRAME_SIZE_MAX];
 	uint8_t fcs;
 	uint16_t space;
 	uint16_t data_len;
+	uint16_t remaining;
+	uint16_t size;
 	uint16_t buf_idx;
 
 	space = ring_buf_space_get(&cmux->transmit_rb) - MODEM_CMUX_FRAME_SIZE_MAX;
@@ -298,18 +302,24 @@ static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
 	/* Compute FCS for the header (exclude SOF) */
 	fcs = crc8_rohc(MODEM_CMUX_FCS_INIT_VALUE, &buf[1], (buf_idx - 1));
 
-	/* FCS final */
-	if (frame->type == MODEM_CMUX_FRAME_TYPE_UIH) {
-		fcs = 0xFF - fcs;
-	} else {
-		fcs = 0xFF - crc8_rohc(fcs, frame->data, data_len);
-	}
-
 	/* Frame header */
 	ring_buf_put(&cmux->transmit_rb, buf, buf_idx);
 
 	/* Data */
-	ring_buf_put(&cmux->transmit_rb, frame->data, data_len);
+	remaining = data_len;
+	for (size_t i = 0; (i < iovcnt) && (remaining > 0); i++) {
+		size = MIN(remaining, iov[i].size);
+
+		if (frame->type != MODEM_CMUX_FRAME_TYPE_UIH) {
+			fcs = crc8_rohc(fcs, iov[i].buf, size);
+		}
+
+		ring_buf_put(&cmux->transmit_rb, iov[i].buf, size);
+		remaining -= size;
+	}
+
+	/* FCS final */
+	fcs = 0xFF - fcs;
 
 	/* FCS and EOF will be put on the same call */
 	buf[0] = fcs;
@@ -319,6 +329,17 @@ static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
 	return data_len;
 }
 
+static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
+					  const struct modem_cmux_frame *frame)
+{
+	const struct modem_pipe_iov iov = {
+		.buf = frame->data,
+		.size = frame->data_len,
+	};
+
+	return modem_cmux_transmit_frame_iov(cmux, frame, &iov, 1);
+}
+
 static bool modem_cmux_transmit_cmd_frame(struct modem_cmux *cmux,
 					  const struct modem_cmux_frame *frame)
 {
@@ -344,7 +365,8 @@ static bool modem_cmux_transmit_cmd_frame(struct modem_cmux *cmux,
 }
 
 static int16_t modem_cmux_transmit_data_frame(struct modem_cmux *cmux,
-					      const struct modem_cmux_frame *frame)
+					      const struct modem_cmux_frame *frame,
+					      const struct modem_pipe_iov *iov, size_t iovcnt)
 {
 	uint16_t space;
 	int ret;
@@ -370,8 +392,8 @@ static int16_t modem_cmux_transmit_data_frame(struct modem_cmux *cmux,
 		return 0;
 	}
 
-	modem_cmux_log_transmit_frame(frame);
-	ret = modem_cmux_transmit_frame(cmux, frame);
+	modem_cmux_log_frame(frame, "tx", MIN(iov[0].size, frame->data_len));
+	ret = modem_cmux_transmit_frame_iov(cmux, frame, iov, iovcnt);
 	k_mutex_unlock(&cmux->transmit_rb_lock);
 	return ret;
 }
@@ -914,10 +936,16 @@ static void modem_cmux_receive_handler(struct k_work *item)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
 	struct modem_cmux *cmux = CONTAINER_OF(dwork, struct modem_cmux, receive_work);
+	uint8_t *buf;
 	int ret;
 
-	/* Receive data from pipe */
-	ret = modem_pipe_receive(cmux->pipe, cmux->work_buf, sizeof(cmux->work_buf));
+	/* Process data in place in the pipe's receive buffer if supported */
+	ret = modem_pipe_receive_claim(cmux->pipe, &buf, sizeof(cmux->work_buf));
+	if (ret == -ENOTSUP) {
+		buf = cmux->work_buf;
+		ret = modem_pipe_receive(cmux->pipe, cmux->work_buf, sizeof(cmux->work_buf));
+	}
+
 	if (ret < 1) {
 		if (ret < 0) {
 			LOG_ERR("Pipe receiving error: %d", ret);
@@ -927,7 +955,11 @@ static void modem_cmux_receive_handler(struct k_work *item)
 
 	/* Process received data */
 	for (int i = 0; i < ret; i++) {
-		modem_cmux_process_received_byte(cmux, cmux->work_buf[i]);
+		modem_cmux_process_received_byte(cmux, buf[i]);
+	}
+
+	if (buf != cmux->work_buf) {
+		modem_pipe_receive_finish(cmux->pipe, ret);
 	}
 
 	/* Reschedule received work */
@@ -949,6 +981,7 @@ static void modem_cmux_transmit_handler(struct k_work *item)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
 	struct modem_cmux *cmux = CONTAINER_OF(dwork, struct modem_cmux, transmit_work);
+	struct modem_pipe_iov iov[2];
 	uint8_t *reserved;
 	uint32_t reserved_size;
 	int ret;
@@ -967,9 +1000,14 @@ static void modem_cmux_transmit_handler(struct k_work *item)
 			break;
 		}
 
-		reserved_size = ring_buf_get_claim(&cmux->transmit_rb, &reserved, UINT32_MAX);
+		/* Claim up to the end of the ring buffer, then the wrapped part if any */
+		iov[0].size = ring_buf_get_claim(&cmux->transmit_rb, &reserved, UINT32_MAX);
+		iov[0].buf = reserved;
+		iov[1].size = ring_buf_get_claim(&cmux->transmit_rb, &reserved, UINT32_MAX);
+		iov[1].buf = reserved;
+		reserved_size = iov[0].size + iov[1].size;
 
-		ret = modem_pipe_transmit(cmux->pipe, reserved, reserved_size);
+		ret = modem_pipe_transmit_iov(cmux->pipe, iov, (iov[1].size > 0) ? 2 : 1);
 		if (ret < 0) {
 			ring_buf_get_finish(&cmux->transmit_rb, 0);
 			if (ret != -EPERM) {
@@ -1104,33 +1142,54 @@ static int modem_cmux_dlci_pipe_api_open(void *data)
 	return ret;
 }
 
-static int modem_cmux_dlci_pipe_api_transmit(void *data, const uint8_t *buf, size_t size)
+static int modem_cmux_dlci_pipe_api_transmit_iov(void *data, const struct modem_pipe_iov *iov,
+						 size_t iovcnt)
 {
 	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
 	struct modem_cmux *cmux = dlci->cmux;
+	size_t size = 0;
 	int ret = 0;
 
+	for (size_t i = 0; i < iovcnt; i++) {
+		size += iov[i].size;
+	}
+
+	if (size == 0) {
+		return 0;
+	}
+
 	K_SPINLOCK(&cmux->work_lock) {
 		if (!cmux->attached) {
 			ret = -EPERM;
 			K_SPINLOCK_BREAK;
 		}
 
+		/* All buffers are wrapped in as few frames as the MTU allows */
 		struct modem_cmux_frame frame = {
 			.dlci_address = dlci->dlci_address,
 			.cr = true,
 			.pf = false,
 			.type = MODEM_CMUX_FRAME_TYPE_UIH,
-			.data = buf,
-			.data_len = size,
+			.data = iov[0].buf,
+			.data_len = MIN(size, UINT16_MAX),
 		};
 
-		ret = modem_cmux_transmit_data_frame(cmux, &frame);
+		ret = modem_cmux_transmit_data_frame(cmux, &frame, iov, iovcnt);
 	}
 
 	return ret;
 }
 
+static int modem_cmux_dlci_pipe_api_transmit(void *data, const uint8_t *buf, size_t size)
+{
+	const struct modem_pipe_iov iov = {
+		.buf = buf,
+		.size = size,
+	};
+
+	return modem_cmux_dlci_pipe_api_transmit_iov(data, &iov, 1);
+}
+
 static int modem_cmux_dlci_pipe_api_receive(void *data, uint8_t *buf, size_t size)
 {
 	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
@@ -1147,6 +1206,33 @@ static int modem_cmux_dlci_pipe_api_receive(void *data, uint8_t *buf, size_t siz
 	return ret;
 }
 
+static int modem_cmux_dlci_pipe_api_receive_claim(void *data, uint8_t **buf, size_t size)
+{
+	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
+	uint32_t ret;
+
+	k_mutex_lock(&dlci->receive_rb_lock, K_FOREVER);
+
+#if CONFIG_MODEM_STATS
+	modem_cmux_dlci_advertise_receive_buf_stat(dlci);
+#endif
+
+	ret = ring_buf_get_claim(&dlci->receive_rb, buf, size);
+	k_mutex_unlock(&dlci->receive_rb_lock);
+	return ret;
+}
+
+static int modem_cmux_dlci_pipe_api_receive_finish(void *data, size_t size)
+{
+	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
+	int ret;
+
+	k_mutex_lock(&dlci->receive_rb_lock, K_FOREVER);
+	ret = ring_buf_get_finish(&dlci->receive_rb, size);
+	k_mutex_unlock(&dlci->receive_rb_lock);
+	return ret;
+}
+
 static int modem_cmux_dlci_pipe_api_close(void *data)
 {
 	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
@@ -1175,6 +1261,9 @@ static const struct modem_pipe_api modem_cmux_dlci_pipe_api = {
 	.transmit = modem_cmux_dlci_pipe_api_transmit,
 	.receive = modem_cmux_dlci_pipe_api_receive,
 	.close = modem_cmux_dlci_pipe_api_close,
+	.transmit_iov = modem_cmux_dlci_pipe_api_transmit_iov,
+	.receive_claim = modem_cmux_dlci_pipe_api_receive_claim,
+	.receive_finish = modem_cmux_dlci_pipe_api_receive_finish,
 };
 
 static void modem_cmux_dlci_open_handler(struct k_work *item)
@@ -72,6 +72,54 @@ static int pipe_call_receive(struct modem_pipe *pipe, uint8_t *buf, size_t size)
 	return pipe->api->receive(pipe->data, buf, size);
 }
 
+static int pipe_call_transmit_iov(struct modem_pipe *pipe, const struct modem_pipe_iov *iov,
+				  size_t iovcnt)
+{
+	int written = 0;
+	int ret;
+
+	if (pipe->api->transmit_iov != NULL) {
+		return pipe->api->transmit_iov(pipe->data, iov, iovcnt);
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		if (iov[i].size == 0) {
+			continue;
+		}
+
+		ret = pipe->api->transmit(pipe->data, iov[i].buf, iov[i].size);
+		if (ret < 0) {
+			return (written > 0) ? written : ret;
+		}
+
+		written += ret;
+
+		if ((size_t)ret < iov[i].size) {
+			break;
+		}
+	}
+
+	return written;
+}
+
+static int pipe_call_receive_claim(struct modem_pipe *pipe, uint8_t **buf, size_t size)
+{
+	if (pipe->api->receive_claim == NULL) {
+		return -ENOTSUP;
+	}
+
+	return pipe->api->receive_claim(pipe->data, buf, size);
+}
+
+static int pipe_call_receive_finish(struct modem_pipe *pipe, size_t size)
+{
+	if (pipe->api->receive_finish == NULL) {
+		return -ENOTSUP;
+	}
+
+	return pipe->api->receive_finish(pipe->data, size);
+}
+
 static int pipe_call_close(struct modem_pipe *pipe)
 {
 	return pipe->api->close(pipe->data);
@@ -153,6 +201,32 @@ int modem_pipe_receive(struct modem_pipe *pipe, uint8_t *buf, size_t size)
 	return pipe_call_receive(pipe, buf, size);
 }
 
+int modem_pipe_transmit_iov(struct modem_pipe *pipe, const struct modem_pipe_iov *iov,
+			    size_t iovcnt)
+{
+	if (!pipe_test_events(pipe, PIPE_EVENT_OPENED_BIT)) {
+		return -EPERM;
+	}
+
+	pipe_clear_events(pipe, PIPE_EVENT_TRANSMIT_IDLE_BIT);
+	return pipe_call_transmit_iov(pipe, iov, iovcnt);
+}
+
+int modem_pipe_receive_claim(struct modem_pipe *pipe, uint8_t **buf, size_t size)
+{
+	if (!pipe_test_events(pipe, PIPE_EVENT_OPENED_BIT)) {
+		return -EPERM;
+	}
+
+	pipe_clear_events(pipe, PIPE_EVENT_RECEIVE_READY_BIT);
+	return pipe_call_receive_claim(pipe, buf, size);
+}
+
+int modem_pipe_receive_finish(struct modem_pipe *pipe, size_t size)
+{
+	return pipe_call_receive_finish(pipe, size);
+}
+
 void modem_pipe_release(struct modem_pipe *pipe)
 {
 	pipe_set_callback(pipe, NULL, NULL);
@@ -6,6 +6,8 @@
 
 #include <zephyr/net/ppp.h>
 #include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
 #include <zephyr/modem/ppp.h>
 #include <string.h>
 
@@ -19,6 +21,104 @@ LOG_MODULE_REGISTER(modem_ppp, CONFIG_MODEM_MODULES_LOG_LEVEL);
 #define MODEM_PPP_CODE_ESCAPE		(0x7D)
 #define MODEM_PPP_VALUE_ESCAPE		(0x20)
 
+/* Bytes escaped on transmit, all control characters plus the delimiter and escape codes */
+static const uint32_t modem_ppp_escape_map[8] = {
+	0xFFFFFFFF, 0x00000000, 0x00000000, 0x60000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000,
+};
+
+static inline bool modem_ppp_byte_needs_escape(uint8_t byte)
+{
+	return (modem_ppp_escape_map[byte >> 5] & BIT(byte & 0x1F)) != 0;
+}
+
+/* Test four bytes at once for control characters, delimiter and escape codes */
+static inline bool modem_ppp_word_needs_escape(uint32_t word)
+{
+	uint32_t delimiter = word ^ 0x7E7E7E7EU;
+	uint32_t escape = word ^ 0x7D7D7D7DU;
+
+	return ((((word - 0x20202020U) & ~word) |
+		 ((delimiter - 0x01010101U) & ~delimiter) |
+		 ((escape - 0x01010101U) & ~escape)) & 0x80808080U) != 0;
+}
+
+/* Test four bytes at once for delimiter and escape codes */
+static inline bool modem_ppp_word_has_code(uint32_t word)
+{
+	uint32_t delimiter = word ^ 0x7E7E7E7EU;
+	uint32_t escape = word ^ 0x7D7D7D7DU;
+
+	return ((((delimiter - 0x01010101U) & ~delimiter) |
+		 ((escape - 0x01010101U) & ~escape)) & 0x80808080U) != 0;
+}
+
+/*
+ * Escape data into out, copying a word at a time as long as none of its bytes must be
+ * escaped. Returns number of bytes consumed from data, out_size is updated with the number
+ * of bytes written to out.
+ */
+static size_t modem_ppp_escape(const uint8_t *data, size_t size, uint8_t *out, size_t *out_size)
+{
+	size_t in_pos = 0;
+	size_t out_pos = 0;
+	uint32_t word;
+	uint8_t byte;
+
+	while (in_pos < size) {
+		if (((size - in_pos) >= sizeof(word)) && ((*out_size - out_pos) >= sizeof(word))) {
+			word = UNALIGNED_GET((const uint32_t *)&data[in_pos]);
+
+			if (!modem_ppp_word_needs_escape(word)) {
+				UNALIGNED_PUT(word, (uint32_t *)&out[out_pos]);
+				in_pos += sizeof(word);
+				out_pos += sizeof(word);
+				continue;
+			}
+		}
+
+		byte = data[in_pos];
+
+		if (modem_ppp_byte_needs_escape(byte)) {
+			if ((*out_size - out_pos) < 2) {
+				break;
+			}
+
+			out[out_pos++] = MODEM_PPP_CODE_ESCAPE;
+			out[out_pos++] = byte ^ MODEM_PPP_VALUE_ESCAPE;
+		} else {
+			if ((*out_size - out_pos) < 1) {
+				break;
+			}
+
+			out[out_pos++] = byte;
+		}
+
+		in_pos++;
+	}
+
+	*out_size = out_pos;
+	return in_pos;
+}
+
+/* Number of bytes at the start of data which are neither delimiter nor escape codes */
+static size_t modem_ppp_unescaped_len(const uint8_t *data, size_t size)
+{
+	size_t len = 0;
+
+	while (((size - len) >= sizeof(uint32_t)) &&
+	       !modem_ppp_word_has_code(UNALIGNED_GET((const uint32_t *)&data[len]))) {
+		len += sizeof(uint32_t);
+	}
+
+	while ((len < size) && (data[len] != MODEM_PPP_CODE_DELIMITER) &&
+	       (data[len] != MODEM_PPP_CODE_ESCAPE)) {
+		len++;
+	}
+
+	return len;
+}
+
 static uint16_t modem_ppp_fcs_init(uint8_t byte)
 {
 	return crc16_ccitt(0xFFFF, &byte, 1);
@@ -88,8 +188,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		byte = (ppp->tx_pkt_protocol >> 8) & 0xFF;
 		ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, byte);
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_byte_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_PROTOCOL_HIGH;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -106,8 +205,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		byte = ppp->tx_pkt_protocol & 0xFF;
 		ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, byte);
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_byte_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_PROTOCOL_LOW;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -125,8 +223,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		(void)net_pkt_read_u8(ppp->tx_pkt, &byte);
 		ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, byte);
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_byte_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_DATA;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -152,8 +249,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		ppp->tx_pkt_fcs = modem_ppp_fcs_final(ppp->tx_pkt_fcs);
 		byte = ppp->tx_pkt_fcs & 0xFF;
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_byte_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_FCS_LOW;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -169,8 +265,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 	case MODEM_PPP_TRANSMIT_STATE_FCS_HIGH:
 		byte = (ppp->tx_pkt_fcs >> 8) & 0xFF;
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_byte_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_FCS_HIGH;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -192,6 +287,50 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 	return 0;
 }
 
+/*
+ * Escape as much of the packet data as fits in the transmit ring buffer in one go. Returns
+ * false if nothing could be done, in which case the byte-wise path must be used.
+ */
+static bool modem_ppp_wrap_net_pkt_data(struct modem_ppp *ppp)
+{
+	struct net_pkt_cursor *cursor = &ppp->tx_pkt->cursor;
+	const uint8_t *data;
+	uint8_t *reserved;
+	size_t reserved_size;
+	size_t consumed;
+	size_t size;
+
+	if (cursor->buf == NULL) {
+		return false;
+	}
+
+	/* Unread data left in fragment at cursor */
+	data = cursor->pos;
+	size = cursor->buf->len - (cursor->pos - cursor->buf->data);
+	if (size == 0) {
+		return false;
+	}
+
+	reserved_size = ring_buf_put_claim(&ppp->transmit_rb, &reserved, UINT32_MAX);
+	consumed = modem_ppp_escape(data, size, reserved, &reserved_size);
+	ring_buf_put_finish(&ppp->transmit_rb, reserved_size);
+
+	if (consumed == 0) {
+		return false;
+	}
+
+	ppp->tx_pkt_fcs = crc16_ccitt(ppp->tx_pkt_fcs, data, consumed);
+
+	/* Move cursor past consumed data */
+	(void)net_pkt_read(ppp->tx_pkt, NULL, consumed);
+
+	if (net_pkt_remaining_data(ppp->tx_pkt) == 0) {
+		ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_FCS_LOW;
+	}
+
+	return true;
+}
+
 static bool modem_ppp_is_byte_expected(uint8_t byte, uint8_t expected_byte)
 {
 	if (byte == expected_byte) {
@@ -313,6 +452,72 @@ static void modem_ppp_process_received_byte(struct modem_ppp *ppp, uint8_t byte)
 	}
 }
 
+static void modem_ppp_drop_rx_pkt(struct modem_ppp *ppp)
+{
+	net_pkt_unref(ppp->rx_pkt);
+	ppp->rx_pkt = NULL;
+	ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
+}
+
+/* Write a run of bytes which contains no delimiter or escape codes to network packet */
+static void modem_ppp_process_received_data(struct modem_ppp *ppp, const uint8_t *data,
+					    size_t size)
+{
+	size_t available;
+	size_t len;
+
+	while (size > 0) {
+		available = net_pkt_available_buffer(ppp->rx_pkt);
+
+		if (available <= 1) {
+			if (net_pkt_alloc_buffer(ppp->rx_pkt, CONFIG_MODEM_PPP_NET_BUF_FRAG_SIZE,
+						 AF_INET, K_NO_WAIT) < 0) {
+				LOG_WRN("Failed to alloc buffer");
+				modem_ppp_drop_rx_pkt(ppp);
+				return;
+			}
+
+			continue;
+		}
+
+		/* Like the byte-wise path, keep at least one byte of buffer available */
+		len = MIN(size, available - 1);
+
+		if (net_pkt_write(ppp->rx_pkt, data, len) < 0) {
+			LOG_WRN("Dropped PPP frame");
+			modem_ppp_drop_rx_pkt(ppp);
+#if defined(CONFIG_NET_STATISTICS_PPP)
+			ppp->stats.drop++;
+#endif
+			return;
+		}
+
+		data += len;
+		size -= len;
+	}
+}
+
+static void modem_ppp_process_received(struct modem_ppp *ppp, const uint8_t *buf, size_t size)
+{
+	size_t pos = 0;
+	size_t len;
+
+	while (pos < size) {
+		if (ppp->receive_state == MODEM_PPP_RECEIVE_STATE_WRITING) {
+			len = modem_ppp_unescaped_len(&buf[pos], size - pos);
+
+			if (len > 0) {
+				modem_ppp_process_received_data(ppp, &buf[pos], len);
+				pos += len;
+				continue;
+			}
+		}
+
+		modem_ppp_process_received_byte(ppp, buf[pos]);
+		pos++;
+	}
+}
+
 #if CONFIG_MODEM_STATS
 static uint32_t get_transmit_buf_length(struct modem_ppp *ppp)
 {
@@ -356,6 +561,7 @@ static void modem_ppp_pipe_callback(struct modem_pipe *pipe, enum modem_pipe_eve
 static void modem_ppp_send_handler(struct k_work *item)
 {
 	struct modem_ppp *ppp = CONTAINER_OF(item, struct modem_ppp, send_work);
+	struct modem_pipe_iov iov[2];
 	uint8_t byte;
 	uint8_t *reserved;
 	uint32_t reserved_size;
@@ -373,6 +579,11 @@ static void modem_ppp_send_handler(struct k_work *item)
 
 		/* Fill transmit ring buffer */
 		while (ring_buf_space_get(&ppp->transmit_rb) > 0) {
+			if ((ppp->transmit_state == MODEM_PPP_TRANSMIT_STATE_DATA) &&
+			    modem_ppp_wrap_net_pkt_data(ppp)) {
+				continue;
+			}
+
 			byte = modem_ppp_wrap_net_pkt_byte(ppp);
 
 			ring_buf_put(&ppp->transmit_rb, &byte, 1);
@@ -390,9 +601,14 @@ static void modem_ppp_send_handler(struct k_work *item)
 #endif
 
 	while (!ring_buf_is_empty(&ppp->transmit_rb)) {
-		reserved_size = ring_buf_get_claim(&ppp->transmit_rb, &reserved, UINT32_MAX);
-
-		ret = modem_pipe_transmit(ppp->pipe, reserved, reserved_size);
+		/* Claim up to the end of the ring buffer, then the wrapped part if any */
+		iov[0].size = ring_buf_get_claim(&ppp->transmit_rb, &reserved, UINT32_MAX);
+		iov[0].buf = reserved;
+		iov[1].size = ring_buf_get_claim(&ppp->transmit_rb, &reserved, UINT32_MAX);
+		iov[1].buf = reserved;
+		reserved_size = iov[0].size + iov[1].size;
+
+		ret = modem_pipe_transmit_iov(ppp->pipe, iov, (iov[1].size > 0) ? 2 : 1);
 		if (ret < 0) {
 			ring_buf_get_finish(&ppp->transmit_rb, 0);
 			break;
@@ -409,9 +625,16 @@ static void modem_ppp_send_handler(struct k_work *item)
 static void modem_ppp_process_handler(struct k_work *item)
 {
 	struct modem_ppp *ppp = CONTAINER_OF(item, struct modem_ppp, process_work);
+	uint8_t *buf;
 	int ret;
 
-	ret = modem_pipe_receive(ppp->pipe, ppp->receive_buf, ppp->buf_size);
+	/* Process data in place in the pipe's receive buffer if supported */
+	ret = modem_pipe_receive_claim(ppp->pipe, &buf, ppp->buf_size);
+	if (ret == -ENOTSUP) {
+		buf = ppp->receive_buf;
+		ret = modem_pipe_receive(ppp->pipe, ppp->receive_buf, ppp->buf_size);
+	}
+
 	if (ret < 1) {
 		return;
 	}
@@ -420,8 +643,10 @@ static void modem_ppp_process_handler(struct k_work *item)
 	advertise_receive_buf_stats(ppp, ret);
 #endif
 
-	for (int i = 0; i < ret; i++) {
-		modem_ppp_process_received_byte(ppp, ppp->receive_buf[i]);
+	modem_ppp_process_received(ppp, buf, ret);
+
+	if (buf != ppp->receive_buf) {
+		modem_pipe_receive_finish(ppp->pipe, ret);
 	}
 
 	k_work_submit(&ppp->process_work);
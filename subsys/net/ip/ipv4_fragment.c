@@ -15,6 +15,8 @@ LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/net_mgmt.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/slist.h>
 #include "net_private.h"
 #include "connection.h"
 #include "icmpv4.h"
@@ -32,42 +34,77 @@ static void reassembly_timeout(struct k_work *work);
 
 static struct net_ipv4_reassembly reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
 
+/* Active reassemblies are hashed by (id, src, dst, protocol) so that finding the
+ * reassembly of an incoming fragment does not need to walk through all the slots.
+ */
+static sys_slist_t reassembly_hash[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+
+static sys_slist_t *reassembly_bucket(uint16_t id, const struct in_addr *src,
+				      const struct in_addr *dst, uint8_t protocol)
+{
+	uint32_t hash;
+
+	hash = UNALIGNED_GET(&src->s_addr) ^ (UNALIGNED_GET(&dst->s_addr) * 31U) ^
+	       ((uint32_t)protocol << 16) ^ id;
+	hash *= 2654435761U;
+
+	return &reassembly_hash[(hash >> 16) % ARRAY_SIZE(reassembly_hash)];
+}
+
+static void reassembly_unlink(struct net_ipv4_reassembly *reass)
+{
+	(void)sys_slist_find_and_remove(reassembly_bucket(reass->id, &reass->src, &reass->dst,
+							  reass->protocol),
+					&reass->node);
+}
+
 static struct net_ipv4_reassembly *reassembly_get(uint16_t id, struct in_addr *src,
 						  struct in_addr *dst, uint8_t protocol)
 {
-	int i, avail = -1;
-
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
-		    reassembly[i].id == id &&
-		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
-		    net_ipv4_addr_cmp(dst, &reassembly[i].dst) &&
-		    reassembly[i].protocol == protocol) {
-			return &reassembly[i];
-		}
+	sys_slist_t *bucket = reassembly_bucket(id, src, dst, protocol);
+	struct net_ipv4_reassembly *reass;
+	int i;
 
-		if (k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, reass, node) {
+		if (k_work_delayable_remaining_get(&reass->timer) &&
+		    reass->id == id &&
+		    net_ipv4_addr_cmp(src, &reass->src) &&
+		    net_ipv4_addr_cmp(dst, &reass->dst) &&
+		    reass->protocol == protocol) {
+			return reass;
 		}
+	}
 
-		if (avail < 0) {
-			avail = i;
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
+			break;
 		}
 	}
 
-	if (avail < 0) {
+	if (i == CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT) {
 		return NULL;
 	}
 
-	k_work_reschedule(&reassembly[avail].timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
+	reass = &reassembly[i];
+
+	/* An expired slot might still be linked if its timeout handler has not run yet */
+	reassembly_unlink(reass);
+
+	k_work_reschedule(&reass->timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
 
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
+	net_ipaddr_copy(&reass->src, src);
+	net_ipaddr_copy(&reass->dst, dst);
 
-	reassembly[avail].protocol = protocol;
-	reassembly[avail].id = id;
+	reass->protocol = protocol;
+	reass->id = id;
+	reass->received_len = 0U;
+	reass->total_len = 0U;
+	reass->pkt_count = 0U;
+	reass->last_received = false;
 
-	return &reassembly[avail];
+	sys_slist_prepend(bucket, &reass->node);
+
+	return reass;
 }
 
 static bool reassembly_cancel(uint32_t id, struct in_addr *src, struct in_addr *dst)
@@ -91,7 +128,13 @@ static bool reassembly_cancel(uint32_t id, struct in_addr *src, struct in_addr *
 
 		LOG_DBG("IPv4 reassembly id 0x%x remaining %d ms", reassembly[i].id, remaining);
 
+		reassembly_unlink(&reassembly[i]);
+
 		reassembly[i].id = 0U;
+		reassembly[i].pkt_count = 0U;
+		reassembly[i].received_len = 0U;
+		reassembly[i].total_len = 0U;
+		reassembly[i].last_received = false;
 
 		for (j = 0; j < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; j++) {
 			if (!reassembly[i].pkt[j]) {
@@ -149,6 +192,9 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 
 	NET_ASSERT(reass->pkt[0]);
 
+	reassembly_unlink(reass);
+	reass->pkt_count = 0U;
+
 	last = net_buf_frag_last(reass->pkt[0]->buffer);
 
 	/* We start from 2nd packet which is then appended to the first one */
@@ -235,98 +281,116 @@ void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
 	}
 }
 
-/* Verify that we have all the fragments received and in correct order.
- * Return:
- * - a negative value if the fragments are erroneous and must be dropped
- * - zero if we are expecting more fragments
- * - a positive value if we can proceed with the reassembly
+static inline int fragment_payload_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+}
+
+/* Find the position of the first stored fragment whose offset is not smaller
+ * than the given offset.
  */
-static int fragments_are_ready(struct net_ipv4_reassembly *reass)
+static int fragment_position(struct net_ipv4_reassembly *reass, unsigned int offset)
 {
-	unsigned int expected_offset = 0;
-	bool more = true;
-	int i;
+	int low = 0;
+	int high = reass->pkt_count;
 
-	/* Fragments can arrive in any order, for example in reverse order:
-	 *   1 -> Fragment3(M=0, offset=x2)
-	 *   2 -> Fragment2(M=1, offset=x1)
-	 *   3 -> Fragment1(M=1, offset=0)
-	 * We have to test several requirements before proceeding with the reassembly:
-	 * - We received the first fragment (Fragment Offset is 0)
-	 * - All intermediate fragments are contiguous
-	 * - The More bit of the last fragment is 0
-	 */
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		struct net_pkt *pkt = reass->pkt[i];
-		unsigned int offset;
-		int payload_len;
+	while (low < high) {
+		int mid = (low + high) / 2;
 
-		if (!pkt) {
-			break;
+		if (net_pkt_ipv4_fragment_offset(reass->pkt[mid]) < offset) {
+			low = mid + 1;
+		} else {
+			high = mid;
 		}
+	}
 
-		offset = net_pkt_ipv4_fragment_offset(pkt);
+	return low;
+}
 
-		if (offset < expected_offset) {
-			/* Overlapping or duplicated, drop it */
+/* Store the fragment so that the fragments stay sorted by offset.
+ * Return:
+ * - -EBADMSG if the fragment overlaps with the received data or lies outside
+ *   of the datagram, the whole reassembly must be dropped
+ * - -ENOMEM if there is no room for the fragment
+ * - zero if the fragment was stored
+ */
+static int fragment_insert(struct net_ipv4_reassembly *reass, struct net_pkt *pkt)
+{
+	unsigned int offset = net_pkt_ipv4_fragment_offset(pkt);
+	int payload_len = fragment_payload_len(pkt);
+	unsigned int end;
+	int pos;
+
+	if (payload_len < 0) {
+		return -EBADMSG;
+	}
+
+	end = offset + payload_len;
+	pos = fragment_position(reass, offset);
+
+	/* Overlapping or duplicated fragments */
+	if (pos > 0) {
+		struct net_pkt *prev = reass->pkt[pos - 1];
+
+		if (net_pkt_ipv4_fragment_offset(prev) + fragment_payload_len(prev) > offset) {
 			return -EBADMSG;
-		} else if (offset != expected_offset) {
-			/* Not contiguous, let's wait for fragments */
-			return 0;
 		}
+	}
 
-		payload_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+	if (pos < reass->pkt_count) {
+		unsigned int next = net_pkt_ipv4_fragment_offset(reass->pkt[pos]);
 
-		if (payload_len < 0) {
+		if (next < end || next == offset) {
 			return -EBADMSG;
 		}
-
-		expected_offset += payload_len;
-		more = net_pkt_ipv4_fragment_more(pkt);
 	}
 
-	if (more) {
-		return 0;
+	if (net_pkt_ipv4_fragment_more(pkt)) {
+		if (reass->last_received && end > reass->total_len) {
+			return -EBADMSG;
+		}
+	} else if (reass->last_received || pos < reass->pkt_count) {
+		/* Either a second last fragment or data beyond the end of the datagram */
+		return -EBADMSG;
 	}
 
-	return 1;
-}
-
-static int shift_packets(struct net_ipv4_reassembly *reass, int pos)
-{
-	int i;
+	if (reass->pkt_count == CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
+		return -ENOMEM;
+	}
 
-	for (i = pos + 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			LOG_DBG("Moving [%d] %p (offset 0x%x) to [%d]", pos, reass->pkt[pos],
-				net_pkt_ipv4_fragment_offset(reass->pkt[pos]), pos + 1);
+	memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
+		sizeof(void *) * (reass->pkt_count - pos));
 
-			/* pkt[i] is free, so shift everything between [pos] and [i - 1] by one
-			 * element
-			 */
-			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
+	LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, pos, offset);
 
-			/* pkt[pos] is now free */
-			reass->pkt[pos] = NULL;
+	reass->pkt[pos] = pkt;
+	reass->pkt_count++;
+	reass->received_len += payload_len;
 
-			return 0;
-		}
+	if (!net_pkt_ipv4_fragment_more(pkt)) {
+		reass->last_received = true;
+		reass->total_len = end;
 	}
 
-	/* We do not have free space left in the array */
-	return -ENOMEM;
+	return 0;
+}
+
+/* Fragments can arrive in any order. As overlapping fragments and fragments
+ * beyond the end of the datagram are refused when stored, all the data is
+ * received once the stored payload adds up to the length of the datagram.
+ */
+static bool fragments_are_ready(struct net_ipv4_reassembly *reass)
+{
+	return reass->last_received && reass->received_len == reass->total_len;
 }
 
 enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ipv4_hdr *hdr)
 {
 	struct net_ipv4_reassembly *reass = NULL;
 	uint16_t flag;
-	bool found;
 	uint8_t more;
 	uint16_t id;
 	int ret;
-	int i;
 
 	flag = ntohs(*((uint16_t *)&hdr->offset));
 	id = ntohs(*((uint16_t *)&hdr->id));
@@ -353,50 +417,21 @@ enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ip
 	/* The fragments might come in wrong order so place them in the reassembly chain in the
 	 * correct order.
 	 */
-	for (i = 0, found = false; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv4_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room then it will discard
-			 * the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
-		}
-
-		LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, i,
-			net_pkt_ipv4_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
-	}
-
-	if (!found) {
+	ret = fragment_insert(reass, pkt);
+	if (ret == -ENOMEM) {
 		/* We could not add this fragment into our saved fragment list. The whole packet
 		 * must be discarded at this point.
 		 */
 		LOG_ERR("No slots available for 0x%x", reass->id);
 		net_pkt_unref(pkt);
 		goto drop;
-	}
-
-	ret = fragments_are_ready(reass);
-	if (ret < 0) {
+	} else if (ret < 0) {
 		LOG_ERR("Reassembled IPv4 verify failed, dropping id %u", reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
 		net_pkt_unref(pkt);
 		goto drop;
-	} else if (ret == 0) {
+	}
+
+	if (!fragments_are_ready(reass)) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		LOG_DBG("More fragments to be received");
@@ -429,9 +464,15 @@ static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fi
 	struct net_pkt_cursor cur;
 	struct net_pkt_cursor cur_pkt;
 	uint16_t offset_pkt;
+	bool share;
+
+	/* With variable sized data buffers the payload is shared with the original
+	 * packet instead of being copied, so only the header needs a buffer.
+	 */
+	share = IS_ENABLED(CONFIG_NET_BUF_VARIABLE_DATA_SIZE);
 
-	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), fit_len +
-					     net_pkt_ip_hdr_len(pkt),
+	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					     (share ? 0 : fit_len) + net_pkt_ip_hdr_len(pkt),
 					     AF_INET, 0, NET_BUF_TIMEOUT);
 	if (!frag_pkt) {
 		return -ENOMEM;
@@ -450,9 +491,27 @@ static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fi
 
 	net_pkt_cursor_restore(pkt, &cur_pkt);
 
+	if (net_pkt_skip(pkt, (frag_offset + net_pkt_ip_hdr_len(pkt)))) {
+		goto fail;
+	}
+
+	if (share) {
+		ret = net_pkt_share_data(frag_pkt, pkt, fit_len, NET_BUF_TIMEOUT);
+		if (ret == -ENOTSUP) {
+			/* External data cannot be shared, copy it instead */
+			share = false;
+
+			ret = net_pkt_alloc_buffer_raw(frag_pkt, fit_len, NET_BUF_TIMEOUT);
+		}
+
+		if (ret < 0) {
+			goto fail;
+		}
+	}
+
 	/* Copy the payload part of this fragment from the original packet */
-	if (net_pkt_skip(pkt, (frag_offset + net_pkt_ip_hdr_len(pkt))) ||
-	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+	if (!share && net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		ret = -ENOBUFS;
 		goto fail;
 	}
 
@@ -430,15 +430,30 @@ struct net_ipv6_reassembly {
 	/** IPv6 destination address of the fragment */
 	struct in6_addr dst;
 
+	/** Node in the reassembly lookup hash bucket */
+	sys_snode_t node;
+
 	/**
 	 * Timeout for cancelling the reassembly. The timer is used
 	 * also to detect if this reassembly slot is used or not.
 	 */
 	struct k_work_delayable timer;
 
-	/** Pointers to pending fragments */
+	/** Pointers to pending fragments, sorted by fragment offset */
 	struct net_pkt *pkt[CONFIG_NET_IPV6_FRAGMENT_MAX_PKT];
 
+	/** Number of payload bytes received so far */
+	uint32_t received_len;
+
+	/** Total payload length, valid once the last fragment is received */
+	uint32_t total_len;
+
+	/** Number of fragments stored in pkt */
+	uint16_t pkt_count;
+
+	/** The fragment with the More Fragments flag cleared is received */
+	bool last_received;
+
 	/** IPv6 fragment identification */
 	uint32_t id;
 };
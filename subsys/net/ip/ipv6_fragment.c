@@ -18,6 +18,8 @@ LOG_MODULE_DECLARE(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/net_mgmt.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/slist.h>
 #include "net_private.h"
 #include "connection.h"
 #include "icmpv6.h"
@@ -46,6 +48,12 @@ static bool reassembly_init_done;
 static struct net_ipv6_reassembly
 reassembly[CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT];
 
+/* Active reassemblies are hashed by (id, src, dst) so that finding the
+ * reassembly of an incoming fragment does not need to walk through all
+ * the slots.
+ */
+static sys_slist_t reassembly_hash[CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT];
+
 int net_ipv6_find_last_ext_hdr(struct net_pkt *pkt, uint16_t *next_hdr_off,
 			       uint16_t *last_hdr_off)
 {
@@ -120,41 +128,78 @@ fail:
 	return -EINVAL;
 }
 
+static sys_slist_t *reassembly_bucket(uint32_t id,
+				      const struct in6_addr *src,
+				      const struct in6_addr *dst)
+{
+	uint32_t hash = id;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(src->s6_addr32); i++) {
+		hash ^= UNALIGNED_GET(&src->s6_addr32[i]) ^
+			(UNALIGNED_GET(&dst->s6_addr32[i]) * 31U);
+		hash *= 2654435761U;
+	}
+
+	return &reassembly_hash[(hash >> 16) % ARRAY_SIZE(reassembly_hash)];
+}
+
+static void reassembly_unlink(struct net_ipv6_reassembly *reass)
+{
+	(void)sys_slist_find_and_remove(reassembly_bucket(reass->id,
+							  &reass->src,
+							  &reass->dst),
+					&reass->node);
+}
+
 static struct net_ipv6_reassembly *reassembly_get(uint32_t id,
 						  struct in6_addr *src,
 						  struct in6_addr *dst)
 {
-	int i, avail = -1;
-
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
-		    reassembly[i].id == id &&
-		    net_ipv6_addr_cmp(src, &reassembly[i].src) &&
-		    net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
-			return &reassembly[i];
-		}
+	sys_slist_t *bucket = reassembly_bucket(id, src, dst);
+	struct net_ipv6_reassembly *reass;
+	int i;
 
-		if (k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, reass, node) {
+		if (k_work_delayable_remaining_get(&reass->timer) &&
+		    reass->id == id &&
+		    net_ipv6_addr_cmp(src, &reass->src) &&
+		    net_ipv6_addr_cmp(dst, &reass->dst)) {
+			return reass;
 		}
+	}
 
-		if (avail < 0) {
-			avail = i;
+	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
+		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
+			break;
 		}
 	}
 
-	if (avail < 0) {
+	if (i == CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT) {
 		return NULL;
 	}
 
-	k_work_reschedule(&reassembly[avail].timer, IPV6_REASSEMBLY_TIMEOUT);
+	reass = &reassembly[i];
+
+	/* An expired slot might still be linked if its timeout handler
+	 * has not run yet.
+	 */
+	reassembly_unlink(reass);
+
+	k_work_reschedule(&reass->timer, IPV6_REASSEMBLY_TIMEOUT);
 
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
+	net_ipaddr_copy(&reass->src, src);
+	net_ipaddr_copy(&reass->dst, dst);
 
-	reassembly[avail].id = id;
+	reass->id = id;
+	reass->received_len = 0U;
+	reass->total_len = 0U;
+	reass->pkt_count = 0U;
+	reass->last_received = false;
 
-	return &reassembly[avail];
+	sys_slist_prepend(bucket, &reass->node);
+
+	return reass;
 }
 
 static bool reassembly_cancel(uint32_t id,
@@ -181,7 +226,13 @@ static bool reassembly_cancel(uint32_t id,
 		NET_DBG("IPv6 reassembly id 0x%x remaining %d ms",
 			reassembly[i].id, remaining);
 
+		reassembly_unlink(&reassembly[i]);
+
 		reassembly[i].id = 0U;
+		reassembly[i].pkt_count = 0U;
+		reassembly[i].received_len = 0U;
+		reassembly[i].total_len = 0U;
+		reassembly[i].last_received = false;
 
 		for (j = 0; j < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; j++) {
 			if (!reassembly[i].pkt[j]) {
@@ -245,6 +296,9 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 
 	NET_ASSERT(reass->pkt[0]);
 
+	reassembly_unlink(reass);
+	reass->pkt_count = 0U;
+
 	last = net_buf_frag_last(reass->pkt[0]->buffer);
 
 	/* We start from 2nd packet which is then appended to
@@ -370,91 +424,116 @@ void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
 	}
 }
 
-/* Verify that we have all the fragments received and in correct order.
- * Return:
- * - a negative value if the fragments are erroneous and must be dropped
- * - zero if we are expecting more fragments
- * - a positive value if we can proceed with the reassembly
+static inline int fragment_payload_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ipv6_fragment_start(pkt) -
+		sizeof(struct net_ipv6_frag_hdr);
+}
+
+/* Find the position of the first stored fragment whose offset is not
+ * smaller than the given offset.
  */
-static int fragments_are_ready(struct net_ipv6_reassembly *reass)
+static int fragment_position(struct net_ipv6_reassembly *reass,
+			     unsigned int offset)
 {
-	unsigned int expected_offset = 0;
-	bool more = true;
-	int i;
+	int low = 0;
+	int high = reass->pkt_count;
 
-	/* Fragments can arrive in any order, for example in reverse order:
-	 *   1 -> Fragment3(M=0, offset=x2)
-	 *   2 -> Fragment2(M=1, offset=x1)
-	 *   3 -> Fragment1(M=1, offset=0)
-	 * We have to test several requirements before proceeding with the reassembly:
-	 * - We received the first fragment (Fragment Offset is 0)
-	 * - All intermediate fragments are contiguous
-	 * - The More bit of the last fragment is 0
-	 */
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		struct net_pkt *pkt = reass->pkt[i];
-		unsigned int offset;
-		int payload_len;
+	while (low < high) {
+		int mid = (low + high) / 2;
 
-		if (!pkt) {
-			break;
+		if (net_pkt_ipv6_fragment_offset(reass->pkt[mid]) < offset) {
+			low = mid + 1;
+		} else {
+			high = mid;
 		}
+	}
 
-		offset = net_pkt_ipv6_fragment_offset(pkt);
+	return low;
+}
+
+/* Store the fragment so that the fragments stay sorted by offset.
+ * Return:
+ * - -EBADMSG if the fragment overlaps with the received data or lies
+ *   outside of the datagram, the whole reassembly must be dropped
+ *   (RFC 8200 ch. 4.5)
+ * - -ENOMEM if there is no room for the fragment
+ * - zero if the fragment was stored
+ */
+static int fragment_insert(struct net_ipv6_reassembly *reass,
+			   struct net_pkt *pkt)
+{
+	unsigned int offset = net_pkt_ipv6_fragment_offset(pkt);
+	int payload_len = fragment_payload_len(pkt);
+	unsigned int end;
+	int pos;
 
-		if (offset < expected_offset) {
-			/* Overlapping or duplicated
-			 * According to RFC8200 we can drop it
-			 */
+	if (payload_len < 0) {
+		return -EBADMSG;
+	}
+
+	end = offset + payload_len;
+	pos = fragment_position(reass, offset);
+
+	/* Overlapping or duplicated fragments */
+	if (pos > 0) {
+		struct net_pkt *prev = reass->pkt[pos - 1];
+
+		if (net_pkt_ipv6_fragment_offset(prev) +
+		    fragment_payload_len(prev) > offset) {
 			return -EBADMSG;
-		} else if (offset != expected_offset) {
-			/* Not contiguous, let's wait for fragments */
-			return 0;
 		}
+	}
+
+	if (pos < reass->pkt_count) {
+		unsigned int next =
+			net_pkt_ipv6_fragment_offset(reass->pkt[pos]);
 
-		payload_len = net_pkt_get_len(pkt) - net_pkt_ipv6_fragment_start(pkt);
-		payload_len -= sizeof(struct net_ipv6_frag_hdr);
-		if (payload_len < 0) {
+		if (next < end || next == offset) {
 			return -EBADMSG;
 		}
-
-		expected_offset += payload_len;
-		more = net_pkt_ipv6_fragment_more(pkt);
 	}
 
-	if (more) {
-		return 0;
+	if (net_pkt_ipv6_fragment_more(pkt)) {
+		if (reass->last_received && end > reass->total_len) {
+			return -EBADMSG;
+		}
+	} else if (reass->last_received || pos < reass->pkt_count) {
+		/* Either a second last fragment or data beyond the end
+		 * of the datagram.
+		 */
+		return -EBADMSG;
 	}
 
-	return 1;
-}
-
-static int shift_packets(struct net_ipv6_reassembly *reass, int pos)
-{
-	int i;
+	if (reass->pkt_count == CONFIG_NET_IPV6_FRAGMENT_MAX_PKT) {
+		return -ENOMEM;
+	}
 
-	for (i = pos + 1; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			NET_DBG("Moving [%d] %p (offset 0x%x) to [%d]",
-				pos, reass->pkt[pos],
-				net_pkt_ipv6_fragment_offset(reass->pkt[pos]),
-				pos + 1);
+	memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
+		sizeof(void *) * (reass->pkt_count - pos));
 
-			/* pkt[i] is free, so shift everything between
-			 * [pos] and [i - 1] by one element
-			 */
-			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
+	NET_DBG("Storing pkt %p to slot %d offset %d", pkt, pos, offset);
 
-			/* pkt[pos] is now free */
-			reass->pkt[pos] = NULL;
+	reass->pkt[pos] = pkt;
+	reass->pkt_count++;
+	reass->received_len += payload_len;
 
-			return 0;
-		}
+	if (!net_pkt_ipv6_fragment_more(pkt)) {
+		reass->last_received = true;
+		reass->total_len = end;
 	}
 
-	/* We do not have free space left in the array */
-	return -ENOMEM;
+	return 0;
+}
+
+/* Fragments can arrive in any order. As overlapping fragments and fragments
+ * beyond the end of the datagram are refused when stored, all the data is
+ * received once the stored payload adds up to the length of the datagram.
+ */
+static bool fragments_are_ready(struct net_ipv6_reassembly *reass)
+{
+	return reass->last_received &&
+		reass->received_len == reass->total_len;
 }
 
 enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
@@ -463,7 +542,6 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 {
 	struct net_ipv6_reassembly *reass = NULL;
 	uint16_t flag;
-	bool found;
 	uint8_t more;
 	uint32_t id;
 	int ret;
@@ -515,51 +593,22 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 	/* The fragments might come in wrong order so place them
 	 * in reassembly chain in correct order.
 	 */
-	for (i = 0, found = false; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv6_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv6_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room,
-			 * then it will discard the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
-		}
-
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, i, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
-	}
-
-	if (!found) {
+	ret = fragment_insert(reass, pkt);
+	if (ret == -ENOMEM) {
 		/* We could not add this fragment into our saved fragment
 		 * list. We must discard the whole packet at this point.
 		 */
 		NET_DBG("No slots available for 0x%x", reass->id);
 		net_pkt_unref(pkt);
 		goto drop;
-	}
-
-	ret = fragments_are_ready(reass);
-	if (ret < 0) {
+	} else if (ret < 0) {
 		NET_DBG("Reassembled IPv6 verify failed, dropping id %u",
 			reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
 		net_pkt_unref(pkt);
 		goto drop;
-	} else if (ret == 0) {
+	}
+
+	if (!fragments_are_ready(reass)) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		NET_DBG("More fragments to be received");
@@ -598,8 +647,16 @@ static int send_ipv6_fragment(struct net_pkt *pkt,
 	int ret = -ENOBUFS;
 	struct net_ipv6_frag_hdr *frag_hdr;
 	struct net_pkt *frag_pkt;
+	bool share;
+
+	/* With variable sized data buffers the payload is shared with the
+	 * original packet instead of being copied, so only the headers
+	 * need a buffer.
+	 */
+	share = IS_ENABLED(CONFIG_NET_BUF_VARIABLE_DATA_SIZE);
 
-	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), fit_len +
+	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					     (share ? 0 : fit_len) +
 					     net_pkt_ipv6_ext_len(pkt) +
 					     NET_IPV6_FRAGH_LEN,
 					     AF_INET6, 0, BUF_ALLOC_TIMEOUT);
@@ -649,11 +706,31 @@ static int send_ipv6_fragment(struct net_pkt *pkt,
 				 net_pkt_ipv6_ext_len(pkt) +
 				 sizeof(struct net_ipv6_frag_hdr));
 
+	if (net_pkt_skip(pkt, frag_offset)) {
+		goto fail;
+	}
+
+	if (share) {
+		ret = net_pkt_share_data(frag_pkt, pkt, fit_len,
+					 BUF_ALLOC_TIMEOUT);
+		if (ret == -ENOTSUP) {
+			/* External data cannot be shared, copy it instead */
+			share = false;
+
+			ret = net_pkt_alloc_buffer_raw(frag_pkt, fit_len,
+						       BUF_ALLOC_TIMEOUT);
+		}
+
+		if (ret < 0) {
+			goto fail;
+		}
+	}
+
 	/* Finally we copy the payload part of this fragment from
 	 * the original packet
 	 */
-	if (net_pkt_skip(pkt, frag_offset) ||
-	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+	if (!share && net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		ret = -ENOBUFS;
 		goto fail;
 	}
 
@@ -135,6 +135,65 @@ static inline struct net_nbr *get_nbr(int idx)
 	return &net_neighbor_pool[idx].nbr;
 }
 
+/* Incremented whenever a neighbor leaves the table, so that neighbors
+ * cached by the net_context users can be validated.
+ */
+static uint32_t nbr_table_gen = 1U;
+
+static inline int nbr_index(struct net_nbr *nbr)
+{
+	return ((uint8_t *)nbr - (uint8_t *)net_neighbor_pool) /
+		sizeof(net_neighbor_pool[0]);
+}
+
+#if defined(CONFIG_NET_IPV6_NBR_HASH)
+#define NBR_HASH_SIZE CONFIG_NET_IPV6_MAX_NEIGHBORS
+
+/* Chains of neighbors, by the hash of their IPv6 address. The values
+ * are neighbor indexes + 1 so that 0 terminates a chain.
+ */
+static uint8_t nbr_hash_head[NBR_HASH_SIZE];
+static uint8_t nbr_hash_next[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+
+static inline uint8_t *nbr_hash_bucket(const struct in6_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[0]) ^
+			UNALIGNED_GET(&addr->s6_addr32[1]) ^
+			UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	return &nbr_hash_head[((hash * 0x9e3779b1U) >> 16) % NBR_HASH_SIZE];
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	uint8_t *head = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	int idx = nbr_index(nbr);
+
+	nbr_hash_next[idx] = *head;
+	*head = idx + 1;
+}
+
+static void nbr_hash_del(struct net_nbr *nbr)
+{
+	uint8_t *link = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	int idx = nbr_index(nbr);
+
+	while (*link != 0U) {
+		if (*link == idx + 1) {
+			*link = nbr_hash_next[idx];
+			nbr_hash_next[idx] = 0U;
+			return;
+		}
+
+		link = &nbr_hash_next[*link - 1];
+	}
+}
+#else
+#define nbr_hash_add(nbr)
+#define nbr_hash_del(nbr)
+#endif /* CONFIG_NET_IPV6_NBR_HASH */
+
 static void ipv6_nbr_set_state(struct net_nbr *nbr,
 			       enum net_ipv6_nbr_state new_state)
 {
@@ -256,6 +315,25 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
+#if defined(CONFIG_NET_IPV6_NBR_HASH)
+	uint8_t next = *nbr_hash_bucket(addr);
+
+	ARG_UNUSED(table);
+
+	while (next != 0U) {
+		struct net_nbr *nbr = get_nbr(next - 1);
+
+		next = nbr_hash_next[next - 1];
+
+		if (iface && nbr->iface != iface) {
+			continue;
+		}
+
+		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
+			return nbr;
+		}
+	}
+#else
 	int i;
 
 	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
@@ -273,10 +351,51 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 			return nbr;
 		}
 	}
+#endif /* CONFIG_NET_IPV6_NBR_HASH */
 
 	return NULL;
 }
 
+#if defined(CONFIG_NET_CONTEXT_NBR_CACHE)
+/* Try first the neighbor used for the previous packet of the same
+ * net_context, it is valid only if no neighbor has been removed since.
+ */
+static struct net_nbr *nbr_lookup_cached(struct net_context *ctx,
+					 struct net_if *iface,
+					 const struct in6_addr *addr)
+{
+	struct net_nbr *nbr;
+
+	if (ctx == NULL) {
+		return nbr_lookup(&net_neighbor.table, iface, addr);
+	}
+
+	nbr = ctx->nbr_cache;
+
+	/* The context may also have cached an ARP entry, e.g. for IPv4
+	 * mapped addresses, so make sure this is one of our neighbors.
+	 */
+	if (ctx->nbr_cache_gen == nbr_table_gen &&
+	    (uint8_t *)nbr >= (uint8_t *)net_neighbor_pool &&
+	    (uint8_t *)nbr < (uint8_t *)net_neighbor_pool + sizeof(net_neighbor_pool) &&
+	    (iface == NULL || nbr->iface == iface) &&
+	    net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
+		return nbr;
+	}
+
+	nbr = nbr_lookup(&net_neighbor.table, iface, addr);
+	if (nbr != NULL) {
+		ctx->nbr_cache = nbr;
+		ctx->nbr_cache_gen = nbr_table_gen;
+	}
+
+	return nbr;
+}
+#else
+#define nbr_lookup_cached(ctx, iface, addr) \
+	nbr_lookup(&net_neighbor.table, iface, addr)
+#endif /* CONFIG_NET_CONTEXT_NBR_CACHE */
+
 static inline void nbr_clear_ns_pending(struct net_ipv6_nbr_data *data)
 {
 	data->send_ns = 0;
@@ -434,6 +553,7 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 	}
 
 	nbr_init(nbr, iface, addr, is_router, state);
+	nbr_hash_add(nbr);
 
 	NET_DBG("nbr %p iface %p/%d state %d IPv6 %s",
 		nbr, iface, net_if_get_by_iface(iface), state,
@@ -656,7 +776,10 @@ void net_neighbor_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	net_ipv6_nbr_lock();
+	nbr_hash_del(nbr);
+	nbr_table_gen++;
+	net_ipv6_nbr_unlock();
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -794,9 +917,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. TCP GSO
+	 * super-segments are split into MTU sized packets by L2.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && net_pkt_gso_size(pkt) == 0U) {
 		size_t pkt_len = net_pkt_get_len(pkt);
 		uint16_t mtu;
 
@@ -931,7 +1055,7 @@ try_send:
 
 	net_ipv6_nbr_lock();
 
-	nbr = nbr_lookup(&net_neighbor.table, iface, nexthop);
+	nbr = nbr_lookup_cached(net_pkt_context(pkt), iface, nexthop);
 
 	NET_DBG("Neighbor lookup %p (%d) iface %p/%d addr %s state %s", nbr,
 		nbr ? nbr->idx : NET_NBR_LLADDR_UNKNOWN,
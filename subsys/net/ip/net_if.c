@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include <zephyr/linker/sections.h>
 #include <zephyr/random/random.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/barrier.h>
 #include <stdlib.h>
 #include <string.h>
 #include <zephyr/net/igmp.h>
@@ -101,6 +102,231 @@ static struct {
 } ipv4_addresses[CONFIG_NET_IF_MAX_IPV4_COUNT];
 #endif /* CONFIG_NET_NATIVE_IPV4 */
 
+#if defined(CONFIG_NET_IF_ADDR_INDEX)
+/* Open addressing hash table of all the unicast addresses in use. It is
+ * sized for twice the number of unicast address slots in the system, so it
+ * can never fill up. Writers serialize on the spinlock and keep the sequence
+ * counter odd while they modify the table, readers probe it without taking
+ * any lock and retry if the counter changed under them.
+ */
+#if defined(CONFIG_NET_IPV6)
+#define ADDR_INDEX_IPV6_SLOTS (CONFIG_NET_IF_MAX_IPV6_COUNT * NET_IF_MAX_IPV6_ADDR)
+#else
+#define ADDR_INDEX_IPV6_SLOTS 0
+#endif
+
+#if defined(CONFIG_NET_IPV4)
+#define ADDR_INDEX_IPV4_SLOTS (CONFIG_NET_IF_MAX_IPV4_COUNT * NET_IF_MAX_IPV4_ADDR)
+#else
+#define ADDR_INDEX_IPV4_SLOTS 0
+#endif
+
+#define ADDR_INDEX_SIZE (2 * (ADDR_INDEX_IPV6_SLOTS + ADDR_INDEX_IPV4_SLOTS) + 1)
+
+static struct addr_index_entry {
+	/** Copy of the address, so that lookups never touch the interface */
+	struct net_addr key;
+	/** Interface address, NULL if the slot is free */
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+} addr_index[ADDR_INDEX_SIZE];
+
+static struct k_spinlock addr_index_lock;
+static atomic_t addr_index_seq;
+
+static uint32_t addr_index_hash(sa_family_t family, const void *addr)
+{
+	uint32_t hash;
+
+	if (family == AF_INET6) {
+		const struct in6_addr *addr6 = addr;
+
+		hash = UNALIGNED_GET(&addr6->s6_addr32[0]) ^
+		       UNALIGNED_GET(&addr6->s6_addr32[1]) ^
+		       UNALIGNED_GET(&addr6->s6_addr32[2]) ^
+		       UNALIGNED_GET(&addr6->s6_addr32[3]);
+	} else {
+		hash = UNALIGNED_GET(&((const struct in_addr *)addr)->s_addr);
+	}
+
+	/* Multiplicative hashing, the high bits are the best mixed ones */
+	return ((hash * 0x9e3779b1U) >> 16) % ADDR_INDEX_SIZE;
+}
+
+static inline size_t addr_index_len(sa_family_t family)
+{
+	return family == AF_INET6 ? sizeof(struct in6_addr) :
+				    sizeof(struct in_addr);
+}
+
+static void addr_index_add(struct net_if *iface, struct net_if_addr *ifaddr)
+{
+	sa_family_t family = ifaddr->address.family;
+	uint32_t idx = addr_index_hash(family, &ifaddr->address.in6_addr);
+	k_spinlock_key_t key = k_spin_lock(&addr_index_lock);
+
+	atomic_inc(&addr_index_seq);
+
+	for (int i = 0; i < ADDR_INDEX_SIZE; i++) {
+		struct addr_index_entry *entry = &addr_index[idx];
+
+		if (entry->ifaddr == NULL || entry->ifaddr == ifaddr) {
+			entry->key.family = family;
+			memcpy(&entry->key.in6_addr, &ifaddr->address.in6_addr,
+			       addr_index_len(family));
+			entry->iface = iface;
+			entry->ifaddr = ifaddr;
+			break;
+		}
+
+		idx = (idx + 1) % ADDR_INDEX_SIZE;
+	}
+
+	atomic_inc(&addr_index_seq);
+
+	k_spin_unlock(&addr_index_lock, key);
+}
+
+static void addr_index_del(struct net_if_addr *ifaddr)
+{
+	uint32_t hole = addr_index_hash(ifaddr->address.family,
+					&ifaddr->address.in6_addr);
+	k_spinlock_key_t key = k_spin_lock(&addr_index_lock);
+	uint32_t idx;
+
+	for (int i = 0; i < ADDR_INDEX_SIZE; i++) {
+		if (addr_index[hole].ifaddr == NULL) {
+			goto out;
+		}
+
+		if (addr_index[hole].ifaddr == ifaddr) {
+			break;
+		}
+
+		hole = (hole + 1) % ADDR_INDEX_SIZE;
+	}
+
+	if (addr_index[hole].ifaddr != ifaddr) {
+		goto out;
+	}
+
+	atomic_inc(&addr_index_seq);
+
+	/* Backward shift deletion: move up every following entry of the
+	 * cluster whose home slot is not between the hole and itself, so
+	 * that no tombstones are needed.
+	 */
+	idx = (hole + 1) % ADDR_INDEX_SIZE;
+
+	while (addr_index[idx].ifaddr != NULL) {
+		struct addr_index_entry *entry = &addr_index[idx];
+		uint32_t home = addr_index_hash(entry->key.family,
+						&entry->key.in6_addr);
+
+		if ((idx + ADDR_INDEX_SIZE - home) % ADDR_INDEX_SIZE >=
+		    (idx + ADDR_INDEX_SIZE - hole) % ADDR_INDEX_SIZE) {
+			addr_index[hole] = *entry;
+			hole = idx;
+		}
+
+		idx = (idx + 1) % ADDR_INDEX_SIZE;
+	}
+
+	addr_index[hole].ifaddr = NULL;
+	addr_index[hole].iface = NULL;
+
+	atomic_inc(&addr_index_seq);
+
+out:
+	k_spin_unlock(&addr_index_lock, key);
+}
+
+static struct net_if_addr *addr_index_lookup(sa_family_t family,
+					     const void *addr,
+					     struct net_if **ret)
+{
+	uint32_t start = addr_index_hash(family, addr);
+	size_t len = addr_index_len(family);
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+	atomic_val_t seq;
+
+	do {
+		uint32_t idx = start;
+
+		ifaddr = NULL;
+		iface = NULL;
+
+		seq = atomic_get(&addr_index_seq);
+		if (seq & 1) {
+			/* Writer in progress on another CPU */
+			continue;
+		}
+
+		for (int i = 0; i < ADDR_INDEX_SIZE; i++) {
+			struct addr_index_entry *entry = &addr_index[idx];
+
+			if (entry->ifaddr == NULL) {
+				break;
+			}
+
+			if (entry->key.family == family &&
+			    memcmp(&entry->key.in6_addr, addr, len) == 0) {
+				ifaddr = entry->ifaddr;
+				iface = entry->iface;
+				break;
+			}
+
+			idx = (idx + 1) % ADDR_INDEX_SIZE;
+		}
+
+		barrier_dmem_fence_full();
+	} while ((seq & 1) || atomic_get(&addr_index_seq) != seq);
+
+	if (ifaddr != NULL && ret != NULL) {
+		*ret = iface;
+	}
+
+	return ifaddr;
+}
+#else
+#define addr_index_add(...)
+#define addr_index_del(...)
+#define addr_index_lookup(...) NULL
+#endif /* CONFIG_NET_IF_ADDR_INDEX */
+
+#if defined(CONFIG_NET_IF_IPV6_SRC_ADDR_CACHE)
+/* Bumped on every change that can affect IPv6 source address selection,
+ * which invalidates all the cached selections at once.
+ */
+static atomic_t ipv6_src_cache_gen;
+static struct k_spinlock ipv6_src_cache_lock;
+/* Cache for the selections done without an interface hint */
+static struct net_if_ipv6_src_cache ipv6_src_cache_any;
+
+static inline void ipv6_src_cache_flush(void)
+{
+	atomic_inc(&ipv6_src_cache_gen);
+}
+
+/* Address state can also be changed outside of this file (for example
+ * the privacy extensions deprecate temporary addresses), so a cached
+ * address is checked to still be usable before it is returned. Only
+ * preferred addresses are served from the cache. A deprecated address
+ * loses against any preferred one (RFC 6724 rule 3), so the selection is
+ * done again in that case.
+ */
+static inline bool ipv6_src_cache_addr_usable(const struct in6_addr *src)
+{
+	const struct net_if_addr *ifaddr =
+		CONTAINER_OF(src, struct net_if_addr, address.in6_addr);
+
+	return ifaddr->is_used && ifaddr->addr_state == NET_ADDR_PREFERRED;
+}
+#else
+#define ipv6_src_cache_flush(...)
+#endif /* CONFIG_NET_IF_IPV6_SRC_ADDR_CACHE */
+
 /* We keep track of the link callbacks in this list.
  */
 static sys_slist_t link_callbacks;
@@ -397,6 +623,9 @@ void net_if_stats_reset(struct net_if *iface)
 		if (iface == tmp) {
 			net_if_lock(iface);
 			memset(&iface->stats, 0, sizeof(iface->stats));
+			IF_ENABLED(CONFIG_NET_STATISTICS_PER_CPU,
+				   (memset(iface->stats_per_cpu, 0,
+					   sizeof(iface->stats_per_cpu));))
 			net_if_unlock(iface);
 			return;
 		}
@@ -412,6 +641,9 @@ void net_if_stats_reset_all(void)
 	STRUCT_SECTION_FOREACH(net_if, iface) {
 		net_if_lock(iface);
 		memset(&iface->stats, 0, sizeof(iface->stats));
+		IF_ENABLED(CONFIG_NET_STATISTICS_PER_CPU,
+			   (memset(iface->stats_per_cpu, 0,
+				   sizeof(iface->stats_per_cpu));))
 		net_if_unlock(iface);
 	}
 #endif
@@ -606,6 +838,7 @@ struct net_if *net_if_lookup_by_dev(const struct device *dev)
 void net_if_set_default(struct net_if *iface)
 {
 	default_iface = iface;
+	ipv6_src_cache_flush();
 }
 
 struct net_if *net_if_get_default(void)
@@ -1119,6 +1352,15 @@ int net_if_config_ipv6_put(struct net_if *iface)
 			continue;
 		}
 
+#if defined(CONFIG_NET_IF_ADDR_INDEX)
+		ARRAY_FOR_EACH(ipv6_addresses[i].ipv6.unicast, j) {
+			if (ipv6_addresses[i].ipv6.unicast[j].is_used) {
+				addr_index_del(&ipv6_addresses[i].ipv6.unicast[j]);
+			}
+		}
+#endif
+		ipv6_src_cache_flush();
+
 		iface->config.ip.ipv6 = NULL;
 		ipv6_addresses[i].iface = NULL;
 
@@ -1275,6 +1517,7 @@ static void dad_timeout(struct k_work *work)
 
 		ifaddr->addr_state = NET_ADDR_PREFERRED;
 		iface = net_if_get_by_index(ifaddr->ifindex);
+		ipv6_src_cache_flush();
 
 		net_mgmt_event_notify_with_info(NET_EVENT_IPV6_DAD_SUCCEED,
 						iface,
@@ -1292,6 +1535,7 @@ void net_if_ipv6_start_dad(struct net_if *iface,
 			   struct net_if_addr *ifaddr)
 {
 	ifaddr->addr_state = NET_ADDR_TENTATIVE;
+	ipv6_src_cache_flush();
 
 	if (net_if_is_up(iface)) {
 		NET_DBG("Interface %p ll addr %s tentative IPv6 addr %s",
@@ -1446,6 +1690,8 @@ void net_if_ipv6_dad_failed(struct net_if *iface, const struct in6_addr *addr)
 		}
 	}
 
+	ipv6_src_cache_flush();
+
 	net_mgmt_event_notify_with_info(NET_EVENT_IPV6_DAD_FAILED, iface,
 					&ifaddr->address.in6_addr,
 					sizeof(struct in6_addr));
@@ -1829,6 +2075,10 @@ struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 {
 	struct net_if_addr *ifaddr = NULL;
 
+	if (IS_ENABLED(CONFIG_NET_IF_ADDR_INDEX)) {
+		return addr_index_lookup(AF_INET6, addr, ret);
+	}
+
 	STRUCT_SECTION_FOREACH(net_if, iface) {
 		struct net_if_ipv6 *ipv6;
 
@@ -1938,6 +2188,7 @@ void net_if_ipv6_addr_update_lifetime(struct net_if_addr *ifaddr,
 		vlifetime);
 
 	ifaddr->addr_state = NET_ADDR_PREFERRED;
+	ipv6_src_cache_flush();
 
 	address_start_timer(ifaddr, vlifetime);
 
@@ -2050,6 +2301,9 @@ struct net_if_addr *net_if_ipv6_addr_add(struct net_if *iface,
 			ipv6->unicast[i].addr_state = NET_ADDR_PREFERRED;
 		}
 
+		addr_index_add(iface, &ipv6->unicast[i]);
+		ipv6_src_cache_flush();
+
 		net_mgmt_event_notify_with_info(
 			NET_EVENT_IPV6_ADDR_ADD, iface,
 			&ipv6->unicast[i].address.in6_addr,
@@ -2563,6 +2817,7 @@ static void prefix_lifetime_expired(struct net_if_ipv6_prefix *ifprefix)
 		ifprefix->len);
 
 	ifprefix->is_used = false;
+	ipv6_src_cache_flush();
 
 	if (net_if_config_ipv6_get(ifprefix->iface, &ipv6) < 0) {
 		return;
@@ -2746,6 +3001,8 @@ struct net_if_ipv6_prefix *net_if_ipv6_prefix_add(struct net_if *iface,
 		NET_DBG("[%zu] interface %p prefix %s/%d added", i, iface,
 			net_sprint_ipv6_addr(prefix), len);
 
+		ipv6_src_cache_flush();
+
 		if (IS_ENABLED(CONFIG_NET_MGMT_EVENT_INFO)) {
 			struct net_event_ipv6_prefix info;
 
@@ -2796,6 +3053,7 @@ bool net_if_ipv6_prefix_rm(struct net_if *iface, struct in6_addr *addr,
 		net_if_ipv6_prefix_unset_timer(&ipv6->prefix[i]);
 
 		ipv6->prefix[i].is_used = false;
+		ipv6_src_cache_flush();
 
 		/* Remove also all auto addresses if the they have the same
 		 * prefix.
@@ -3279,9 +3537,9 @@ out:
 	return src;
 }
 
-const struct in6_addr *net_if_ipv6_select_src_addr_hint(struct net_if *dst_iface,
-							const struct in6_addr *dst,
-							int flags)
+static const struct in6_addr *ipv6_select_src_addr(struct net_if *dst_iface,
+						   const struct in6_addr *dst,
+						   int flags)
 {
 	const struct in6_addr *src = NULL;
 	uint8_t best_match = 0U;
@@ -3350,6 +3608,71 @@ out:
 	return src;
 }
 
+const struct in6_addr *net_if_ipv6_select_src_addr_hint(struct net_if *dst_iface,
+							const struct in6_addr *dst,
+							int flags)
+{
+#if defined(CONFIG_NET_IF_IPV6_SRC_ADDR_CACHE)
+	struct net_if_ipv6_src_cache *cache = NULL;
+	const struct in6_addr *src;
+	k_spinlock_key_t key;
+	uint32_t gen;
+
+	if (dst == NULL) {
+		return NULL;
+	}
+
+	if (dst_iface == NULL) {
+		cache = &ipv6_src_cache_any;
+	} else if (dst_iface->config.ip.ipv6 != NULL) {
+		cache = &dst_iface->config.ip.ipv6->src_cache;
+	}
+
+	if (cache == NULL) {
+		return ipv6_select_src_addr(dst_iface, dst, flags);
+	}
+
+	/* Read the generation before selecting, so that a change done
+	 * while the selection runs invalidates the stored result.
+	 */
+	gen = (uint32_t)atomic_get(&ipv6_src_cache_gen);
+
+	key = k_spin_lock(&ipv6_src_cache_lock);
+
+	if (cache->src != NULL && cache->gen == gen && cache->flags == flags &&
+	    net_ipv6_addr_cmp(&cache->dst, dst) &&
+	    ipv6_src_cache_addr_usable(cache->src)) {
+		src = cache->src;
+		k_spin_unlock(&ipv6_src_cache_lock, key);
+
+		return src;
+	}
+
+	k_spin_unlock(&ipv6_src_cache_lock, key);
+
+	src = ipv6_select_src_addr(dst_iface, dst, flags);
+	if (src == NULL || src == net_ipv6_unspecified_address()) {
+		/* Do not cache failures, an address can become usable
+		 * without the generation being bumped.
+		 */
+		return src;
+	}
+
+	key = k_spin_lock(&ipv6_src_cache_lock);
+
+	net_ipaddr_copy(&cache->dst, dst);
+	cache->src = src;
+	cache->gen = gen;
+	cache->flags = flags;
+
+	k_spin_unlock(&ipv6_src_cache_lock, key);
+
+	return src;
+#else
+	return ipv6_select_src_addr(dst_iface, dst, flags);
+#endif /* CONFIG_NET_IF_IPV6_SRC_ADDR_CACHE */
+}
+
 const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
 						   const struct in6_addr *dst)
 {
@@ -3587,6 +3910,14 @@ int net_if_config_ipv4_put(struct net_if *iface)
 			continue;
 		}
 
+#if defined(CONFIG_NET_IF_ADDR_INDEX)
+		ARRAY_FOR_EACH(ipv4_addresses[i].ipv4.unicast, j) {
+			if (ipv4_addresses[i].ipv4.unicast[j].ipv4.is_used) {
+				addr_index_del(&ipv4_addresses[i].ipv4.unicast[j].ipv4);
+			}
+		}
+#endif
+
 		iface->config.ip.ipv4 = NULL;
 		ipv4_addresses[i].iface = NULL;
 
@@ -3974,6 +4305,10 @@ struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
 {
 	struct net_if_addr *ifaddr = NULL;
 
+	if (IS_ENABLED(CONFIG_NET_IF_ADDR_INDEX)) {
+		return addr_index_lookup(AF_INET, addr, ret);
+	}
+
 	STRUCT_SECTION_FOREACH(net_if, iface) {
 		struct net_if_ipv4 *ipv4;
 
@@ -4542,6 +4877,11 @@ struct net_if_addr *net_if_ipv4_addr_add(struct net_if *iface,
 	}
 
 	if (ifaddr) {
+		if (ifaddr->is_used) {
+			/* Overridable address replaced by a DHCP one */
+			addr_index_del(ifaddr);
+		}
+
 		ifaddr->is_used = true;
 		ifaddr->is_added = true;
 		ifaddr->address.family = AF_INET;
@@ -4578,6 +4918,8 @@ struct net_if_addr *net_if_ipv4_addr_add(struct net_if *iface,
 
 		cur->netmask.s_addr = htonl(default_netmask);
 
+		addr_index_add(iface, ifaddr);
+
 		net_mgmt_event_notify_with_info(NET_EVENT_IPV4_ADDR_ADD, iface,
 						&ifaddr->address.in_addr,
 						sizeof(struct in_addr));
@@ -5357,6 +5699,8 @@ static void remove_ipv6_ifaddr(struct net_if *iface,
 		net_if_ipv6_maddr_rm(iface, &maddr);
 	}
 
+	ipv6_src_cache_flush();
+
 	/* Using the IPv6 address pointer here can give false
 	 * info if someone adds a new IP address into this position
 	 * in the address array. This is quite unlikely thou.
@@ -5524,6 +5868,7 @@ int net_if_addr_unref(struct net_if *iface,
 	}
 
 	ifaddr->is_used = false;
+	addr_index_del(ifaddr);
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6 && addr != NULL) {
 		remove_ipv6_ifaddr(iface, ifaddr, maddr_count);
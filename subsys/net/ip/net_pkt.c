@@ -698,7 +698,7 @@ void net_pkt_frag_unref(struct net_buf *frag)
 		net_pkt_alloc_del(frag, caller, line);
 	}
 
-	net_buf_unref(frag);
+	net_buf_unref_chain(frag);
 }
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -941,26 +941,20 @@ static struct net_buf *pkt_alloc_buffer(struct net_pkt *pkt,
 	ARG_UNUSED(pkt);
 #endif
 
-	k_timepoint_t end = sys_timepoint_calc(timeout);
-	struct net_buf *first = NULL;
-	struct net_buf *current = NULL;
-
-	do {
-		struct net_buf *new;
-
-		new = net_buf_alloc_fixed(pool, timeout);
-		if (!new) {
-			goto error;
-		}
+	size_t frag_size = pool->alloc->max_alloc_size;
+	struct net_buf *first;
+	struct net_buf *current;
+	size_t count;
 
-		if (!first && !current) {
-			first = new;
-		} else {
-			current->frags = new;
-		}
+	/* Take all the fragments from the pool at once */
+	count = MAX(DIV_ROUND_UP(size + headroom, frag_size), 1);
 
-		current = new;
+	first = net_buf_alloc_bulk(pool, frag_size, count, timeout);
+	if (!first) {
+		goto error;
+	}
 
+	for (current = first; current; current = current->frags) {
 		/* If there is headroom reserved, then allocate that to the
 		 * first buf.
 		 */
@@ -980,18 +974,18 @@ static struct net_buf *pkt_alloc_buffer(struct net_pkt *pkt,
 			size -= current->size;
 		}
 
-		timeout = sys_timepoint_timeout(end);
-
 #if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
-		NET_FRAG_CHECK_IF_NOT_IN_USE(new, new->ref + 1);
+		NET_FRAG_CHECK_IF_NOT_IN_USE(current, current->ref + 1);
 
-		net_pkt_alloc_add(new, false, caller, line);
+		net_pkt_alloc_add(current, false, caller, line);
 
 		NET_DBG("%s (%s) [%d] frag %p ref %d (%s():%d)",
 			pool2str(pool), get_name(pool), get_frees(pool),
-			new, new->ref, caller, line);
+			current, current->ref, caller, line);
 #endif
-	} while (size);
+	}
+
+	NET_ASSERT(size == 0U);
 
 #if defined(CONFIG_NET_PKT_ALLOC_STATS)
 	if (NET_PKT_ALLOC_STATS_UPDATE(pkt, total_size, start_time) == 0) {
@@ -1001,10 +995,6 @@ static struct net_buf *pkt_alloc_buffer(struct net_pkt *pkt,
 
 	return first;
 error:
-	if (first) {
-		net_buf_unref(first);
-	}
-
 #if defined(CONFIG_NET_PKT_ALLOC_STATS)
 	if (NET_PKT_ALLOC_STATS_FAIL(pkt, total_size, start_time) == 0) {
 		NET_DBG("pkt %p %s stats rollover", pkt, "fail");
@@ -1194,6 +1184,8 @@ size_t net_pkt_available_payload_buffer(struct net_pkt *pkt,
 void net_pkt_trim_buffer(struct net_pkt *pkt)
 {
 	struct net_buf *buf, *prev;
+	struct net_buf *empty = NULL;
+	struct net_buf *empty_last = NULL;
 
 	buf = pkt->buffer;
 	prev = buf;
@@ -1209,13 +1201,29 @@ void net_pkt_trim_buffer(struct net_pkt *pkt)
 			}
 
 			buf->frags = NULL;
-			net_buf_unref(buf);
+
+			/* Collect the empty buffers that are freed here and
+			 * release them at once.
+			 */
+			if (buf->ref > 1U) {
+				net_buf_unref(buf);
+			} else if (empty_last) {
+				empty_last->frags = buf;
+				empty_last = buf;
+			} else {
+				empty = buf;
+				empty_last = buf;
+			}
 		} else {
 			prev = buf;
 		}
 
 		buf = next;
 	}
+
+	if (empty) {
+		net_buf_unref_chain(empty);
+	}
 }
 
 int net_pkt_remove_tail(struct net_pkt *pkt, size_t length)
@@ -1760,6 +1768,48 @@ void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer)
 	}
 }
 
+void net_pkt_page_pool_recycle(struct k_mem_slab *pages, struct net_buf *buf)
+{
+	/* The page is external data of the buffer so net_buf_destroy()
+	 * leaves it alone.
+	 */
+	k_mem_slab_free(pages, buf->__buf);
+	net_buf_destroy(buf);
+}
+
+struct net_pkt *net_pkt_rx_alloc_on_page(struct net_pkt_page_pool *pool,
+					 struct net_if *iface,
+					 uint8_t *page, size_t len,
+					 k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+
+	if (len > pool->page_size) {
+		return NULL;
+	}
+
+	pkt = net_pkt_rx_alloc_on_iface(iface, timeout);
+	if (!pkt) {
+		return NULL;
+	}
+
+	buf = net_buf_alloc_with_data(pool->bufs, page, len,
+				      sys_timepoint_timeout(end));
+	if (!buf) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	/* Allow the stack to write in place up to the end of the page */
+	buf->size = pool->page_size;
+
+	net_pkt_append_buffer(pkt, buf);
+
+	return pkt;
+}
+
 void net_pkt_cursor_init(struct net_pkt *pkt)
 {
 	pkt->cursor.buf = pkt->buffer;
@@ -1828,6 +1878,44 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
+/* Fast path for operations that end before the end of the current buffer,
+ * which covers all header accesses of single buffer packets. The cursor
+ * never has to move to another fragment so it can be bumped directly.
+ */
+static inline bool pkt_cursor_operate_in_buf(struct net_pkt *pkt,
+					     void *data, size_t length,
+					     bool copy, bool write)
+{
+	struct net_pkt_cursor *c_op = &pkt->cursor;
+	bool append = write && !net_pkt_is_being_overwritten(pkt);
+	size_t offset;
+
+	if (c_op->buf == NULL) {
+		return false;
+	}
+
+	offset = c_op->pos - c_op->buf->data;
+	if (offset + length >= (append ? net_buf_max_len(c_op->buf) :
+					 c_op->buf->len)) {
+		return false;
+	}
+
+	if (copy && data) {
+		memcpy(write ? c_op->pos : data, write ? data : c_op->pos,
+		       length);
+	} else if (data) {
+		memset(c_op->pos, *(int *)data, length);
+	}
+
+	if (append) {
+		net_buf_add(c_op->buf, length);
+	}
+
+	c_op->pos += length;
+
+	return true;
+}
+
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
@@ -1836,6 +1924,10 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
 
+	if (pkt_cursor_operate_in_buf(pkt, data, length, copy, write)) {
+		return 0;
+	}
+
 	while (c_op->buf && length) {
 		size_t d_len, len;
 
@@ -2012,6 +2104,81 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 	return 0;
 }
 
+int net_pkt_share_data(struct net_pkt *pkt_dst,
+		       struct net_pkt *pkt_src,
+		       size_t length,
+		       k_timeout_t timeout)
+{
+	struct net_pkt_cursor *c_src = &pkt_src->cursor;
+	struct net_buf *head = NULL, *tail = NULL;
+	struct net_pkt_cursor backup;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_BUF_VARIABLE_DATA_SIZE)) {
+		return -ENOTSUP;
+	}
+
+	net_pkt_cursor_backup(pkt_src, &backup);
+
+	while (length) {
+		struct net_buf *clone;
+		size_t offset, len;
+
+		pkt_cursor_advance(pkt_src, false);
+
+		if (!c_src->buf) {
+			ret = -ENOBUFS;
+			goto error;
+		}
+
+		if (c_src->buf->flags & NET_BUF_EXTERNAL_DATA) {
+			ret = -ENOTSUP;
+			goto error;
+		}
+
+		offset = c_src->pos - c_src->buf->data;
+		len = MIN(length, c_src->buf->len - offset);
+
+		/* With variable data size the clone references the data
+		 * of the original buffer.
+		 */
+		clone = net_buf_clone(c_src->buf, timeout);
+		if (!clone) {
+			ret = -ENOMEM;
+			goto error;
+		}
+
+		net_buf_pull(clone, offset);
+		net_buf_remove_mem(clone, clone->len - len);
+
+		if (!head) {
+			head = clone;
+		} else {
+			net_buf_frag_insert(tail, clone);
+		}
+
+		tail = clone;
+
+		pkt_cursor_update(pkt_src, len, false);
+		length -= len;
+	}
+
+	if (head) {
+		net_pkt_append_buffer(pkt_dst, head);
+	}
+
+	return 0;
+
+error:
+	if (head) {
+		net_pkt_frag_unref(head);
+	}
+
+	net_pkt_cursor_restore(pkt_src, &backup);
+
+	return ret;
+}
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 static inline void clone_pkt_cb(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
@@ -2025,7 +2192,7 @@ static inline void clone_pkt_cb(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 }
 #endif
 
-static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
+void net_pkt_clone_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
 	net_pkt_set_family(clone_pkt, net_pkt_family(pkt));
 	net_pkt_set_context(clone_pkt, net_pkt_context(pkt));
@@ -2052,6 +2219,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 #if defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_L2_IPIP)
 	net_pkt_set_remote_address(clone_pkt, net_pkt_remote_address(pkt),
@@ -2120,7 +2288,7 @@ static struct net_pkt *net_pkt_clone_internal(struct net_pkt *pkt,
 	}
 	net_pkt_set_overwrite(clone_pkt, true);
 
-	clone_pkt_attributes(pkt, clone_pkt);
+	net_pkt_clone_attributes(pkt, clone_pkt);
 
 	net_pkt_cursor_init(clone_pkt);
 
@@ -2163,7 +2331,7 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 
 	net_pkt_frag_ref(buf);
 
-	clone_pkt_attributes(pkt, clone_pkt);
+	net_pkt_clone_attributes(pkt, clone_pkt);
 
 	net_pkt_cursor_restore(clone_pkt, &pkt->cursor);
 
@@ -2212,6 +2380,8 @@ int net_pkt_update_length(struct net_pkt *pkt, size_t length)
 int net_pkt_pull(struct net_pkt *pkt, size_t length)
 {
 	struct net_pkt_cursor *c_op = &pkt->cursor;
+	struct net_buf *pulled = NULL;
+	struct net_buf *pulled_last = NULL;
 
 	while (length) {
 		size_t left, rem;
@@ -2242,7 +2412,19 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 			if (buf) {
 				pkt->buffer = buf->frags;
 				buf->frags = NULL;
-				net_buf_unref(buf);
+
+				/* Release the drained buffers that are freed
+				 * here at once.
+				 */
+				if (buf->ref > 1U) {
+					net_buf_unref(buf);
+				} else if (pulled_last) {
+					pulled_last->frags = buf;
+					pulled_last = buf;
+				} else {
+					pulled = buf;
+					pulled_last = buf;
+				}
 			}
 
 			net_pkt_cursor_init(pkt);
@@ -2251,6 +2433,10 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 		length -= rem;
 	}
 
+	if (pulled) {
+		net_buf_unref_chain(pulled);
+	}
+
 	net_pkt_cursor_init(pkt);
 
 	if (length) {
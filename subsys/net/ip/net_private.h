@@ -98,6 +98,8 @@ extern bool net_context_is_v6only_set(struct net_context *context);
 extern bool net_context_is_recv_pktinfo_set(struct net_context *context);
 extern bool net_context_is_timestamping_set(struct net_context *context);
 extern void net_pkt_init(void);
+extern void net_pkt_clone_attributes(struct net_pkt *pkt,
+				     struct net_pkt *clone_pkt);
 int net_context_get_local_addr(struct net_context *context,
 			       struct sockaddr *addr,
 			       socklen_t *addrlen);
@@ -206,6 +208,7 @@ static inline void net_tc_rx_init(void) { }
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 					       k_timeout_t timeout);
 extern enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern enum net_verdict net_tc_submit_to_rx_flow_queue(struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -34,6 +34,91 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  */
 struct net_stats net_stats = { 0 };
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* Counters updated by each CPU, summed up into net_stats when read. */
+struct net_stats_per_cpu net_stats_per_cpu[CONFIG_MP_MAX_NUM_CPUS];
+
+BUILD_ASSERT(sizeof(struct net_stats) % sizeof(net_stats_t) == 0);
+
+#define NET_STATS_WORDS (sizeof(struct net_stats) / sizeof(net_stats_t))
+
+static void stats_get_storage(struct net_if *iface, struct net_stats **shared,
+			      struct net_stats_per_cpu **per_cpu)
+{
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+	if (iface) {
+		*shared = &iface->stats;
+		*per_cpu = iface->stats_per_cpu;
+		return;
+	}
+#else
+	ARG_UNUSED(iface);
+#endif
+
+	*shared = &net_stats;
+	*per_cpu = net_stats_per_cpu;
+}
+
+/* The counters are summed word by word. Fields which are only updated with
+ * UPDATE_STAT_SHARED() (priorities, 64-bit sums, PM data) stay zero in all
+ * the per CPU copies, so a word that no CPU has touched is left as it is.
+ */
+static void stats_sync_words(struct net_stats *shared,
+			     const struct net_stats_per_cpu *per_cpu,
+			     size_t first, size_t count)
+{
+	net_stats_t *dst = (net_stats_t *)shared;
+
+	for (size_t i = first; i < first + count; i++) {
+		net_stats_t sum = 0U;
+		bool used = false;
+
+		for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+			net_stats_t val = ((const net_stats_t *)&per_cpu[cpu].stats)[i];
+
+			sum += val;
+			used |= (val != 0U);
+		}
+
+		if (used) {
+			dst[i] = sum;
+		}
+	}
+}
+
+void net_stats_sync(struct net_if *iface)
+{
+	struct net_stats_per_cpu *per_cpu;
+	struct net_stats *shared;
+
+	stats_get_storage(iface, &shared, &per_cpu);
+	stats_sync_words(shared, per_cpu, 0, NET_STATS_WORDS);
+}
+
+#if defined(CONFIG_NET_STATISTICS_VIA_PROMETHEUS)
+/* Only sum up the single counter a metric points to */
+static void stats_sync_counter(struct net_if *iface, const net_stats_t *counter)
+{
+	struct net_stats_per_cpu *per_cpu;
+	struct net_stats *shared;
+	ptrdiff_t offset;
+
+	stats_get_storage(iface, &shared, &per_cpu);
+
+	offset = (const uint8_t *)counter - (const uint8_t *)shared;
+	if (offset < 0 || (size_t)offset >= sizeof(struct net_stats) ||
+	    (offset % sizeof(net_stats_t)) != 0) {
+		/* Not one of the core counters, e.g. Ethernet statistics */
+		return;
+	}
+
+	stats_sync_words(shared, per_cpu, offset / sizeof(net_stats_t), 1);
+}
+#endif /* CONFIG_NET_STATISTICS_VIA_PROMETHEUS */
+#else
+#define stats_sync_counter(iface, counter)
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
 #define PRINT_STATISTICS_INTERVAL (30 * MSEC_PER_SEC)
@@ -77,6 +162,8 @@ static inline void stats(struct net_if *iface)
 	int i;
 
 	if (!next_print || (abs(cmp) > PRINT_STATISTICS_INTERVAL)) {
+		net_stats_sync(iface);
+
 		if (iface) {
 			NET_INFO("Interface %p [%d]", iface,
 				 net_if_get_by_iface(iface));
@@ -102,6 +189,12 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, ipv6_pmtu.sent),
 			 GET_STAT(iface, ipv6_pmtu.drop));
 #endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
+#if defined(CONFIG_NET_STATISTICS_ROUTE)
+		NET_INFO("IPv6 route lookup %d\tcache hit\t%d\tno route\t%d",
+			 GET_STAT(iface, route.lookup),
+			 GET_STAT(iface, route.cache_hit),
+			 GET_STAT(iface, route.no_route));
+#endif /* CONFIG_NET_STATISTICS_ROUTE */
 #if defined(CONFIG_NET_STATISTICS_MLD)
 		NET_INFO("IPv6 MLD recv  %d\tsent\t%d\tdrop\t%d",
 			 GET_STAT(iface, ipv6_mld.recv),
@@ -258,6 +351,8 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 	size_t len_chk = 0;
 	void *src = NULL;
 
+	net_stats_sync(iface);
+
 	switch (NET_MGMT_GET_COMMAND(mgmt_request)) {
 	case NET_REQUEST_STATS_CMD_GET_ALL:
 		len_chk = sizeof(struct net_stats);
@@ -303,6 +398,12 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 		src = GET_STAT_ADDR(iface, ipv6_pmtu);
 		break;
 #endif
+#if defined(CONFIG_NET_STATISTICS_ROUTE)
+	case NET_REQUEST_STATS_CMD_GET_ROUTE:
+		len_chk = sizeof(struct net_stats_route);
+		src = GET_STAT_ADDR(iface, route);
+		break;
+#endif
 #if defined(CONFIG_NET_STATISTICS_IPV4_PMTU)
 	case NET_REQUEST_STATS_CMD_GET_IPV4_PMTU:
 		len_chk = sizeof(struct net_stats_ipv4_pmtu);
@@ -376,6 +477,11 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_PMTU,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_ROUTE)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_ROUTE,
+				  net_stats_get);
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_IPV4_PMTU)
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV4_PMTU,
 				  net_stats_get);
@@ -412,6 +518,9 @@ void net_stats_reset(struct net_if *iface)
 
 	net_if_stats_reset_all();
 	memset(&net_stats, 0, sizeof(net_stats));
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	memset(net_stats_per_cpu, 0, sizeof(net_stats_per_cpu));
+#endif
 }
 
 #if defined(CONFIG_NET_STATISTICS_VIA_PROMETHEUS)
@@ -506,6 +615,7 @@ int net_stats_prometheus_scrape(struct prometheus_collector *collector,
 			return -EAGAIN;
 		}
 
+		stats_sync_counter(iface, counter->user_data);
 		value = *((net_stats_t *)counter->user_data);
 
 		prometheus_counter_set(counter, (uint64_t)value);
@@ -518,6 +628,7 @@ int net_stats_prometheus_scrape(struct prometheus_collector *collector,
 			return -EAGAIN;
 		}
 
+		stats_sync_counter(iface, gauge->user_data);
 		value = *((net_stats_t *)gauge->user_data);
 
 		prometheus_gauge_set(gauge, (double)value);
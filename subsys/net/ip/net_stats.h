@@ -27,10 +27,42 @@ extern struct net_stats net_stats;
 #define GET_STAT_ADDR(iface, s) (&GET_STAT(iface, s))
 #endif
 
-#define UPDATE_STAT_GLOBAL(cmd) (net_##cmd)
-#define UPDATE_STAT(_iface, _cmd) \
-	{ NET_ASSERT(_iface); (UPDATE_STAT_GLOBAL(_cmd)); \
+/* Fields which are assigned rather than incremented, or which are wider
+ * than net_stats_t, are always updated in the shared statistics.
+ */
+#define UPDATE_STAT_SHARED(_iface, _cmd) \
+	{ NET_ASSERT(_iface); (net_##_cmd); \
 	  SET_STAT(_iface->_cmd); }
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+extern struct net_stats_per_cpu net_stats_per_cpu[CONFIG_MP_MAX_NUM_CPUS];
+
+#if defined(CONFIG_SMP)
+/* The CPU is sampled without locking. If the thread migrates before the
+ * update is done, the counter simply ends up in the copy of another CPU.
+ */
+#define NET_STATS_CPU_ID() (arch_curr_cpu()->id)
+#else
+#define NET_STATS_CPU_ID() 0
+#endif
+
+#define UPDATE_STAT_GLOBAL(cmd) (net_stats_per_cpu[NET_STATS_CPU_ID()].cmd)
+#define UPDATE_STAT(_iface, _cmd) \
+	{ unsigned int _cpu = NET_STATS_CPU_ID(); \
+	  NET_ASSERT(_iface); (net_stats_per_cpu[_cpu]._cmd); \
+	  SET_STAT(_iface->stats_per_cpu[_cpu]._cmd); }
+
+/* Sum up the per CPU counters into the shared statistics of the given
+ * interface, or into the global statistics if iface is NULL. Must be
+ * called before the shared statistics are read.
+ */
+void net_stats_sync(struct net_if *iface);
+#else
+#define UPDATE_STAT_GLOBAL(cmd) (net_##cmd)
+#define UPDATE_STAT(_iface, _cmd) UPDATE_STAT_SHARED(_iface, _cmd)
+#define net_stats_sync(iface)
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 /* Core stats */
 
 static inline void net_stats_update_processing_error(struct net_if *iface)
@@ -99,6 +131,7 @@ static inline void net_stats_update_filter_rx_local_drop(struct net_if *iface)
 #define net_stats_update_filter_rx_local_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_PKT_FILTER */
 #else
+#define net_stats_sync(iface)
 #define net_stats_update_processing_error(iface)
 #define net_stats_update_ip_errors_protoerr(iface)
 #define net_stats_update_ip_errors_vhlerr(iface)
@@ -180,6 +213,51 @@ static inline void net_stats_update_ipv6_pmtu_drop(struct net_if *iface)
 #define net_stats_update_ipv6_pmtu_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
 
+#if defined(CONFIG_NET_STATISTICS_ROUTE) && defined(CONFIG_NET_NATIVE_IPV6)
+/* Route lookups can be done without a network interface, in that case
+ * only the global statistics are updated.
+ */
+#define UPDATE_ROUTE_STAT(_iface, _cmd)			\
+	do {						\
+		if (_iface) {				\
+			UPDATE_STAT(_iface, _cmd);	\
+		} else {				\
+			UPDATE_STAT_GLOBAL(_cmd);	\
+		}					\
+	} while (false)
+
+static inline void net_stats_update_route_lookup(struct net_if *iface)
+{
+	UPDATE_ROUTE_STAT(iface, stats.route.lookup++);
+}
+
+static inline void net_stats_update_route_cache_hit(struct net_if *iface)
+{
+	UPDATE_ROUTE_STAT(iface, stats.route.cache_hit++);
+}
+
+static inline void net_stats_update_route_no_route(struct net_if *iface)
+{
+	UPDATE_ROUTE_STAT(iface, stats.route.no_route++);
+}
+
+static inline void net_stats_update_route_added(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.route.added++);
+}
+
+static inline void net_stats_update_route_deleted(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.route.deleted++);
+}
+#else
+#define net_stats_update_route_lookup(iface)
+#define net_stats_update_route_cache_hit(iface)
+#define net_stats_update_route_no_route(iface)
+#define net_stats_update_route_added(iface)
+#define net_stats_update_route_deleted(iface)
+#endif /* CONFIG_NET_STATISTICS_ROUTE */
+
 #if defined(CONFIG_NET_STATISTICS_IPV4_PMTU) && defined(CONFIG_NET_NATIVE_IPV4)
 /* IPv4 Path MTU Discovery stats */
 
@@ -463,9 +541,9 @@ static inline void net_stats_update_tx_time(struct net_if *iface,
 {
 	uint32_t diff = end_time - start_time;
 
-	UPDATE_STAT(iface, stats.tx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.tx_time.count += 1);
+	UPDATE_STAT_SHARED(iface, stats.tx_time.sum +=
+		           k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT_SHARED(iface, stats.tx_time.count += 1);
 }
 #else
 #define net_stats_update_tx_time(iface, start_time, end_time)
@@ -478,11 +556,11 @@ static inline void net_stats_update_tx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.tx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.tx_time_detail[i].count += 1);
+		UPDATE_STAT_SHARED(iface,
+			           stats.tx_time_detail[i].sum +=
+			           k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
+		UPDATE_STAT_SHARED(iface,
+			           stats.tx_time_detail[i].count += 1);
 	}
 }
 #else
@@ -496,9 +574,9 @@ static inline void net_stats_update_rx_time(struct net_if *iface,
 {
 	uint32_t diff = end_time - start_time;
 
-	UPDATE_STAT(iface, stats.rx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.rx_time.count += 1);
+	UPDATE_STAT_SHARED(iface, stats.rx_time.sum +=
+		           k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT_SHARED(iface, stats.rx_time.count += 1);
 }
 #else
 #define net_stats_update_rx_time(iface, start_time, end_time)
@@ -511,11 +589,11 @@ static inline void net_stats_update_rx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.rx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.rx_time_detail[i].count += 1);
+		UPDATE_STAT_SHARED(iface,
+			           stats.rx_time_detail[i].sum +=
+			           k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
+		UPDATE_STAT_SHARED(iface,
+			           stats.rx_time_detail[i].count += 1);
 	}
 }
 #else
@@ -543,7 +621,7 @@ static inline void net_stats_update_tc_sent_bytes(struct net_if *iface,
 static inline void net_stats_update_tc_sent_priority(struct net_if *iface,
 						     uint8_t tc, uint8_t priority)
 {
-	UPDATE_STAT(iface, stats.tc.sent[tc].priority = priority);
+	UPDATE_STAT_SHARED(iface, stats.tc.sent[tc].priority = priority);
 }
 
 #if defined(CONFIG_NET_PKT_TXTIME_STATS) && \
@@ -556,9 +634,9 @@ static inline void net_stats_update_tc_tx_time(struct net_if *iface,
 	uint32_t diff = end_time - start_time;
 	int tc = net_tx_priority2tc(priority);
 
-	UPDATE_STAT(iface, stats.tc.sent[tc].tx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.tc.sent[tc].tx_time.count += 1);
+	UPDATE_STAT_SHARED(iface, stats.tc.sent[tc].tx_time.sum +=
+		           k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT_SHARED(iface, stats.tc.sent[tc].tx_time.count += 1);
 
 	net_stats_update_tx_time(iface, start_time, end_time);
 }
@@ -575,11 +653,11 @@ static inline void net_stats_update_tc_tx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.tc.sent[tc].tx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.tc.sent[tc].tx_time_detail[i].count += 1);
+		UPDATE_STAT_SHARED(iface,
+			           stats.tc.sent[tc].tx_time_detail[i].sum +=
+			           k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
+		UPDATE_STAT_SHARED(iface,
+			           stats.tc.sent[tc].tx_time_detail[i].count += 1);
 	}
 
 	net_stats_update_tx_time_detail(iface, detail_stat);
@@ -598,9 +676,9 @@ static inline void net_stats_update_tc_rx_time(struct net_if *iface,
 	uint32_t diff = end_time - start_time;
 	int tc = net_rx_priority2tc(priority);
 
-	UPDATE_STAT(iface, stats.tc.recv[tc].rx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.tc.recv[tc].rx_time.count += 1);
+	UPDATE_STAT_SHARED(iface, stats.tc.recv[tc].rx_time.sum +=
+		           k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT_SHARED(iface, stats.tc.recv[tc].rx_time.count += 1);
 
 	net_stats_update_rx_time(iface, start_time, end_time);
 }
@@ -617,11 +695,11 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.tc.recv[tc].rx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.tc.recv[tc].rx_time_detail[i].count += 1);
+		UPDATE_STAT_SHARED(iface,
+			           stats.tc.recv[tc].rx_time_detail[i].sum +=
+			           k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
+		UPDATE_STAT_SHARED(iface,
+			           stats.tc.recv[tc].rx_time_detail[i].count += 1);
 	}
 
 	net_stats_update_rx_time_detail(iface, detail_stat);
@@ -649,7 +727,7 @@ static inline void net_stats_update_tc_recv_bytes(struct net_if *iface,
 static inline void net_stats_update_tc_recv_priority(struct net_if *iface,
 						     uint8_t tc, uint8_t priority)
 {
-	UPDATE_STAT(iface, stats.tc.recv[tc].priority = priority);
+	UPDATE_STAT_SHARED(iface, stats.tc.recv[tc].priority = priority);
 }
 #else
 static inline void net_stats_update_tc_sent_pkt(struct net_if *iface, uint8_t tc)
@@ -765,12 +843,31 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 #endif /* CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING) && defined(CONFIG_NET_STATISTICS) \
+	&& defined(CONFIG_NET_NATIVE)
+static inline void net_stats_update_rx_flow_pkt(struct net_if *iface,
+						uint8_t queue, size_t bytes)
+{
+	UPDATE_STAT(iface, stats.rx_flow.queue[queue].pkts++);
+	UPDATE_STAT(iface, stats.rx_flow.queue[queue].bytes += bytes);
+}
+
+static inline void net_stats_update_rx_flow_dropped(struct net_if *iface,
+						    uint8_t queue)
+{
+	UPDATE_STAT(iface, stats.rx_flow.queue[queue].dropped++);
+}
+#else
+#define net_stats_update_rx_flow_pkt(iface, queue, bytes)
+#define net_stats_update_rx_flow_dropped(iface, queue)
+#endif /* CONFIG_NET_TC_RX_FLOW_STEERING */
+
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)	\
 	&& defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_NATIVE)
 static inline void net_stats_add_suspend_start_time(struct net_if *iface,
 						    uint32_t time)
 {
-	UPDATE_STAT(iface, stats.pm.start_time = time);
+	UPDATE_STAT_SHARED(iface, stats.pm.start_time = time);
 }
 
 static inline void net_stats_add_suspend_end_time(struct net_if *iface,
@@ -779,10 +876,10 @@ static inline void net_stats_add_suspend_end_time(struct net_if *iface,
 	uint32_t diff_time =
 		k_cyc_to_ms_floor32(time - GET_STAT(iface, pm.start_time));
 
-	UPDATE_STAT(iface, stats.pm.start_time = 0);
-	UPDATE_STAT(iface, stats.pm.last_suspend_time = diff_time);
-	UPDATE_STAT(iface, stats.pm.suspend_count++);
-	UPDATE_STAT(iface, stats.pm.overall_suspend_time += diff_time);
+	UPDATE_STAT_SHARED(iface, stats.pm.start_time = 0);
+	UPDATE_STAT_SHARED(iface, stats.pm.last_suspend_time = diff_time);
+	UPDATE_STAT_SHARED(iface, stats.pm.suspend_count++);
+	UPDATE_STAT_SHARED(iface, stats.pm.overall_suspend_time += diff_time);
 }
 #else
 #define net_stats_add_suspend_start_time(iface, time)
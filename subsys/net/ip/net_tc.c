@@ -13,20 +13,33 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
+#include "tcp_internal.h"
+
+/* With flow steering the single RX traffic class is split into several
+ * queues, each one served by its own thread.
+ */
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+#define NET_TC_RX_QUEUE_COUNT CONFIG_NET_TC_RX_FLOW_QUEUES
+#else
+#define NET_TC_RX_QUEUE_COUNT NET_TC_RX_COUNT
+#endif
 
 #define TC_RX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO, (1), (0)))
-#define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_COUNT + TC_RX_PSEUDO_QUEUE)
+#define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_QUEUE_COUNT + TC_RX_PSEUDO_QUEUE)
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 #define NET_TC_RX_SLOTS (CONFIG_NET_PKT_RX_COUNT / NET_TC_RX_EFFECTIVE_COUNT)
 BUILD_ASSERT(NET_TC_RX_SLOTS > 0,
 		"Misconfiguration: There are more traffic classes then packets, "
 		"either increase CONFIG_NET_PKT_RX_COUNT or decrease "
-		"CONFIG_NET_TC_RX_COUNT or disable CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO");
+		"CONFIG_NET_TC_RX_COUNT or disable CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO "
+		"or decrease CONFIG_NET_TC_RX_FLOW_QUEUES");
 #endif
 
 #define TC_TX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_TX_SKIP_FOR_HIGH_PRIO, (1), (0)))
@@ -54,7 +67,7 @@ K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -62,7 +75,7 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_QUEUE_COUNT];
 #endif
 
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
@@ -117,6 +130,152 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #endif
 }
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+/* FNV-1a, good enough to spread the flows and cheap to calculate */
+#define RX_FLOW_HASH_INIT 2166136261U
+#define RX_FLOW_HASH_PRIME 16777619U
+
+static uint32_t rx_flow_hash_add(uint32_t hash, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ data[i]) * RX_FLOW_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+/* Calculate the flow hash from the IP addresses and TCP/UDP ports of a
+ * received packet. Nothing has been parsed yet at this point, so the headers
+ * are read from the start of the packet. Packets that cannot be classified
+ * (non IP, IP fragments, unknown transport) still get a stable hash so that
+ * they are always handled by the same queue.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	uint32_t hash = RX_FLOW_HASH_INIT;
+	uint16_t ptype = 0U;
+	uint8_t proto = 0U;
+	bool has_ports = false;
+	uint8_t ports[4];
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr eth_hdr;
+
+		if (net_pkt_read(pkt, &eth_hdr, sizeof(eth_hdr)) < 0) {
+			goto out;
+		}
+
+		ptype = ntohs(eth_hdr.type);
+		if (ptype == NET_ETH_PTYPE_VLAN) {
+			if (net_pkt_skip(pkt, sizeof(uint16_t)) < 0 ||
+			    net_pkt_read_be16(pkt, &ptype) < 0) {
+				goto out;
+			}
+		}
+	} else
+#endif
+	{
+		uint8_t vhl;
+
+		if (net_pkt_read_u8(pkt, &vhl) < 0) {
+			goto out;
+		}
+
+		net_pkt_cursor_init(pkt);
+
+		if ((vhl & 0xf0) == 0x40) {
+			ptype = NET_ETH_PTYPE_IP;
+		} else if ((vhl & 0xf0) == 0x60) {
+			ptype = NET_ETH_PTYPE_IPV6;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && ptype == NET_ETH_PTYPE_IP) {
+		struct net_ipv4_hdr hdr;
+		size_t hdr_len;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr)) < 0) {
+			goto out;
+		}
+
+		hash = rx_flow_hash_add(hash, hdr.src, sizeof(hdr.src));
+		hash = rx_flow_hash_add(hash, hdr.dst, sizeof(hdr.dst));
+
+		/* All the fragments of a datagram must end up in the same
+		 * queue, and only the first one carries the ports.
+		 */
+		if ((sys_get_be16(hdr.offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			goto out;
+		}
+
+		hdr_len = (hdr.vhl & NET_IPV4_IHL_MASK) * 4U;
+		if (hdr_len < sizeof(hdr) ||
+		    net_pkt_skip(pkt, hdr_len - sizeof(hdr)) < 0) {
+			goto out;
+		}
+
+		proto = hdr.proto;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && ptype == NET_ETH_PTYPE_IPV6) {
+		struct net_ipv6_hdr hdr;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr)) < 0) {
+			goto out;
+		}
+
+		hash = rx_flow_hash_add(hash, hdr.src, sizeof(hdr.src));
+		hash = rx_flow_hash_add(hash, hdr.dst, sizeof(hdr.dst));
+
+		/* Extension headers are not walked, such packets are steered
+		 * by the addresses only.
+		 */
+		proto = hdr.nexthdr;
+	} else {
+		goto out;
+	}
+
+	if (proto == IPPROTO_TCP || proto == IPPROTO_UDP) {
+		has_ports = net_pkt_read(pkt, ports, sizeof(ports)) == 0;
+	}
+
+	hash = rx_flow_hash_add(hash, &proto, sizeof(proto));
+
+	if (has_ports) {
+		hash = rx_flow_hash_add(hash, ports, sizeof(ports));
+	}
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return hash;
+}
+
+enum net_verdict net_tc_submit_to_rx_flow_queue(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	size_t len = net_pkt_get_len(pkt);
+	uint8_t queue;
+
+	queue = rx_flow_hash(pkt) % NET_TC_RX_QUEUE_COUNT;
+
+	NET_DBG("pkt %p steered to RX queue %d", pkt, queue);
+
+	if (net_tc_submit_to_rx_queue(queue, pkt) != NET_OK) {
+		net_stats_update_rx_flow_dropped(iface, queue);
+		return NET_DROP;
+	}
+
+	net_stats_update_rx_flow_pkt(iface, queue, len);
+
+	return NET_OK;
+}
+#endif /* CONFIG_NET_TC_RX_FLOW_STEERING */
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -305,6 +464,14 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 		k_sem_give(fifo_slot);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+			pkt = net_tcp_gro_receive(fifo, pkt, fifo_slot);
+		}
+#else
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+			pkt = net_tcp_gro_receive(fifo, pkt, NULL);
+		}
 #endif
 
 		net_process_rx_packet(pkt);
@@ -425,12 +592,16 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		/* All the flow steering queues belong to the same traffic
+		 * class and run at the same priority.
+		 */
+		thread_priority = rx_tc2thread(
+			IS_ENABLED(CONFIG_NET_TC_RX_FLOW_STEERING) ? 0 : i);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -474,6 +645,12 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+		if (k_thread_cpu_pin(tid, i % arch_num_cpus()) < 0) {
+			NET_ERR("Cannot pin RX queue %d thread to CPU", i);
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "icmpv6.h"
 #include "nbr.h"
 #include "route.h"
+#include "net_stats.h"
 
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
@@ -267,34 +268,336 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+/* The routes are indexed by a path compressed binary trie. Each node holds
+ * a prefix, and nodes are only created for route prefixes or at points where
+ * two prefixes diverge. A lookup visits the nodes along the bits of the
+ * destination address, so the cost depends on the prefix length and not on
+ * the number of routes. Every route can add at most one prefix node and one
+ * branch node, hence the size of the node pool.
+ */
+struct net_route_lpm_node {
+	struct net_route_lpm_node *parent;
+	struct net_route_lpm_node *child[2];
+
+	/** Routes (one per network interface) having exactly this prefix */
+	sys_slist_t routes;
+
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+	bool in_use;
+};
+
+static struct net_route_lpm_node lpm_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct net_route_lpm_node *lpm_root;
+
+/* Remember the last destination looked up on each interface. Slot 0 is used
+ * for the lookups that are not tied to any interface.
+ */
+struct route_cache_entry {
+	struct net_if *iface;
+	struct net_route_entry *route;
+	struct in6_addr dst;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_IF_MAX_IPV6_COUNT + 1];
+
+static inline uint8_t lpm_bit(const struct in6_addr *addr, uint8_t bit)
 {
-	struct net_route_entry *route, *found = NULL;
-	uint8_t longest_match = 0U;
-	int i;
+	return (addr->s6_addr[bit / 8U] >> (7U - (bit % 8U))) & 0x01;
+}
 
-	net_ipv6_nbr_lock();
+static uint8_t lpm_common_len(const struct in6_addr *addr1,
+			      const struct in6_addr *addr2,
+			      uint8_t max_len)
+{
+	uint8_t len = 0U;
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	for (int i = 0; i < NET_IPV6_ADDR_SIZE && len < max_len; i++) {
+		uint8_t diff = addr1->s6_addr[i] ^ addr2->s6_addr[i];
 
-		if (!nbr->ref) {
+		if (diff == 0U) {
+			len += 8U;
 			continue;
 		}
 
-		if (iface && nbr->iface != iface) {
+		len += (uint8_t)(__builtin_clz(diff) - 24);
+		break;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct net_route_lpm_node *lpm_node_alloc(const struct in6_addr *prefix,
+						 uint8_t prefix_len)
+{
+	ARRAY_FOR_EACH_PTR(lpm_nodes, node) {
+		if (node->in_use) {
 			continue;
 		}
 
-		route = net_route_data(nbr);
+		memset(node, 0, sizeof(*node));
+		node->in_use = true;
+		node->prefix_len = prefix_len;
+		net_ipv6_addr_prefix_mask(prefix->s6_addr, node->prefix.s6_addr,
+					  prefix_len);
+		sys_slist_init(&node->routes);
+
+		return node;
+	}
+
+	return NULL;
+}
+
+static inline void lpm_node_free(struct net_route_lpm_node *node)
+{
+	node->in_use = false;
+}
+
+/* Return the pointer that links the node to the trie */
+static inline struct net_route_lpm_node **lpm_link(struct net_route_lpm_node *node)
+{
+	if (node->parent == NULL) {
+		return &lpm_root;
+	}
+
+	return &node->parent->child[lpm_bit(&node->prefix,
+					    node->parent->prefix_len)];
+}
+
+static struct net_route_lpm_node *lpm_insert(const struct in6_addr *addr,
+					     uint8_t prefix_len)
+{
+	struct net_route_lpm_node **link = &lpm_root;
+	struct net_route_lpm_node *parent = NULL;
+	struct net_route_lpm_node *node, *new_node, *branch;
+	uint8_t common;
+
+	while (*link != NULL) {
+		node = *link;
+		common = lpm_common_len(&node->prefix, addr,
+					MIN(node->prefix_len, prefix_len));
+
+		if (common == node->prefix_len) {
+			if (node->prefix_len == prefix_len) {
+				return node;
+			}
+
+			parent = node;
+			link = &node->child[lpm_bit(addr, node->prefix_len)];
+			continue;
+		}
+
+		new_node = lpm_node_alloc(addr, prefix_len);
+		if (new_node == NULL) {
+			return NULL;
+		}
+
+		if (common == prefix_len) {
+			/* The new prefix covers the existing node */
+			new_node->parent = parent;
+			new_node->child[lpm_bit(&node->prefix, prefix_len)] = node;
+			node->parent = new_node;
+			*link = new_node;
+
+			return new_node;
+		}
+
+		/* The prefixes diverge, add a branch node where they split */
+		branch = lpm_node_alloc(addr, common);
+		if (branch == NULL) {
+			lpm_node_free(new_node);
+			return NULL;
+		}
+
+		branch->parent = parent;
+		branch->child[lpm_bit(&node->prefix, common)] = node;
+		branch->child[lpm_bit(addr, common)] = new_node;
+		node->parent = branch;
+		new_node->parent = branch;
+		*link = branch;
+
+		return new_node;
+	}
+
+	new_node = lpm_node_alloc(addr, prefix_len);
+	if (new_node == NULL) {
+		return NULL;
+	}
+
+	new_node->parent = parent;
+	*link = new_node;
+
+	return new_node;
+}
+
+/* Remove the nodes that do not hold any routes and are not needed as
+ * branch points anymore.
+ */
+static void lpm_prune(struct net_route_lpm_node *node)
+{
+	while (node != NULL && sys_slist_is_empty(&node->routes)) {
+		struct net_route_lpm_node *parent = node->parent;
+		struct net_route_lpm_node *child;
+
+		if (node->child[0] != NULL && node->child[1] != NULL) {
+			break;
+		}
+
+		child = node->child[0] != NULL ? node->child[0] : node->child[1];
+		*lpm_link(node) = child;
+
+		if (child != NULL) {
+			child->parent = parent;
+		}
+
+		lpm_node_free(node);
+
+		node = parent;
+	}
+}
+
+static int lpm_add_route(struct net_route_entry *route)
+{
+	struct net_route_lpm_node *node;
+
+	node = lpm_insert(&route->addr, route->prefix_len);
+	if (node == NULL) {
+		return -ENOMEM;
+	}
+
+	route->lpm = node;
+	sys_slist_append(&node->routes, &route->lpm_node);
+
+	return 0;
+}
+
+static void lpm_del_route(struct net_route_entry *route)
+{
+	struct net_route_lpm_node *node = route->lpm;
+
+	if (node == NULL) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&node->routes, &route->lpm_node);
+	route->lpm = NULL;
+
+	lpm_prune(node);
+}
+
+static struct net_route_entry *lpm_lookup(struct net_if *iface,
+					  const struct in6_addr *dst)
+{
+	struct net_route_lpm_node *node = lpm_root;
+	struct net_route_entry *found = NULL;
+	struct net_route_entry *route;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, lpm_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[lpm_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix(dst->s6_addr,
-				       route->addr.s6_addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
+/* Find the route having exactly the given prefix */
+static struct net_route_entry *lpm_lookup_exact(struct net_if *iface,
+						const struct in6_addr *addr,
+						uint8_t prefix_len)
+{
+	struct net_route_lpm_node *node = lpm_root;
+	struct net_route_entry *route;
+
+	while (node != NULL && node->prefix_len <= prefix_len &&
+	       net_ipv6_is_prefix(addr->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		if (node->prefix_len == prefix_len) {
+			SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route,
+						     lpm_node) {
+				if (route->iface == iface) {
+					return route;
+				}
+			}
+
+			break;
+		}
+
+		node = node->child[lpm_bit(addr, node->prefix_len)];
+	}
+
+	return NULL;
+}
+
+static struct route_cache_entry *route_cache_get(struct net_if *iface)
+{
+	static int next;
+	int i;
+
+	if (iface == NULL) {
+		return &route_cache[0];
+	}
+
+	for (i = 1; i < ARRAY_SIZE(route_cache); i++) {
+		if (route_cache[i].iface == iface) {
+			return &route_cache[i];
+		}
+	}
+
+	for (i = 1; i < ARRAY_SIZE(route_cache); i++) {
+		if (route_cache[i].iface == NULL) {
+			route_cache[i].iface = iface;
+			return &route_cache[i];
+		}
+	}
+
+	/* More interfaces than slots, recycle one of them */
+	next = (next % (ARRAY_SIZE(route_cache) - 1)) + 1;
+
+	route_cache[next].iface = iface;
+	route_cache[next].route = NULL;
+
+	return &route_cache[next];
+}
+
+/* Any change in the routing table invalidates the cached results */
+static void route_cache_flush(void)
+{
+	ARRAY_FOR_EACH_PTR(route_cache, entry) {
+		entry->route = NULL;
+	}
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct route_cache_entry *cache;
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	net_stats_update_route_lookup(iface);
+
+	cache = route_cache_get(iface);
+	if (cache->route != NULL && net_ipv6_addr_cmp(&cache->dst, dst)) {
+		net_stats_update_route_cache_hit(iface);
+		found = cache->route;
+	} else {
+		found = lpm_lookup(iface, dst);
+		if (found) {
+			net_ipaddr_copy(&cache->dst, dst);
+			cache->route = found;
 		}
 	}
 
@@ -302,6 +605,8 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		net_route_info("Found", found, dst);
 
 		update_route_access(found);
+	} else {
+		net_stats_update_route_no_route(iface);
 	}
 
 	net_ipv6_nbr_unlock();
@@ -361,7 +666,10 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	/* Only a route with the very same prefix is replaced, more specific
+	 * routes can co-exist with the ones covering them.
+	 */
+	route = lpm_lookup_exact(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -442,6 +750,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+	if (lpm_add_route(route) < 0) {
+		NET_ERR("No route index node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+
+	route_cache_flush();
+	net_stats_update_route_added(iface);
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -588,12 +907,17 @@ int net_route_del(struct net_route_entry *route)
 
 	sys_slist_find_and_remove(&routes, &route->node);
 
+	lpm_del_route(route);
+	route_cache_flush();
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		net_ipv6_nbr_unlock();
 		return -ENOENT;
 	}
 
+	net_stats_update_route_deleted(route->iface);
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
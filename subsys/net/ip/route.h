@@ -38,6 +38,8 @@ struct net_route_nexthop {
 	struct net_nbr *nbr;
 };
 
+struct net_route_lpm_node;
+
 /**
  * @brief Route entry to a specific neighbor.
  */
@@ -52,6 +54,12 @@ struct net_route_entry {
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
+	/** Node in the list of routes having the same prefix. */
+	sys_snode_t lpm_node;
+
+	/** Longest prefix match trie node holding this route. */
+	struct net_route_lpm_node *lpm;
+
 	/** Network interface for the route. */
 	struct net_if *iface;
 
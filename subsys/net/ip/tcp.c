@@ -1474,6 +1474,8 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1659,13 +1661,76 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Return the payload length of a GSO super-segment to send, or 0 if the
+ * data must be sent one MSS at a time.
+ */
+static int tcp_gso_len(struct tcp *conn, int unsent)
+{
+	int mss = conn_mss(conn);
+
+	/* Retransmissions are always done one segment at a time */
+	if (conn->data_mode != TCP_DATA_MODE_SEND || unsent <= mss) {
+		return 0;
+	}
+
+	if (conn->iface == NULL ||
+	    net_if_l2(conn->iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return 0;
+	}
+
+	/* Locally destined data never reaches the Ethernet L2 where the
+	 * super-segment would be split.
+	 */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && conn->dst.sa.sa_family == AF_INET &&
+	    (net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+	     net_ipv4_is_my_addr(&conn->dst.sin.sin_addr))) {
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->dst.sa.sa_family == AF_INET6 &&
+	    (net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+	     net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr))) {
+		return 0;
+	}
+
+	return ROUND_DOWN(MIN(unsent, CONFIG_NET_TCP_GSO_MAX_SIZE), mss);
+}
+
+/* The super-segment is larger than the interface MTU, so the data buffer
+ * is allocated without the MTU clamping done by net_pkt_alloc_with_buffer().
+ */
+static struct net_pkt *tcp_gso_pkt_alloc(struct tcp *conn, int len)
+{
+	struct net_pkt *pkt;
+
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(pkt, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_set_gso_size(pkt, conn_mss(conn));
+
+	return pkt;
+}
+#else
+#define tcp_gso_len(...) 0
+#define tcp_gso_pkt_alloc(...) NULL
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
+	int gso_len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = tcp_unsent_len(conn);
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1676,7 +1741,15 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	gso_len = tcp_gso_len(conn, len);
+	if (gso_len > 0) {
+		len = gso_len;
+		pkt = tcp_gso_pkt_alloc(conn, len);
+	} else {
+		len = MIN(len, conn_mss(conn));
+		pkt = tcp_pkt_alloc(conn, len);
+	}
+
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
@@ -1699,7 +1772,11 @@ static int tcp_send_data(struct tcp *conn)
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			/* A GSO super-segment ends up as several segments */
+			for (int sent = 0; sent < len; sent += conn_mss(conn)) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
@@ -3987,7 +4064,12 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* The checksum of a GSO super-segment is never used as is, it is
+	 * calculated for each segment separately when it is split, or by
+	 * the hardware doing the segmentation.
+	 */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -3995,6 +4077,120 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len, data_len, offset;
+	uint8_t flags;
+	uint32_t seq;
+	int total = 0;
+	int ret = 0;
+
+	if (mss == 0U) {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+
+	if (net_pkt_get_len(pkt) <= hdr_len) {
+		return -EINVAL;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (offset = 0; offset < data_len; offset += mss) {
+		size_t seg_len = MIN(mss, data_len - offset);
+		struct net_pkt *seg;
+
+		seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+						hdr_len + seg_len, AF_UNSPEC, 0,
+						TCP_PKT_ALLOC_TIMEOUT);
+		if (!seg) {
+			ret = -ENOBUFS;
+			break;
+		}
+
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_copy(seg, pkt, hdr_len) ||
+		    net_pkt_skip(pkt, offset) ||
+		    net_pkt_copy(seg, pkt, seg_len)) {
+			tcp_pkt_unref(seg);
+			ret = -ENOBUFS;
+			break;
+		}
+
+		net_pkt_clone_attributes(pkt, seg);
+		net_pkt_set_gso_size(seg, 0U);
+
+		net_pkt_cursor_init(seg);
+		net_pkt_set_overwrite(seg, true);
+		net_pkt_skip(seg, ip_len);
+
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg,
+								 &tcp_access);
+		if (!tcp_hdr) {
+			tcp_pkt_unref(seg);
+			ret = -ENOBUFS;
+			break;
+		}
+
+		sys_put_be32(seq + offset, tcp_hdr->seq);
+
+		/* PSH and FIN belong to the last segment only */
+		if (offset + seg_len < data_len) {
+			tcp_hdr->flags = flags & ~(PSH | FIN);
+		}
+
+		net_pkt_set_data(seg, &tcp_access);
+
+		ret = tcp_finalize_pkt(seg);
+		if (ret < 0) {
+			tcp_pkt_unref(seg);
+			break;
+		}
+
+		net_pkt_cursor_init(seg);
+
+		ret = cb(seg, user_data);
+		if (ret < 0) {
+			break;
+		}
+
+		total += ret;
+	}
+
+	/* Segments given to the callback before a failure are already on
+	 * their way, so report them as sent. The rest of the data is
+	 * recovered by the normal TCP retransmission.
+	 */
+	if (ret < 0 && total == 0) {
+		return ret;
+	}
+
+	return total;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -0,0 +1,372 @@
+/** @file
+ * @brief TCP generic receive offload (GRO)
+ *
+ * Merge consecutive in-order TCP segments of the same flow waiting in a RX
+ * traffic class queue into one segment before the IP stack processes them.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Parsed headers of a segment that is a GRO candidate */
+struct tcp_gro_seg {
+	struct net_eth_hdr eth;
+	union {
+		struct net_ipv4_hdr ipv4;
+		struct net_ipv6_hdr ipv6;
+	};
+	struct net_tcp_hdr tcp;
+	sa_family_t family;
+	uint16_t ip_hdr_len;
+	uint16_t hdr_len;
+	uint16_t payload_len;
+	/* Expected one's complement sum of the payload, derived from the
+	 * headers and the checksum field of the segment.
+	 */
+	uint16_t payload_sum;
+};
+
+static uint16_t tcp_gro_csum_add(uint16_t a, uint16_t b)
+{
+	uint32_t sum = (uint32_t)a + b;
+
+	return (sum & 0xffff) + (sum >> 16);
+}
+
+/* One's complement sum of the TCP pseudo header and of the TCP header */
+static uint16_t tcp_gro_hdr_sum(struct tcp_gro_seg *seg)
+{
+	uint16_t sum = seg->payload_len + sizeof(struct net_tcp_hdr) + IPPROTO_TCP;
+
+	if (seg->family == AF_INET) {
+		sum = calc_chksum(sum, seg->ipv4.src, 2 * NET_IPV4_ADDR_SIZE);
+	} else {
+		sum = calc_chksum(sum, seg->ipv6.src, 2 * NET_IPV6_ADDR_SIZE);
+	}
+
+	return calc_chksum(sum, (uint8_t *)&seg->tcp, sizeof(struct net_tcp_hdr));
+}
+
+static bool tcp_gro_parse_ipv4(struct net_pkt *pkt, struct tcp_gro_seg *seg)
+{
+	if (net_pkt_read(pkt, &seg->ipv4, sizeof(struct net_ipv4_hdr))) {
+		return false;
+	}
+
+	/* No IPv4 options and no fragments */
+	if (seg->ipv4.vhl != 0x45 || seg->ipv4.proto != IPPROTO_TCP ||
+	    (sys_get_be16(seg->ipv4.offset) &
+	     (NET_IPV4_FRAGH_OFFSET_MASK | NET_IPV4_MORE_FRAG_MASK)) != 0) {
+		return false;
+	}
+
+	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt),
+					 NET_IF_CHECKSUM_IPV4_HEADER) &&
+	    calc_chksum(0, (uint8_t *)&seg->ipv4,
+			sizeof(struct net_ipv4_hdr)) != 0xffff) {
+		return false;
+	}
+
+	seg->family = AF_INET;
+	seg->ip_hdr_len = sizeof(struct net_ipv4_hdr);
+
+	return ntohs(seg->ipv4.len) > seg->ip_hdr_len + sizeof(struct net_tcp_hdr);
+}
+
+static bool tcp_gro_parse_ipv6(struct net_pkt *pkt, struct tcp_gro_seg *seg)
+{
+	if (net_pkt_read(pkt, &seg->ipv6, sizeof(struct net_ipv6_hdr))) {
+		return false;
+	}
+
+	/* No extension headers */
+	if (seg->ipv6.nexthdr != IPPROTO_TCP) {
+		return false;
+	}
+
+	seg->family = AF_INET6;
+	seg->ip_hdr_len = sizeof(struct net_ipv6_hdr);
+
+	return ntohs(seg->ipv6.len) > sizeof(struct net_tcp_hdr);
+}
+
+static bool tcp_gro_parse(struct net_pkt *pkt, struct tcp_gro_seg *seg)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	size_t ip_len;
+	uint16_t type;
+	bool ret;
+
+	if (!iface || net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return false;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_read(pkt, &seg->eth, sizeof(struct net_eth_hdr))) {
+		return false;
+	}
+
+	if (net_eth_is_addr_multicast(&seg->eth.dst) ||
+	    net_eth_is_addr_broadcast(&seg->eth.dst)) {
+		return false;
+	}
+
+	type = ntohs(seg->eth.type);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && type == NET_ETH_PTYPE_IP) {
+		ret = tcp_gro_parse_ipv4(pkt, seg);
+		ip_len = ret ? ntohs(seg->ipv4.len) : 0;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && type == NET_ETH_PTYPE_IPV6) {
+		ret = tcp_gro_parse_ipv6(pkt, seg);
+		ip_len = ret ? sizeof(struct net_ipv6_hdr) + ntohs(seg->ipv6.len) : 0;
+	} else {
+		ret = false;
+	}
+
+	if (!ret || net_pkt_read(pkt, &seg->tcp, sizeof(struct net_tcp_hdr))) {
+		goto out;
+	}
+
+	/* Only plain data segments without TCP options are merged */
+	if ((seg->tcp.offset >> 4) != sizeof(struct net_tcp_hdr) / 4U ||
+	    (seg->tcp.flags & ~PSH) != ACK) {
+		ret = false;
+		goto out;
+	}
+
+	seg->hdr_len = sizeof(struct net_eth_hdr) + seg->ip_hdr_len +
+		       sizeof(struct net_tcp_hdr);
+
+	if (net_pkt_get_len(pkt) < sizeof(struct net_eth_hdr) + ip_len) {
+		ret = false;
+		goto out;
+	}
+
+	seg->payload_len = ip_len - seg->ip_hdr_len - sizeof(struct net_tcp_hdr);
+	seg->payload_sum = ~tcp_gro_hdr_sum(seg);
+
+out:
+	net_pkt_cursor_init(pkt);
+
+	return ret;
+}
+
+static bool tcp_gro_can_merge(struct net_pkt *pkt, struct tcp_gro_seg *held,
+			      struct net_pkt *next_pkt, struct tcp_gro_seg *next)
+{
+	if (net_pkt_iface(pkt) != net_pkt_iface(next_pkt) ||
+	    held->family != next->family) {
+		return false;
+	}
+
+	/* The merged checksum is derived from the per segment sums, which
+	 * only adds up if every payload but the last one has even length.
+	 */
+	if (held->payload_len % 2) {
+		return false;
+	}
+
+	if (held->payload_len + next->payload_len > CONFIG_NET_TCP_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	if (memcmp(&held->eth, &next->eth, sizeof(struct net_eth_hdr)) != 0) {
+		return false;
+	}
+
+	if (held->family == AF_INET) {
+		if (held->ipv4.tos != next->ipv4.tos ||
+		    held->ipv4.ttl != next->ipv4.ttl ||
+		    memcmp(held->ipv4.src, next->ipv4.src,
+			   2 * NET_IPV4_ADDR_SIZE) != 0) {
+			return false;
+		}
+	} else {
+		if (held->ipv6.vtc != next->ipv6.vtc ||
+		    held->ipv6.tcflow != next->ipv6.tcflow ||
+		    held->ipv6.flow != next->ipv6.flow ||
+		    held->ipv6.hop_limit != next->ipv6.hop_limit ||
+		    memcmp(held->ipv6.src, next->ipv6.src,
+			   2 * NET_IPV6_ADDR_SIZE) != 0) {
+			return false;
+		}
+	}
+
+	if (held->tcp.src_port != next->tcp.src_port ||
+	    held->tcp.dst_port != next->tcp.dst_port) {
+		return false;
+	}
+
+	/* Do not let the merged segment carry an older ACK */
+	if ((int32_t)(sys_get_be32(next->tcp.ack) -
+		      sys_get_be32(held->tcp.ack)) < 0) {
+		return false;
+	}
+
+	/* Next segment must continue exactly where the held one ends */
+	return sys_get_be32(next->tcp.seq) ==
+		sys_get_be32(held->tcp.seq) + held->payload_len;
+}
+
+static int tcp_gro_append(struct net_pkt *pkt, struct tcp_gro_seg *held,
+			  struct net_pkt *next_pkt, struct tcp_gro_seg *next)
+{
+	int ret;
+
+	/* Drop any Ethernet padding after the data */
+	ret = net_pkt_update_length(pkt, held->hdr_len + held->payload_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	net_pkt_cursor_init(next_pkt);
+	net_pkt_set_overwrite(next_pkt, true);
+
+	ret = net_pkt_pull(next_pkt, next->hdr_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_pkt_update_length(next_pkt, next->payload_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	net_pkt_trim_buffer(next_pkt);
+	net_pkt_append_buffer(pkt, next_pkt->buffer);
+	next_pkt->buffer = NULL;
+
+	held->payload_len += next->payload_len;
+	held->payload_sum = tcp_gro_csum_add(held->payload_sum,
+					     next->payload_sum);
+
+	/* The latest segment carries the most recent ACK and window */
+	memcpy(held->tcp.ack, next->tcp.ack, sizeof(held->tcp.ack));
+	memcpy(held->tcp.wnd, next->tcp.wnd, sizeof(held->tcp.wnd));
+	held->tcp.flags |= next->tcp.flags;
+
+	return 0;
+}
+
+/* Rewrite the IP and TCP headers of the merged segment */
+static int tcp_gro_finalize(struct net_pkt *pkt, struct tcp_gro_seg *held)
+{
+	uint16_t ip_len = held->ip_hdr_len + sizeof(struct net_tcp_hdr) +
+			  held->payload_len;
+	uint16_t sum;
+	int ret;
+
+	if (held->family == AF_INET) {
+		held->ipv4.len = htons(ip_len);
+		held->ipv4.chksum = 0U;
+
+		sum = calc_chksum(0, (uint8_t *)&held->ipv4,
+				  sizeof(struct net_ipv4_hdr));
+		sum = (sum == 0U) ? 0xffff : htons(sum);
+		held->ipv4.chksum = ~sum;
+	} else {
+		held->ipv6.len = htons(ip_len - sizeof(struct net_ipv6_hdr));
+	}
+
+	/* The payload was covered by the checksums of the merged segments,
+	 * so the checksum of the merged segment is computed from the
+	 * headers and the expected payload sums only. A corrupted segment
+	 * still makes the checksum verification of the merged one fail.
+	 */
+	held->tcp.chksum = 0U;
+	sum = tcp_gro_csum_add(tcp_gro_hdr_sum(held), held->payload_sum);
+	held->tcp.chksum = htons((uint16_t)~sum);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, sizeof(struct net_eth_hdr));
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_pkt_write(pkt, &held->ipv4, held->ip_hdr_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_pkt_write(pkt, &held->tcp, sizeof(struct net_tcp_hdr));
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, false);
+
+	return ret;
+}
+
+struct net_pkt *net_tcp_gro_receive(struct k_fifo *fifo, struct net_pkt *pkt,
+				    struct k_sem *fifo_slot)
+{
+	struct tcp_gro_seg held;
+	struct tcp_gro_seg next;
+	struct net_pkt *next_pkt;
+	int merged = 0;
+	int ret;
+
+	if (!tcp_gro_parse(pkt, &held)) {
+		return pkt;
+	}
+
+	/* The RX thread is the only consumer of its queue, so the packet at
+	 * the head of the queue cannot change between peek and get.
+	 */
+	while (!(held.tcp.flags & PSH)) {
+		next_pkt = k_fifo_peek_head(fifo);
+		if (!next_pkt || !tcp_gro_parse(next_pkt, &next) ||
+		    !tcp_gro_can_merge(pkt, &held, next_pkt, &next)) {
+			break;
+		}
+
+		(void)k_fifo_get(fifo, K_NO_WAIT);
+
+		if (fifo_slot) {
+			k_sem_give(fifo_slot);
+		}
+
+		ret = tcp_gro_append(pkt, &held, next_pkt, &next);
+
+		net_pkt_unref(next_pkt);
+
+		if (ret < 0) {
+			/* The lengths were validated when parsing so this
+			 * should not happen, the peer retransmits the data.
+			 */
+			NET_DBG("Cannot merge pkt %p (%d)", next_pkt, ret);
+			break;
+		}
+
+		merged++;
+	}
+
+	if (merged > 0) {
+		NET_DBG("Merged %d segments into pkt %p (%u bytes)", merged + 1,
+			pkt, held.payload_len);
+
+		if (tcp_gro_finalize(pkt, &held) < 0) {
+			NET_DBG("Cannot update merged pkt %p", pkt);
+		}
+	}
+
+	return pkt;
+}
@@ -263,6 +263,80 @@ static inline int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 }
 #endif
 
+/**
+ * @typedef net_tcp_gso_cb_t
+ * @brief Callback used to pass segments created by net_tcp_gso_segment()
+ *
+ * @param pkt TCP segment. The callback takes the ownership of the packet.
+ * @param user_data User specified data.
+ *
+ * @return Number of bytes sent on success, negative errno otherwise.
+ */
+typedef int (*net_tcp_gso_cb_t)(struct net_pkt *pkt, void *user_data);
+
+/**
+ * @brief Split a TCP GSO super-segment into MSS sized segments
+ *
+ * @details The super-segment is split into segments carrying at most
+ * net_pkt_gso_size() bytes of payload each. Every segment gets a copy of
+ * the IP and TCP headers with the sequence number, flags, lengths and
+ * checksums updated, and is passed to the given callback. The
+ * super-segment itself is not modified. If a segment cannot be created
+ * or the callback fails, the remaining segments are not sent. The
+ * segments already passed to the callback are counted as sent, so a
+ * partial transmission is reported as success.
+ *
+ * @param pkt Network packet containing the super-segment
+ * @param cb Callback to call for each segment
+ * @param user_data User specified data passed to the callback
+ *
+ * @return Total number of bytes sent by the callback, negative errno if
+ *         no segment could be sent.
+ */
+#if defined(CONFIG_NET_NATIVE_TCP) && defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data);
+#else
+static inline int net_tcp_gso_segment(struct net_pkt *pkt,
+				      net_tcp_gso_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Merge queued in-order TCP segments of the same flow (GRO)
+ *
+ * @details The function is called by the RX traffic class thread for each
+ * packet taken from its queue. If the packet is a TCP segment that can be
+ * merged, the following packets at the head of the queue that continue
+ * the same flow are dequeued and their payload is appended to the packet.
+ *
+ * @param fifo RX queue the packet was taken from
+ * @param pkt Network packet taken from the queue
+ * @param fifo_slot Semaphore to give for each dequeued packet, can be NULL
+ *
+ * @return Packet to process, this is always the packet given as parameter.
+ */
+#if defined(CONFIG_NET_NATIVE_TCP) && defined(CONFIG_NET_TCP_GRO)
+struct net_pkt *net_tcp_gro_receive(struct k_fifo *fifo, struct net_pkt *pkt,
+				    struct k_sem *fifo_slot);
+#else
+static inline struct net_pkt *net_tcp_gro_receive(struct k_fifo *fifo,
+						  struct net_pkt *pkt,
+						  struct k_sem *fifo_slot)
+{
+	ARG_UNUSED(fifo);
+	ARG_UNUSED(fifo_slot);
+
+	return pkt;
+}
+#endif
+
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
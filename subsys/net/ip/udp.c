@@ -69,6 +69,12 @@ struct net_udp_hdr *net_udp_get_hdr(struct net_pkt *pkt,
 	struct net_udp_hdr *udp_hdr;
 	bool overwrite;
 
+	/* Common case, the header sits in the first buffer */
+	udp_hdr = net_pkt_udp_hdr(pkt);
+	if (udp_hdr) {
+		return udp_hdr;
+	}
+
 	udp_access.data = hdr;
 
 	overwrite = net_pkt_is_being_overwritten(pkt);
@@ -100,6 +106,16 @@ struct net_udp_hdr *net_udp_set_hdr(struct net_pkt *pkt,
 	struct net_udp_hdr *udp_hdr;
 	bool overwrite;
 
+	udp_hdr = net_pkt_udp_hdr(pkt);
+	if (udp_hdr) {
+		/* The caller may pass back the pointer from net_udp_get_hdr() */
+		if (udp_hdr != hdr) {
+			memcpy(udp_hdr, hdr, sizeof(struct net_udp_hdr));
+		}
+
+		return hdr;
+	}
+
 	overwrite = net_pkt_is_being_overwritten(pkt);
 	net_pkt_set_overwrite(pkt, true);
 
@@ -28,9 +28,21 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
-static sys_slist_t arp_free_entries;
-static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+static sys_dlist_t arp_free_entries;
+static sys_dlist_t arp_pending_entries;
+static sys_dlist_t arp_table;
+
+#if defined(CONFIG_NET_ARP_TABLE_HASH)
+#define ARP_HASH_SIZE CONFIG_NET_ARP_TABLE_SIZE
+
+/* Entries of arp_table, chained by the hash of their IPv4 address */
+static sys_slist_t arp_hash[ARP_HASH_SIZE];
+#endif
+
+/* Incremented whenever an entry leaves arp_table, so that entries cached
+ * by the net_context users can be validated.
+ */
+static uint32_t arp_table_gen = 1U;
 
 static struct k_work_delayable arp_request_timer;
 
@@ -64,14 +76,13 @@ static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
 }
 
-static struct arp_entry *arp_entry_find(sys_slist_t *list,
+static struct arp_entry *arp_entry_find(sys_dlist_t *list,
 					struct net_if *iface,
-					struct in_addr *dst,
-					sys_snode_t **previous)
+					struct in_addr *dst)
 {
 	struct arp_entry *entry;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(list, entry, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER(list, entry, node) {
 		NET_DBG("iface %d (%p) dst %s",
 			net_if_get_by_iface(iface), iface,
 			net_sprint_ipv4_addr(&entry->ip));
@@ -83,34 +94,126 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 
 			return entry;
 		}
+	}
+
+	return NULL;
+}
 
-		if (previous) {
-			*previous = &entry->node;
+#if defined(CONFIG_NET_ARP_TABLE_HASH)
+static inline sys_slist_t *arp_hash_bucket(struct in_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s_addr);
+
+	return &arp_hash[((hash * 0x9e3779b1U) >> 16) % ARP_HASH_SIZE];
+}
+
+static struct arp_entry *arp_table_lookup(struct net_if *iface,
+					  struct in_addr *dst)
+{
+	struct arp_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(arp_hash_bucket(dst), entry, hash_node) {
+		if (entry->iface == iface &&
+		    net_ipv4_addr_cmp(&entry->ip, dst)) {
+			return entry;
 		}
 	}
 
 	return NULL;
 }
+#else
+static inline struct arp_entry *arp_table_lookup(struct net_if *iface,
+						 struct in_addr *dst)
+{
+	return arp_entry_find(&arp_table, iface, dst);
+}
+#endif /* CONFIG_NET_ARP_TABLE_HASH */
+
+static void arp_table_add(struct arp_entry *entry)
+{
+	sys_dlist_prepend(&arp_table, &entry->node);
+
+	IF_ENABLED(CONFIG_NET_ARP_TABLE_HASH,
+		   (sys_slist_prepend(arp_hash_bucket(&entry->ip),
+				      &entry->hash_node);))
+}
 
-static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
+static void arp_table_remove(struct arp_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+
+	IF_ENABLED(CONFIG_NET_ARP_TABLE_HASH,
+		   (sys_slist_find_and_remove(arp_hash_bucket(&entry->ip),
+					      &entry->hash_node);))
+
+	arp_table_gen++;
+}
+
+#if defined(CONFIG_NET_CONTEXT_NBR_CACHE)
+/* Entry used for the previous packet of the same net_context, valid only
+ * if arp_table has not lost any entry since then.
+ */
+static struct arp_entry *arp_entry_from_context(struct net_context *ctx,
+						struct net_if *iface,
+						struct in_addr *dst)
+{
+	struct arp_entry *entry;
+
+	if (ctx == NULL || ctx->nbr_cache_gen != arp_table_gen) {
+		return NULL;
+	}
+
+	/* The context may also have cached an IPv6 neighbor, so make sure
+	 * this is one of our entries.
+	 */
+	entry = ctx->nbr_cache;
+	if (entry < arp_entries || entry >= &arp_entries[ARRAY_SIZE(arp_entries)] ||
+	    entry->iface != iface || !net_ipv4_addr_cmp(&entry->ip, dst)) {
+		return NULL;
+	}
+
+	return entry;
+}
+
+static inline void arp_entry_to_context(struct net_context *ctx,
+					struct arp_entry *entry)
+{
+	if (ctx != NULL) {
+		ctx->nbr_cache = entry;
+		ctx->nbr_cache_gen = arp_table_gen;
+	}
+}
+#else
+#define arp_entry_from_context(ctx, iface, dst) NULL
+#define arp_entry_to_context(ctx, entry)
+#endif /* CONFIG_NET_CONTEXT_NBR_CACHE */
+
+static inline struct arp_entry *arp_entry_find_move_first(struct net_pkt *pkt,
 							  struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
+	struct net_if *iface = net_pkt_iface(pkt);
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", net_sprint_ipv4_addr(dst));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
-	if (entry) {
-		/* Let's assume the target is going to be accessed
-		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
-		 * in order to reduce subsequent find.
-		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
+	entry = arp_entry_from_context(net_pkt_context(pkt), iface, dst);
+	if (entry == NULL) {
+		entry = arp_table_lookup(iface, dst);
+		if (entry == NULL) {
+			return NULL;
 		}
+
+		arp_entry_to_context(net_pkt_context(pkt), entry);
+	}
+
+	/* Let's assume the target is going to be accessed
+	 * more than once here in a short time frame. So we
+	 * place the entry first in position into the table
+	 * so that it is the last one to be recycled.
+	 */
+	if (!sys_dlist_is_head(&arp_table, &entry->node)) {
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&arp_table, &entry->node);
 	}
 
 	return entry;
@@ -122,24 +225,23 @@ struct arp_entry *arp_entry_find_pending(struct net_if *iface,
 {
 	NET_DBG("dst %s", net_sprint_ipv4_addr(dst));
 
-	return arp_entry_find(&arp_pending_entries, iface, dst, NULL);
+	return arp_entry_find(&arp_pending_entries, iface, dst);
 }
 
 static struct arp_entry *arp_entry_get_pending(struct net_if *iface,
 					       struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", net_sprint_ipv4_addr(dst));
 
-	entry = arp_entry_find(&arp_pending_entries, iface, dst, &prev);
+	entry = arp_entry_find(&arp_pending_entries, iface, dst);
 	if (entry) {
 		/* We remove the entry from the pending list */
-		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
+		sys_dlist_remove(&entry->node);
 	}
 
-	if (sys_slist_is_empty(&arp_pending_entries)) {
+	if (sys_dlist_is_empty(&arp_pending_entries)) {
 		k_work_cancel_delayable(&arp_request_timer);
 	}
 
@@ -148,35 +250,35 @@ static struct arp_entry *arp_entry_get_pending(struct net_if *iface,
 
 static struct arp_entry *arp_entry_get_free(void)
 {
-	sys_snode_t *node;
+	sys_dnode_t *node;
 
-	node = sys_slist_peek_head(&arp_free_entries);
+	/* We remove the node from the free list */
+	node = sys_dlist_get(&arp_free_entries);
 	if (!node) {
 		return NULL;
 	}
 
-	/* We remove the node from the free list */
-	sys_slist_remove(&arp_free_entries, NULL, node);
-
 	return CONTAINER_OF(node, struct arp_entry, node);
 }
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	sys_dnode_t *node;
+	struct arp_entry *entry;
 
 	/* We assume last entry is the oldest one,
 	 * so is the preferred one to be taken out.
 	 */
 
-	node = sys_slist_peek_tail(&arp_table);
+	node = sys_dlist_peek_tail(&arp_table);
 	if (!node) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	entry = CONTAINER_OF(node, struct arp_entry, node);
+	arp_table_remove(entry);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return entry;
 }
 
 
@@ -184,7 +286,7 @@ static void arp_entry_register_pending(struct arp_entry *entry)
 {
 	NET_DBG("dst %s", net_sprint_ipv4_addr(&entry->ip));
 
-	sys_slist_append(&arp_pending_entries, &entry->node);
+	sys_dlist_append(&arp_pending_entries, &entry->node);
 
 	entry->req_start = k_uptime_get_32();
 
@@ -204,7 +306,7 @@ static void arp_request_timeout(struct k_work *work)
 
 	k_mutex_lock(&arp_mutex, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
 					  entry, next, node) {
 		if ((int32_t)(entry->req_start +
 			    ARP_REQUEST_TIMEOUT - current) > 0) {
@@ -213,8 +315,8 @@ static void arp_request_timeout(struct k_work *work)
 
 		arp_entry_cleanup(entry, true);
 
-		sys_slist_remove(&arp_pending_entries, NULL, &entry->node);
-		sys_slist_append(&arp_free_entries, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_append(&arp_free_entries, &entry->node);
 
 		entry = NULL;
 	}
@@ -407,7 +509,7 @@ int net_arp_prepare(struct net_pkt *pkt,
 	/* If the destination address is already known, we do not need
 	 * to send any ARP packet.
 	 */
-	entry = arp_entry_find_move_first(net_pkt_iface(pkt), addr);
+	entry = arp_entry_find_move_first(pkt, addr);
 	if (!entry) {
 		struct net_pkt *req;
 
@@ -454,7 +556,7 @@ int net_arp_prepare(struct net_pkt *pkt,
 			/* Add the arp entry back to arp_free_entries, to avoid the
 			 * arp entry is leak due to ARP packet allocated failed.
 			 */
-			sys_slist_prepend(&arp_free_entries, &entry->node);
+			sys_dlist_prepend(&arp_free_entries, &entry->node);
 		}
 
 		k_mutex_unlock(&arp_mutex);
@@ -483,10 +585,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_table_lookup(iface, src);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			net_sprint_ll_addr((const uint8_t *)&entry->eth,
@@ -660,10 +761,9 @@ void net_arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *arp_ent;
 
-			arp_ent = arp_entry_find(&arp_table, iface, src, &prev);
+			arp_ent = arp_table_lookup(iface, src);
 			if (arp_ent) {
 				memcpy(&arp_ent->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
@@ -682,7 +782,7 @@ void net_arp_update(struct net_if *iface,
 					arp_ent->iface = iface;
 					net_ipaddr_copy(&arp_ent->ip, src);
 					memcpy(&arp_ent->eth, hwaddr, sizeof(arp_ent->eth));
-					sys_slist_prepend(&arp_table, &arp_ent->node);
+					arp_table_add(arp_ent);
 				}
 			}
 		}
@@ -695,7 +795,7 @@ void net_arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_table_add(entry);
 
 	while (!k_fifo_is_empty(&entry->pending_queue)) {
 		int ret;
@@ -917,43 +1017,38 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 void net_arp_clear_cache(struct net_if *iface)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry, *next;
 
 	NET_DBG("Flushing ARP table");
 
 	k_mutex_lock(&arp_mutex, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
 		if (iface && iface != entry->iface) {
-			prev = &entry->node;
 			continue;
 		}
 
+		arp_table_remove(entry);
 		arp_entry_cleanup(entry, false);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+		sys_dlist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	prev = NULL;
-
 	NET_DBG("Flushing ARP pending requests");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
 					  entry, next, node) {
 		if (iface && iface != entry->iface) {
-			prev = &entry->node;
 			continue;
 		}
 
 		arp_entry_cleanup(entry, true);
 
-		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	if (sys_slist_is_empty(&arp_pending_entries)) {
+	if (sys_dlist_is_empty(&arp_pending_entries)) {
 		k_work_cancel_delayable(&arp_request_timer);
 	}
 
@@ -980,7 +1075,7 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 
 	k_mutex_lock(&arp_mutex, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
 		ret++;
 		cb(entry, user_data);
 	}
@@ -998,14 +1093,15 @@ void net_arp_init(void)
 		return;
 	}
 
-	sys_slist_init(&arp_free_entries);
-	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+	sys_dlist_init(&arp_free_entries);
+	sys_dlist_init(&arp_pending_entries);
+	sys_dlist_init(&arp_table);
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free with initialised packet queue */
 		k_fifo_init(&arp_entries[i].pending_queue);
-		sys_slist_prepend(&arp_free_entries, &arp_entries[i].node);
+		sys_dnode_init(&arp_entries[i].node);
+		sys_dlist_prepend(&arp_free_entries, &arp_entries[i].node);
 	}
 
 	k_work_init_delayable(&arp_request_timer, arp_request_timeout);
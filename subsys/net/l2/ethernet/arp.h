@@ -7,6 +7,7 @@
 #ifndef __ARP_H
 #define __ARP_H
 
+#include <zephyr/sys/dlist.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/net/ethernet.h>
 
@@ -75,7 +76,10 @@ int net_arp_clear_pending(struct net_if *iface,
 				struct in_addr *dst);
 
 struct arp_entry {
-	sys_snode_t node;
+	sys_dnode_t node;
+#if defined(CONFIG_NET_ARP_TABLE_HASH)
+	sys_snode_t hash_node;
+#endif
 	uint32_t req_start;
 	struct net_if *iface;
 	struct in_addr ip;
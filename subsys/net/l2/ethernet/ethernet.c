@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "ipv6.h"
 #include "ipv4.h"
 #include "bridge.h"
+#include "tcp_internal.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
@@ -682,6 +683,32 @@ static void ethernet_update_tx_stats(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_TCP_GSO)
+static int ethernet_gso_send(struct net_pkt *pkt, void *user_data)
+{
+	struct net_if *iface = user_data;
+	int ret;
+
+	ret = ethernet_send(iface, pkt);
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static bool ethernet_needs_gso(struct net_if *iface, struct net_pkt *pkt)
+{
+	return net_pkt_gso_size(pkt) > 0U &&
+		!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TSO);
+}
+#else
+#define ethernet_gso_send NULL
+#define ethernet_needs_gso(...) false
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->api;
@@ -700,6 +727,19 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		goto error;
 	}
 
+	/* TCP GSO super-segment that the device cannot segment itself is
+	 * split here and each segment is sent separately.
+	 */
+	if (ethernet_needs_gso(iface, pkt)) {
+		ret = net_tcp_gso_segment(pkt, ethernet_gso_send, iface);
+		if (ret < 0) {
+			goto error;
+		}
+
+		net_pkt_unref(pkt);
+		return ret;
+	}
+
 	/* We are trying to send a packet that is from bridge interface,
 	 * so all the bits and pieces should be there (like Ethernet header etc)
 	 * so just send it.
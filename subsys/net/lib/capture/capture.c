@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
 #include "ipv6.h"
 #include "udp_internal.h"
 #include "net_stats.h"
+#include "capture_internal.h"
 
 #define PKT_ALLOC_TIME K_MSEC(50)
 #define DEFAULT_PORT 4242
@@ -510,6 +511,86 @@ static int capture_disable(const struct device *dev)
 	return 0;
 }
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+static int capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_capture *ctx;
+	bool tunnel = false;
+
+	/* The device list is only modified when the capture devices are
+	 * initialized so it can be walked here without taking the lock.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&net_capture_devlist, ctx, node) {
+		if (ctx->in_use && ctx->is_enabled &&
+		    ctx->capture_iface == iface) {
+			tunnel = true;
+			break;
+		}
+	}
+
+	if (!tunnel && !net_capture_ring_is_sink_iface(iface)) {
+		return -ENOENT;
+	}
+
+	return net_capture_ring_put(iface, pkt, tunnel);
+}
+
+int net_capture_ring_tunnel(struct net_if *iface, const uint8_t *data,
+			    size_t len)
+{
+	struct net_pkt *captured;
+	struct net_buf *buf;
+	sys_snode_t *sn, *sns;
+	int ret = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_NODE_SAFE(&net_capture_devlist, sn, sns) {
+		struct net_capture *ctx = CONTAINER_OF(sn, struct net_capture,
+						       node);
+
+		if (!ctx->in_use || !ctx->is_enabled ||
+		    ctx->capture_iface != iface) {
+			continue;
+		}
+
+		captured = net_pkt_alloc_from_slab(get_net_pkt(), PKT_ALLOC_TIME);
+		if (captured == NULL) {
+			ret = -ENOMEM;
+			continue;
+		}
+
+		buf = net_buf_alloc_len(get_net_buf(), len, PKT_ALLOC_TIME);
+		if (buf == NULL) {
+			net_pkt_unref(captured);
+			ret = -ENOMEM;
+			continue;
+		}
+
+		net_pkt_append_buffer(captured, buf);
+
+		if (net_buf_append_bytes(buf, len, data, PKT_ALLOC_TIME,
+					 NULL, NULL) != len) {
+			net_pkt_unref(captured);
+			ret = -ENOMEM;
+			continue;
+		}
+
+		net_pkt_set_orig_iface(captured, iface);
+		net_pkt_set_iface(captured, ctx->tunnel_iface);
+
+		ret = net_capture_send(ctx->dev, ctx->tunnel_iface, captured);
+		if (ret < 0) {
+			net_pkt_unref(captured);
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_CAPTURE_RING */
+
 int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct k_mem_slab *orig_slab;
@@ -525,6 +606,18 @@ int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 		return -EALREADY;
 	}
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+	/* Cooked mode packets are already copies so send them directly */
+	if (!net_pkt_is_cooked_mode(pkt)) {
+		ret = capture_ring_pkt(iface, pkt);
+		if (ret == 0) {
+			net_pkt_set_captured(pkt, true);
+		}
+
+		return ret;
+	}
+#endif
+
 	k_mutex_lock(&lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_NODE_SAFE(&net_capture_devlist, sn, sns) {
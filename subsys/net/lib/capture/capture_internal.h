@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_CAPTURE_INTERNAL_H
+#define __NET_CAPTURE_INTERNAL_H
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+/* Is there a pcapng sink interested in packets of this interface */
+bool net_capture_ring_is_sink_iface(struct net_if *iface);
+
+/* Copy the beginning of the packet into the capture ring. If tunnel is
+ * set, the consumer thread will also pass the data to the capture devices
+ * that are enabled for the interface. Can be called from any context.
+ */
+int net_capture_ring_put(struct net_if *iface, struct net_pkt *pkt,
+			 bool tunnel);
+
+/* Called from the ring consumer thread to send captured data to all the
+ * capture devices that are enabled for the given interface.
+ */
+int net_capture_ring_tunnel(struct net_if *iface, const uint8_t *data,
+			    size_t len);
+#endif
+
+#endif /* __NET_CAPTURE_INTERNAL_H */
@@ -0,0 +1,419 @@
+/** @file
+ * @brief Lock-free network packet capture ring
+ *
+ * The RX/TX capture hooks copy the beginning of the packet into a
+ * pre-allocated ring without allocating memory. Slots are reserved without
+ * locks, the consumer thread is only signaled when a packet is put into an
+ * empty ring. It drains the ring to the capture tunnel and to a pcapng sink.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/capture.h>
+
+#include "capture_internal.h"
+
+#define RING_SLOTS CONFIG_NET_CAPTURE_RING_SLOTS
+#define RING_MASK (RING_SLOTS - 1)
+#define SNAPLEN CONFIG_NET_CAPTURE_RING_SNAPLEN
+
+BUILD_ASSERT((RING_SLOTS & RING_MASK) == 0,
+	     "CONFIG_NET_CAPTURE_RING_SLOTS must be a power of two");
+
+/* Slot flags */
+#define SLOT_OUTBOUND BIT(0)
+#define SLOT_TUNNEL   BIT(1)
+#define SLOT_SINK     BIT(2)
+
+/* pcapng block types and link types */
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_EPB_FLAGS 2
+#define PCAPNG_EPB_FLAG_INBOUND 1
+#define PCAPNG_EPB_FLAG_OUTBOUND 2
+
+#define LINKTYPE_ETHERNET 1
+#define LINKTYPE_RAW 101
+#define LINKTYPE_IEEE802_15_4_NOFCS 230
+
+#define SHB_LEN 28
+#define IDB_LEN 20
+/* Fixed part of EPB, the epb_flags option, opt_endofopt and the trailing
+ * block length.
+ */
+#define EPB_HDR_LEN 28
+#define EPB_TRAILER_LEN (8 + 4 + 4)
+
+struct capture_slot {
+	/* Sequence number of the slot minus the slot index, so that a zero
+	 * initialized ring is ready to use. The producer owns the slot when
+	 * the sequence equals the ring position, the consumer when it equals
+	 * position + 1.
+	 */
+	atomic_t seq;
+	uint64_t timestamp;
+	uint32_t orig_len;
+	uint16_t caplen;
+	uint8_t iface;
+	uint8_t flags;
+	uint8_t data[SNAPLEN];
+};
+
+static struct capture_slot ring[RING_SLOTS];
+static atomic_t ring_head;
+static atomic_t ring_tail;
+
+static atomic_t captured;
+static atomic_t truncated;
+static atomic_t dropped;
+static atomic_t sink_errors;
+
+static K_SEM_DEFINE(ring_sem, 0, 1);
+
+/* The sink is only used by the consumer thread. The lock protects it
+ * against net_capture_ring_start() and net_capture_ring_stop().
+ */
+static K_MUTEX_DEFINE(sink_lock);
+static net_capture_ring_sink_t ring_sink;
+static void *ring_sink_user_data;
+static struct net_if *ring_sink_iface;
+static atomic_t sink_active;
+static bool header_pending;
+
+/* Big enough for one enhanced packet block */
+static uint8_t block_buf[EPB_HDR_LEN + ROUND_UP(SNAPLEN, 4) + EPB_TRAILER_LEN];
+
+static inline uint32_t slot_seq(uint32_t pos)
+{
+	return (uint32_t)atomic_get(&ring[pos & RING_MASK].seq) + (pos & RING_MASK);
+}
+
+static inline void slot_seq_set(uint32_t pos, uint32_t seq)
+{
+	(void)atomic_set(&ring[pos & RING_MASK].seq, seq - (pos & RING_MASK));
+}
+
+static bool pkt_is_outbound(struct net_pkt *pkt)
+{
+	struct k_mem_slab *rx;
+
+	net_pkt_get_info(&rx, NULL, NULL, NULL);
+
+	return pkt->slab != rx;
+}
+
+bool net_capture_ring_is_sink_iface(struct net_if *iface)
+{
+	if (!atomic_get(&sink_active)) {
+		return false;
+	}
+
+	return ring_sink_iface == NULL || ring_sink_iface == iface;
+}
+
+int net_capture_ring_put(struct net_if *iface, struct net_pkt *pkt,
+			 bool tunnel)
+{
+	struct capture_slot *slot;
+	size_t len;
+	uint32_t pos;
+	int32_t diff;
+
+	pos = (uint32_t)atomic_get(&ring_head);
+
+	while (true) {
+		diff = (int32_t)(slot_seq(pos) - pos);
+		if (diff == 0) {
+			if (atomic_cas(&ring_head, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* The consumer has not yet released the slot */
+			atomic_inc(&dropped);
+			return -ENOBUFS;
+		}
+
+		pos = (uint32_t)atomic_get(&ring_head);
+	}
+
+	slot = &ring[pos & RING_MASK];
+
+	len = net_pkt_get_len(pkt);
+
+	slot->timestamp = k_ticks_to_us_floor64(k_uptime_ticks());
+	slot->orig_len = len;
+	slot->caplen = net_buf_linearize(slot->data, sizeof(slot->data),
+					 pkt->buffer, 0, MIN(len, SNAPLEN));
+	slot->iface = net_if_get_by_iface(iface);
+	slot->flags = (pkt_is_outbound(pkt) ? SLOT_OUTBOUND : 0) |
+		      (tunnel ? SLOT_TUNNEL : 0) |
+		      (net_capture_ring_is_sink_iface(iface) ? SLOT_SINK : 0);
+
+	if (len > SNAPLEN) {
+		atomic_inc(&truncated);
+	}
+
+	atomic_inc(&captured);
+
+	/* Hand the slot over to the consumer */
+	slot_seq_set(pos, pos + 1);
+
+	/* The consumer is either busy draining the ring or waiting for this
+	 * slot. Only wake it up in the latter case, it checks the next slot
+	 * after releasing the previous one so no wake up is lost.
+	 */
+	if ((uint32_t)atomic_get(&ring_tail) == pos) {
+		k_sem_give(&ring_sem);
+	}
+
+	return 0;
+}
+
+static void put_u16(uint8_t **ptr, uint16_t val)
+{
+	memcpy(*ptr, &val, sizeof(val));
+	*ptr += sizeof(val);
+}
+
+static void put_u32(uint8_t **ptr, uint32_t val)
+{
+	memcpy(*ptr, &val, sizeof(val));
+	*ptr += sizeof(val);
+}
+
+static int sink_write(const uint8_t *data, size_t len)
+{
+	int ret;
+
+	ret = ring_sink(data, len, ring_sink_user_data);
+	if (ret < 0) {
+		NET_DBG("Sink write failed (%d)", ret);
+		atomic_inc(&sink_errors);
+	}
+
+	return ret;
+}
+
+static uint16_t pcapng_link_type(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return LINKTYPE_ETHERNET;
+	}
+#endif
+#if defined(CONFIG_NET_L2_IEEE802154)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(IEEE802154)) {
+		return LINKTYPE_IEEE802_15_4_NOFCS;
+	}
+#endif
+
+	return LINKTYPE_RAW;
+}
+
+/* Write the section header block and one interface description block for
+ * every network interface. The pcapng interface id is the network interface
+ * index minus one.
+ */
+static void pcapng_write_header(void)
+{
+	uint8_t *ptr = block_buf;
+
+	put_u32(&ptr, PCAPNG_SHB);
+	put_u32(&ptr, SHB_LEN);
+	put_u32(&ptr, PCAPNG_BYTE_ORDER_MAGIC);
+	put_u16(&ptr, 1U);
+	put_u16(&ptr, 0U);
+	/* Section length is not known */
+	put_u32(&ptr, UINT32_MAX);
+	put_u32(&ptr, UINT32_MAX);
+	put_u32(&ptr, SHB_LEN);
+
+	if (sink_write(block_buf, ptr - block_buf) < 0) {
+		return;
+	}
+
+	STRUCT_SECTION_FOREACH(net_if, iface) {
+		ptr = block_buf;
+
+		put_u32(&ptr, PCAPNG_IDB);
+		put_u32(&ptr, IDB_LEN);
+		put_u16(&ptr, pcapng_link_type(iface));
+		put_u16(&ptr, 0U);
+		put_u32(&ptr, SNAPLEN);
+		put_u32(&ptr, IDB_LEN);
+
+		if (sink_write(block_buf, ptr - block_buf) < 0) {
+			return;
+		}
+	}
+}
+
+static void pcapng_write_packet(struct capture_slot *slot)
+{
+	uint32_t padded = ROUND_UP(slot->caplen, 4);
+	uint32_t block_len = EPB_HDR_LEN + padded + EPB_TRAILER_LEN;
+	uint8_t *ptr = block_buf;
+
+	put_u32(&ptr, PCAPNG_EPB);
+	put_u32(&ptr, block_len);
+	put_u32(&ptr, slot->iface - 1U);
+	put_u32(&ptr, (uint32_t)(slot->timestamp >> 32));
+	put_u32(&ptr, (uint32_t)slot->timestamp);
+	put_u32(&ptr, slot->caplen);
+	put_u32(&ptr, slot->orig_len);
+
+	memcpy(ptr, slot->data, slot->caplen);
+	memset(ptr + slot->caplen, 0, padded - slot->caplen);
+	ptr += padded;
+
+	put_u16(&ptr, PCAPNG_OPT_EPB_FLAGS);
+	put_u16(&ptr, sizeof(uint32_t));
+	put_u32(&ptr, (slot->flags & SLOT_OUTBOUND) ?
+		PCAPNG_EPB_FLAG_OUTBOUND : PCAPNG_EPB_FLAG_INBOUND);
+	/* opt_endofopt */
+	put_u32(&ptr, 0U);
+	put_u32(&ptr, block_len);
+
+	(void)sink_write(block_buf, ptr - block_buf);
+}
+
+static void ring_process(struct capture_slot *slot)
+{
+	struct net_if *iface;
+	int ret;
+
+	iface = net_if_get_by_index(slot->iface);
+	if (iface == NULL) {
+		return;
+	}
+
+	if (slot->flags & SLOT_TUNNEL) {
+		ret = net_capture_ring_tunnel(iface, slot->data, slot->caplen);
+		if (ret < 0) {
+			NET_DBG("Captured pkt %s (%d)", "dropped", ret);
+			atomic_inc(&sink_errors);
+		}
+	}
+
+	if (slot->flags & SLOT_SINK) {
+		k_mutex_lock(&sink_lock, K_FOREVER);
+
+		if (ring_sink != NULL && !header_pending) {
+			pcapng_write_packet(slot);
+		}
+
+		k_mutex_unlock(&sink_lock);
+	}
+}
+
+static void ring_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t tail;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_mutex_lock(&sink_lock, K_FOREVER);
+
+		if (header_pending && ring_sink != NULL) {
+			header_pending = false;
+			pcapng_write_header();
+		}
+
+		k_mutex_unlock(&sink_lock);
+
+		tail = (uint32_t)atomic_get(&ring_tail);
+
+		while ((int32_t)(slot_seq(tail) - (tail + 1)) == 0) {
+			ring_process(&ring[tail & RING_MASK]);
+
+			/* Release the slot for the next round */
+			slot_seq_set(tail, tail + RING_SLOTS);
+			tail++;
+			(void)atomic_set(&ring_tail, (atomic_val_t)tail);
+		}
+
+		k_sem_take(&ring_sem, K_FOREVER);
+	}
+}
+
+K_THREAD_DEFINE(net_capture_ring_thread, CONFIG_NET_CAPTURE_RING_STACK_SIZE,
+		ring_consumer, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(CONFIG_NET_CAPTURE_RING_THREAD_PRIORITY), 0, 0);
+
+int net_capture_ring_start(struct net_if *iface, net_capture_ring_sink_t sink,
+			   void *user_data)
+{
+	if (sink == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sink_lock, K_FOREVER);
+
+	if (ring_sink != NULL) {
+		k_mutex_unlock(&sink_lock);
+		return -EALREADY;
+	}
+
+	ring_sink = sink;
+	ring_sink_user_data = user_data;
+	ring_sink_iface = iface;
+	header_pending = true;
+
+	(void)atomic_set(&sink_active, 1);
+
+	k_mutex_unlock(&sink_lock);
+
+	/* Let the consumer write the pcapng header right away */
+	k_sem_give(&ring_sem);
+
+	return 0;
+}
+
+int net_capture_ring_stop(void)
+{
+	k_mutex_lock(&sink_lock, K_FOREVER);
+
+	if (ring_sink == NULL) {
+		k_mutex_unlock(&sink_lock);
+		return -EALREADY;
+	}
+
+	(void)atomic_set(&sink_active, 0);
+
+	ring_sink = NULL;
+	ring_sink_user_data = NULL;
+	ring_sink_iface = NULL;
+	header_pending = false;
+
+	k_mutex_unlock(&sink_lock);
+
+	return 0;
+}
+
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	stats->captured = (uint32_t)atomic_get(&captured);
+	stats->truncated = (uint32_t)atomic_get(&truncated);
+	stats->dropped = (uint32_t)atomic_get(&dropped);
+	stats->sink_errors = (uint32_t)atomic_get(&sink_errors);
+}
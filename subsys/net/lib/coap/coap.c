@@ -51,8 +51,6 @@ LOG_MODULE_REGISTER(net_coap, CONFIG_COAP_LOG_LEVEL);
 
 #define BASIC_HEADER_SIZE	4
 
-#define COAP_OBSERVE_FIRST_OFFSET 2
-
 /* The CoAP message ID that is incremented each time coap_next_id() is called. */
 static uint16_t message_id;
 
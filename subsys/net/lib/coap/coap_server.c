@@ -16,6 +16,7 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #include <zephyr/net/coap_link_format.h>
 #include <zephyr/net/coap_mgmt.h>
 #include <zephyr/net/coap_service.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/zvfs/eventfd.h>
 
@@ -35,8 +36,15 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #define MAX_PENDINGS   CONFIG_COAP_SERVICE_PENDING_MESSAGES
 #define MAX_OBSERVERS  CONFIG_COAP_SERVICE_OBSERVERS
 #define MAX_POLL_FD    CONFIG_ZVFS_POLL_MAX
+#define OBSERVER_HASH  CONFIG_COAP_SERVICE_OBSERVER_HASH_SIZE
+#define RESOURCE_HASH  CONFIG_COAP_SERVICE_RESOURCE_HASH_SIZE
+
+#define HEADER_SIZE    4U
 
 BUILD_ASSERT(CONFIG_ZVFS_POLL_MAX > 0, "CONFIG_ZVFS_POLL_MAX can't be 0");
+BUILD_ASSERT(MAX_OBSERVERS < UINT16_MAX, "Observer index doesn't fit the hash tables");
+BUILD_ASSERT(CONFIG_COAP_SERVER_MESSAGE_SIZE > HEADER_SIZE + COAP_TOKEN_MAX_LEN,
+	     "CONFIG_COAP_SERVER_MESSAGE_SIZE too small for notifications");
 
 static K_MUTEX_DEFINE(lock);
 static int control_sock;
@@ -82,6 +90,251 @@ static inline void coap_server_free(void *ptr)
 #endif
 }
 
+#if OBSERVER_HASH > 0 || RESOURCE_HASH > 0
+/* FNV-1a, chained over the segments of a path */
+#define HASH_INIT 2166136261U
+
+static uint32_t coap_server_hash(uint32_t hash, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash ^= data[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+#endif
+
+#if OBSERVER_HASH > 0
+static uint16_t *observer_bucket(const struct coap_service *service,
+				 const uint8_t *token, uint8_t tkl)
+{
+	uint32_t hash = coap_server_hash(HASH_INIT, token, tkl);
+
+	return &service->data->observer_buckets[hash % OBSERVER_HASH];
+}
+
+static void coap_service_index_observer(const struct coap_service *service,
+					struct coap_observer *obs)
+{
+	uint16_t *bucket = observer_bucket(service, obs->token, obs->tkl);
+	size_t idx = obs - service->data->observers;
+
+	service->data->observer_next[idx] = *bucket;
+	*bucket = idx + 1;
+}
+
+static void coap_service_unindex_observer(const struct coap_service *service,
+					  struct coap_observer *obs)
+{
+	uint16_t *entry = observer_bucket(service, obs->token, obs->tkl);
+	uint16_t idx = obs - service->data->observers + 1;
+
+	while (*entry != 0) {
+		if (*entry == idx) {
+			*entry = service->data->observer_next[idx - 1];
+			service->data->observer_next[idx - 1] = 0;
+			return;
+		}
+
+		entry = &service->data->observer_next[*entry - 1];
+	}
+}
+
+static struct coap_observer *coap_service_find_observer(const struct coap_service *service,
+							const struct sockaddr *addr,
+							const uint8_t *token, uint8_t tkl)
+{
+	uint16_t idx;
+
+	if (tkl == 0U || tkl > COAP_TOKEN_MAX_LEN) {
+		return NULL;
+	}
+
+	for (idx = *observer_bucket(service, token, tkl); idx != 0;
+	     idx = service->data->observer_next[idx - 1]) {
+		struct coap_observer *obs = &service->data->observers[idx - 1];
+
+		/* Reuse the library matching on the single candidate */
+		if (addr != NULL) {
+			obs = coap_find_observer(obs, 1, addr, token, tkl);
+		} else {
+			obs = coap_find_observer_by_token(obs, 1, token, tkl);
+		}
+
+		if (obs != NULL) {
+			return obs;
+		}
+	}
+
+	return NULL;
+}
+#else
+static inline void coap_service_index_observer(const struct coap_service *service,
+					       struct coap_observer *obs)
+{
+	ARG_UNUSED(service);
+	ARG_UNUSED(obs);
+}
+
+static inline void coap_service_unindex_observer(const struct coap_service *service,
+						 struct coap_observer *obs)
+{
+	ARG_UNUSED(service);
+	ARG_UNUSED(obs);
+}
+
+static struct coap_observer *coap_service_find_observer(const struct coap_service *service,
+							const struct sockaddr *addr,
+							const uint8_t *token, uint8_t tkl)
+{
+	if (addr != NULL) {
+		return coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token,
+					  tkl);
+	}
+
+	return coap_find_observer_by_token(service->data->observers, MAX_OBSERVERS, token, tkl);
+}
+#endif /* OBSERVER_HASH > 0 */
+
+#if RESOURCE_HASH > 0
+static bool resource_path_has_wildcard(const char * const *path)
+{
+	if (!IS_ENABLED(CONFIG_COAP_URI_WILDCARD)) {
+		return false;
+	}
+
+	for (; *path != NULL; path++) {
+		if (strlen(*path) == 1 && (**path == '+' || **path == '#')) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static uint32_t resource_path_hash(uint32_t hash, const void *segment, size_t len)
+{
+	static const uint8_t separator = '/';
+
+	hash = coap_server_hash(hash, segment, len);
+
+	/* Keep "ab" and "a/b" apart */
+	return coap_server_hash(hash, &separator, 1);
+}
+
+static void coap_service_index_resources(const struct coap_service *service)
+{
+	struct coap_service_data *data = service->data;
+
+	memset(data->resource_slots, 0, sizeof(data->resource_slots));
+	data->resource_wildcards = false;
+	data->resource_overflow = false;
+
+	COAP_SERVICE_FOREACH_RESOURCE(service, it) {
+		uint32_t hash = HASH_INIT;
+		size_t n;
+
+		if (resource_path_has_wildcard(it->path)) {
+			data->resource_wildcards = true;
+			continue;
+		}
+
+		for (const char * const *segment = it->path; *segment != NULL; segment++) {
+			hash = resource_path_hash(hash, *segment, strlen(*segment));
+		}
+
+		/* Linear probing, resources sharing a path keep their definition order */
+		for (n = 0; n < RESOURCE_HASH; n++) {
+			uint16_t *slot = &data->resource_slots[(hash + n) % RESOURCE_HASH];
+
+			if (*slot == 0) {
+				*slot = it - service->res_begin + 1;
+				break;
+			}
+		}
+
+		if (n == RESOURCE_HASH) {
+			LOG_WRN("Resource hash of %s full, falling back to scanning", service->name);
+			data->resource_overflow = true;
+			return;
+		}
+	}
+}
+
+static struct coap_resource *coap_service_lookup_resource(const struct coap_service *service,
+							  struct coap_option *options,
+							  uint8_t opt_num)
+{
+	uint32_t hash = HASH_INIT;
+
+	for (uint8_t i = 0; i < opt_num; i++) {
+		if (options[i].delta == COAP_OPTION_URI_PATH) {
+			hash = resource_path_hash(hash, options[i].value, options[i].len);
+		}
+	}
+
+	for (size_t n = 0; n < RESOURCE_HASH; n++) {
+		uint16_t slot = service->data->resource_slots[(hash + n) % RESOURCE_HASH];
+		struct coap_resource *resource;
+
+		if (slot == 0) {
+			break;
+		}
+
+		resource = &service->res_begin[slot - 1];
+		if (coap_uri_path_match(resource->path, options, opt_num)) {
+			return resource;
+		}
+	}
+
+	return NULL;
+}
+#endif /* RESOURCE_HASH > 0 */
+
+static int coap_service_handle_request(const struct coap_service *service,
+				       struct coap_packet *request,
+				       struct coap_option *options, uint8_t opt_num,
+				       struct sockaddr *addr, socklen_t addr_len)
+{
+#if RESOURCE_HASH > 0
+	if (!service->data->resource_overflow) {
+		struct coap_resource *resource;
+		size_t end;
+
+		if (!coap_packet_is_request(request)) {
+			return -ENOTSUP;
+		}
+
+		resource = coap_service_lookup_resource(service, options, opt_num);
+		end = resource != NULL ? resource - service->res_begin
+				       : COAP_SERVICE_RESOURCE_COUNT(service);
+
+		/* Wildcard resources defined before the exact match take precedence */
+		for (size_t i = 0; service->data->resource_wildcards && i < end; i++) {
+			struct coap_resource *it = &service->res_begin[i];
+
+			if (resource_path_has_wildcard(it->path) &&
+			    coap_uri_path_match(it->path, options, opt_num)) {
+				resource = it;
+				break;
+			}
+		}
+
+		if (resource == NULL) {
+			return -ENOENT;
+		}
+
+		return coap_handle_request_len(request, resource, 1, options, opt_num, addr,
+					       addr_len);
+	}
+#endif
+
+	return coap_handle_request_len(request, service->res_begin,
+				       COAP_SERVICE_RESOURCE_COUNT(service),
+				       options, opt_num, addr, addr_len);
+}
+
 static int coap_service_remove_observer(const struct coap_service *service,
 					struct coap_resource *resource,
 					const struct sockaddr *addr,
@@ -89,13 +342,9 @@ static int coap_service_remove_observer(const struct coap_service *service,
 {
 	struct coap_observer *obs;
 
-	if (tkl > 0 && addr != NULL) {
-		/* Prefer addr+token to find the observer */
-		obs = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token, tkl);
-	} else if (tkl > 0) {
-		/* Then try to find the observer by token */
-		obs = coap_find_observer_by_token(service->data->observers, MAX_OBSERVERS, token,
-						  tkl);
+	if (tkl > 0) {
+		/* Prefer addr+token, then token only to find the observer */
+		obs = coap_service_find_observer(service, addr, token, tkl);
 	} else if (addr != NULL) {
 		obs = coap_find_observer_by_addr(service->data->observers, MAX_OBSERVERS, addr);
 	} else {
@@ -110,11 +359,13 @@ static int coap_service_remove_observer(const struct coap_service *service,
 	if (resource == NULL) {
 		COAP_SERVICE_FOREACH_RESOURCE(service, it) {
 			if (coap_remove_observer(it, obs)) {
+				coap_service_unindex_observer(service, obs);
 				memset(obs, 0, sizeof(*obs));
 				return 1;
 			}
 		}
 	} else if (coap_remove_observer(resource, obs)) {
+		coap_service_unindex_observer(service, obs);
 		memset(obs, 0, sizeof(*obs));
 		return 1;
 	}
@@ -254,9 +505,8 @@ static int coap_server_process(int sock_fd)
 
 		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
 	} else {
-		ret = coap_handle_request_len(&request, service->res_begin,
-					      COAP_SERVICE_RESOURCE_COUNT(service),
-					      options, opt_num, &client_addr, client_addr_len);
+		ret = coap_service_handle_request(service, &request, options, opt_num,
+						  &client_addr, client_addr_len);
 
 		/* Translate errors to response codes */
 		switch (ret) {
@@ -428,6 +678,10 @@ int coap_service_start(const struct coap_service *service)
 		goto end;
 	}
 
+#if RESOURCE_HASH > 0
+	coap_service_index_resources(service);
+#endif
+
 	/* set the default address (in6addr_any / INADDR_ANY are all 0) */
 	addr_storage = (struct sockaddr_storage){0};
 	if (IS_ENABLED(CONFIG_NET_IPV6) && service->host != NULL &&
@@ -705,8 +959,7 @@ int coap_resource_parse_observe(struct coap_resource *resource, const struct coa
 		struct coap_observer *observer;
 
 		/* RFC7641 section 4.1 - Check if the current observer already exists */
-		observer = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token,
-					      tkl);
+		observer = coap_service_find_observer(service, addr, token, tkl);
 		if (observer != NULL) {
 			/* Client refresh */
 			goto unlock;
@@ -720,6 +973,7 @@ int coap_resource_parse_observe(struct coap_resource *resource, const struct coa
 		}
 
 		coap_observer_init(observer, request, addr);
+		coap_service_index_observer(service, observer);
 		coap_register_observer(resource, observer);
 	} else if (ret == 1) {
 		ret = coap_service_remove_observer(service, resource, addr, token, tkl);
@@ -740,6 +994,105 @@ unlock:
 	return ret;
 }
 
+int coap_resource_notify_observers(struct coap_resource *resource, enum coap_msgtype type,
+				   coap_notification_encode_t encode, void *user_data,
+				   const struct coap_transmission_parameters *params)
+{
+	/* Template is encoded after room for the largest token */
+	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+
+	const struct coap_service *service = NULL;
+	struct coap_observer *obs;
+	struct coap_packet base;
+	uint8_t hdr[HEADER_SIZE];
+	int notified = 0;
+	int ret;
+
+	if (encode == NULL || (type != COAP_TYPE_CON && type != COAP_TYPE_NON_CON)) {
+		return -EINVAL;
+	}
+
+	/* Find owning service */
+	COAP_SERVICE_FOREACH(svc) {
+		if (COAP_SERVICE_HAS_RESOURCE(svc, resource)) {
+			service = svc;
+			break;
+		}
+	}
+
+	if (service == NULL) {
+		return -ENOENT;
+	}
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	if (service->data->sock_fd < 0) {
+		ret = -EBADF;
+		goto unlock;
+	}
+
+	if (sys_slist_is_empty(&resource->observers)) {
+		ret = 0;
+		goto unlock;
+	}
+
+	/* Same sequence as coap_resource_notify() */
+	resource->age++;
+	if (resource->age > COAP_OBSERVE_MAX_AGE) {
+		resource->age = COAP_OBSERVE_FIRST_OFFSET;
+	}
+
+	ret = coap_packet_init(&base, buf + COAP_TOKEN_MAX_LEN,
+			       sizeof(buf) - COAP_TOKEN_MAX_LEN, COAP_VERSION_1, type, 0, NULL,
+			       COAP_RESPONSE_CODE_CONTENT, 0);
+	if (ret < 0) {
+		goto unlock;
+	}
+
+	ret = encode(resource, &base, user_data);
+	if (ret < 0) {
+		LOG_ERR("Failed to encode notification for %s (%d)", service->name, ret);
+		goto unlock;
+	}
+
+	memcpy(hdr, base.data, sizeof(hdr));
+
+	/* Header and token are written right in front of the options and payload,
+	 * nothing else is copied per observer.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&resource->observers, obs, list) {
+		struct coap_packet notification = {
+			.data = base.data - obs->tkl,
+			.offset = base.offset + obs->tkl,
+			.max_len = base.offset + obs->tkl,
+			.hdr_len = base.hdr_len + obs->tkl,
+			.opt_len = base.opt_len,
+			.delta = base.delta,
+		};
+
+		notification.data[0] = (hdr[0] & 0xF0) | obs->tkl;
+		notification.data[1] = hdr[1];
+		sys_put_be16(coap_next_id(), &notification.data[2]);
+		memcpy(&notification.data[HEADER_SIZE], obs->token, obs->tkl);
+
+		ret = coap_service_send(service, &notification, &obs->addr, ADDRLEN(&obs->addr),
+					params);
+		if (ret < 0) {
+			LOG_WRN("Failed to notify observer of %s (%d)", service->name, ret);
+			continue;
+		}
+
+		notified++;
+	}
+
+	ret = notified;
+
+unlock:
+	(void)k_mutex_unlock(&lock);
+
+	return ret;
+}
+
 static int coap_resource_remove_observer(struct coap_resource *resource,
 					 const struct sockaddr *addr,
 					 const uint8_t *token, uint8_t token_len)
@@ -10,14 +10,166 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static uint32_t dns_cache_hash(const char *query)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash ^= (uint8_t)*query++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static inline sys_slist_t *dns_cache_bucket(struct dns_cache *cache, uint32_t hash)
+{
+	return &cache->buckets[hash % cache->size];
+}
+
+static int dns_cache_family(enum dns_query_type type, sa_family_t *family)
+{
+	if (type == DNS_QUERY_TYPE_A) {
+		*family = AF_INET;
+	} else if (type == DNS_QUERY_TYPE_AAAA) {
+		*family = AF_INET6;
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int dns_cache_check_query(const char *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_release(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	(void)sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->hash_node);
+	entry->in_use = false;
+
+	/* Free entries are kept at the tail so that they are reused first */
+	sys_dlist_remove(&entry->lru_node);
+	sys_dlist_append(&cache->lru, &entry->lru_node);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_touch(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	sys_dlist_remove(&entry->lru_node);
+	sys_dlist_prepend(&cache->lru, &entry->lru_node);
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_alloc(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+	sys_dnode_t *tail;
+
+	tail = sys_dlist_peek_tail(&cache->lru);
+	if (tail != NULL) {
+		entry = CONTAINER_OF(tail, struct dns_cache_entry, lru_node);
+		if (!entry->in_use) {
+			return entry;
+		}
+	}
+
+	if (cache->used < cache->size) {
+		entry = &cache->entries[cache->used++];
+		sys_dlist_append(&cache->lru, &entry->lru_node);
+
+		return entry;
+	}
+
+	/* Evict the least recently used entry */
+	entry = CONTAINER_OF(tail, struct dns_cache_entry, lru_node);
+
+	NET_DBG("Overwrite \"%s\"", entry->query);
+
+	cache->stats.evictions++;
+	dns_cache_release(cache, entry);
+
+	return entry;
+}
+
+/* Needs to be called when lock is already acquired. Removes expired entries
+ * of the bucket and the entries superseded by a new answer for the query.
+ */
+static void dns_cache_clean(struct dns_cache *cache, uint32_t hash, const char *query,
+			    sa_family_t family, bool replace_all)
+{
+	struct dns_cache_entry *entry, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, hash_node) {
+		if (sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, entry);
+			continue;
+		}
+
+		if (query == NULL || entry->hash != hash || entry->data.ai_family != family ||
+		    strcmp(entry->query, query) != 0) {
+			continue;
+		}
+
+		if (replace_all || entry->negative || entry->refreshing) {
+			dns_cache_release(cache, entry);
+		}
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_insert(struct dns_cache *cache, const char *query,
+						uint32_t hash, uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+
+	entry = dns_cache_alloc(cache);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->refresh = sys_timepoint_calc(K_FOREVER);
+	entry->hash = hash;
+	entry->hits = 0U;
+	entry->negative = false;
+	entry->refreshing = false;
+	entry->in_use = true;
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+	uint32_t refresh_ttl = ttl - ttl * CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT / 100U;
+
+	if (refresh_ttl < ttl) {
+		entry->refresh = sys_timepoint_calc(K_SECONDS(refresh_ttl));
+	}
+#endif
+
+	sys_slist_prepend(dns_cache_bucket(cache, hash), &entry->hash_node);
+	dns_cache_touch(cache, entry);
+
+	return entry;
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		sys_slist_init(&cache->buckets[i]);
 	}
+	sys_dlist_init(&cache->lru);
+	cache->used = 0;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -26,47 +178,63 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	struct dns_cache_entry *entry;
+	uint32_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	dns_cache_clean(cache, hash, query, addrinfo->ai_family, false);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	entry = dns_cache_insert(cache, query, hash, ttl);
+	entry->data = *addrinfo;
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	sa_family_t family;
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0 ||
+	    dns_cache_family(type, &family) < 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (dns_cache_check_query(query) < 0) {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_clean(cache, hash, query, family, true);
+
+	entry = dns_cache_insert(cache, query, hash, ttl);
+	memset(&entry->data, 0, sizeof(entry->data));
+	entry->data.ai_family = family;
+	entry->negative = true;
+	/* Negative answers are not refreshed */
+	entry->refresh = sys_timepoint_calc(K_FOREVER);
 
 	k_mutex_unlock(cache->lock);
 
@@ -75,21 +243,22 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	struct dns_cache_entry *entry, *next;
+	uint32_t hash;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = dns_cache_hash(query);
 
-	dns_cache_clean(cache);
+	k_mutex_lock(cache->lock, K_FOREVER);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, hash_node) {
+		if (sys_timepoint_expired(entry->expiry) ||
+		    (entry->hash == hash && strcmp(entry->query, query) == 0)) {
+			dns_cache_release(cache, entry);
 		}
 	}
 
@@ -98,54 +267,69 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
+	struct dns_cache_entry *entry;
+	bool negative = false;
 	size_t found = 0;
 	sa_family_t family;
+	uint32_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (type == DNS_QUERY_TYPE_A) {
-		family = AF_INET;
-	} else if (type == DNS_QUERY_TYPE_AAAA) {
-		family = AF_INET6;
-	} else {
+	if (dns_cache_family(type, &family) < 0) {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	dns_cache_clean(cache, hash, NULL, family, false);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, hash_node) {
+		if (entry->hash != hash || entry->data.ai_family != family) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (strcmp(entry->query, query) != 0) {
 			continue;
 		}
-		if (cache->entries[i].data.ai_family != family) {
+
+		dns_cache_touch(cache, entry);
+
+		if (entry->hits < UINT16_MAX) {
+			entry->hits++;
+		}
+
+		if (entry->negative) {
+			negative = true;
 			continue;
 		}
+
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
 	}
 
+	if (found > 0) {
+		cache->stats.hits++;
+	} else if (negative) {
+		cache->stats.negative_hits++;
+	} else {
+		cache->stats.misses++;
+	}
+
 	k_mutex_unlock(cache->lock);
 
 	if (found > addrinfo_array_len) {
@@ -153,22 +337,87 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	}
 
 	if (found == 0) {
+		if (negative) {
+			NET_DBG("Negative answer cached for \"%s\"", query);
+			return -ENOENT;
+		}
+
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+bool dns_cache_prefetch_needed(struct dns_cache *cache, const char *query,
+			       enum dns_query_type type)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+	struct dns_cache_entry *entry;
+	bool needed = false;
+	sa_family_t family;
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || dns_cache_family(type, &family) < 0) {
+		return false;
+	}
+
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, hash_node) {
+		if (entry->hash != hash || entry->data.ai_family != family || entry->negative ||
+		    strcmp(entry->query, query) != 0) {
 			continue;
 		}
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+		if (entry->refreshing) {
+			needed = false;
+			break;
 		}
+
+		if (entry->hits >= CONFIG_DNS_RESOLVER_CACHE_PREFETCH_MIN_HITS &&
+		    sys_timepoint_expired(entry->refresh)) {
+			needed = true;
+		}
+	}
+
+	if (needed) {
+		SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, hash_node) {
+			if (entry->hash == hash && entry->data.ai_family == family &&
+			    !entry->negative && strcmp(entry->query, query) == 0) {
+				entry->refreshing = true;
+			}
+		}
+
+		NET_DBG("Refresh \"%s\"", query);
+		cache->stats.prefetches++;
 	}
+
+	k_mutex_unlock(cache->lock);
+
+	return needed;
+#else
+	ARG_UNUSED(cache);
+	ARG_UNUSED(query);
+	ARG_UNUSED(type);
+
+	return false;
+#endif
+}
+
+void dns_cache_stats_get(struct dns_cache *cache, struct dns_resolve_cache_stats *stats)
+{
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	*stats = cache->stats;
+	stats->size = cache->size;
+	stats->entries = 0;
+
+	for (size_t i = 0; i < cache->used; i++) {
+		if (cache->entries[i].in_use && !sys_timepoint_expired(cache->entries[i].expiry)) {
+			stats->entries++;
+		}
+	}
+
+	k_mutex_unlock(cache->lock);
 }
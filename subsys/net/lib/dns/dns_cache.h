@@ -17,17 +17,35 @@
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/slist.h>
 
 struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* A hit after this time point refreshes the entry in the background */
+	k_timepoint_t refresh;
+	sys_snode_t hash_node;
+	sys_dnode_t lru_node;
+	uint32_t hash;
+	uint16_t hits;
 	bool in_use;
+	/* Cached negative answer, only data.ai_family is valid */
+	bool negative;
+	bool refreshing;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* Entries are hashed by query, one bucket per entry */
+	sys_slist_t *buckets;
+	/* Most recently used entries first, free entries at the tail */
+	sys_dlist_t lru;
+	/* Number of entries taken into use from the entries array */
+	size_t used;
+	struct dns_resolve_cache_stats stats;
 	struct k_mutex *lock;
 };
 
@@ -43,8 +61,10 @@ struct dns_cache {
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static sys_slist_t name##_buckets[cache_size];                                             \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .size = cache_size, .buckets = name##_buckets,          \
+		.lru = SYS_DLIST_STATIC_INIT(&name.lru), .lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -56,8 +76,11 @@ struct dns_cache {
 int dns_cache_flush(struct dns_cache *cache);
 
 /**
- * @brief Adds a new entry to the dns cache removing the one closest to expiry
- * if no free space is available.
+ * @brief Adds a new entry to the dns cache removing the least recently used
+ * one if no free space is available.
+ *
+ * A cached negative answer or entries being refreshed for the same query and
+ * address family are replaced by the new entry.
  *
  * @param cache Cache where the entry should be added.
  * @param query Query which should be persisted in the cache.
@@ -71,6 +94,21 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative answer (the name does not exist) to the dns cache.
+ *
+ * All the entries with the same query and address family are replaced.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param type Query type of the negative answer.
+ * @param ttl Time to live for the entry in seconds, see RFC 2308 ch. 5.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -94,8 +132,32 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
+ * -ENOENT means that a negative answer is cached for the query.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
+/**
+ * @brief Checks if the cached entries of the query should be refreshed.
+ *
+ * Entries that have been used often are refreshed shortly before their TTL
+ * expires so that the next lookups do not miss the cache. The entries are
+ * marked as being refreshed, so this returns true only once per refresh.
+ *
+ * @param cache Cache where the entries should be searched.
+ * @param query Query which should be searched for.
+ * @param type Query type of the entries.
+ * @retval true if the caller should resolve the query again.
+ */
+bool dns_cache_prefetch_needed(struct dns_cache *cache, const char *query,
+			       enum dns_query_type type);
+
+/**
+ * @brief Gets the statistics of the dns cache.
+ *
+ * @param cache Cache whose statistics are wanted.
+ * @param stats Statistics are stored here.
+ */
+void dns_cache_stats_get(struct dns_cache *cache, struct dns_resolve_cache_stats *stats);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
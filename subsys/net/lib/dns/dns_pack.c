@@ -6,6 +6,7 @@
 
 #include <string.h>
 #include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net_buf.h>
 
@@ -179,6 +180,69 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 	return 0;
 }
 
+int dns_unpack_soa_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	uint16_t offset = dns_msg->answer_offset;
+	int count = dns_header_nscount(dns_msg->msg);
+
+	for (int i = 0; i < count; i++) {
+		uint8_t *rr = dns_msg->msg + offset;
+		int rem_size = dns_msg->msg_size - offset;
+		int dname_len;
+		int rdata_len;
+
+		dname_len = skip_fqdn(rr, rem_size);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		rem_size -= dname_len + DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE +
+			    DNS_TTL_LEN + DNS_RDLENGTH_LEN;
+		if (rem_size < 0) {
+			return -EINVAL;
+		}
+
+		rdata_len = dns_answer_rdlength(dname_len, rr);
+		if (rdata_len > rem_size) {
+			return -EINVAL;
+		}
+
+		if (dns_answer_type(dname_len, rr) == DNS_RR_TYPE_SOA) {
+			uint8_t *rdata = rr + dname_len + DNS_COMMON_UINT_SIZE +
+					 DNS_COMMON_UINT_SIZE + DNS_TTL_LEN +
+					 DNS_RDLENGTH_LEN;
+			uint32_t minimum;
+			int pos = 0;
+
+			/* Skip MNAME and RNAME */
+			for (int j = 0; j < 2; j++) {
+				int len = skip_fqdn(rdata + pos, rdata_len - pos);
+
+				if (len < 0) {
+					return len;
+				}
+
+				pos += len;
+			}
+
+			/* SERIAL, REFRESH, RETRY and EXPIRE precede MINIMUM */
+			if (rdata_len - pos < 5 * DNS_TTL_LEN) {
+				return -EINVAL;
+			}
+
+			minimum = sys_get_be32(rdata + pos + 4 * DNS_TTL_LEN);
+			*ttl = MIN((uint32_t)dns_answer_ttl(dname_len, rr), minimum);
+
+			return 0;
+		}
+
+		offset += dname_len + DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE +
+			  DNS_TTL_LEN + DNS_RDLENGTH_LEN + rdata_len;
+	}
+
+	return -ENOENT;
+}
+
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 {
 	uint8_t *dns_header;
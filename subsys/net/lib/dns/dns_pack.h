@@ -89,6 +89,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -349,6 +350,23 @@ int dns_msg_pack_qname(uint16_t *len, uint8_t *buf, uint16_t size,
 int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 		      enum dns_rr_type *type);
 
+/**
+ * @brief Gets the negative caching TTL of a response
+ *
+ * @details Looks for the SOA record in the authority section of the
+ *          response and returns the smaller of the SOA record TTL and the
+ *          SOA MINIMUM field, see RFC 2308 ch. 5. The answer_offset of
+ *          dns_msg must point to the authority section, i.e. all the answers
+ *          must have been unpacked already.
+ *
+ * @param dns_msg Structure containing the response.
+ * @param ttl Negative caching TTL.
+ * @retval 0 on success
+ * @retval -ENOENT if the response does not contain a SOA record
+ * @retval -EINVAL if the authority section is malformed
+ */
+int dns_unpack_soa_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Unpacks the header's response.
  *
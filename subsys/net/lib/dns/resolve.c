@@ -81,6 +81,17 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR,
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+#define DNS_PREFETCH_TIMEOUT (MSEC_PER_SEC * 2) /* ms */
+#define DNS_PREFETCH_COUNT MAX(1, CONFIG_DNS_NUM_CONCUR_QUERIES / 2)
+
+/* Names being refreshed in the background. The pending query refers to the
+ * name so it must stay valid until the query has finished.
+ */
+static char dns_prefetch_query[DNS_PREFETCH_COUNT][CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static ATOMIC_DEFINE(dns_prefetch_busy, DNS_PREFETCH_COUNT);
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 static int init_called;
 static struct dns_resolve_context dns_default_ctx;
 
@@ -823,6 +834,30 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+/* Must be invoked with context lock held */
+static void dns_cache_add_name_error(struct dns_resolve_context *ctx,
+				     struct dns_msg_t *dns_msg,
+				     int query_idx)
+{
+	uint32_t ttl;
+
+	if (CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_MAX_TTL == 0) {
+		return;
+	}
+
+	/* Negative answers without SOA record are not cached, RFC 2308 ch. 5 */
+	if (dns_unpack_soa_ttl(dns_msg, &ttl) < 0 || ttl == 0) {
+		return;
+	}
+
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_MAX_TTL);
+
+	(void)dns_cache_add_negative(&dns_cache, ctx->queries[query_idx].query,
+				     ctx->queries[query_idx].query_type, ttl);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -1135,6 +1170,12 @@ rr_qtype_aaaa:
 	}
 
 	if (items == 0) {
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+		if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+			dns_cache_add_name_error(ctx, dns_msg, *query_idx);
+		}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1480,6 +1521,65 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	int slot = POINTER_TO_INT(user_data);
+
+	ARG_UNUSED(info);
+
+	/* The answers are added to the cache when they are received */
+	if (status == DNS_EAI_INPROGRESS) {
+		return;
+	}
+
+	NET_DBG("Refresh of \"%s\" done (%d)", dns_prefetch_query[slot], status);
+
+	atomic_clear_bit(dns_prefetch_busy, slot);
+}
+
+static void dns_cache_prefetch(struct dns_resolve_context *ctx,
+			       const char *query,
+			       enum dns_query_type type)
+{
+	int slot, ret;
+
+	for (slot = 0; slot < DNS_PREFETCH_COUNT; slot++) {
+		if (!atomic_test_and_set_bit(dns_prefetch_busy, slot)) {
+			break;
+		}
+	}
+
+	if (slot == DNS_PREFETCH_COUNT) {
+		return;
+	}
+
+	if (!dns_cache_prefetch_needed(&dns_cache, query, type)) {
+		goto release;
+	}
+
+	strncpy(dns_prefetch_query[slot], query,
+		sizeof(dns_prefetch_query[slot]) - 1);
+	dns_prefetch_query[slot][sizeof(dns_prefetch_query[slot]) - 1] = '\0';
+
+	ret = dns_resolve_name_internal(ctx, dns_prefetch_query[slot], type,
+					NULL, dns_prefetch_cb,
+					INT_TO_POINTER(slot),
+					DNS_PREFETCH_TIMEOUT, false);
+	if (ret < 0) {
+		NET_DBG("Cannot refresh \"%s\" (%d)", query, ret);
+		goto release;
+	}
+
+	return;
+
+release:
+	atomic_clear_bit(dns_prefetch_busy, slot);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 int dns_resolve_name_internal(struct dns_resolve_context *ctx,
 			      const char *query,
 			      enum dns_query_type type,
@@ -1575,6 +1675,15 @@ try_resolve:
 
 			cb(DNS_EAI_ALLDONE, NULL, user_data);
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+			dns_cache_prefetch(ctx, query, type);
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+			return 0;
+		} else if (ret == -ENOENT) {
+			/* The name is known not to exist */
+			cb(DNS_EAI_NODATA, NULL, user_data);
+
 			return 0;
 		}
 	}
@@ -1917,6 +2026,19 @@ unlock:
 	return err;
 }
 
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats)
+{
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+	dns_cache_stats_get(&dns_cache, stats);
+
+	return 0;
+#else
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+}
+
 struct dns_resolve_context *dns_resolve_get_default(void)
 {
 	return &dns_default_ctx;
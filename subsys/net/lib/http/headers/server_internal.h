@@ -53,6 +53,8 @@ void http_server_get_content_type_from_extension(char *url, char *content_type,
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
 			  uint8_t supported_compression, enum http_compression *chosen_compression);
 void http_client_timer_restart(struct http_client_ctx *client);
+bool http_server_resource_acquire(struct http_resource_detail_dynamic *detail,
+				  struct http_client_ctx *client);
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status);
 bool http_response_is_provided(struct http_response_ctx *rsp);
 
@@ -6,6 +6,7 @@
  */
 #include <errno.h>
 #include <string.h>
+#include <strings.h>
 
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/hpack.h>
@@ -132,6 +133,190 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 	return -ENOENT;
 }
 
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+/* Headers that are never added to the dynamic table when encoding, either
+ * because they carry secrets or because their value changes all the time.
+ */
+static const char *const hpack_no_index_names[] = {
+	"authorization",
+	"content-length",
+	"cookie",
+	"date",
+	"proxy-authorization",
+	"set-cookie",
+};
+
+static bool hpack_name_no_index(struct http_hpack_header_buf *header)
+{
+	ARRAY_FOR_EACH(hpack_no_index_names, i) {
+		if (strlen(hpack_no_index_names[i]) == header->name_len &&
+		    strncasecmp(hpack_no_index_names[i], header->name, header->name_len) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool hpack_table_owns(struct http_hpack_dynamic_table *table, const char *ptr)
+{
+	return (const uint8_t *)ptr >= table->data &&
+	       (const uint8_t *)ptr < table->data + sizeof(table->data);
+}
+
+static void hpack_table_evict(struct http_hpack_dynamic_table *table)
+{
+	size_t len = table->entries[0].name_len + table->entries[0].value_len;
+
+	memmove(table->data, table->data + len, table->data_len - len);
+	memmove(&table->entries[0], &table->entries[1],
+		(table->count - 1) * sizeof(table->entries[0]));
+
+	table->count--;
+	table->data_len -= len;
+	table->size -= len + HTTP_HPACK_ENTRY_OVERHEAD;
+
+	for (int i = 0; i < table->count; i++) {
+		table->entries[i].offset -= len;
+	}
+}
+
+static void hpack_table_shrink(struct http_hpack_dynamic_table *table, size_t size)
+{
+	while (table->size > size) {
+		hpack_table_evict(table);
+	}
+}
+
+/* Based on RFC7541, ch. 4.4. The name and value must not point to the table
+ * data, as adding an entry may evict others.
+ */
+static void hpack_table_add(struct http_hpack_dynamic_table *table,
+			    const char *name, size_t name_len,
+			    const char *value, size_t value_len)
+{
+	size_t entry_size = name_len + value_len + HTTP_HPACK_ENTRY_OVERHEAD;
+	uint16_t offset;
+
+	if (entry_size > table->max_size) {
+		/* Adding an entry larger than the table empties the table. */
+		hpack_table_shrink(table, 0);
+		return;
+	}
+
+	hpack_table_shrink(table, table->max_size - entry_size);
+
+	offset = table->data_len;
+	memcpy(table->data + offset, name, name_len);
+	memcpy(table->data + offset + name_len, value, value_len);
+
+	table->entries[table->count].offset = offset;
+	table->entries[table->count].name_len = name_len;
+	table->entries[table->count].value_len = value_len;
+
+	table->count++;
+	table->data_len += name_len + value_len;
+	table->size += entry_size;
+}
+
+static int hpack_table_get(struct http_hpack_dynamic_table *table, uint32_t index,
+			   const char **name, size_t *name_len,
+			   const char **value, size_t *value_len)
+{
+	uint32_t pos;
+
+	if (table == NULL || index <= HTTP_HPACK_STATIC_TABLE_LEN) {
+		return -EBADMSG;
+	}
+
+	/* The newest entry has the lowest index. */
+	index -= HTTP_HPACK_STATIC_TABLE_LEN + 1;
+	if (index >= table->count) {
+		return -EBADMSG;
+	}
+
+	pos = table->count - 1 - index;
+
+	*name = (const char *)table->data + table->entries[pos].offset;
+	*name_len = table->entries[pos].name_len;
+	*value = *name + *name_len;
+	*value_len = table->entries[pos].value_len;
+
+	return 0;
+}
+
+static int hpack_table_find(struct http_hpack_dynamic_table *table,
+			    struct http_hpack_header_buf *header, bool *name_only)
+{
+	int candidate = -ENOENT;
+
+	for (int pos = table->count - 1; pos >= 0; pos--) {
+		const char *name = (const char *)table->data + table->entries[pos].offset;
+		int index = HTTP_HPACK_STATIC_TABLE_LEN + table->count - pos;
+
+		if (table->entries[pos].name_len != header->name_len ||
+		    memcmp(name, header->name, header->name_len) != 0) {
+			continue;
+		}
+
+		if (table->entries[pos].value_len == header->value_len &&
+		    memcmp(name + header->name_len, header->value, header->value_len) == 0) {
+			*name_only = false;
+			return index;
+		}
+
+		if (candidate < 0) {
+			candidate = index;
+		}
+	}
+
+	*name_only = true;
+
+	return candidate;
+}
+
+void http_hpack_table_init(struct http_hpack_dynamic_table *table, size_t max_size)
+{
+	table->count = 0;
+	table->data_len = 0;
+	table->size = 0;
+	table->max_size = MIN(max_size, sizeof(table->data));
+	table->size_update = false;
+}
+
+void http_hpack_table_resize(struct http_hpack_dynamic_table *table, size_t max_size)
+{
+	max_size = MIN(max_size, sizeof(table->data));
+	if (max_size == table->max_size) {
+		return;
+	}
+
+	table->max_size = max_size;
+	table->size_update = true;
+
+	hpack_table_shrink(table, max_size);
+}
+#else
+static int hpack_table_get(struct http_hpack_dynamic_table *table, uint32_t index,
+			   const char **name, size_t *name_len,
+			   const char **value, size_t *value_len)
+{
+	return -EBADMSG;
+}
+
+void http_hpack_table_init(struct http_hpack_dynamic_table *table, size_t max_size)
+{
+	ARG_UNUSED(table);
+	ARG_UNUSED(max_size);
+}
+
+void http_hpack_table_resize(struct http_hpack_dynamic_table *table, size_t max_size)
+{
+	ARG_UNUSED(table);
+	ARG_UNUSED(max_size);
+}
+#endif /* HTTP_SERVER_HPACK_TABLE_SIZE > 0 */
+
 #define HPACK_INTEGER_CONTINUATION_FLAG            0x80
 #define HPACK_STRING_HUFFMAN_FLAG                  0x80
 #define HPACK_STRING_PREFIX_LEN                    7
@@ -282,6 +467,7 @@ static int hpack_string_decode(const uint8_t *buf, size_t datalen,
 }
 
 static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
+				struct http_hpack_dynamic_table *table,
 				struct http_hpack_header_buf *header)
 {
 	const struct hpack_table_entry *entry;
@@ -298,6 +484,18 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
+	if (index > HTTP_HPACK_STATIC_TABLE_LEN) {
+		int len = ret;
+
+		ret = hpack_table_get(table, index, &header->name, &header->name_len,
+				      &header->value, &header->value_len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		return len;
+	}
+
 	entry = http_hpack_table_get(index);
 	if (entry == NULL) {
 		return -EBADMSG;
@@ -316,8 +514,9 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 }
 
 static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
+				struct http_hpack_dynamic_table *table,
 				struct http_hpack_header_buf *header,
-				uint8_t prefix_len)
+				uint8_t prefix_len, bool indexing)
 {
 	uint32_t index;
 	int ret, len;
@@ -344,6 +543,16 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		len += ret;
 		buf += ret;
 		datalen -= ret;
+	} else if (index > HTTP_HPACK_STATIC_TABLE_LEN) {
+		/* Name indexed in the dynamic table. */
+		const char *value;
+		size_t value_len;
+
+		ret = hpack_table_get(table, index, &header->name, &header->name_len,
+				      &value, &value_len);
+		if (ret < 0) {
+			return ret;
+		}
 	} else {
 		/* Indexed name. */
 		const struct hpack_table_entry *entry;
@@ -368,26 +577,48 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 
 	len += ret;
 
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	if (indexing && table != NULL) {
+		if (hpack_table_owns(table, header->name)) {
+			/* Adding the entry may evict the one holding the name. */
+			if (header->name_len > sizeof(header->buf) - header->datalen) {
+				return -ENOBUFS;
+			}
+
+			memcpy(header->buf + header->datalen, header->name, header->name_len);
+			header->name = header->buf + header->datalen;
+			header->datalen += header->name_len;
+		}
+
+		hpack_table_add(table, header->name, header->name_len,
+				header->value, header->value_len);
+	}
+#else
+	ARG_UNUSED(indexing);
+#endif
+
 	return len;
 }
 
 static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
-			       struct http_hpack_header_buf *header)
+				      struct http_hpack_dynamic_table *table,
+				      struct http_hpack_header_buf *header)
 {
-	/* TODO Add dynamic table support, if needed. */
-
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	return hpack_handle_literal(buf, datalen, table, header,
+				    HPACK_PREFIX_LEN_LITERAL_INDEXING, true);
 }
 
 static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
-				  struct http_hpack_header_buf *header)
+					 struct http_hpack_dynamic_table *table,
+					 struct http_hpack_header_buf *header)
 {
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
+	return hpack_handle_literal(buf, datalen, table, header,
+				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING, false);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen,
+					    struct http_hpack_dynamic_table *table,
+					    struct http_hpack_header_buf *header)
 {
 	uint32_t max_size;
 	int ret;
@@ -398,13 +629,36 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	if (table != NULL) {
+		/* The new size cannot exceed the size we advertised. */
+		if (max_size > sizeof(table->data)) {
+			return -EBADMSG;
+		}
+
+		table->max_size = max_size;
+		hpack_table_shrink(table, max_size);
+	}
+#endif
+
+	/* No header field is decoded. */
+	header->name = "";
+	header->name_len = 0;
+	header->value = "";
+	header->value_len = 0;
 
 	return ret;
 }
 
 int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 			     struct http_hpack_header_buf *header)
+{
+	return http_hpack_decode_header_table(buf, datalen, NULL, header);
+}
+
+int http_hpack_decode_header_table(const uint8_t *buf, size_t datalen,
+				   struct http_hpack_dynamic_table *table,
+				   struct http_hpack_header_buf *header)
 {
 	uint8_t prefix;
 	int ret;
@@ -420,18 +674,18 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 	prefix = *buf;
 
 	if ((prefix & HPACK_PREFIX_INDEXED_MASK) == HPACK_PREFIX_INDEXED) {
-		ret = hpack_handle_indexed(buf, datalen, header);
+		ret = hpack_handle_indexed(buf, datalen, table, header);
 	} else if ((prefix & HPACK_PREFIX_LITERAL_INDEXING_MASK) ==
 		   HPACK_PREFIX_LITERAL_INDEXING) {
-		ret = hpack_handle_literal_index(buf, datalen, header);
+		ret = hpack_handle_literal_index(buf, datalen, table, header);
 	} else if (((prefix & HPACK_PREFIX_LITERAL_NO_INDEXING_MASK) ==
 		    HPACK_PREFIX_LITERAL_NO_INDEXING) ||
 		   ((prefix & HPACK_PREFIX_LITERAL_NEVER_INDEXED_MASK) ==
 		    HPACK_PREFIX_LITERAL_NEVER_INDEXED)) {
-		ret = hpack_handle_literal_no_index(buf, datalen, header);
+		ret = hpack_handle_literal_no_index(buf, datalen, table, header);
 	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
 		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_dynamic_size_update(buf, datalen, table, header);
 	} else {
 		ret = -EINVAL;
 	}
@@ -596,6 +850,45 @@ static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
 				    HPACK_PREFIX_LEN_INDEXED);
 }
 
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+static int hpack_encode_literal_indexing(uint8_t *buf, size_t buflen, int index,
+					 struct http_hpack_header_buf *header)
+{
+	int ret, len = 0;
+
+	ret = hpack_integer_encode(buf, buflen, index,
+				   HPACK_PREFIX_LITERAL_INDEXING,
+				   HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	if (ret < 0) {
+		return ret;
+	}
+
+	buf += ret;
+	buflen -= ret;
+	len += ret;
+
+	if (index == 0) {
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	return len;
+}
+#endif
+
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header)
 {
@@ -626,3 +919,78 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 
 	return len;
 }
+
+int http_hpack_encode_header_table(uint8_t *buf, size_t buflen,
+				   struct http_hpack_dynamic_table *table,
+				   struct http_hpack_header_buf *header)
+{
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	int ret, index, len = 0;
+	bool name_only;
+
+	if (table == NULL) {
+		return http_hpack_encode_header(buf, buflen, header);
+	}
+
+	if (buf == NULL || header->name == NULL || header->name_len == 0 ||
+	    header->value == NULL || header->value_len == 0) {
+		return -EINVAL;
+	}
+
+	if (table->size_update) {
+		/* Signal the new size at the beginning of the next header block. */
+		ret = hpack_integer_encode(buf, buflen, table->max_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	index = http_hpack_find_index(header, &name_only);
+	if (index < 0 || name_only) {
+		bool dynamic_name_only;
+		int dynamic;
+
+		dynamic = hpack_table_find(table, header, &dynamic_name_only);
+		if (dynamic > 0 && (!dynamic_name_only || index < 0)) {
+			index = dynamic;
+			name_only = dynamic_name_only;
+		}
+	}
+
+	if (index > 0 && !name_only) {
+		ret = hpack_encode_indexed(buf, buflen, index);
+	} else if (hpack_name_no_index(header) ||
+		   header->name_len + header->value_len + HTTP_HPACK_ENTRY_OVERHEAD >
+		   table->max_size) {
+		if (index > 0) {
+			ret = hpack_encode_literal_value(buf, buflen, index, header);
+		} else {
+			ret = hpack_encode_literal(buf, buflen, header);
+		}
+	} else {
+		ret = hpack_encode_literal_indexing(buf, buflen, MAX(index, 0), header);
+		if (ret >= 0) {
+			hpack_table_add(table, header->name, header->name_len,
+					header->value, header->value_len);
+		}
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	table->size_update = false;
+
+	return len + ret;
+#else
+	ARG_UNUSED(table);
+
+	return http_hpack_encode_header(buf, buflen, header);
+#endif
+}
@@ -298,29 +298,121 @@ static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
 	return false;
 }
 
+/* The decoding is accelerated with lookup tables derived from decode_table,
+ * which lists the codes in canonical order (sorted by length, then by code).
+ * Codes of up to 8 bits, which cover the characters most commonly found in
+ * headers, are resolved with a single lookup on the next byte of input.
+ * Longer codes are resolved from the range of consecutive codes of each
+ * length.
+ */
+#define HUFFMAN_FAST_BITS 8
+#define HUFFMAN_FAST_NONE 0xff
+
+struct huffman_code_range {
+	uint8_t bitlen;
+	uint8_t count;
+	uint8_t index;
+	uint32_t first_code;
+};
+
+/* Index in decode_table of the symbol whose code prefixes the given byte,
+ * or HUFFMAN_FAST_NONE if the code is longer than 8 bits.
+ */
+static const uint8_t huffman_fast_table[256] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x04,
+	0x04, 0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+	0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x07, 0x07, 0x07, 0x07,
+	0x07, 0x07, 0x07, 0x07, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+	0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x0a, 0x0a, 0x0a, 0x0a,
+	0x0b, 0x0b, 0x0b, 0x0b, 0x0c, 0x0c, 0x0c, 0x0c, 0x0d, 0x0d, 0x0d, 0x0d,
+	0x0e, 0x0e, 0x0e, 0x0e, 0x0f, 0x0f, 0x0f, 0x0f, 0x10, 0x10, 0x10, 0x10,
+	0x11, 0x11, 0x11, 0x11, 0x12, 0x12, 0x12, 0x12, 0x13, 0x13, 0x13, 0x13,
+	0x14, 0x14, 0x14, 0x14, 0x15, 0x15, 0x15, 0x15, 0x16, 0x16, 0x16, 0x16,
+	0x17, 0x17, 0x17, 0x17, 0x18, 0x18, 0x18, 0x18, 0x19, 0x19, 0x19, 0x19,
+	0x1a, 0x1a, 0x1a, 0x1a, 0x1b, 0x1b, 0x1b, 0x1b, 0x1c, 0x1c, 0x1c, 0x1c,
+	0x1d, 0x1d, 0x1d, 0x1d, 0x1e, 0x1e, 0x1e, 0x1e, 0x1f, 0x1f, 0x1f, 0x1f,
+	0x20, 0x20, 0x20, 0x20, 0x21, 0x21, 0x21, 0x21, 0x22, 0x22, 0x22, 0x22,
+	0x23, 0x23, 0x23, 0x23, 0x24, 0x24, 0x25, 0x25, 0x26, 0x26, 0x27, 0x27,
+	0x28, 0x28, 0x29, 0x29, 0x2a, 0x2a, 0x2b, 0x2b, 0x2c, 0x2c, 0x2d, 0x2d,
+	0x2e, 0x2e, 0x2f, 0x2f, 0x30, 0x30, 0x31, 0x31, 0x32, 0x32, 0x33, 0x33,
+	0x34, 0x34, 0x35, 0x35, 0x36, 0x36, 0x37, 0x37, 0x38, 0x38, 0x39, 0x39,
+	0x3a, 0x3a, 0x3b, 0x3b, 0x3c, 0x3c, 0x3d, 0x3d, 0x3e, 0x3e, 0x3f, 0x3f,
+	0x40, 0x40, 0x41, 0x41, 0x42, 0x42, 0x43, 0x43, 0x44, 0x45, 0x46, 0x47,
+	0x48, 0x49, 0xff, 0xff,
+};
+
+/* Index in decode_table of each symbol. */
+static const uint8_t huffman_encode_table[256] = {
+	0x54, 0x91, 0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xae, 0xfd, 0xe7,
+	0xe8, 0xfe, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef, 0xf0, 0xff, 0xf1,
+	0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0x0a, 0x4a, 0x4b, 0x52,
+	0x55, 0x0b, 0x44, 0x4f, 0x4c, 0x4d, 0x45, 0x50, 0x46, 0x0c, 0x0d, 0x0e,
+	0x00, 0x01, 0x02, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x24, 0x47,
+	0x5c, 0x16, 0x53, 0x4e, 0x56, 0x17, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a,
+	0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+	0x37, 0x38, 0x39, 0x3a, 0x48, 0x3b, 0x49, 0x57, 0x5f, 0x58, 0x5a, 0x18,
+	0x5d, 0x03, 0x19, 0x04, 0x1a, 0x05, 0x1b, 0x1c, 0x1d, 0x06, 0x3c, 0x3d,
+	0x1e, 0x1f, 0x20, 0x07, 0x21, 0x3e, 0x22, 0x08, 0x09, 0x23, 0x3f, 0x40,
+	0x41, 0x42, 0x43, 0x5e, 0x51, 0x5b, 0x59, 0xfa, 0x62, 0x77, 0x63, 0x64,
+	0x78, 0x79, 0x7a, 0x92, 0x7b, 0x93, 0x94, 0x95, 0x96, 0x97, 0xaf, 0x98,
+	0xb0, 0xb1, 0x7c, 0x99, 0xb2, 0x9a, 0x9b, 0x9c, 0x9d, 0x6a, 0x7d, 0x9e,
+	0x7e, 0x9f, 0xa0, 0xb3, 0x7f, 0x6b, 0x65, 0x80, 0x81, 0xa1, 0xa2, 0x6c,
+	0xa3, 0x82, 0x83, 0xb4, 0x6d, 0x84, 0xa4, 0xa5, 0x6e, 0x6f, 0x85, 0x70,
+	0xa6, 0x86, 0xa7, 0xa8, 0x66, 0x87, 0x88, 0x89, 0xa9, 0x8a, 0x8b, 0xaa,
+	0xbe, 0xbf, 0x67, 0x60, 0x8c, 0xab, 0x8d, 0xba, 0xc0, 0xc1, 0xc2, 0xcd,
+	0xce, 0xc3, 0xb5, 0xbb, 0x61, 0x71, 0xc4, 0xcf, 0xd0, 0xc5, 0xd1, 0xb6,
+	0x72, 0x73, 0xc6, 0xc7, 0xfb, 0xd2, 0xd3, 0xd4, 0x68, 0xb7, 0x69, 0x74,
+	0x8e, 0x75, 0x76, 0xac, 0x8f, 0x90, 0xbc, 0xbd, 0xb8, 0xb9, 0xc8, 0xad,
+	0xc9, 0xd5, 0xca, 0xcb, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xfc, 0xdb, 0xdc,
+	0xdd, 0xde, 0xdf, 0xcc,
+};
+
+/* First code and its index in decode_table for each code length longer
+ * than 8 bits. The codes of a given length are consecutive.
+ */
+static const struct huffman_code_range huffman_ranges[] = {
+	{ 10,   5,  74, 0x000003f8 },
+	{ 11,   3,  79, 0x000007fa },
+	{ 12,   2,  82, 0x00000ffa },
+	{ 13,   6,  84, 0x00001ff8 },
+	{ 14,   2,  90, 0x00003ffc },
+	{ 15,   3,  92, 0x00007ffc },
+	{ 19,   3,  95, 0x0007fff0 },
+	{ 20,   8,  98, 0x000fffe6 },
+	{ 21,  13, 106, 0x001fffdc },
+	{ 22,  26, 119, 0x003fffd2 },
+	{ 23,  29, 145, 0x007fffd8 },
+	{ 24,  12, 174, 0x00ffffea },
+	{ 25,   4, 186, 0x01ffffec },
+	{ 26,  15, 190, 0x03ffffe0 },
+	{ 27,  19, 205, 0x07ffffde },
+	{ 28,  29, 224, 0x0fffffe2 },
+	{ 30,   3, 253, 0x3ffffffc },
+};
+
 static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
-		}
-	}
+	uint8_t index = huffman_fast_table[bits >> (UINT32_BITLEN - HUFFMAN_FAST_BITS)];
 
-	if (huffman_bits_compare(bits, &eos)) {
-		return &eos;
+	if (index != HUFFMAN_FAST_NONE) {
+		return &decode_table[index];
 	}
 
-	return NULL;
-}
+	for (int i = 0; i < ARRAY_SIZE(huffman_ranges); i++) {
+		const struct huffman_code_range *range = &huffman_ranges[i];
+		uint32_t code = bits >> (UINT32_BITLEN - range->bitlen);
 
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
+		if (code >= range->first_code && code - range->first_code < range->count) {
+			return &decode_table[range->index + code - range->first_code];
 		}
 	}
 
+	if (huffman_bits_compare(bits, &eos)) {
+		return &eos;
+	}
+
 	return NULL;
 }
 
@@ -420,7 +512,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 {
 	const struct decode_elem *entry;
 	size_t buflen_bits = buflen * 8;
-	uint8_t bit_offset = 0;
+	uint8_t acc_bits = 0;
+	uint64_t acc = 0;
 	int len = 0;
 
 	if (str == NULL || buf == NULL || str_len == 0) {
@@ -428,41 +521,23 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	while (str_len > 0) {
-		uint32_t code;
-		uint8_t bitlen;
-
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
+		entry = &decode_table[huffman_encode_table[*str]];
 
 		if (entry->bitlen > buflen_bits) {
 			return -ENOBUFS;
 		}
 
-		bitlen = entry->bitlen;
-		code = sys_get_be32(entry->code);
-
-		while (bitlen > 0) {
-			uint8_t to_copy = MIN(8 - bit_offset, bitlen);
-			uint8_t byte = (uint8_t)((code & MSB_MASK(to_copy)) >>
-						 (24 + bit_offset));
-
-			/* This is way suboptimal */
-			if (bit_offset == 0) {
-				*buf = byte;
-			} else {
-				*buf |= byte;
-			}
-
-			code <<= to_copy;
-			bitlen -= to_copy;
-			bit_offset  = (bit_offset + to_copy) % 8;
-
-			if (bit_offset == 0) {
-				buf++;
-				len++;
-			}
+		/* Accumulate the codes and flush whole bytes, at most 7 bits
+		 * are left over in between.
+		 */
+		acc = (acc << entry->bitlen) |
+		      (sys_get_be32(entry->code) >> (UINT32_BITLEN - entry->bitlen));
+		acc_bits += entry->bitlen;
+
+		while (acc_bits >= 8) {
+			acc_bits -= 8;
+			*buf++ = (uint8_t)(acc >> acc_bits);
+			len++;
 		}
 
 		buflen_bits -= entry->bitlen;
@@ -471,8 +546,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	/* Pad with ones. */
-	if (bit_offset > 0) {
-		*buf |= LSB_MASK((8 - bit_offset));
+	if (acc_bits > 0) {
+		*buf = (uint8_t)((acc << (8 - acc_bits)) | LSB_MASK((8 - acc_bits)));
 		len++;
 	}
 
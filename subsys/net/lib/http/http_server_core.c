@@ -14,6 +14,7 @@
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/fs_interface.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
@@ -43,6 +44,11 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
 
+/* Marks the pollfd of a client that is being processed by a worker thread,
+ * poll() ignores negative descriptors.
+ */
+#define BUSY_SOCK -2
+
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
@@ -52,11 +58,59 @@ struct http_server_ctx {
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	/* Number of clients currently handed over to the worker threads */
+	int busy_clients;
+#endif
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
+static struct k_spinlock resource_lock;
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+enum http_worker_action {
+	HTTP_WORKER_ACTION_NONE = 0,
+	HTTP_WORKER_ACTION_RELEASE,
+	HTTP_WORKER_ACTION_CLOSE,
+};
+
+/* Clients with pending data, and clients the workers are done with */
+static K_MSGQ_DEFINE(http_server_work_q, sizeof(struct http_client_ctx *),
+		     HTTP_SERVER_MAX_CLIENTS, sizeof(void *));
+static K_MSGQ_DEFINE(http_server_done_q, sizeof(struct http_client_ctx *),
+		     HTTP_SERVER_MAX_CLIENTS, sizeof(void *));
+
+static K_THREAD_STACK_ARRAY_DEFINE(http_server_worker_stacks,
+				   CONFIG_HTTP_SERVER_WORKER_COUNT,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread http_server_workers[CONFIG_HTTP_SERVER_WORKER_COUNT];
+#endif
+
+#if CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES > 0
+#define TRIE_NONE 0
+
+/* Node of the resource routing trie. Each node matches one '/' separated
+ * segment of a resource path. Resources containing wildcards are stored in
+ * the wildcard list of the node matching their literal prefix, and are
+ * matched with fnmatch() from there.
+ */
+struct http_resource_trie_node {
+	const char *segment;
+	uint16_t segment_len;
+	uint16_t child;
+	uint16_t sibling;
+	uint16_t wildcard;
+	/* Index of the resource within the service + 1, 0 if none */
+	uint16_t resource;
+};
+
+/* Node 0 is never used so that TRIE_NONE can be used as a list terminator */
+static struct http_resource_trie_node trie_nodes[CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES + 1];
+static uint16_t trie_nodes_used = 1;
+#endif
 
 #if defined(CONFIG_HTTP_SERVER_TLS_USE_ALPN)
 static const char *const alpn_list[] = {"h2", "http/1.1"};
@@ -353,6 +407,21 @@ void http_server_release_client(struct http_client_ctx *client)
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
 
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	if (client->worker_busy) {
+		/* The server thread owns the poll array, let it finish the
+		 * release once the worker is done with the client.
+		 */
+		if (client->worker_action == HTTP_WORKER_ACTION_NONE) {
+			client->worker_action = HTTP_WORKER_ACTION_RELEASE;
+		}
+
+		client->data_len = 0;
+		return;
+	}
+#endif
+
 	client_release_resources(client);
 
 	client->service->data->num_clients--;
@@ -378,6 +447,18 @@ static void close_client_connection(struct http_client_ctx *client)
 {
 	int fd = client->fd;
 
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	if (client->worker_busy) {
+		/* Deferred to the server thread, see http_server_release_client() */
+		if (client->worker_action == HTTP_WORKER_ACTION_NONE) {
+			client->worker_action = HTTP_WORKER_ACTION_CLOSE;
+		}
+
+		client->data_len = 0;
+		return;
+	}
+#endif
+
 	http_server_release_client(client);
 
 	(void)zsock_close(fd);
@@ -544,6 +625,130 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+static int http_server_client_process(struct http_client_ctx *client)
+{
+	int ret;
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d",
+				(int)ARRAY_INDEX(server_ctx.clients, client));
+			return -ENOTCONN;
+		}
+
+		ret = -errno;
+		LOG_DBG("ERROR reading from socket (%d)", ret);
+		return ret;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+
+		return ret;
+	}
+
+	if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+static void http_server_worker(void *p1, void *p2, void *p3)
+{
+	struct http_client_ctx *client;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&http_server_work_q, &client, K_FOREVER);
+
+		ret = http_server_client_process(client);
+		if (ret < 0 && client->worker_action == HTTP_WORKER_ACTION_NONE) {
+			client->worker_action = HTTP_WORKER_ACTION_CLOSE;
+		}
+
+		(void)k_msgq_put(&http_server_done_q, &client, K_FOREVER);
+		(void)eventfd_write(server_ctx.fds[0].fd, 1);
+	}
+}
+
+/* Hand a client with pending data over to the worker threads. Its socket is
+ * not polled until the worker is done, so that the requests of one client are
+ * never processed concurrently.
+ */
+static void http_server_dispatch(struct http_server_ctx *ctx, int idx)
+{
+	struct http_client_ctx *client = &ctx->clients[idx - ctx->listen_fds];
+
+	client->worker_busy = true;
+	client->worker_action = HTTP_WORKER_ACTION_NONE;
+	ctx->fds[idx].fd = BUSY_SOCK;
+	ctx->busy_clients++;
+
+	/* Cannot fail, each client is queued at most once */
+	(void)k_msgq_put(&http_server_work_q, &client, K_NO_WAIT);
+}
+
+static void http_server_complete(struct http_server_ctx *ctx, k_timeout_t timeout)
+{
+	struct http_client_ctx *client;
+	int idx;
+
+	while (ctx->busy_clients > 0 &&
+	       k_msgq_get(&http_server_done_q, &client, timeout) == 0) {
+		idx = ARRAY_INDEX(ctx->clients, client) + ctx->listen_fds;
+
+		ctx->busy_clients--;
+		ctx->fds[idx].fd = client->fd;
+		client->worker_busy = false;
+
+		switch (client->worker_action) {
+		case HTTP_WORKER_ACTION_CLOSE:
+			close_client_connection(client);
+			break;
+		case HTTP_WORKER_ACTION_RELEASE:
+			http_server_release_client(client);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void http_server_stop_workers(struct http_server_ctx *ctx)
+{
+	/* Make pending reads return so the workers finish quickly */
+	ARRAY_FOR_EACH_PTR(ctx->clients, client) {
+		if (client->worker_busy) {
+			(void)zsock_shutdown(client->fd, ZSOCK_SHUT_RD);
+		}
+	}
+
+	http_server_complete(ctx, K_FOREVER);
+}
+#endif /* CONFIG_HTTP_SERVER_WORKER_POOL */
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
@@ -570,12 +775,28 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+		if (ctx->fds[0].revents) {
+			/* The eventfd is used both to stop the server and by
+			 * the workers to report the clients they are done with.
+			 */
+			eventfd_read(ctx->fds[0].fd, &value);
+			http_server_complete(ctx, K_NO_WAIT);
+
+			if (!server_running) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
+			}
+		}
+#else
 		if (ret == 1 && ctx->fds[0].revents) {
 			eventfd_read(ctx->fds[0].fd, &value);
 			LOG_DBG("Received stop event. exiting ..");
 			ret = 0;
 			goto closing;
 		}
+#endif
 
 		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
 			if (ctx->fds[i].fd < 0) {
@@ -663,49 +884,26 @@ static int http_server_run(struct http_server_ctx *ctx)
 			}
 
 			/* Client sock */
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+			http_server_dispatch(ctx, i);
+#else
 			client = &ctx->clients[i - ctx->listen_fds];
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
-
-				close_client_connection(client);
-				continue;
-			}
-
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
+			ret = http_server_client_process(client);
+			if (ret < 0) {
 				close_client_connection(client);
 			}
+#endif
 		}
 	}
 
 	return 0;
 
 closing:
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	http_server_stop_workers(ctx);
+#endif
+
 	/* Close all client connections and the server socket */
 	close_all_sockets(ctx);
 	return ret;
@@ -760,8 +958,8 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
-struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
-						 const char *path, int *path_len, bool is_websocket)
+static struct http_resource_desc *find_resource_linear(const struct http_service_desc *service,
+							 const char *path, bool is_websocket)
 {
 	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 		if (skip_this(resource, is_websocket)) {
@@ -773,19 +971,268 @@ struct http_resource_detail *get_resource_detail(const struct http_service_desc
 
 			ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
 			if (ret == 0) {
-				*path_len = path_len_without_query(path);
-				return resource->detail;
+				return resource;
 			}
 		}
 
 		if (compare_strings(path, resource->resource) == 0) {
-			NET_DBG("Got match for %s", resource->resource);
+			return resource;
+		}
+	}
+
+	return NULL;
+}
+
+#if CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES > 0
+static bool segment_has_wildcard(const char *segment, size_t len)
+{
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		return false;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		if (segment[i] == '*' || segment[i] == '?' || segment[i] == '[' ||
+		    segment[i] == '\\') {
+			return true;
+		}
+	}
 
-			*path_len = strlen(resource->resource);
-			return resource->detail;
+	return false;
+}
+
+static uint16_t trie_node_alloc(void)
+{
+	if (trie_nodes_used >= ARRAY_SIZE(trie_nodes)) {
+		return TRIE_NONE;
+	}
+
+	memset(&trie_nodes[trie_nodes_used], 0, sizeof(trie_nodes[0]));
+
+	return trie_nodes_used++;
+}
+
+static uint16_t trie_find_child(uint16_t node, const char *segment, size_t len)
+{
+	uint16_t child;
+
+	for (child = trie_nodes[node].child; child != TRIE_NONE;
+	     child = trie_nodes[child].sibling) {
+		if (trie_nodes[child].segment_len == len &&
+		    memcmp(trie_nodes[child].segment, segment, len) == 0) {
+			break;
 		}
 	}
 
+	return child;
+}
+
+static int trie_insert(uint16_t root, const char *resource, size_t idx)
+{
+	uint16_t node = root;
+	uint16_t child;
+	size_t len;
+
+	while (true) {
+		len = strcspn(resource, "/");
+
+		if (segment_has_wildcard(resource, len)) {
+			uint16_t *last = &trie_nodes[node].wildcard;
+
+			child = trie_node_alloc();
+			if (child == TRIE_NONE) {
+				return -ENOMEM;
+			}
+
+			/* Keep the list in resource order, the first match wins */
+			while (*last != TRIE_NONE) {
+				last = &trie_nodes[*last].sibling;
+			}
+
+			trie_nodes[child].resource = idx + 1;
+			*last = child;
+
+			return 0;
+		}
+
+		child = trie_find_child(node, resource, len);
+		if (child == TRIE_NONE) {
+			child = trie_node_alloc();
+			if (child == TRIE_NONE) {
+				return -ENOMEM;
+			}
+
+			trie_nodes[child].segment = resource;
+			trie_nodes[child].segment_len = len;
+			trie_nodes[child].sibling = trie_nodes[node].child;
+			trie_nodes[node].child = child;
+		}
+
+		node = child;
+		resource += len;
+
+		if (*resource == '\0') {
+			break;
+		}
+
+		resource++;
+	}
+
+	if (trie_nodes[node].resource == 0) {
+		trie_nodes[node].resource = idx + 1;
+	}
+
+	return 0;
+}
+
+/* Update the best match with the resource stored in a node, if it was
+ * registered before the current best match.
+ */
+static void trie_match(const struct http_service_desc *service, uint16_t resource,
+		       bool is_websocket, size_t *best)
+{
+	if (resource == 0 || resource - 1 >= *best) {
+		return;
+	}
+
+	if (skip_this(&service->res_begin[resource - 1], is_websocket)) {
+		return;
+	}
+
+	*best = resource - 1;
+}
+
+static void trie_match_wildcards(const struct http_service_desc *service, uint16_t node,
+				 const char *path, bool is_websocket, size_t *best)
+{
+	struct http_resource_desc *resource;
+	uint16_t entry;
+
+	for (entry = trie_nodes[node].wildcard; entry != TRIE_NONE;
+	     entry = trie_nodes[entry].sibling) {
+		if (trie_nodes[entry].resource - 1 >= *best) {
+			break;
+		}
+
+		resource = &service->res_begin[trie_nodes[entry].resource - 1];
+		if (skip_this(resource, is_websocket)) {
+			continue;
+		}
+
+		if (fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR)) == 0 ||
+		    compare_strings(path, resource->resource) == 0) {
+			*best = trie_nodes[entry].resource - 1;
+			break;
+		}
+	}
+}
+
+/* Walk the path segment by segment. Gives the same result as the linear
+ * lookup, i.e. the first registered resource matching the path.
+ */
+static struct http_resource_desc *find_resource_trie(const struct http_service_desc *service,
+						     const char *path, bool is_websocket)
+{
+	uint16_t node = service->data->trie_root;
+	const char *segment = path;
+	size_t best = SIZE_MAX;
+	size_t len;
+
+	while (true) {
+		trie_match_wildcards(service, node, path, is_websocket, &best);
+
+		len = strcspn(segment, "/?");
+
+		node = trie_find_child(node, segment, len);
+		if (node == TRIE_NONE) {
+			break;
+		}
+
+		segment += len;
+
+		if (*segment != '/') {
+			/* End of the path, or start of the query string */
+			trie_match(service, trie_nodes[node].resource, is_websocket, &best);
+			trie_match_wildcards(service, node, path, is_websocket, &best);
+			break;
+		}
+
+		/* With wildcards enabled, a resource also matches the paths
+		 * below it (FNM_LEADING_DIR).
+		 */
+		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+			trie_match(service, trie_nodes[node].resource, is_websocket, &best);
+		}
+
+		segment++;
+	}
+
+	if (best == SIZE_MAX) {
+		return NULL;
+	}
+
+	return &service->res_begin[best];
+}
+
+static int http_server_resource_trie_init(void)
+{
+	uint16_t root;
+	size_t idx;
+	int ret;
+
+	HTTP_SERVICE_FOREACH(svc) {
+		svc->data->trie_root = TRIE_NONE;
+
+		root = trie_node_alloc();
+		if (root == TRIE_NONE) {
+			LOG_WRN("No free resource trie nodes, using linear lookup");
+			continue;
+		}
+
+		ret = 0;
+		idx = 0;
+
+		HTTP_SERVICE_FOREACH_RESOURCE(svc, resource) {
+			ret = trie_insert(root, resource->resource, idx++);
+			if (ret < 0) {
+				LOG_WRN("No free resource trie nodes, using linear lookup");
+				break;
+			}
+		}
+
+		if (ret == 0) {
+			svc->data->trie_root = root;
+		}
+	}
+
+	LOG_DBG("Resource trie uses %d nodes", trie_nodes_used - 1);
+
+	return 0;
+}
+
+SYS_INIT(http_server_resource_trie_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES > 0 */
+
+struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+						 const char *path, int *path_len, bool is_websocket)
+{
+	struct http_resource_desc *resource = NULL;
+
+#if CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES > 0
+	if (service->data->trie_root != TRIE_NONE) {
+		resource = find_resource_trie(service, path, is_websocket);
+	} else
+#endif
+	{
+		resource = find_resource_linear(service, path, is_websocket);
+	}
+
+	if (resource != NULL) {
+		NET_DBG("Got match for %s", resource->resource);
+
+		*path_len = path_len_without_query(path);
+		return resource->detail;
+	}
+
 	if (service->res_fallback != NULL) {
 		*path_len = path_len_without_query(path);
 		return service->res_fallback;
@@ -796,6 +1243,22 @@ struct http_resource_detail *get_resource_detail(const struct http_service_desc
 	return NULL;
 }
 
+bool http_server_resource_acquire(struct http_resource_detail_dynamic *detail,
+				  struct http_client_ctx *client)
+{
+	k_spinlock_key_t key = k_spin_lock(&resource_lock);
+	bool acquired = false;
+
+	if (detail->holder == NULL || detail->holder == client) {
+		detail->holder = client;
+		acquired = true;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return acquired;
+}
+
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
 			  uint8_t supported_compression, enum http_compression *chosen_compression)
 {
@@ -975,6 +1438,16 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	ARRAY_FOR_EACH(http_server_workers, i) {
+		k_thread_create(&http_server_workers[i], http_server_worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(http_server_worker_stacks[i]),
+				http_server_worker, NULL, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&http_server_workers[i], "http_worker");
+	}
+#endif
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
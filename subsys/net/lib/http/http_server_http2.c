@@ -107,6 +107,14 @@ static void release_http_stream_context(struct http_client_ctx *client,
 	}
 }
 
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+#define HPACK_DECODER(client) (&(client)->hpack_decoder)
+#define HPACK_ENCODER(client) (&(client)->hpack_encoder)
+#else
+#define HPACK_DECODER(client) NULL
+#define HPACK_ENCODER(client) NULL
+#endif
+
 static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 			    size_t *buflen, const char *name, const char *value)
 {
@@ -117,7 +125,8 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
-	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+	ret = http_hpack_encode_header_table(*buf, *buflen, HPACK_ENCODER(client),
+					     &client->header_field);
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -240,6 +249,45 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 	return ret;
 }
 
+static void http2_hpack_init(struct http_client_ctx *client)
+{
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	/* The encoder table starts with the protocol default size, until the
+	 * peer announces its own limit in a SETTINGS frame.
+	 */
+	http_hpack_table_init(&client->hpack_decoder, HTTP_SERVER_HPACK_TABLE_SIZE);
+	http_hpack_table_init(&client->hpack_encoder,
+			      MIN(HTTP_HPACK_DEFAULT_TABLE_SIZE, HTTP_SERVER_HPACK_TABLE_SIZE));
+#else
+	ARG_UNUSED(client);
+#endif
+}
+
+static void http2_hpack_settings(struct http_client_ctx *client)
+{
+#if HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	struct http2_frame *frame = &client->current_frame;
+	const uint8_t *cursor = client->cursor;
+
+	for (size_t i = 0; i + sizeof(struct http2_settings_field) <= frame->length;
+	     i += sizeof(struct http2_settings_field)) {
+		struct http2_settings_field *setting =
+			(struct http2_settings_field *)(cursor + i);
+
+		if (ntohs(UNALIGNED_GET(&setting->id)) != HTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+			continue;
+		}
+
+		/* The peer limits the size of our encoder table. */
+		http_hpack_table_resize(&client->hpack_encoder,
+					MIN(ntohl(UNALIGNED_GET(&setting->value)),
+					    HTTP_SERVER_HPACK_TABLE_SIZE));
+	}
+#else
+	ARG_UNUSED(client);
+#endif
+}
+
 int send_settings_frame(struct http_client_ctx *client, bool ack)
 {
 	uint8_t settings_frame[HTTP2_FRAME_HEADER_SIZE +
@@ -262,7 +310,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP2_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_HEADER_TABLE_SIZE),
 			      &setting->id);
-		UNALIGNED_PUT(0, &setting->value);
+		UNALIGNED_PUT(htonl(HTTP_SERVER_HPACK_TABLE_SIZE),
+			      &setting->value);
 
 		setting++;
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -782,7 +831,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_resource_acquire(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -791,8 +840,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
@@ -851,6 +898,8 @@ int enter_http2_request(struct http_client_ctx *client)
 	 * (settings frame).
 	 */
 	if (!client->preface_sent) {
+		http2_hpack_init(client);
+
 		ret = send_settings_frame(client, false);
 		if (ret < 0) {
 			return ret;
@@ -1083,6 +1132,8 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 		/* The first HTTP/2 frame sent by the server MUST be a server connection
 		 * preface.
 		 */
+		http2_hpack_init(client);
+
 		ret = send_settings_frame(client, false);
 		if (ret < 0) {
 			goto error;
@@ -1561,7 +1612,8 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		struct http_hpack_header_buf *header = &client->header_field;
 		size_t datalen = MIN(client->data_len, frame->length);
 
-		ret = http_hpack_decode_header(client->cursor, datalen, header);
+		ret = http_hpack_decode_header_table(client->cursor, datalen,
+						     HPACK_DECODER(client), header);
 		if (ret <= 0) {
 			if (ret == -EAGAIN) {
 				ret = handle_incomplete_http_header(client);
@@ -1586,6 +1638,11 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		client->cursor += ret;
 		client->data_len -= ret;
 
+		if (header->name_len == 0) {
+			/* Dynamic table size update, no header field. */
+			continue;
+		}
+
 		LOG_DBG("Parsed header: %.*s %.*s", (int)header->name_len,
 			header->name, (int)header->value_len, header->value);
 
@@ -1736,6 +1793,10 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		http2_hpack_settings(client);
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -89,6 +89,22 @@ static const struct default_obj_version default_obj_versions[] = {
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 
+/* Lookup tables, objects and object instances hashed by their IDs */
+static sys_slist_t engine_obj_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+
+static inline sys_slist_t *obj_bucket(int obj_id)
+{
+	return &engine_obj_hash[(uint16_t)obj_id % ARRAY_SIZE(engine_obj_hash)];
+}
+
+static inline sys_slist_t *obj_inst_bucket(int obj_id, int obj_inst_id)
+{
+	uint32_t hash = (uint16_t)obj_id * 31U + (uint16_t)obj_inst_id;
+
+	return &engine_obj_inst_hash[hash % ARRAY_SIZE(engine_obj_inst_hash)];
+}
+
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
@@ -112,7 +128,16 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 	access_control_add_obj(obj->obj_id, server_obj_inst_id);
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
+	obj->fields_sorted = true;
+	for (int i = 1; i < obj->field_count; i++) {
+		if (obj->fields[i - 1].res_id >= obj->fields[i].res_id) {
+			obj->fields_sorted = false;
+			break;
+		}
+	}
+
 	sys_slist_append(&engine_obj_list, &obj->node);
+	sys_slist_prepend(obj_bucket(obj->obj_id), &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +149,7 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+	sys_slist_find_and_remove(obj_bucket(obj->obj_id), &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,7 +157,7 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_bucket(obj_id), obj, hash_node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
@@ -144,12 +170,66 @@ struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_ob
 {
 	int i;
 
-	if (obj && obj->fields && obj->field_count > 0) {
-		for (i = 0; i < obj->field_count; i++) {
-			if (obj->fields[i].res_id == res_id) {
-				return &obj->fields[i];
+	if (!obj || !obj->fields || obj->field_count == 0) {
+		return NULL;
+	}
+
+	if (obj->fields_sorted) {
+		int low = 0;
+		int high = obj->field_count - 1;
+
+		while (low <= high) {
+			int mid = low + (high - low) / 2;
+
+			if (obj->fields[mid].res_id == res_id) {
+				return &obj->fields[mid];
+			} else if (obj->fields[mid].res_id < res_id) {
+				low = mid + 1;
+			} else {
+				high = mid - 1;
 			}
 		}
+
+		return NULL;
+	}
+
+	for (i = 0; i < obj->field_count; i++) {
+		if (obj->fields[i].res_id == res_id) {
+			return &obj->fields[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct lwm2m_engine_res *get_engine_res(struct lwm2m_engine_obj_inst *obj_inst,
+					       int res_id)
+{
+	int i;
+
+	if (obj_inst->resources_sorted) {
+		int low = 0;
+		int high = obj_inst->resource_count - 1;
+
+		while (low <= high) {
+			int mid = low + (high - low) / 2;
+
+			if (obj_inst->resources[mid].res_id == res_id) {
+				return &obj_inst->resources[mid];
+			} else if (obj_inst->resources[mid].res_id < res_id) {
+				low = mid + 1;
+			} else {
+				high = mid - 1;
+			}
+		}
+
+		return NULL;
+	}
+
+	for (i = 0; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i].res_id == res_id) {
+			return &obj_inst->resources[i];
+		}
 	}
 
 	return NULL;
@@ -175,7 +255,17 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 	access_control_add(obj_inst->obj->obj_id, obj_inst->obj_inst_id, server_obj_inst_id);
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
+	obj_inst->resources_sorted = true;
+	for (int i = 1; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i - 1].res_id >= obj_inst->resources[i].res_id) {
+			obj_inst->resources_sorted = false;
+			break;
+		}
+	}
+
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_prepend(obj_inst_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			  &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,13 +275,15 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(obj_inst_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_bucket(obj_id, obj_inst_id), obj_inst, hash_node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
@@ -204,6 +296,16 @@ struct lwm2m_engine_obj_inst *next_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst, *next = NULL;
 
+	/* Instance IDs are usually allocated in sequence, and the following
+	 * ID is the smallest possible match.
+	 */
+	if (obj_inst_id < UINT16_MAX) {
+		next = get_engine_obj_inst(obj_id, obj_inst_id + 1);
+		if (next) {
+			return next;
+		}
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id > obj_inst_id &&
 		    (!next || next->obj_inst_id > obj_inst->obj_inst_id)) {
@@ -370,7 +472,7 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 {
 	struct lwm2m_engine_obj_inst *oi;
 	struct lwm2m_engine_obj_field *of;
-	struct lwm2m_engine_res *r = NULL;
+	struct lwm2m_engine_res *r;
 	struct lwm2m_engine_res_inst *ri = NULL;
 	int i;
 
@@ -395,13 +497,7 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
-		}
-	}
-
+	r = get_engine_res(oi, path->res_id);
 	if (!r) {
 		if (LWM2M_HAS_PERM(of, BIT(LWM2M_FLAG_OPTIONAL))) {
 			LOG_DBG("resource %d not found", path->res_id);
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <inttypes.h>
 #include <ctype.h>
 #include <time.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
 
@@ -55,6 +56,12 @@ struct cbor_out_fmt_data {
 		size_t objlnk_sz; /* Object link buff size */
 		uint8_t objlnk_cnt;
 	};
+
+	/* Records already encoded into the output buffer, and where their
+	 * array starts. The array header is written once all records are known.
+	 */
+	uint16_t flushed_cnt;
+	uint16_t array_offset;
 };
 
 struct cbor_in_fmt_data {
@@ -139,6 +146,97 @@ static int fmt_range_check(struct cbor_out_fmt_data *fd)
 	return 0;
 }
 
+static size_t cbor_array_header_len(uint8_t initial_byte)
+{
+	switch (initial_byte & 0x1f) {
+	case 24:
+		return 2;
+	case 25:
+		return 3;
+	default:
+		return 1;
+	}
+}
+
+static size_t put_array_header(uint8_t *buf, uint16_t count)
+{
+	if (count < 24) {
+		buf[0] = 0x80 | count; /* 8x # array(x) */
+		return 1;
+	}
+
+	if (count <= UINT8_MAX) {
+		buf[0] = 0x98; /* 98 xx # array(xx) */
+		buf[1] = count;
+		return 2;
+	}
+
+	buf[0] = 0x99; /* 99 xxxx # array(xxxx) */
+	sys_put_be16(count, &buf[1]);
+	return 3;
+}
+
+/* Encode the pending records into the output buffer and release their slots.
+ * Records of all batches end up in a single array, the array header of each
+ * batch is dropped here and the final one is written by put_end().
+ */
+static int fmt_flush(struct lwm2m_output_context *out)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t *payload = CPKT_BUF_W_PTR(out->out_cpkt);
+	size_t hdr_len;
+	size_t len;
+	uint_fast8_t ret;
+
+	if (!fd->input.lwm2m_senml_record_m_count) {
+		return 0;
+	}
+
+	if (fd->flushed_cnt + fd->input.lwm2m_senml_record_m_count > UINT16_MAX) {
+		return -E2BIG;
+	}
+
+	ret = cbor_encode_lwm2m_senml(CPKT_BUF_W_REGION(out->out_cpkt), &fd->input, &len);
+	if (ret != ZCBOR_SUCCESS) {
+		LOG_ERR("unable to encode senml cbor msg");
+
+		return -E2BIG;
+	}
+
+	if (!fd->flushed_cnt) {
+		fd->array_offset = out->out_cpkt->offset;
+	}
+
+	hdr_len = cbor_array_header_len(payload[0]);
+	memmove(payload, payload + hdr_len, len - hdr_len);
+	out->out_cpkt->offset += len - hdr_len;
+	fd->flushed_cnt += fd->input.lwm2m_senml_record_m_count;
+
+	/* Names and object links are referenced by the encoded records only */
+	(void)memset(&fd->input, 0, sizeof(fd->input));
+	fd->name_cnt = 0;
+	fd->objlnk_cnt = 0;
+
+	return 0;
+}
+
+/* Called once a record is complete. A record takes up to three names
+ * (basename, resource and resource instance) and one object link, flush
+ * while there is still guaranteed room for the next one.
+ */
+static int fmt_flush_if_full(struct lwm2m_output_context *out)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+
+	if (fd->input.lwm2m_senml_record_m_count >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS ||
+	    fd->name_cnt + 3 > CONFIG_LWM2M_RW_SENML_CBOR_RECORDS ||
+	    fd->objlnk_cnt + 1 > CONFIG_LWM2M_RW_SENML_CBOR_RECORDS) {
+		return fmt_flush(out);
+	}
+
+	return 0;
+}
+
 static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
@@ -187,27 +285,34 @@ static int put_empty_array(struct lwm2m_output_context *out)
 
 static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
-	size_t len;
-	struct lwm2m_senml *input = &(LWM2M_OFD_CBOR(out)->input);
-
-	if (!input->lwm2m_senml_record_m_count) {
-		len = put_empty_array(out);
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	struct coap_packet *cpkt = out->out_cpkt;
+	uint8_t hdr[3];
+	size_t hdr_len;
+	int ret;
 
-		return len;
+	ret = fmt_flush(out);
+	if (ret < 0) {
+		return ret;
 	}
 
-	uint_fast8_t ret =
-		cbor_encode_lwm2m_senml(CPKT_BUF_W_REGION(out->out_cpkt), input, &len);
+	if (!fd->flushed_cnt) {
+		return put_empty_array(out);
+	}
 
-	if (ret != ZCBOR_SUCCESS) {
+	hdr_len = put_array_header(hdr, fd->flushed_cnt);
+	if (hdr_len > CPKT_BUF_W_SIZE(cpkt)) {
 		LOG_ERR("unable to encode senml cbor msg");
 
 		return -E2BIG;
 	}
 
-	out->out_cpkt->offset += len;
+	memmove(cpkt->data + fd->array_offset + hdr_len, cpkt->data + fd->array_offset,
+		cpkt->offset - fd->array_offset);
+	memcpy(cpkt->data + fd->array_offset, hdr, hdr_len);
+	cpkt->offset += hdr_len;
 
-	return len;
+	return cpkt->offset - fd->array_offset;
 }
 
 static int put_begin_oi(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
@@ -376,7 +481,7 @@ static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vi = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return fmt_flush_if_full(out);
 }
 
 static int put_s8(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int8_t value)
@@ -414,7 +519,7 @@ static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vi = (int64_t)value;
 	record->record_union_present = 1;
 
-	return 0;
+	return fmt_flush_if_full(out);
 }
 
 static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
@@ -432,7 +537,7 @@ static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vf = *value;
 	record->record_union_present = 1;
 
-	return 0;
+	return fmt_flush_if_full(out);
 }
 
 static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -452,7 +557,7 @@ static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vs.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return fmt_flush_if_full(out);
 }
 
 static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
@@ -470,7 +575,7 @@ static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vb = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return fmt_flush_if_full(out);
 }
 
 static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -490,7 +595,7 @@ static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vd.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return fmt_flush_if_full(out);
 }
 
 static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
@@ -529,7 +634,7 @@ static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 
 	fd->objlnk_cnt++;
 
-	return 0;
+	return fmt_flush_if_full(out);
 }
 
 static int get_opaque(struct lwm2m_input_context *in,
@@ -293,13 +293,253 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
+/** @brief Encode publish header into the tx buffer and prepare a message
+ *         referencing the payload in application memory.
+ */
+static int publish_msg_prepare(struct mqtt_client *client,
+			       const struct mqtt_publish_param *param,
+			       struct iovec io_vector[2], struct msghdr *msg)
+{
+	int err_code;
+	struct buf_ctx packet;
+
+	tx_buf_init(client, &packet);
+
+	err_code = publish_encode(client, param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	io_vector[0].iov_base = packet.cur;
+	io_vector[0].iov_len = packet.end - packet.cur;
+	io_vector[1].iov_base = param->message.payload.data;
+	io_vector[1].iov_len = param->message.payload.len;
+
+	memset(msg, 0, sizeof(*msg));
+
+	msg->msg_iov = io_vector;
+	msg->msg_iovlen = 2;
+
+	return 0;
+}
+
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+static struct mqtt_inflight *inflight_find(struct mqtt_client *client,
+					   uint16_t message_id)
+{
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		struct mqtt_inflight *entry = &client->internal.inflight[i];
+
+		if (entry->state != MQTT_INFLIGHT_FREE &&
+		    entry->param.message_id == message_id) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static uint16_t inflight_next_id(struct mqtt_client *client)
+{
+	uint16_t message_id = client->internal.last_message_id;
+
+	do {
+		message_id++;
+	} while (message_id == 0U || inflight_find(client, message_id) != NULL);
+
+	client->internal.last_message_id = message_id;
+
+	return message_id;
+}
+
+/** @brief Reserve an in-flight entry for a QoS 1/QoS 2 publication. */
+static int inflight_reserve(struct mqtt_client *client,
+			    const struct mqtt_publish_param *param,
+			    struct mqtt_inflight **entry)
+{
+	struct mqtt_inflight *free_entry = NULL;
+
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		struct mqtt_inflight *cur = &client->internal.inflight[i];
+
+		if (cur->state == MQTT_INFLIGHT_FREE) {
+			if (free_entry == NULL) {
+				free_entry = cur;
+			}
+		} else if (param->message_id != 0U &&
+			   cur->param.message_id == param->message_id) {
+			return -EBUSY;
+		}
+	}
+
+	if (free_entry == NULL) {
+		return -EAGAIN;
+	}
+
+	free_entry->param = *param;
+	free_entry->state = MQTT_INFLIGHT_PUBLISHED;
+
+	if (free_entry->param.message_id == 0U) {
+		free_entry->param.message_id = inflight_next_id(client);
+	}
+
+	*entry = free_entry;
+
+	return 0;
+}
+
+/** @brief Retransmit an in-flight entry. Does not close the connection on
+ *         failure, this is left to the caller.
+ */
+static int inflight_resend(struct mqtt_client *client,
+			   struct mqtt_inflight *entry)
+{
+	int err_code;
+
+	if (entry->state == MQTT_INFLIGHT_PUBLISHED) {
+		struct iovec io_vector[2];
+		struct msghdr msg;
+
+		entry->param.dup_flag = 1U;
+
+		err_code = publish_msg_prepare(client, &entry->param,
+					       io_vector, &msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		err_code = mqtt_transport_write_msg(client, &msg);
+	} else {
+		const struct mqtt_pubrel_param rel_param = {
+			.message_id = entry->param.message_id,
+		};
+		struct buf_ctx packet;
+
+		tx_buf_init(client, &packet);
+
+		err_code = publish_release_encode(client, &rel_param, &packet);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		err_code = mqtt_transport_write(client, packet.cur,
+						packet.end - packet.cur);
+	}
+
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	NET_DBG("[CID %p]: Retransmitted message id 0x%04x, state %d",
+		client, entry->param.message_id, entry->state);
+
+	entry->timestamp = mqtt_sys_tick_in_ms_get();
+	client->internal.last_activity = entry->timestamp;
+
+	return 0;
+}
+
+void mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		       uint16_t message_id)
+{
+	struct mqtt_inflight *entry = inflight_find(client, message_id);
+
+	if (entry == NULL) {
+		NET_DBG("[CID %p]: Message id 0x%04x not in flight", client,
+			message_id);
+		return;
+	}
+
+	switch (type) {
+	case MQTT_PKT_TYPE_PUBACK:
+	case MQTT_PKT_TYPE_PUBCOMP:
+		entry->state = MQTT_INFLIGHT_FREE;
+		break;
+	case MQTT_PKT_TYPE_PUBREC:
+		/* Release is still sent by the application on PUBREC event. */
+		entry->state = MQTT_INFLIGHT_RELEASED;
+		entry->timestamp = mqtt_sys_tick_in_ms_get();
+		break;
+	default:
+		break;
+	}
+}
+
+void mqtt_inflight_connack(struct mqtt_client *client, bool session_present)
+{
+	int dropped = 0;
+
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		struct mqtt_inflight *entry = &client->internal.inflight[i];
+
+		if (entry->state == MQTT_INFLIGHT_FREE) {
+			continue;
+		}
+
+		if (!session_present) {
+			entry->state = MQTT_INFLIGHT_FREE;
+			dropped++;
+			continue;
+		}
+
+		if (inflight_resend(client, entry) < 0) {
+			/* Connection is broken, remaining entries will be
+			 * retried on the next reconnect.
+			 */
+			NET_ERR("Failed to retransmit message id 0x%04x",
+				entry->param.message_id);
+			break;
+		}
+	}
+
+	if (dropped > 0) {
+		NET_WARN("Session not present, dropped %d in-flight messages",
+			 dropped);
+	}
+}
+
+#if CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT > 0
+static int inflight_retry(struct mqtt_client *client)
+{
+	int err_code;
+
+	if (mqtt_is_version_5_0(client) ||
+	    !MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		return 0;
+	}
+
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		struct mqtt_inflight *entry = &client->internal.inflight[i];
+
+		if (entry->state == MQTT_INFLIGHT_FREE ||
+		    mqtt_elapsed_time_in_ms_get(entry->timestamp) <
+		    CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT) {
+			continue;
+		}
+
+		err_code = inflight_resend(client, entry);
+		if (err_code < 0) {
+			NET_ERR("Transport write failed, err_code = %d, "
+				"closing connection", err_code);
+			mqtt_client_disconnect(client, err_code, true);
+			return err_code;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT > 0 */
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW > 0 */
+
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
 	int err_code;
-	struct buf_ctx packet;
 	struct iovec io_vector[2];
 	struct msghdr msg;
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+	struct mqtt_inflight *entry = NULL;
+#endif
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -311,29 +551,36 @@ int mqtt_publish(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
-
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = publish_encode(client, param, &packet);
-	if (err_code < 0) {
-		goto error;
-	}
-
-	io_vector[0].iov_base = packet.cur;
-	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+	if (param->message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) {
+		err_code = inflight_reserve(client, param, &entry);
+		if (err_code < 0) {
+			goto error;
+		}
 
-	memset(&msg, 0, sizeof(msg));
+		param = &entry->param;
+	}
+#endif
 
-	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	err_code = publish_msg_prepare(client, param, io_vector, &msg);
+	if (err_code == 0) {
+		err_code = client_write_msg(client, &msg);
+	}
 
-	err_code = client_write_msg(client, &msg);
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+	if (entry != NULL) {
+		if (err_code < 0) {
+			entry->state = MQTT_INFLIGHT_FREE;
+		} else {
+			entry->timestamp = client->internal.last_activity;
+		}
+	}
+#endif
 
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -711,6 +958,14 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
+#if CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT > 0
+	err_code = inflight_retry(client);
+	if (err_code < 0) {
+		mqtt_mutex_unlock(client);
+		return err_code;
+	}
+#endif
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
 	if ((client->keepalive > 0) &&
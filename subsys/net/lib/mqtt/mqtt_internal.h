@@ -208,6 +208,46 @@ int mqtt_handle_rx(struct mqtt_client *client);
  */
 void mqtt_client_disconnect(struct mqtt_client *client, int result, bool notify);
 
+/**@brief In-flight entry states. */
+#define MQTT_INFLIGHT_FREE      0
+#define MQTT_INFLIGHT_PUBLISHED 1 /**< Awaiting PUBACK or PUBREC. */
+#define MQTT_INFLIGHT_RELEASED  2 /**< Awaiting PUBCOMP. */
+
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+/**@brief Update the in-flight window on a received acknowledgment.
+ *
+ * @param[in] client Identifies the client that received the acknowledgment.
+ * @param[in] type Packet type of the acknowledgment (PUBACK, PUBREC or
+ *                 PUBCOMP).
+ * @param[in] message_id Acknowledged message id.
+ */
+void mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		       uint16_t message_id);
+
+/**@brief Resume or drop the in-flight window after the connection was
+ *        accepted.
+ *
+ * @param[in] client Identifies the client that received CONNACK.
+ * @param[in] session_present Whether the broker resumed the previous session.
+ */
+void mqtt_inflight_connack(struct mqtt_client *client, bool session_present);
+#else
+static inline void mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+				     uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(type);
+	ARG_UNUSED(message_id);
+}
+
+static inline void mqtt_inflight_connack(struct mqtt_client *client,
+					 bool session_present)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(session_present);
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW > 0 */
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
@@ -13,8 +13,7 @@
 #include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/counter.h>
 
-#include <stdarg.h>
-#include <stdio.h>
+#include <float.h>
 #include <string.h>
 #include <stddef.h>
 #include <errno.h>
@@ -24,219 +23,444 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
-{
-	/* helper function to write formatted metric to buffer */
-	va_list args;
-	size_t len = strlen(buffer);
+/* Number of decimals used for floating point values, same as printf("%f") */
+#define FRACTION_DIGITS 6
+#define FRACTION_SCALE  1000000ULL
 
-	if (len >= buffer_size) {
-		return -ENOMEM;
-	}
-	buffer += len;
-	buffer_size -= len;
+/* Values below this are printed in fixed notation, above in scientific. */
+#define FIXED_NOTATION_MAX 1e18
+
+struct line_writer {
+	char *buf;
+	size_t size;
+	size_t len;
+};
 
-	va_start(args, format);
-	len = vsnprintf(buffer, buffer_size, format, args);
-	va_end(args);
-	if (len >= buffer_size) {
+/* Render results besides errors */
+#define LINE_RENDERED 0
+#define LINE_SKIPPED  1
+#define LINE_END      2
+
+/* Line numbers within one metric */
+#define LINE_HELP     0
+#define LINE_TYPE     1
+#define LINE_SAMPLES  2
+
+static int put_mem(struct line_writer *w, const char *data, size_t len)
+{
+	/* Always leave room for the terminating NUL */
+	if (len >= w->size - w->len) {
 		return -ENOMEM;
 	}
 
+	memcpy(&w->buf[w->len], data, len);
+	w->len += len;
+	w->buf[w->len] = '\0';
+
 	return 0;
 }
 
-int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
-				 size_t buffer_size, int *written)
+static int put_str(struct line_writer *w, const char *str)
 {
-	int ret = 0;
+	return put_mem(w, str, strlen(str));
+}
 
-	/* write HELP line if available */
-	if (metric->description[0] != '\0') {
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# HELP %s %s\n", metric->name,
-					     metric->description);
-		if (ret < 0) {
-			LOG_ERR("Error writing to buffer");
-			goto out;
-		}
+static int put_u64(struct line_writer *w, uint64_t value)
+{
+	char digits[20];
+	int pos = sizeof(digits);
+
+	do {
+		digits[--pos] = '0' + value % 10U;
+		value /= 10U;
+	} while (value > 0U);
+
+	return put_mem(w, &digits[pos], sizeof(digits) - pos);
+}
+
+static int put_fraction(struct line_writer *w, uint64_t fraction)
+{
+	char digits[1 + FRACTION_DIGITS];
+
+	digits[0] = '.';
+
+	for (int i = FRACTION_DIGITS; i > 0; i--) {
+		digits[i] = '0' + fraction % 10U;
+		fraction /= 10U;
 	}
 
-	/* write TYPE line */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s counter\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing counter");
-			goto out;
-		}
+	return put_mem(w, digits, sizeof(digits));
+}
+
+/* Format a double the way printf("%f") would for the usual metric ranges,
+ * switching to "%e" style for huge values. Special values use the spelling
+ * from the Prometheus exposition format.
+ */
+static int put_double(struct line_writer *w, double value)
+{
+	uint64_t integer;
+	uint64_t fraction;
+	int exponent = 0;
+	int ret;
 
-		break;
+	if (value != value) {
+		return put_str(w, "NaN");
+	}
 
-	case PROMETHEUS_GAUGE:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s gauge\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing gauge");
-			goto out;
-		}
+	if (value > DBL_MAX) {
+		return put_str(w, "+Inf");
+	}
 
-		break;
+	if (value < -DBL_MAX) {
+		return put_str(w, "-Inf");
+	}
 
-	case PROMETHEUS_HISTOGRAM:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s histogram\n", metric->name);
+	if (value < 0) {
+		ret = put_mem(w, "-", 1);
 		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+			return ret;
 		}
 
-		break;
+		value = -value;
+	}
 
-	case PROMETHEUS_SUMMARY:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s summary\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+	if (value >= FIXED_NOTATION_MAX) {
+		while (value >= 10.0) {
+			value /= 10.0;
+			exponent++;
 		}
+	}
 
-		break;
+	integer = (uint64_t)value;
+	fraction = (uint64_t)((value - (double)integer) * FRACTION_SCALE + 0.5);
+	if (fraction >= FRACTION_SCALE) {
+		integer++;
+		fraction -= FRACTION_SCALE;
+	}
 
+	if (exponent > 0 && integer >= 10U) {
+		/* Rounding carried into the next decade */
+		integer = 1U;
+		exponent++;
+	}
+
+	ret = put_u64(w, integer);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = put_fraction(w, fraction);
+	if (ret < 0 || exponent == 0) {
+		return ret;
+	}
+
+	ret = put_mem(w, "e+", 2);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return put_u64(w, exponent);
+}
+
+static const char *metric_type_str(enum prometheus_metric_type type)
+{
+	switch (type) {
+	case PROMETHEUS_COUNTER:
+		return "counter";
+	case PROMETHEUS_GAUGE:
+		return "gauge";
+	case PROMETHEUS_HISTOGRAM:
+		return "histogram";
+	case PROMETHEUS_SUMMARY:
+		return "summary";
 	default:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s untyped\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing untyped");
-			goto out;
-		}
+		return "untyped";
+	}
+}
+
+/* Write the metric name, or reuse it if it is still at the start of the
+ * buffer from the previous sample line of the same metric.
+ */
+static int put_name(struct line_writer *w, const struct prometheus_metric *metric,
+		    size_t *prefix_len)
+{
+	int ret;
+
+	if (prefix_len != NULL && *prefix_len > 0) {
+		w->len = *prefix_len;
+		return 0;
+	}
+
+	ret = put_str(w, metric->name);
+	if (ret == 0 && prefix_len != NULL) {
+		*prefix_len = w->len;
+	}
+
+	return ret;
+}
+
+static int put_label(struct line_writer *w, const char *key, const char *value)
+{
+	int ret;
+
+	ret = put_mem(w, "{", 1);
+	if (ret == 0) {
+		ret = put_str(w, key);
+	}
+
+	if (ret == 0) {
+		ret = put_mem(w, "=\"", 2);
+	}
+
+	if (ret == 0) {
+		ret = put_str(w, value);
+	}
+
+	if (ret == 0) {
+		ret = put_mem(w, "\"} ", 3);
+	}
+
+	return ret;
+}
+
+static int render_sum_count(struct line_writer *w, const struct prometheus_metric *metric,
+			    size_t *prefix_len, int line, double sum, unsigned long count)
+{
+	int ret;
+
+	if (line > 1) {
+		return LINE_END;
+	}
+
+	ret = put_name(w, metric, prefix_len);
+	if (ret < 0) {
+		return ret;
+	}
 
-		break;
+	if (line == 0) {
+		ret = put_mem(w, "_sum ", 5);
+		if (ret == 0) {
+			ret = put_double(w, sum);
+		}
+	} else {
+		ret = put_mem(w, "_count ", 7);
+		if (ret == 0) {
+			ret = put_u64(w, count);
+		}
 	}
 
-	/* write metric-specific fields */
+	return ret;
+}
+
+static int render_samples(struct line_writer *w, const struct prometheus_metric *metric,
+			  size_t *prefix_len, int line)
+{
+	int ret;
+
 	switch (metric->type) {
 	case PROMETHEUS_COUNTER: {
 		const struct prometheus_counter *counter =
 			CONTAINER_OF(metric, struct prometheus_counter, base);
 
-		LOG_DBG("counter->value: %llu", counter->value);
+		if (line >= metric->num_labels) {
+			return LINE_END;
+		}
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, counter->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				goto out;
-			}
+		ret = put_name(w, metric, prefix_len);
+		if (ret == 0) {
+			ret = put_label(w, metric->labels[line].key,
+					metric->labels[line].value);
+		}
+
+		if (ret == 0) {
+			ret = put_u64(w, counter->value);
 		}
 
-		break;
+		return ret;
 	}
 
 	case PROMETHEUS_GAUGE: {
 		const struct prometheus_gauge *gauge =
 			CONTAINER_OF(metric, struct prometheus_gauge, base);
 
-		LOG_DBG("gauge->value: %f", gauge->value);
+		if (line >= metric->num_labels) {
+			return LINE_END;
+		}
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, gauge->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				goto out;
-			}
+		ret = put_name(w, metric, prefix_len);
+		if (ret == 0) {
+			ret = put_label(w, metric->labels[line].key,
+					metric->labels[line].value);
 		}
 
-		break;
+		if (ret == 0) {
+			ret = put_double(w, gauge->value);
+		}
+
+		return ret;
 	}
 
 	case PROMETHEUS_HISTOGRAM: {
 		const struct prometheus_histogram *histogram =
 			CONTAINER_OF(metric, struct prometheus_histogram, base);
 
-		LOG_DBG("histogram->count: %lu", histogram->count);
+		if (line >= histogram->num_buckets) {
+			return render_sum_count(w, metric, prefix_len,
+						line - histogram->num_buckets,
+						histogram->sum, histogram->count);
+		}
 
-		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				goto out;
-			}
+		ret = put_name(w, metric, prefix_len);
+		if (ret == 0) {
+			ret = put_mem(w, "_bucket{le=\"", 12);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, histogram->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+		if (ret == 0) {
+			ret = put_double(w, histogram->buckets[line].upper_bound);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     histogram->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+		if (ret == 0) {
+			ret = put_mem(w, "\"} ", 3);
+		}
+
+		if (ret == 0) {
+			ret = put_u64(w, histogram->buckets[line].count);
 		}
 
-		break;
+		return ret;
 	}
 
 	case PROMETHEUS_SUMMARY: {
 		const struct prometheus_summary *summary =
 			CONTAINER_OF(metric, struct prometheus_summary, base);
 
-		LOG_DBG("summary->count: %lu", summary->count);
+		if (line >= summary->num_quantiles) {
+			return render_sum_count(w, metric, prefix_len,
+						line - summary->num_quantiles,
+						summary->sum, summary->count);
+		}
 
-		for (int i = 0; i < summary->num_quantiles; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-				summary->quantiles[i].quantile,
-				summary->quantiles[i].value);
-			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				goto out;
-			}
+		ret = put_name(w, metric, prefix_len);
+		if (ret == 0) {
+			ret = put_mem(w, "{quantile=\"", 11);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, summary->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		if (ret == 0) {
+			ret = put_double(w, summary->quantiles[line].quantile);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     summary->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		if (ret == 0) {
+			ret = put_mem(w, "\"} ", 3);
+		}
+
+		if (ret == 0) {
+			ret = put_double(w, summary->quantiles[line].value);
 		}
 
-		break;
+		return ret;
 	}
 
 	default:
 		/* should not happen */
 		LOG_ERR("Unsupported metric type %d", metric->type);
-		ret = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
+}
+
+/* Render one line of the metric exposition (without the newline) into the
+ * writer. The prefix_len is used to cache the metric name between sample
+ * lines written to the same buffer, NULL disables caching.
+ */
+static int render_line(struct line_writer *w, const struct prometheus_metric *metric,
+		       size_t *prefix_len, int line)
+{
+	int ret;
+
+	switch (line) {
+	case LINE_HELP:
+		if (metric->description[0] == '\0') {
+			return LINE_SKIPPED;
+		}
+
+		ret = put_mem(w, "# HELP ", 7);
+		if (ret == 0) {
+			ret = put_str(w, metric->name);
+		}
+
+		if (ret == 0) {
+			ret = put_mem(w, " ", 1);
+		}
+
+		if (ret == 0) {
+			ret = put_str(w, metric->description);
+		}
+
+		return ret;
+
+	case LINE_TYPE:
+		ret = put_mem(w, "# TYPE ", 7);
+		if (ret == 0) {
+			ret = put_str(w, metric->name);
+		}
+
+		if (ret == 0) {
+			ret = put_mem(w, " ", 1);
+		}
+
+		if (ret == 0) {
+			ret = put_str(w, metric_type_str(metric->type));
+		}
+
+		return ret;
+
+	default:
+		return render_samples(w, metric, prefix_len, line - LINE_SAMPLES);
+	}
+}
+
+int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
+				 size_t buffer_size, int *written)
+{
+	struct line_writer w;
+	int ret;
+
+	if (buffer_size <= *written) {
+		return -ENOMEM;
+	}
+
+	/* Append to whatever is already in the buffer */
+	w.buf = buffer + *written;
+	w.size = buffer_size - *written;
+	w.len = strnlen(w.buf, w.size);
+
+	for (int line = LINE_HELP; ; line++) {
+		size_t start = w.len;
+
+		ret = render_line(&w, metric, NULL, line);
+		if (ret == LINE_SKIPPED) {
+			continue;
+		}
+
+		if (ret == LINE_END) {
+			ret = 0;
+			break;
+		}
+
+		if (ret == 0) {
+			ret = put_mem(&w, "\n", 1);
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Error writing %s %s", metric_type_str(metric->type),
+				metric->name);
+			/* Do not leave a partial line behind */
+			w.buf[start] = '\0';
+			return ret;
+		}
+	}
+
+	*written += w.len;
 
-out:
 	return ret;
 }
 
@@ -282,3 +506,157 @@ out:
 
 	return ret;
 }
+
+int prometheus_format_stream_init(struct prometheus_format_stream *stream,
+				  struct prometheus_collector *collector)
+{
+	if (stream == NULL || collector == NULL) {
+		return -EINVAL;
+	}
+
+	memset(stream, 0, sizeof(*stream));
+	stream->collector = collector;
+	stream->state = PROMETHEUS_FORMAT_STREAM_START;
+
+	return 0;
+}
+
+static void stream_finish(struct prometheus_format_stream *stream)
+{
+	if (stream->state == PROMETHEUS_FORMAT_STREAM_RUNNING) {
+		k_mutex_unlock(&stream->collector->lock);
+	}
+
+	stream->state = PROMETHEUS_FORMAT_STREAM_DONE;
+	stream->metric = NULL;
+}
+
+/* Move to the next metric that has data to show. Returns 0 if found,
+ * -ENOENT at the end of the list or the user callback error.
+ */
+static int stream_next_metric(struct prometheus_format_stream *stream)
+{
+	struct prometheus_collector *collector = stream->collector;
+	int ret;
+
+	while (stream->next != NULL) {
+		stream->metric = stream->next;
+		stream->next = SYS_SLIST_PEEK_NEXT_CONTAINER(stream->metric, node);
+
+		if (collector->user_cb) {
+			ret = collector->user_cb(collector, stream->metric,
+						 collector->user_data);
+			if (ret == -EAGAIN) {
+				/* Skip this metric for now */
+				continue;
+			}
+
+			if (ret < 0) {
+				LOG_ERR("Error in user callback (%d)", ret);
+				return ret;
+			}
+		}
+
+		stream->line = LINE_HELP;
+		stream->prefix_len = 0;
+
+		return 0;
+	}
+
+	stream->metric = NULL;
+
+	return -ENOENT;
+}
+
+int prometheus_format_stream(struct prometheus_format_stream *stream, char *buffer,
+			     size_t buffer_size)
+{
+	size_t written = 0;
+	int ret;
+
+	if (stream == NULL || stream->collector == NULL || buffer == NULL ||
+	    buffer_size == 0) {
+		return -EINVAL;
+	}
+
+	if (stream->state == PROMETHEUS_FORMAT_STREAM_DONE) {
+		return 0;
+	}
+
+	if (stream->state == PROMETHEUS_FORMAT_STREAM_START) {
+		/* The lock is held until the whole exposition has been
+		 * produced so that all chunks come from a consistent set of
+		 * metrics.
+		 */
+		k_mutex_lock(&stream->collector->lock, K_FOREVER);
+		stream->state = PROMETHEUS_FORMAT_STREAM_RUNNING;
+		stream->next = SYS_SLIST_PEEK_HEAD_CONTAINER(&stream->collector->metrics,
+							     stream->next, node);
+		stream->metric = NULL;
+	}
+
+	while (written < buffer_size) {
+		struct line_writer w;
+		size_t len;
+
+		/* Flush what is left of the current line first */
+		if (stream->line_pos < stream->line_len) {
+			len = MIN(stream->line_len - stream->line_pos, buffer_size - written);
+			memcpy(&buffer[written], &stream->line_buf[stream->line_pos], len);
+			stream->line_pos += len;
+			written += len;
+			continue;
+		}
+
+		if (stream->metric == NULL) {
+			ret = stream_next_metric(stream);
+			if (ret == -ENOENT) {
+				stream_finish(stream);
+				break;
+			}
+
+			if (ret < 0) {
+				stream_finish(stream);
+				return ret;
+			}
+		}
+
+		w.buf = stream->line_buf;
+		w.size = sizeof(stream->line_buf);
+		w.len = 0;
+
+		ret = render_line(&w, stream->metric, &stream->prefix_len, stream->line);
+		if (ret == LINE_END) {
+			stream->metric = NULL;
+			continue;
+		}
+
+		stream->line++;
+
+		if (ret == LINE_SKIPPED) {
+			continue;
+		}
+
+		if (ret == 0) {
+			ret = put_mem(&w, "\n", 1);
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Line of %s does not fit (%d)", stream->metric->name, ret);
+			stream_finish(stream);
+			return ret;
+		}
+
+		stream->line_len = w.len;
+		stream->line_pos = 0;
+	}
+
+	return written;
+}
+
+void prometheus_format_stream_abort(struct prometheus_format_stream *stream)
+{
+	if (stream != NULL) {
+		stream_finish(stream);
+	}
+}
@@ -94,6 +94,16 @@ static int cmd_net_capture(const struct shell *sh, size_t argc, char *argv[])
 
 		net_capture_foreach(capture_cb, &user_data);
 	}
+
+	if (IS_ENABLED(CONFIG_NET_CAPTURE_RING)) {
+		struct net_capture_ring_stats stats;
+
+		net_capture_ring_stats_get(&stats);
+
+		PR("Capture ring: captured %u truncated %u dropped %u "
+		   "errors %u\n", stats.captured, stats.truncated,
+		   stats.dropped, stats.sink_errors);
+	}
 #else
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
@@ -136,6 +136,27 @@ static void print_dns_info(const struct shell *sh,
 			   remaining);
 		}
 	}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_resolve_cache_stats stats;
+	uint32_t lookups;
+
+	if (dns_resolve_cache_stats_get(&stats) < 0) {
+		return;
+	}
+
+	lookups = stats.hits + stats.negative_hits + stats.misses;
+
+	PR("Cache:\n");
+	PR("\tEntries %u/%u\n", stats.entries, stats.size);
+	PR("\tHits %u (negative %u) misses %u hit ratio %u%%\n",
+	   stats.hits + stats.negative_hits, stats.negative_hits,
+	   stats.misses,
+	   lookups ? (uint32_t)(((uint64_t)stats.hits +
+				 stats.negative_hits) * 100U / lookups) : 0U);
+	PR("\tPrefetches %u evictions %u\n", stats.prefetches,
+	   stats.evictions);
+#endif
 }
 #endif
 
@@ -423,6 +423,26 @@ static void print_tc_rx_stats(const struct shell *sh, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+static void print_rx_flow_stats(const struct shell *sh, struct net_if *iface)
+{
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+	int i;
+
+	PR("RX flow steering statistics:\n");
+	PR("Queue\tRecv pkts\tDrop pkts\tbytes\n");
+
+	for (i = 0; i < CONFIG_NET_TC_RX_FLOW_QUEUES; i++) {
+		PR("[%d]\t%d\t\t%d\t\t%d\n", i,
+		   GET_STAT(iface, rx_flow.queue[i].pkts),
+		   GET_STAT(iface, rx_flow.queue[i].dropped),
+		   GET_STAT(iface, rx_flow.queue[i].bytes));
+	}
+#else
+	ARG_UNUSED(sh);
+	ARG_UNUSED(iface);
+#endif
+}
+
 static void print_net_pm_stats(const struct shell *sh, struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -458,6 +478,8 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 		PR("=================\n");
 	}
 
+	net_stats_sync(iface);
+
 #if defined(CONFIG_NET_STATISTICS_IPV6) && defined(CONFIG_NET_NATIVE_IPV6)
 	PR("IPv6 recv      %d\tsent\t%d\tdrop\t%d\tforwarded\t%d\n",
 	   GET_STAT(iface, ipv6.recv),
@@ -476,6 +498,15 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, ipv6_pmtu.sent),
 	   GET_STAT(iface, ipv6_pmtu.drop));
 #endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
+#if defined(CONFIG_NET_STATISTICS_ROUTE)
+	PR("IPv6 route lookup %d\tcache hit\t%d\tno route\t%d\n",
+	   GET_STAT(iface, route.lookup),
+	   GET_STAT(iface, route.cache_hit),
+	   GET_STAT(iface, route.no_route));
+	PR("IPv6 route added  %d\tdeleted\t%d\n",
+	   GET_STAT(iface, route.added),
+	   GET_STAT(iface, route.deleted));
+#endif /* CONFIG_NET_STATISTICS_ROUTE */
 #if defined(CONFIG_NET_STATISTICS_MLD)
 	PR("IPv6 MLD recv  %d\tsent\t%d\tdrop\t%d\n",
 	   GET_STAT(iface, ipv6_mld.recv),
@@ -581,6 +612,7 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 
 	print_tc_tx_stats(sh, iface);
 	print_tc_rx_stats(sh, iface);
+	print_rx_flow_stats(sh, iface);
 
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
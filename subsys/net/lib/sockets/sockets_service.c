@@ -20,7 +20,6 @@ enum SOCKET_SERVICE_THREAD_STATUS {
 	SOCKET_SERVICE_THREAD_STOPPED,
 	SOCKET_SERVICE_THREAD_RUNNING,
 };
-static enum SOCKET_SERVICE_THREAD_STATUS thread_status;
 
 static K_MUTEX_DEFINE(lock);
 static K_CONDVAR_DEFINE(wait_start);
@@ -28,13 +27,36 @@ static K_CONDVAR_DEFINE(wait_start);
 STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
-static struct service {
-	struct zsock_pollfd events[CONFIG_ZVFS_POLL_MAX];
-	int count;
-} ctx;
+static struct zsock_pollfd ctx_events[CONFIG_ZVFS_POLL_MAX];
+static const struct net_socket_service_desc *ctx_owners[CONFIG_ZVFS_POLL_MAX];
+
+/* Poll context of the common socket service thread */
+static struct net_socket_service_poller ctx = {
+	.events = ctx_events,
+	.owners = ctx_owners,
+};
 
 #define get_idx(svc) (*(svc->idx))
 
+static struct net_socket_service_poller *get_poller(const struct net_socket_service_desc *svc)
+{
+#if defined(CONFIG_NET_SOCKETS_SERVICE_THREADS)
+	if (svc->poller != NULL) {
+		return svc->poller;
+	}
+#else
+	ARG_UNUSED(svc);
+#endif
+
+	return &ctx;
+}
+
+static const struct net_socket_service_desc *get_owner(struct net_socket_service_poller *poller,
+						       int i)
+{
+	return poller->owners != NULL ? poller->owners[i] : poller->svc;
+}
+
 void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 {
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
@@ -50,24 +72,36 @@ static void cleanup_svc_events(const struct net_socket_service_desc *svc)
 	}
 }
 
+/* Must be called with the lock held */
+static void mark_dirty(struct net_socket_service_poller *poller, int start, int end)
+{
+	poller->dirty_start = MIN(poller->dirty_start, start);
+	poller->dirty_end = MAX(poller->dirty_end, end);
+}
+
 int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc,
 				       struct zsock_pollfd *fds, int len,
 				       void *user_data)
 {
+	struct net_socket_service_poller *poller;
 	int i, ret = -ENOENT;
 
 	k_mutex_lock(&lock, K_FOREVER);
 
-	if (thread_status == SOCKET_SERVICE_THREAD_UNINITIALIZED) {
-		(void)k_condvar_wait(&wait_start, &lock, K_FOREVER);
-	} else if (thread_status != SOCKET_SERVICE_THREAD_RUNNING) {
-		NET_ERR("Socket service thread not running, service %p register fails.", svc);
-		ret = -EIO;
+	if (STRUCT_SECTION_START(net_socket_service_desc) > svc ||
+	    STRUCT_SECTION_END(net_socket_service_desc) <= svc) {
 		goto out;
 	}
 
-	if (STRUCT_SECTION_START(net_socket_service_desc) > svc ||
-	    STRUCT_SECTION_END(net_socket_service_desc) <= svc) {
+	poller = get_poller(svc);
+
+	while (poller->status == SOCKET_SERVICE_THREAD_UNINITIALIZED) {
+		(void)k_condvar_wait(&wait_start, &lock, K_FOREVER);
+	}
+
+	if (poller->status != SOCKET_SERVICE_THREAD_RUNNING) {
+		NET_ERR("Socket service thread not running, service %p register fails.", svc);
+		ret = -EIO;
 		goto out;
 	}
 
@@ -88,8 +122,13 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 		}
 	}
 
+	/* Only the entries of this service are copied to the poll array
+	 * when the thread wakes up.
+	 */
+	mark_dirty(poller, get_idx(svc), get_idx(svc) + svc->pev_len);
+
 	/* Tell the thread to re-read the variables */
-	zvfs_eventfd_write(ctx.events[0].fd, 1);
+	zvfs_eventfd_write(poller->events[0].fd, 1);
 	ret = 0;
 
 out:
@@ -98,22 +137,6 @@ out:
 	return ret;
 }
 
-static struct net_socket_service_desc *find_svc_and_event(
-	struct zsock_pollfd *pev,
-	struct net_socket_service_event **event)
-{
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int i = 0; i < svc->pev_len; i++) {
-			if (svc->pev[i].event.fd == pev->fd) {
-				*event = &svc->pev[i];
-				return svc;
-			}
-		}
-	}
-
-	return NULL;
-}
-
 /* We do not set the user callback to our work struct because we need to
  * hook into the flow and restore the global poll array so that the next poll
  * round will not notice it and call the callback again while we are
@@ -145,90 +168,126 @@ static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *
 	return ret;
 }
 
-static int trigger_work(struct zsock_pollfd *pev)
+static int trigger_work(struct net_socket_service_poller *poller, int i)
 {
+	const struct net_socket_service_desc *svc = get_owner(poller, i);
 	struct net_socket_service_event *event;
-	struct net_socket_service_desc *svc;
 
-	svc = find_svc_and_event(pev, &event);
 	if (svc == NULL) {
 		return -ENOENT;
 	}
 
-	event->svc = svc;
+	event = &svc->pev[i - get_idx(svc)];
+	event->svc = (struct net_socket_service_desc *)svc;
 
 	/* Copy the triggered event to our event so that we know what
 	 * was actually causing the event.
 	 */
-	event->event = *pev;
+	event->event = poller->events[i];
 
-	return call_work(pev, event);
+	return call_work(&poller->events[i], event);
 }
 
-static void socket_service_thread(void)
+/* Copy the entries changed by net_socket_service_register() to the poll array */
+static void update_events(struct net_socket_service_poller *poller)
 {
-	int ret, i, fd, count = 0;
-	zvfs_eventfd_t value;
+	k_mutex_lock(&lock, K_FOREVER);
 
-	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
-	if (ret == 0) {
-		NET_INFO("No socket services found, service disabled.");
-		goto fail;
+	for (int i = poller->dirty_start; i < poller->dirty_end; i++) {
+		const struct net_socket_service_desc *svc = get_owner(poller, i);
+
+		poller->events[i] = svc->pev[i - get_idx(svc)].event;
 	}
 
-	/* Create contiguous poll event array to enable socket polling */
+	poller->dirty_start = poller->count;
+	poller->dirty_end = 0;
+
+	k_mutex_unlock(&lock);
+}
+
+/* Place the services handled by the common thread in its poll array */
+static int setup_common_poller(void)
+{
+	int count = 0;
+
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		if (get_poller(svc) != &ctx) {
+			continue;
+		}
+
 		NET_DBG("Service %s has %d pollable sockets",
 			COND_CODE_1(CONFIG_NET_SOCKETS_LOG_LEVEL_DBG,
 				    (svc->owner), ("")),
 			svc->pev_len);
+
+		if ((count + 1 + svc->pev_len) <= ARRAY_SIZE(ctx_owners)) {
+			for (int i = 0; i < svc->pev_len; i++) {
+				ctx_owners[count + 1 + i] = svc;
+			}
+		}
+
 		get_idx(svc) = count + 1;
 		count += svc->pev_len;
 	}
 
-	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
+	if (count == 0) {
+		NET_INFO("No socket services found, service disabled.");
+		return -ENOENT;
+	}
+
+	if ((count + 1) > ARRAY_SIZE(ctx_events)) {
 		NET_ERR("You have %d services to monitor but "
 			"%zd poll entries configured.",
-			count + 1, ARRAY_SIZE(ctx.events));
+			count + 1, ARRAY_SIZE(ctx_events));
 		NET_ERR("Please increase value of %s to at least %d",
 			"CONFIG_ZVFS_POLL_MAX", count + 1);
-		goto fail;
+		return -ENOMEM;
 	}
 
-	NET_DBG("Monitoring %d socket entries", count);
-
 	ctx.count = count + 1;
 
+	return 0;
+}
+
+static void socket_service_thread(struct net_socket_service_poller *poller)
+{
+	int ret, i, fd, ready;
+	zvfs_eventfd_t value;
+
+	if (poller == &ctx && setup_common_poller() < 0) {
+		goto fail;
+	}
+
+	NET_DBG("Monitoring %d socket entries", poller->count - 1);
+
 	/* Create an zvfs_eventfd that can be used to trigger events during polling */
 	fd = zvfs_eventfd(0, 0);
 	if (fd < 0) {
 		fd = -errno;
 		NET_ERR("zvfs_eventfd failed (%d)", fd);
-		goto out;
+		goto fail;
 	}
 
-	thread_status = SOCKET_SERVICE_THREAD_RUNNING;
-	k_condvar_broadcast(&wait_start);
+	poller->events[0].fd = fd;
+	poller->events[0].events = ZSOCK_POLLIN;
 
-	ctx.events[0].fd = fd;
-	ctx.events[0].events = ZSOCK_POLLIN;
+	for (i = 1; i < poller->count; i++) {
+		poller->events[i].fd = -1;
+	}
 
-restart:
-	i = 1;
+	/* Everything is copied to the poll array on the first round */
+	poller->dirty_start = 1;
+	poller->dirty_end = poller->count;
 
 	k_mutex_lock(&lock, K_FOREVER);
-
-	/* Copy individual events to the big array */
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int j = 0; j < svc->pev_len; j++) {
-			ctx.events[get_idx(svc) + j] = svc->pev[j].event;
-		}
-	}
-
+	poller->status = SOCKET_SERVICE_THREAD_RUNNING;
+	k_condvar_broadcast(&wait_start);
 	k_mutex_unlock(&lock);
 
+	update_events(poller);
+
 	while (true) {
-		ret = zsock_poll(ctx.events, count + 1, -1);
+		ret = zsock_poll(poller->events, poller->count, -1);
 		if (ret < 0) {
 			ret = -errno;
 			NET_ERR("poll failed (%d)", ret);
@@ -240,41 +299,72 @@ restart:
 			break;
 		}
 
-		/* Process work here */
-		for (i = 1; i < (count + 1); i++) {
-			if (ctx.events[i].fd < 0) {
+		ready = ret - (poller->events[0].revents ? 1 : 0);
+
+		/* Dispatch every ready socket before polling again */
+		for (i = 1; i < poller->count && ready > 0; i++) {
+			if (poller->events[i].fd < 0 || poller->events[i].revents == 0) {
 				continue;
 			}
 
-			if (ctx.events[i].revents > 0) {
-				ret = trigger_work(&ctx.events[i]);
-				if (ret < 0) {
-					NET_DBG("Triggering work failed (%d)", ret);
-					goto restart;
-				}
+			ready--;
+
+			ret = trigger_work(poller, i);
+			if (ret < 0) {
+				NET_DBG("Triggering work failed (%d)", ret);
 			}
 		}
 
-		/* Relocate after trigger work so the work gets done before restarting */
-		if (ret > 0 && ctx.events[0].revents) {
-			zvfs_eventfd_read(ctx.events[0].fd, &value);
-			ctx.events[0].revents = 0;
+		/* Update after trigger work so the work gets done before restarting.
+		 * Several registrations are handled by a single read.
+		 */
+		if (poller->events[0].revents) {
+			zvfs_eventfd_read(poller->events[0].fd, &value);
+			poller->events[0].revents = 0;
 			NET_DBG("Received restart event.");
-			goto restart;
+			update_events(poller);
 		}
 	}
 
 out:
 	NET_DBG("Socket service thread stopped");
-	thread_status = SOCKET_SERVICE_THREAD_STOPPED;
+	poller->status = SOCKET_SERVICE_THREAD_STOPPED;
 
 	return;
 
 fail:
-	thread_status = SOCKET_SERVICE_THREAD_FAILED;
+	k_mutex_lock(&lock, K_FOREVER);
+	poller->status = SOCKET_SERVICE_THREAD_FAILED;
 	k_condvar_broadcast(&wait_start);
+	k_mutex_unlock(&lock);
 }
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_THREADS)
+static void start_service_threads(void)
+{
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		struct net_socket_service_poller *poller = svc->poller;
+		k_tid_t tid;
+
+		if (poller == NULL) {
+			continue;
+		}
+
+		poller->svc = svc;
+		get_idx(svc) = 1;
+
+		tid = k_thread_create(&poller->thread, poller->stack, poller->stack_size,
+				      (k_thread_entry_t)socket_service_thread,
+				      poller, NULL, NULL,
+				      CLAMP(poller->prio,
+					    K_HIGHEST_APPLICATION_THREAD_PRIO,
+					    K_LOWEST_APPLICATION_THREAD_PRIO), 0, K_NO_WAIT);
+
+		k_thread_name_set(tid, "net_socket_svc");
+	}
+}
+#endif
+
 static int init_socket_service(void)
 {
 	k_tid_t ssm;
@@ -286,13 +376,17 @@ static int init_socket_service(void)
 	ssm = k_thread_create(&service_thread,
 			      service_thread_stack,
 			      K_THREAD_STACK_SIZEOF(service_thread_stack),
-			      (k_thread_entry_t)socket_service_thread, NULL, NULL, NULL,
+			      (k_thread_entry_t)socket_service_thread, &ctx, NULL, NULL,
 			      CLAMP(CONFIG_NET_SOCKETS_SERVICE_THREAD_PRIO,
 				    K_HIGHEST_APPLICATION_THREAD_PRIO,
 				    K_LOWEST_APPLICATION_THREAD_PRIO), 0, K_NO_WAIT);
 
 	k_thread_name_set(ssm, "net_socket_service");
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_THREADS)
+	start_service_threads();
+#endif
+
 	return 0;
 }
 
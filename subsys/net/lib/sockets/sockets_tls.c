@@ -46,7 +46,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
+#include <mbedtls/platform_util.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -192,6 +194,9 @@ __net_socket struct tls_context {
 		/** Session cache enabled on a socket. */
 		bool cache_enabled;
 
+		/** Session tickets enabled on a socket, -1 if not set. */
+		int8_t session_tickets;
+
 		/** Socket TX timeout */
 		k_timeout_t timeout_tx;
 
@@ -258,6 +263,30 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SRV_C)
+/* Ticket keys shared by all server sockets, set up on first use. */
+static mbedtls_ssl_ticket_context server_tickets;
+static bool server_tickets_ready;
+
+/* mbed TLS is built without MBEDTLS_THREADING_C, so the ticket context
+ * is protected by this mutex. It is taken by the ticket callbacks and
+ * when the ticket keys are set up or rotated.
+ */
+static struct k_mutex server_tickets_lock;
+
+/* Size of the ticket key name and of the AES-256/ChaCha20 ticket key */
+#define TLS_TICKET_KEY_NAME_LEN 4
+#define TLS_TICKET_KEY_LEN 32
+
+#if defined(MBEDTLS_GCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_GCM
+#elif defined(MBEDTLS_CCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_CCM
+#else
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_CHACHA20_POLY1305
+#endif
+#endif /* MBEDTLS_SSL_TICKET_C && MBEDTLS_SSL_SRV_C */
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -377,6 +406,11 @@ static int tls_init(void)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SRV_C)
+	k_mutex_init(&server_tickets_lock);
+	mbedtls_ssl_ticket_init(&server_tickets);
+#endif
+
 	return 0;
 }
 
@@ -454,6 +488,7 @@ static struct tls_context *tls_alloc(void)
 			(void)memset(tls, 0, sizeof(*tls));
 			tls->is_used = true;
 			tls->options.verify_level = -1;
+			tls->options.session_tickets = -1;
 			tls->options.timeout_tx = K_FOREVER;
 			tls->options.timeout_rx = K_FOREVER;
 			tls->sock = -1;
@@ -726,6 +761,104 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SRV_C)
+static int tls_ticket_write(void *p_ticket,
+			    const mbedtls_ssl_session *session,
+			    unsigned char *start, const unsigned char *end,
+			    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&server_tickets_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen,
+				       lifetime);
+	k_mutex_unlock(&server_tickets_lock);
+
+	return ret;
+}
+
+static int tls_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+			    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&server_tickets_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&server_tickets_lock);
+
+	return ret;
+}
+
+static int tls_session_tickets_setup(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&server_tickets_lock, K_FOREVER);
+
+	if (!server_tickets_ready) {
+		ret = mbedtls_ssl_ticket_setup(
+			&server_tickets, tls_ctr_drbg_random, NULL,
+			TLS_TICKET_CIPHER,
+			CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+		if (ret != 0) {
+			NET_ERR("Failed to set up session tickets, err: -0x%x",
+				-ret);
+			mbedtls_ssl_ticket_free(&server_tickets);
+			mbedtls_ssl_ticket_init(&server_tickets);
+			ret = -ENOMEM;
+		} else {
+			server_tickets_ready = true;
+		}
+	}
+
+	k_mutex_unlock(&server_tickets_lock);
+
+	return ret;
+}
+
+/* Replace both ticket keys with fresh ones. mbed TLS keeps the previous
+ * key to accept tickets issued before a rotation, so the keys are rotated
+ * twice to invalidate every issued ticket. The ticket context itself is
+ * kept, as the configurations of server sockets still reference it.
+ */
+static void tls_session_tickets_rotate(void)
+{
+	unsigned char name[TLS_TICKET_KEY_NAME_LEN];
+	unsigned char key[TLS_TICKET_KEY_LEN];
+	int ret = 0;
+
+	k_mutex_lock(&server_tickets_lock, K_FOREVER);
+
+	if (!server_tickets_ready) {
+		goto out;
+	}
+
+	for (int i = 0; i < 2 && ret == 0; i++) {
+		ret = tls_ctr_drbg_random(NULL, name, sizeof(name));
+		if (ret == 0) {
+			ret = tls_ctr_drbg_random(NULL, key, sizeof(key));
+		}
+
+		if (ret == 0) {
+			ret = mbedtls_ssl_ticket_rotate(
+				&server_tickets, name, sizeof(name), key,
+				sizeof(key),
+				CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+		}
+	}
+
+	mbedtls_platform_zeroize(key, sizeof(key));
+
+	if (ret != 0) {
+		NET_ERR("Failed to rotate session ticket keys, err: -0x%x",
+			-ret);
+	}
+
+out:
+	k_mutex_unlock(&server_tickets_lock);
+}
+#endif /* MBEDTLS_SSL_TICKET_C && MBEDTLS_SSL_SRV_C */
+
 static void tls_session_purge(void)
 {
 	tls_session_cache_reset();
@@ -734,6 +867,10 @@ static void tls_session_purge(void)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
+
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SRV_C)
+	tls_session_tickets_rotate();
+#endif
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -1425,6 +1562,32 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+	if (is_server) {
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SRV_C)
+		if (context->options.session_tickets ==
+		    TLS_SESSION_TICKETS_ENABLED) {
+			ret = tls_session_tickets_setup();
+			if (ret < 0) {
+				return ret;
+			}
+
+			mbedtls_ssl_conf_session_tickets_cb(&context->config,
+							    tls_ticket_write,
+							    tls_ticket_parse,
+							    &server_tickets);
+		}
+#endif
+	} else if (context->options.session_tickets != -1) {
+		mbedtls_ssl_conf_session_tickets(
+			&context->config,
+			context->options.session_tickets ==
+					TLS_SESSION_TICKETS_ENABLED ?
+				MBEDTLS_SSL_SESSION_TICKETS_ENABLED :
+				MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+	}
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+
 #if defined(MBEDTLS_SSL_EARLY_DATA)
 	mbedtls_ssl_conf_early_data(&context->config, MBEDTLS_SSL_EARLY_DATA_ENABLED);
 #endif
@@ -1957,6 +2120,63 @@ static int tls_opt_session_cache_get(struct tls_context *context,
 	return 0;
 }
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+static int tls_opt_session_tickets_set(struct tls_context *context,
+				       const void *optval, socklen_t optlen)
+{
+	int *val = (int *)optval;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (sizeof(int) != optlen) {
+		return -EINVAL;
+	}
+
+	if (*val != TLS_SESSION_TICKETS_DISABLED &&
+	    *val != TLS_SESSION_TICKETS_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->options.session_tickets = *val;
+
+	return 0;
+}
+
+static int tls_opt_session_tickets_get(struct tls_context *context,
+				       void *optval, socklen_t *optlen)
+{
+	int session_tickets = (context->options.session_tickets ==
+			       TLS_SESSION_TICKETS_ENABLED) ?
+			      TLS_SESSION_TICKETS_ENABLED :
+			      TLS_SESSION_TICKETS_DISABLED;
+
+	if (*optlen != sizeof(session_tickets)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = session_tickets;
+
+	return 0;
+}
+#else /* MBEDTLS_SSL_SESSION_TICKETS */
+static int tls_opt_session_tickets_set(struct tls_context *context,
+				       const void *optval, socklen_t optlen)
+{
+	NET_ERR("TLS_SESSION_TICKETS option requires "
+		"CONFIG_MBEDTLS_TLS_SESSION_TICKETS enabled");
+
+	return -ENOPROTOOPT;
+}
+
+static int tls_opt_session_tickets_get(struct tls_context *context,
+				       void *optval, socklen_t *optlen)
+{
+	return -ENOPROTOOPT;
+}
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+
 static int tls_opt_cert_verify_result_get(struct tls_context *context,
 					  void *optval, socklen_t *optlen)
 {
@@ -3553,6 +3773,10 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_TICKETS:
+		err = tls_opt_session_tickets_get(ctx, optval, optlen);
+		break;
+
 	case TLS_CERT_VERIFY_RESULT:
 		err = tls_opt_cert_verify_result_get(ctx, optval, optlen);
 		break;
@@ -3679,6 +3903,10 @@ int ztls_setsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_purge_set(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_TICKETS:
+		err = tls_opt_session_tickets_set(ctx, optval, optlen);
+		break;
+
 	case TLS_CERT_VERIFY_CALLBACK:
 		err = tls_opt_cert_verify_callback_set(ctx, optval, optlen);
 		break;
@@ -604,30 +604,73 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags,
 }
 #endif /* !defined(CONFIG_NET_TEST) */
 
+/* Apply the masking key to the data, offset is the position of data[0]
+ * within the frame payload. Bytes are handled one at a time only until
+ * the data is word aligned, the rest is masked a native word at a time.
+ */
+static void websocket_mask(uint8_t *data, size_t len, uint32_t masking_value,
+			   uint64_t offset)
+{
+	uint8_t key[sizeof(uintptr_t)];
+	uintptr_t key_word;
+
+	while (len > 0 && !IS_ALIGNED(data, sizeof(uintptr_t))) {
+		*data++ ^= masking_value >> (8 * (3 - offset % 4));
+		offset++;
+		len--;
+	}
+
+	if (len >= sizeof(uintptr_t)) {
+		/* The key repeats every 4 bytes and the word size is a multiple
+		 * of it, so the same rotated key applies to every word.
+		 */
+		for (size_t i = 0; i < sizeof(key); i++) {
+			key[i] = masking_value >> (8 * (3 - (offset + i) % 4));
+		}
+
+		memcpy(&key_word, key, sizeof(key_word));
+
+		do {
+			*(uintptr_t *)data ^= key_word;
+			data += sizeof(uintptr_t);
+			len -= sizeof(uintptr_t);
+		} while (len >= sizeof(uintptr_t));
+	}
+
+	while (len > 0) {
+		*data++ ^= masking_value >> (8 * (3 - offset % 4));
+		offset++;
+		len--;
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
-				      uint8_t *payload, size_t payload_len,
+				      const struct iovec *payload, size_t iovcnt,
 				      int32_t timeout)
 {
-	struct iovec io_vector[2];
+	struct iovec io_vector[1 + WEBSOCKET_SENDMSG_IOV_MAX];
 	struct msghdr msg;
 
 	io_vector[0].iov_base = header;
 	io_vector[0].iov_len = header_len;
-	io_vector[1].iov_base = payload;
-	io_vector[1].iov_len = payload_len;
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		io_vector[1 + i] = payload[i];
+	}
 
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	msg.msg_iovlen = 1 + iovcnt;
 
 	if (HEXDUMP_SENT_PACKETS) {
 		LOG_HEXDUMP_DBG(header, header_len, "Header");
-		if ((payload != NULL) && (payload_len > 0)) {
-			LOG_HEXDUMP_DBG(payload, payload_len, "Payload");
-		} else {
-			LOG_DBG("No payload");
+		for (size_t i = 0; i < iovcnt; i++) {
+			if (payload[i].iov_len > 0) {
+				LOG_HEXDUMP_DBG(payload[i].iov_base,
+						payload[i].iov_len, "Payload");
+			}
 		}
 	}
 
@@ -652,15 +695,9 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 #endif /* CONFIG_NET_TEST */
 }
 
-int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
-		       enum websocket_opcode opcode, bool mask, bool final,
-		       int32_t timeout)
+static int websocket_send_ctx(int ws_sock, enum websocket_opcode opcode,
+			      struct websocket_context **ctx)
 {
-	struct websocket_context *ctx;
-	uint8_t header[MAX_HEADER_LEN], hdr_len = 2;
-	uint8_t *data_to_send = (uint8_t *)payload;
-	int ret;
-
 	if (opcode != WEBSOCKET_OPCODE_DATA_TEXT &&
 	    opcode != WEBSOCKET_OPCODE_DATA_BINARY &&
 	    opcode != WEBSOCKET_OPCODE_CONTINUE &&
@@ -670,8 +707,8 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		return -EINVAL;
 	}
 
-	ctx = zvfs_get_fd_obj(ws_sock, NULL, 0);
-	if (ctx == NULL) {
+	*ctx = zvfs_get_fd_obj(ws_sock, NULL, 0);
+	if (*ctx == NULL) {
 		return -EBADF;
 	}
 
@@ -680,15 +717,24 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 	 * its own, hence skip the check.
 	 */
 
-	if (!PART_OF_ARRAY(contexts, ctx)) {
+	if (!PART_OF_ARRAY(contexts, *ctx)) {
 		return -ENOENT;
 	}
 #endif /* !defined(CONFIG_NET_TEST) */
 
-	NET_DBG("[%p] Len %zd %s/%d/%s", ctx, payload_len, opcode2str(opcode),
-		mask, final ? "final" : "more");
+	return 0;
+}
+
+/* Build the frame header, generating a new masking key if needed. */
+static uint8_t websocket_build_header(struct websocket_context *ctx,
+				      uint8_t header[MAX_HEADER_LEN],
+				      size_t payload_len,
+				      enum websocket_opcode opcode,
+				      bool mask, bool final)
+{
+	uint8_t hdr_len = 2;
 
-	memset(header, 0, sizeof(header));
+	memset(header, 0, MAX_HEADER_LEN);
 
 	/* Is this the last packet? */
 	header[0] = final ? BIT(7) : 0;
@@ -721,31 +767,56 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
-
 		ctx->masking_value = sys_rand32_get();
 
 		header[hdr_len++] |= ctx->masking_value >> 24;
 		header[hdr_len++] |= ctx->masking_value >> 16;
 		header[hdr_len++] |= ctx->masking_value >> 8;
 		header[hdr_len++] |= ctx->masking_value;
+	}
 
-		if ((payload != NULL) && (payload_len > 0)) {
-			data_to_send = k_malloc(payload_len);
-			if (!data_to_send) {
-				return -ENOMEM;
-			}
+	return hdr_len;
+}
 
-			memcpy(data_to_send, payload, payload_len);
+int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
+		       enum websocket_opcode opcode, bool mask, bool final,
+		       int32_t timeout)
+{
+	struct websocket_context *ctx;
+	uint8_t header[MAX_HEADER_LEN], hdr_len;
+	uint8_t *data_to_send = (uint8_t *)payload;
+	struct iovec io_vector;
+	int ret;
 
-			for (i = 0; i < payload_len; i++) {
-				data_to_send[i] ^= ctx->masking_value >> (8 * (3 - i % 4));
-			}
+	ret = websocket_send_ctx(ws_sock, opcode, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	NET_DBG("[%p] Len %zd %s/%d/%s", ctx, payload_len, opcode2str(opcode),
+		mask, final ? "final" : "more");
+
+	hdr_len = websocket_build_header(ctx, header, payload_len, opcode,
+					 mask, final);
+
+	if (mask && (payload != NULL) && (payload_len > 0)) {
+		/* The caller's buffer is read-only, mask a private copy.
+		 * Use websocket_sendmsg() to mask in place instead.
+		 */
+		data_to_send = k_malloc(payload_len);
+		if (!data_to_send) {
+			return -ENOMEM;
 		}
+
+		memcpy(data_to_send, payload, payload_len);
+		websocket_mask(data_to_send, payload_len, ctx->masking_value, 0);
 	}
 
+	io_vector.iov_base = data_to_send;
+	io_vector.iov_len = payload_len;
+
 	ret = websocket_prepare_and_send(ctx, header, hdr_len,
-					 data_to_send, payload_len, timeout);
+					 &io_vector, 1, timeout);
 	if (ret < 0) {
 		NET_DBG("Cannot send ws msg (%d)", -errno);
 		goto quit;
@@ -764,6 +835,56 @@ quit:
 	return ret - hdr_len;
 }
 
+int websocket_sendmsg(int ws_sock, const struct msghdr *message,
+		      enum websocket_opcode opcode, bool mask, bool final,
+		      int32_t timeout)
+{
+	struct websocket_context *ctx;
+	uint8_t header[MAX_HEADER_LEN], hdr_len;
+	size_t payload_len = 0;
+	uint64_t offset = 0;
+	int ret;
+
+	if (message == NULL || message->msg_iovlen > WEBSOCKET_SENDMSG_IOV_MAX) {
+		return -EINVAL;
+	}
+
+	ret = websocket_send_ctx(ws_sock, opcode, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (size_t i = 0; i < message->msg_iovlen; i++) {
+		payload_len += message->msg_iov[i].iov_len;
+	}
+
+	NET_DBG("[%p] Len %zd (%zd iov) %s/%d/%s", ctx, payload_len,
+		(size_t)message->msg_iovlen, opcode2str(opcode), mask,
+		final ? "final" : "more");
+
+	hdr_len = websocket_build_header(ctx, header, payload_len, opcode,
+					 mask, final);
+
+	if (mask) {
+		for (size_t i = 0; i < message->msg_iovlen; i++) {
+			websocket_mask(message->msg_iov[i].iov_base,
+				       message->msg_iov[i].iov_len,
+				       ctx->masking_value, offset);
+			offset += message->msg_iov[i].iov_len;
+		}
+	}
+
+	ret = websocket_prepare_and_send(ctx, header, hdr_len,
+					 message->msg_iov, message->msg_iovlen,
+					 timeout);
+	if (ret <= 0) {
+		NET_DBG("Cannot send ws msg (%d)", ret);
+		return ret;
+	}
+
+	return ret - hdr_len;
+}
+
 static uint32_t websocket_opcode2flag(uint8_t data)
 {
 	switch (data & 0x0f) {
@@ -937,6 +1058,46 @@ static int timeout_to_ms(k_timeout_t *timeout)
 
 #endif /* !defined(CONFIG_NET_TEST) */
 
+/* Read from the underlying socket (or the test input). Returns the number
+ * of bytes read, -EAGAIN on timeout and 0 if the peer closed the socket.
+ */
+static int websocket_read(int ws_sock, struct websocket_context *ctx,
+			  uint8_t *buf, size_t len, k_timepoint_t end)
+{
+	int ret;
+
+#if defined(CONFIG_NET_TEST)
+	struct test_data *test_data = zvfs_get_fd_obj(ws_sock, NULL, 0);
+	size_t input_len = MIN(len, test_data->input_len - test_data->input_pos);
+
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(end);
+
+	if (input_len > 0) {
+		memcpy(buf, &test_data->input_buf[test_data->input_pos], input_len);
+		test_data->input_pos += input_len;
+		ret = input_len;
+	} else {
+		/* emulate timeout */
+		ret = -EAGAIN;
+	}
+#else
+	k_timeout_t tout = sys_timepoint_timeout(end);
+
+	ARG_UNUSED(ws_sock);
+
+	ret = wait_rx(ctx->real_sock, timeout_to_ms(&tout));
+	if (ret == 0) {
+		ret = zsock_recv(ctx->real_sock, buf, len, ZSOCK_MSG_DONTWAIT);
+		if (ret < 0) {
+			ret = -errno;
+		}
+	}
+#endif /* CONFIG_NET_TEST */
+
+	return ret;
+}
+
 int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 		       uint32_t *message_type, uint64_t *remaining, int32_t timeout)
 {
@@ -978,33 +1139,52 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 	do {
 		size_t parsed_count;
 
-		if (ctx->recv_buf.count == 0) {
-#if defined(CONFIG_NET_TEST)
-			size_t input_len = MIN(ctx->recv_buf.size,
-					       test_data->input_len - test_data->input_pos);
-
-			if (input_len > 0) {
-				memcpy(ctx->recv_buf.buf,
-				       &test_data->input_buf[test_data->input_pos], input_len);
-				test_data->input_pos += input_len;
-				ret = input_len;
-			} else {
-				/* emulate timeout */
-				ret = -EAGAIN;
+		if ((ctx->recv_buf.count == 0) &&
+		    (ctx->parser_state == WEBSOCKET_PARSER_STATE_PAYLOAD)) {
+			/* Nothing buffered and in the middle of the payload,
+			 * read it straight into the caller's buffer.
+			 */
+			size_t len = MIN(ctx->parser_remaining,
+					 payload.size - payload.count);
+
+			ret = websocket_read(ws_sock, ctx, &payload.buf[payload.count],
+					     len, end);
+			if (ret < 0) {
+				if ((ret == -EAGAIN) && (payload.count > 0)) {
+					/* go to unmasking */
+					break;
+				}
+				return ret;
 			}
-#else
-			tout = sys_timepoint_timeout(end);
 
-			ret = wait_rx(ctx->real_sock, timeout_to_ms(&tout));
 			if (ret == 0) {
-				ret = zsock_recv(ctx->real_sock, ctx->recv_buf.buf,
-						 ctx->recv_buf.size, ZSOCK_MSG_DONTWAIT);
-				if (ret < 0) {
-					ret = -errno;
+				/* Socket closed */
+				return -ENOTCONN;
+			}
+
+			payload.count += ret;
+			ctx->parser_remaining -= ret;
+			if (ctx->parser_remaining == 0) {
+				ctx->parser_state = WEBSOCKET_PARSER_STATE_OPCODE;
+			}
+
+			if ((ctx->parser_state == WEBSOCKET_PARSER_STATE_OPCODE) ||
+			    (payload.count >= payload.size)) {
+				if (remaining != NULL) {
+					*remaining = ctx->parser_remaining;
 				}
+				if (message_type != NULL) {
+					*message_type = ctx->message_type;
+				}
+				break;
 			}
-#endif /* CONFIG_NET_TEST */
 
+			continue;
+		}
+
+		if (ctx->recv_buf.count == 0) {
+			ret = websocket_read(ws_sock, ctx, ctx->recv_buf.buf,
+					     ctx->recv_buf.size, end);
 			if (ret < 0) {
 				if ((ret == -EAGAIN) && (payload.count > 0)) {
 					/* go to unmasking */
@@ -1051,17 +1231,10 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	} while (true);
 
-	/* Unmask the data */
+	/* Unmask the data in place */
 	if (ctx->masked) {
-		uint8_t *mask_as_bytes = (uint8_t *)&ctx->masking_value;
-		size_t data_buf_offset = ctx->message_len - ctx->parser_remaining - payload.count;
-
-		for (size_t i = 0; i < payload.count; i++) {
-			size_t m = data_buf_offset % 4;
-
-			payload.buf[i] ^= mask_as_bytes[3 - m];
-			data_buf_offset++;
-		}
+		websocket_mask(payload.buf, payload.count, ctx->masking_value,
+			       ctx->message_len - ctx->parser_remaining - payload.count);
 	}
 
 	return payload.count;
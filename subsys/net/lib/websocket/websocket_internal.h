@@ -20,6 +20,9 @@
 /* Max Websocket header length */
 #define MAX_HEADER_LEN 14
 
+/* Max number of payload buffers accepted by websocket_sendmsg() */
+#define WEBSOCKET_SENDMSG_IOV_MAX 4
+
 /* From RFC 6455 chapter 4.2.2 */
 #define WS_MAGIC "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
 
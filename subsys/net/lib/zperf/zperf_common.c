@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/debug/cpu_load.h>
 #include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/socket.h>
@@ -272,6 +273,58 @@ error:
 	return ret;
 }
 
+int zperf_num_streams(const struct zperf_upload_params *param)
+{
+	if (param->options.num_streams == 0U) {
+		return 1;
+	}
+
+	return MIN(param->options.num_streams, CONFIG_NET_ZPERF_MAX_STREAMS);
+}
+
+int zperf_prepare_upload_socks(const struct zperf_upload_params *param,
+			       int proto, int *socks)
+{
+	int count = zperf_num_streams(param);
+	int i;
+
+	for (i = 0; i < count; i++) {
+		socks[i] = zperf_prepare_upload_sock(&param->peer_addr,
+						     param->options.tos,
+						     param->options.priority,
+						     param->options.tcp_nodelay,
+						     proto);
+		if (socks[i] < 0) {
+			int ret = socks[i];
+
+			zperf_close_upload_socks(socks, i);
+			return ret;
+		}
+	}
+
+	return count;
+}
+
+void zperf_close_upload_socks(int *socks, int count)
+{
+	for (int i = 0; i < count; i++) {
+		zsock_close(socks[i]);
+	}
+}
+
+uint16_t zperf_cpu_load_get(void)
+{
+#if defined(CONFIG_CPU_LOAD)
+	int load = cpu_load_get(true);
+
+	if (load > 0) {
+		return load;
+	}
+#endif
+
+	return 0U;
+}
+
 uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps)
 {
 	return (uint32_t)(((uint64_t)packet_size * 8U * USEC_PER_SEC) /
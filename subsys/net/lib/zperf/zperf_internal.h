@@ -131,6 +131,18 @@ extern struct zperf_work *get_queue(enum session_proto proto, int session_id);
 int zperf_prepare_upload_sock(const struct sockaddr *peer_addr, uint8_t tos,
 			      int priority, int tcp_nodelay, int proto);
 
+int zperf_num_streams(const struct zperf_upload_params *param);
+
+/* Open one connected socket per requested stream, returns the number of
+ * sockets opened or a negative error code. On error nothing is left open.
+ */
+int zperf_prepare_upload_socks(const struct zperf_upload_params *param,
+			       int proto, int *socks);
+void zperf_close_upload_socks(int *socks, int count);
+
+/* CPU load in per mille since the previous call, 0 without CONFIG_CPU_LOAD */
+uint16_t zperf_cpu_load_get(void);
+
 uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps);
 
 void zperf_async_work_submit(enum session_proto proto, int session_id, struct k_work *work);
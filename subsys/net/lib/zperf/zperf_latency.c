@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <errno.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/zperf.h>
+
+#include "zperf_internal.h"
+
+/* Log-linear histogram: every power of two is split in 2^SUB_BITS linear
+ * buckets, so a bucket is at most 25% wide and 124 buckets cover the
+ * whole uint32_t microsecond range.
+ */
+#define LATENCY_SUB_BITS 2
+#define LATENCY_SUB_COUNT BIT(LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS ((32 - LATENCY_SUB_BITS + 1) * LATENCY_SUB_COUNT)
+
+/* Requests carry a sequence number so that late responses to requests
+ * which already timed out can be told apart.
+ */
+#define LATENCY_MIN_PACKET_SIZE sizeof(uint32_t)
+
+static uint32_t histogram[LATENCY_BUCKETS];
+static uint8_t request[PACKET_SIZE_MAX];
+static uint8_t response[PACKET_SIZE_MAX];
+static atomic_t latency_busy;
+
+static int latency_bucket(uint32_t value)
+{
+	int msb;
+
+	if (value < LATENCY_SUB_COUNT) {
+		return value;
+	}
+
+	msb = 31 - __builtin_clz(value);
+
+	return (msb - LATENCY_SUB_BITS + 1) * LATENCY_SUB_COUNT +
+	       ((value >> (msb - LATENCY_SUB_BITS)) & (LATENCY_SUB_COUNT - 1));
+}
+
+static uint32_t latency_bucket_max(int bucket)
+{
+	int msb;
+	uint32_t low;
+
+	if (bucket < LATENCY_SUB_COUNT) {
+		return bucket;
+	}
+
+	msb = bucket / LATENCY_SUB_COUNT + LATENCY_SUB_BITS - 1;
+	low = BIT(msb) | ((uint32_t)(bucket % LATENCY_SUB_COUNT) << (msb - LATENCY_SUB_BITS));
+
+	return low + (BIT(msb - LATENCY_SUB_BITS) - 1);
+}
+
+static uint32_t latency_percentile(uint32_t count, uint32_t percent, uint32_t max_us)
+{
+	uint32_t rank = DIV_ROUND_UP((uint64_t)count * percent, 100U);
+	uint32_t seen = 0U;
+
+	for (int i = 0; i < LATENCY_BUCKETS; i++) {
+		seen += histogram[i];
+		if (seen >= rank && seen > 0U) {
+			return MIN(latency_bucket_max(i), max_us);
+		}
+	}
+
+	return max_us;
+}
+
+/* 32-bit cycle counters wrap within seconds on fast cores, so round trips
+ * are timed with the 64-bit cycle counter when the timer has one and with
+ * the 64-bit tick count otherwise.
+ */
+static inline uint64_t latency_timestamp(void)
+{
+	if (IS_ENABLED(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)) {
+		return k_cycle_get_64();
+	}
+
+	return k_uptime_ticks();
+}
+
+static inline uint32_t latency_elapsed_us(uint64_t start)
+{
+	uint64_t delta = latency_timestamp() - start;
+	uint64_t us;
+
+	if (IS_ENABLED(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)) {
+		us = k_cyc_to_us_floor64(delta);
+	} else {
+		us = k_ticks_to_us_floor64(delta);
+	}
+
+	return (uint32_t)MIN(us, UINT32_MAX);
+}
+
+static int latency_send(int sock, size_t len)
+{
+	size_t sent = 0U;
+	ssize_t ret;
+
+	while (sent < len) {
+		ret = zsock_send(sock, request + sent, len - sent, 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		sent += ret;
+	}
+
+	return 0;
+}
+
+static int latency_recv(int sock, int proto, uint32_t seq, size_t len)
+{
+	size_t received = 0U;
+	ssize_t ret;
+
+	while (received < len) {
+		ret = zsock_recv(sock, response + received, len - received, 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		if (ret == 0) {
+			return -ECONNRESET;
+		}
+
+		if (proto == IPPROTO_UDP) {
+			/* Drop stale responses to requests that timed out */
+			if ((size_t)ret < LATENCY_MIN_PACKET_SIZE ||
+			    sys_get_be32(response) != seq) {
+				continue;
+			}
+
+			return 0;
+		}
+
+		received += ret;
+	}
+
+	return 0;
+}
+
+static int latency_run(const struct zperf_upload_params *param, int proto,
+		       struct zperf_latency_results *results)
+{
+	struct timeval rcvtimeo = {
+		.tv_sec = CONFIG_NET_ZPERF_LATENCY_TIMEOUT_MS / MSEC_PER_SEC,
+		.tv_usec = (CONFIG_NET_ZPERF_LATENCY_TIMEOUT_MS % MSEC_PER_SEC) *
+			   USEC_PER_MSEC,
+	};
+	k_timepoint_t end = sys_timepoint_calc(K_MSEC(param->duration_ms));
+	uint32_t packet_size = param->packet_size;
+	uint64_t sum_us = 0U;
+	int64_t start_time;
+	uint32_t seq = 0U;
+	int sock;
+	int ret = 0;
+
+	if (packet_size > PACKET_SIZE_MAX) {
+		NET_WARN("Packet size too large! max size: %u", PACKET_SIZE_MAX);
+		packet_size = PACKET_SIZE_MAX;
+	} else if (packet_size < LATENCY_MIN_PACKET_SIZE) {
+		packet_size = LATENCY_MIN_PACKET_SIZE;
+	}
+
+	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
+					 param->options.priority,
+					 param->options.tcp_nodelay, proto);
+	if (sock < 0) {
+		return sock;
+	}
+
+	if (zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &rcvtimeo,
+			     sizeof(rcvtimeo)) < 0) {
+		NET_ERR("setsockopt error (%d)", errno);
+		ret = -errno;
+		goto out;
+	}
+
+	(void)memset(histogram, 0, sizeof(histogram));
+	(void)memset(request, 'z', packet_size);
+	(void)memset(results, 0, sizeof(*results));
+	results->min_us = UINT32_MAX;
+	results->packet_size = packet_size;
+
+	(void)zperf_cpu_load_get();
+	start_time = k_uptime_ticks();
+
+	do {
+		uint64_t t0;
+		uint32_t rtt_us;
+
+		sys_put_be32(seq, request);
+		t0 = latency_timestamp();
+
+		ret = latency_send(sock, packet_size);
+		if (ret < 0) {
+			NET_ERR("Failed to send the request (%d)", ret);
+			break;
+		}
+
+		results->nb_requests++;
+
+		ret = latency_recv(sock, proto, seq++, packet_size);
+		if (ret == -EAGAIN) {
+			results->nb_timeouts++;
+			if (proto == IPPROTO_TCP) {
+				/* The stream is out of sync, give up */
+				ret = -ETIMEDOUT;
+				break;
+			}
+
+			ret = 0;
+			continue;
+		} else if (ret < 0) {
+			NET_ERR("Failed to receive the response (%d)", ret);
+			break;
+		}
+
+		rtt_us = latency_elapsed_us(t0);
+
+		histogram[latency_bucket(rtt_us)]++;
+		results->nb_responses++;
+		results->min_us = MIN(results->min_us, rtt_us);
+		results->max_us = MAX(results->max_us, rtt_us);
+		sum_us += rtt_us;
+	} while (!sys_timepoint_expired(end));
+
+	results->time_in_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start_time);
+	results->cpu_load = zperf_cpu_load_get();
+
+	if (results->nb_responses == 0U) {
+		results->min_us = 0U;
+	} else {
+		results->avg_us = sum_us / results->nb_responses;
+		results->p50_us = latency_percentile(results->nb_responses, 50U,
+						     results->max_us);
+		results->p90_us = latency_percentile(results->nb_responses, 90U,
+						     results->max_us);
+		results->p99_us = latency_percentile(results->nb_responses, 99U,
+						     results->max_us);
+	}
+
+out:
+	zsock_close(sock);
+
+	return ret;
+}
+
+static int latency_start(const struct zperf_upload_params *param, int proto,
+			 struct zperf_latency_results *result)
+{
+	int ret;
+
+	if (param == NULL || result == NULL) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&latency_busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	ret = latency_run(param, proto, result);
+
+	atomic_clear(&latency_busy);
+
+	return ret;
+}
+
+int zperf_tcp_latency(const struct zperf_upload_params *param,
+		      struct zperf_latency_results *result)
+{
+	if (!IS_ENABLED(CONFIG_NET_TCP)) {
+		return -ENOTSUP;
+	}
+
+	return latency_start(param, IPPROTO_TCP, result);
+}
+
+int zperf_udp_latency(const struct zperf_upload_params *param,
+		      struct zperf_latency_results *result)
+{
+	if (!IS_ENABLED(CONFIG_NET_UDP)) {
+		return -ENOTSUP;
+	}
+
+	return latency_start(param, IPPROTO_UDP, result);
+}
@@ -75,6 +75,11 @@ static struct in_addr shell_ipv4;
 
 #define DEVICE_NAME "zperf shell"
 
+/* Print results as single line JSON objects. Set by the -j option of the
+ * most recently started upload, asynchronous uploads print with it too.
+ */
+static bool json_output;
+
 const uint32_t TIME_US[] = { 60 * 1000 * 1000, 1000 * 1000, 1000, 0 };
 const char *TIME_US_UNIT[] = { "m", "s", "ms", "us" };
 const uint32_t KBPS[] = { 1000, 0 };
@@ -489,6 +494,67 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 
 #endif
 
+static void print_streams_and_cpu_load(const struct shell *sh,
+				       struct zperf_results *results)
+{
+	if (results->nb_streams > 1U) {
+		shell_fprintf(sh, SHELL_NORMAL, "Streams:\t\t%u\n",
+			      results->nb_streams);
+	}
+
+	if (IS_ENABLED(CONFIG_CPU_LOAD)) {
+		shell_fprintf(sh, SHELL_NORMAL, "CPU load:\t\t%u.%u %%\n",
+			      results->cpu_load / 10U, results->cpu_load % 10U);
+	}
+}
+
+static void shell_upload_print_json(const struct shell *sh, const char *type,
+				    bool is_udp, struct zperf_results *results)
+{
+	uint64_t client_rate_in_kbps = 0U;
+
+	if (results->client_time_in_us != 0U) {
+		client_rate_in_kbps = ((uint64_t)results->nb_packets_sent *
+				       results->packet_size * 8U * USEC_PER_SEC) /
+				      (results->client_time_in_us * 1000U);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "{\"type\":\"%s\",\"proto\":\"%s\",\"streams\":%u,"
+		      "\"packet_size\":%u,\"packets_sent\":%u,\"errors\":%u,"
+		      "\"client_time_us\":%llu,\"client_rate_kbps\":%llu",
+		      type, is_udp ? "udp" : "tcp", MAX(results->nb_streams, 1U),
+		      results->packet_size, results->nb_packets_sent,
+		      results->nb_packets_errors, results->client_time_in_us,
+		      client_rate_in_kbps);
+
+	if (is_udp) {
+		uint64_t rate_in_kbps = 0U;
+
+		if (results->time_in_us != 0U) {
+			rate_in_kbps = (results->total_len * 8U * USEC_PER_SEC) /
+				       (results->time_in_us * 1000U);
+		}
+
+		shell_fprintf(sh, SHELL_NORMAL,
+			      ",\"packets_rcvd\":%u,\"packets_lost\":%u,"
+			      "\"packets_outorder\":%u,\"server_time_us\":%llu,"
+			      "\"server_bytes\":%llu,\"jitter_us\":%u,"
+			      "\"server_rate_kbps\":%llu",
+			      results->nb_packets_rcvd, results->nb_packets_lost,
+			      results->nb_packets_outorder, results->time_in_us,
+			      results->total_len, results->jitter_in_us,
+			      rate_in_kbps);
+	}
+
+	if (IS_ENABLED(CONFIG_CPU_LOAD)) {
+		shell_fprintf(sh, SHELL_NORMAL, ",\"cpu_load_permille\":%u",
+			      results->cpu_load);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "}\n");
+}
+
 static void shell_udp_upload_print_stats(const struct shell *sh,
 					 struct zperf_results *results,
 					 bool is_async)
@@ -552,6 +618,8 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, ")\n");
 
+		print_streams_and_cpu_load(sh, results);
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		if (is_async) {
 			struct session *ses = CONTAINER_OF(results,
@@ -609,6 +677,8 @@ static void shell_tcp_upload_print_stats(const struct shell *sh,
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+		print_streams_and_cpu_load(sh, results);
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		if (is_async) {
 			struct session *ses = CONTAINER_OF(results,
@@ -661,6 +731,12 @@ static void shell_tcp_upload_print_periodic(const struct shell *sh,
 			      results->nb_packets_errors);
 		shell_fprintf(sh, SHELL_NORMAL, "Rate: ");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
+
+		if (IS_ENABLED(CONFIG_CPU_LOAD)) {
+			shell_fprintf(sh, SHELL_NORMAL, " | CPU: %u.%u %%",
+				      results->cpu_load / 10U, results->cpu_load % 10U);
+		}
+
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 	}
 }
@@ -680,7 +756,11 @@ static void udp_upload_cb(enum zperf_status status,
 		break;
 
 	case ZPERF_SESSION_FINISHED: {
-		shell_udp_upload_print_stats(sh, result, true);
+		if (json_output) {
+			shell_upload_print_json(sh, "summary", true, result);
+		} else {
+			shell_udp_upload_print_stats(sh, result, true);
+		}
 
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		ses->in_progress = false;
@@ -719,11 +799,19 @@ static void tcp_upload_cb(enum zperf_status status,
 		break;
 
 	case ZPERF_SESSION_PERIODIC_RESULT:
-		shell_tcp_upload_print_periodic(sh, result);
+		if (json_output) {
+			shell_upload_print_json(sh, "interval", false, result);
+		} else {
+			shell_tcp_upload_print_periodic(sh, result);
+		}
 		break;
 
 	case ZPERF_SESSION_FINISHED: {
-		shell_tcp_upload_print_stats(sh, result, true);
+		if (json_output) {
+			shell_upload_print_json(sh, "summary", false, result);
+		} else {
+			shell_tcp_upload_print_stats(sh, result, true);
+		}
 
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		ses->in_progress = false;
@@ -796,9 +884,81 @@ static void send_ping(const struct shell *sh,
 	(void)net_icmp_cleanup_ctx(&ctx);
 }
 
+#ifdef CONFIG_NET_ZPERF_LATENCY
+static void shell_latency_print_stats(const struct shell *sh, bool is_udp,
+				      struct zperf_latency_results *results)
+{
+	if (json_output) {
+		shell_fprintf(sh, SHELL_NORMAL,
+			      "{\"type\":\"latency\",\"proto\":\"%s\","
+			      "\"packet_size\":%u,\"time_us\":%llu,"
+			      "\"requests\":%u,\"responses\":%u,\"timeouts\":%u,"
+			      "\"min_us\":%u,\"avg_us\":%u,\"max_us\":%u,"
+			      "\"p50_us\":%u,\"p90_us\":%u,\"p99_us\":%u",
+			      is_udp ? "udp" : "tcp", results->packet_size,
+			      results->time_in_us, results->nb_requests,
+			      results->nb_responses, results->nb_timeouts,
+			      results->min_us, results->avg_us, results->max_us,
+			      results->p50_us, results->p90_us, results->p99_us);
+
+		if (IS_ENABLED(CONFIG_CPU_LOAD)) {
+			shell_fprintf(sh, SHELL_NORMAL, ",\"cpu_load_permille\":%u",
+				      results->cpu_load);
+		}
+
+		shell_fprintf(sh, SHELL_NORMAL, "}\n");
+		return;
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "-\nLatency test completed!\n");
+	shell_fprintf(sh, SHELL_NORMAL, "Duration:\t\t");
+	print_number_64(sh, results->time_in_us, TIME_US, TIME_US_UNIT);
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+	shell_fprintf(sh, SHELL_NORMAL, "Requests:\t\t%u\n",
+		      results->nb_requests);
+	shell_fprintf(sh, SHELL_NORMAL, "Responses:\t\t%u\n",
+		      results->nb_responses);
+	shell_fprintf(sh, SHELL_NORMAL, "Timeouts:\t\t%u\n",
+		      results->nb_timeouts);
+	shell_fprintf(sh, SHELL_NORMAL, "RTT min/avg/max:\t%u/%u/%u us\n",
+		      results->min_us, results->avg_us, results->max_us);
+	shell_fprintf(sh, SHELL_NORMAL, "RTT p50/p90/p99:\t%u/%u/%u us\n",
+		      results->p50_us, results->p90_us, results->p99_us);
+
+	if (IS_ENABLED(CONFIG_CPU_LOAD)) {
+		shell_fprintf(sh, SHELL_NORMAL, "CPU load:\t\t%u.%u %%\n",
+			      results->cpu_load / 10U, results->cpu_load % 10U);
+	}
+}
+
+static int execute_latency(const struct shell *sh,
+			   const struct zperf_upload_params *param,
+			   bool is_udp)
+{
+	struct zperf_latency_results results;
+	int ret;
+
+	if (is_udp) {
+		ret = zperf_udp_latency(param, &results);
+	} else {
+		ret = zperf_tcp_latency(param, &results);
+	}
+
+	if (ret < 0) {
+		shell_fprintf(sh, SHELL_ERROR, "%s latency test failed (%d)\n",
+			      is_udp ? "UDP" : "TCP", ret);
+		return ret;
+	}
+
+	shell_latency_print_stats(sh, is_udp, &results);
+
+	return 0;
+}
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+
 static int execute_upload(const struct shell *sh,
 			  const struct zperf_upload_params *param,
-			  bool is_udp, bool async)
+			  bool is_udp, bool async, bool latency)
 {
 	struct zperf_results results = { 0 };
 	int ret;
@@ -830,6 +990,20 @@ static int execute_upload(const struct shell *sh,
 		send_ping(sh, &ipv6->sin6_addr, MSEC_PER_SEC);
 	}
 
+#ifdef CONFIG_NET_ZPERF_LATENCY
+	if (latency) {
+		if (async) {
+			shell_fprintf(sh, SHELL_WARNING,
+				      "Latency test cannot be run asynchronously\n");
+			return -ENOEXEC;
+		}
+
+		return execute_latency(sh, param, is_udp);
+	}
+#else
+	ARG_UNUSED(latency);
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+
 	if (is_udp && IS_ENABLED(CONFIG_NET_UDP)) {
 		uint32_t packet_duration =
 			zperf_packet_duration(param->packet_size, param->rate_kbps);
@@ -862,7 +1036,11 @@ static int execute_upload(const struct shell *sh,
 				return ret;
 			}
 
-			shell_udp_upload_print_stats(sh, &results, false);
+			if (json_output) {
+				shell_upload_print_json(sh, "summary", true, &results);
+			} else {
+				shell_udp_upload_print_stats(sh, &results, false);
+			}
 		}
 	} else {
 		if (is_udp && !IS_ENABLED(CONFIG_NET_UDP)) {
@@ -888,7 +1066,11 @@ static int execute_upload(const struct shell *sh,
 				return ret;
 			}
 
-			shell_tcp_upload_print_stats(sh, &results, false);
+			if (json_output) {
+				shell_upload_print_json(sh, "summary", false, &results);
+			} else {
+				shell_tcp_upload_print_stats(sh, &results, false);
+			}
 		}
 	} else {
 		if (!is_udp && !IS_ENABLED(CONFIG_NET_TCP)) {
@@ -956,6 +1138,8 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 	struct sockaddr_in ipv4 = { .sin_family = AF_INET };
 	char *port_str;
 	bool async = false;
+	bool latency = false;
+	bool json = false;
 	bool is_udp;
 	int start = 0;
 	size_t opt_cnt = 0;
@@ -1064,6 +1248,34 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Invalid number of streams, valid "
+					      "values are [1, %d]\n",
+					      CONFIG_NET_ZPERF_MAX_STREAMS);
+				return -ENOEXEC;
+			}
+
+			param.options.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
+#ifdef CONFIG_NET_ZPERF_LATENCY
+		case 'L':
+			latency = true;
+			opt_cnt += 1;
+			break;
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+
+		case 'j':
+			json = true;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1192,7 +1404,9 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 		param.rate_kbps = DEF_RATE_KBPS;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	json_output = json;
+
+	return execute_upload(sh, &param, is_udp, async, latency);
 }
 
 static int cmd_tcp_upload(const struct shell *sh, size_t argc, char *argv[])
@@ -1212,6 +1426,8 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 	sa_family_t family;
 	uint8_t is_udp;
 	bool async = false;
+	bool latency = false;
+	bool json = false;
 	int start = 0;
 	size_t opt_cnt = 0;
 	int seconds;
@@ -1317,6 +1533,34 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Invalid number of streams, valid "
+					      "values are [1, %d]\n",
+					      CONFIG_NET_ZPERF_MAX_STREAMS);
+				return -ENOEXEC;
+			}
+
+			param.options.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
+#ifdef CONFIG_NET_ZPERF_LATENCY
+		case 'L':
+			latency = true;
+			opt_cnt += 1;
+			break;
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+
+		case 'j':
+			json = true;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1398,7 +1642,9 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 		param.rate_kbps = DEF_RATE_KBPS;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	json_output = json;
+
+	return execute_upload(sh, &param, is_udp, async, latency);
 }
 
 static int cmd_tcp_upload2(const struct shell *sh, size_t argc,
@@ -1905,6 +2151,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-P num: Number of parallel streams\n"
+#ifdef CONFIG_NET_ZPERF_LATENCY
+		  "-L: Request/response latency test, the peer must echo the data\n"
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+		  "-j: Print the results in JSON format\n"
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
@@ -1929,6 +2180,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-P num: Number of parallel streams\n"
+#ifdef CONFIG_NET_ZPERF_LATENCY
+		  "-L: Request/response latency test, the peer must echo the data\n"
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+		  "-j: Print the results in JSON format\n"
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
@@ -1989,6 +2245,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
+		  "-P num: Number of parallel streams\n"
+#ifdef CONFIG_NET_ZPERF_LATENCY
+		  "-L: Request/response latency test, the peer must echo the data\n"
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+		  "-j: Print the results in JSON format\n"
 		  "-I: Specify host interface name\n"
 		  "Example: udp upload 192.0.2.2 1111 1 1K 1M\n"
 		  "Example: udp upload 2001:db8::2\n",
@@ -2014,6 +2275,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
+		  "-P num: Number of parallel streams\n"
+#ifdef CONFIG_NET_ZPERF_LATENCY
+		  "-L: Request/response latency test, the peer must echo the data\n"
+#endif /* CONFIG_NET_ZPERF_LATENCY */
+		  "-j: Print the results in JSON format\n"
 		  "-I: Specify host interface name\n"
 		  "Example: udp upload2 v4 1 1K 1M\n"
 		  "Example: udp upload2 v6\n"
@@ -39,7 +39,7 @@ static ssize_t sendall(int sock, const void *buf, size_t len)
 	return 0;
 }
 
-static int tcp_upload(int sock,
+static int tcp_upload(int *socks, int num_socks,
 		      unsigned int duration_in_ms,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results,
@@ -50,6 +50,7 @@ static int tcp_upload(int sock,
 	uint32_t nb_packets = 0U, nb_errors = 0U;
 	uint32_t packet_size = param->packet_size;
 	uint32_t alloc_errors = 0U;
+	int stream = 0;
 	int ret = 0;
 
 	if (packet_size > PACKET_SIZE_MAX) {
@@ -81,8 +82,12 @@ static int tcp_upload(int sock,
 		}
 		*data_offset += packet_size;
 
-		/* Send the packet */
-		ret = sendall(sock, sample_packet, packet_size);
+		/* Send the packet, streams are served round-robin */
+		ret = sendall(socks[stream], sample_packet, packet_size);
+		if (++stream == num_socks) {
+			stream = 0;
+		}
+
 		if (ret < 0) {
 			if (nb_errors == 0 && ret != -ENOMEM) {
 				NET_ERR("Failed to send the packet (%d)", errno);
@@ -122,6 +127,8 @@ static int tcp_upload(int sock,
 	results->packet_size = packet_size;
 	results->nb_packets_errors = nb_errors;
 	results->total_len = (uint64_t)nb_packets * packet_size;
+	results->cpu_load = zperf_cpu_load_get();
+	results->nb_streams = num_socks;
 
 	if (alloc_errors > 0) {
 		NET_WARN("There was %u network buffer allocation "
@@ -142,24 +149,27 @@ static int tcp_upload(int sock,
 int zperf_tcp_upload(const struct zperf_upload_params *param,
 		     struct zperf_results *result)
 {
+	int socks[CONFIG_NET_ZPERF_MAX_STREAMS];
 	uint64_t data_offset = 0;
-	int sock;
+	int num_socks;
 	int ret;
 
 	if (param == NULL || result == NULL) {
 		return -EINVAL;
 	}
 
-	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
-					 param->options.priority, param->options.tcp_nodelay,
-					 IPPROTO_TCP);
-	if (sock < 0) {
-		return sock;
+	num_socks = zperf_prepare_upload_socks(param, IPPROTO_TCP, socks);
+	if (num_socks < 0) {
+		return num_socks;
 	}
 
-	ret = tcp_upload(sock, param->duration_ms, param, result, &data_offset);
+	/* Reset the CPU load measurement so it covers the upload only */
+	(void)zperf_cpu_load_get();
+
+	ret = tcp_upload(socks, num_socks, param->duration_ms, param, result,
+			 &data_offset);
 
-	zsock_close(sock);
+	zperf_close_upload_socks(socks, num_socks);
 
 	return ret;
 }
@@ -198,22 +208,22 @@ static void tcp_upload_async_work(struct k_work *work)
 
 	int ret;
 	struct zperf_upload_params param = upload_ctx->param;
+	int socks[CONFIG_NET_ZPERF_MAX_STREAMS];
 	uint64_t data_offset = 0;
-	int sock;
+	int num_socks;
 
 	upload_ctx->callback(ZPERF_SESSION_STARTED, NULL,
 			     upload_ctx->user_data);
 
-	sock = zperf_prepare_upload_sock(&param.peer_addr, param.options.tos,
-					 param.options.priority, param.options.tcp_nodelay,
-					 IPPROTO_TCP);
-
-	if (sock < 0) {
+	num_socks = zperf_prepare_upload_socks(&param, IPPROTO_TCP, socks);
+	if (num_socks < 0) {
 		upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 				     upload_ctx->user_data);
 		return;
 	}
 
+	(void)zperf_cpu_load_get();
+
 	if (param.options.report_interval_ms > 0) {
 		uint32_t report_interval = param.options.report_interval_ms;
 		uint32_t duration = param.duration_ms;
@@ -224,6 +234,8 @@ static void tcp_upload_async_work(struct k_work *work)
 		uint32_t rounds = (duration + report_interval - 1) / report_interval;
 		uint32_t last_round_duration = duration - ((rounds - 1) * report_interval);
 
+		uint32_t total_rounds = rounds;
+		uint32_t cpu_load_sum = 0U;
 		struct zperf_results periodic_result;
 
 		for (; rounds > 0; rounds--) {
@@ -234,8 +246,8 @@ static void tcp_upload_async_work(struct k_work *work)
 			} else {
 				round_duration = report_interval;
 			}
-			ret = tcp_upload(sock, round_duration, &param, &periodic_result,
-				&data_offset);
+			ret = tcp_upload(socks, num_socks, round_duration, &param,
+					 &periodic_result, &data_offset);
 			if (ret < 0) {
 				upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 						     upload_ctx->user_data);
@@ -247,12 +259,17 @@ static void tcp_upload_async_work(struct k_work *work)
 			result->nb_packets_sent += periodic_result.nb_packets_sent;
 			result->client_time_in_us += periodic_result.client_time_in_us;
 			result->nb_packets_errors += periodic_result.nb_packets_errors;
+			result->total_len += periodic_result.total_len;
+			cpu_load_sum += periodic_result.cpu_load;
 		}
 
 		result->packet_size = periodic_result.packet_size;
+		result->cpu_load = cpu_load_sum / total_rounds;
+		result->nb_streams = num_socks;
 
 	} else {
-		ret = tcp_upload(sock, param.duration_ms, &param, result, &data_offset);
+		ret = tcp_upload(socks, num_socks, param.duration_ms, &param, result,
+				 &data_offset);
 		if (ret < 0) {
 			upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 					     upload_ctx->user_data);
@@ -263,7 +280,7 @@ static void tcp_upload_async_work(struct k_work *work)
 	upload_ctx->callback(ZPERF_SESSION_FINISHED, result,
 			     upload_ctx->user_data);
 cleanup:
-	zsock_close(sock);
+	zperf_close_upload_socks(socks, num_socks);
 }
 
 int zperf_tcp_upload_async(const struct zperf_upload_params *param,
@@ -146,7 +146,7 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
-static int udp_upload(int sock, int port,
+static int udp_upload(int *socks, int num_socks, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
 {
@@ -166,6 +166,7 @@ static int udp_upload(int sock, int port,
 	uint32_t print_period;
 	bool is_mcast_pkt = false;
 	int ret;
+	int i;
 
 	if (packet_size > PACKET_SIZE_MAX) {
 		NET_WARN("Packet size too large! max size: %u", PACKET_SIZE_MAX);
@@ -222,7 +223,7 @@ static int udp_upload(int sock, int port,
 		/* Fill the packet header */
 		datagram = (struct zperf_udp_datagram *)sample_packet;
 
-		datagram->id = htonl(nb_packets);
+		datagram->id = htonl(nb_packets / num_socks);
 		datagram->tv_sec = htonl(secs);
 		datagram->tv_usec = htonl(usecs);
 
@@ -233,7 +234,7 @@ static int udp_upload(int sock, int port,
 		hdr->port = htonl(port);
 		hdr->buffer_len = sizeof(sample_packet) -
 			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
+		hdr->bandwidth = htonl(rate_in_kbps / num_socks);
 		hdr->num_of_bytes = htonl(packet_size);
 
 		/* Load custom data payload if requested */
@@ -247,15 +248,19 @@ static int udp_upload(int sock, int port,
 		}
 		data_offset += packet_size - header_size;
 
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		/* Send the packet. The datagrams are spread round robin over
+		 * the streams so that the requested rate is the total over
+		 * all of them, each stream numbering its datagrams on its own.
+		 */
+		ret = zsock_send(socks[nb_packets % num_socks], sample_packet,
+				 packet_size, 0);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
-		} else {
-			nb_packets++;
 		}
 
+		nb_packets++;
+
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
 			if (print_time >= loop_time) {
 				NET_DBG("nb_packets=%u\tdelay=%u\tadjust=%d",
@@ -289,13 +294,37 @@ static int udp_upload(int sock, int port,
 	} else {
 		return -EINVAL;
 	}
-	ret = zperf_upload_fin(sock, nb_packets, usecs64, packet_size, results, is_mcast_pkt);
-	if (ret < 0) {
-		return ret;
+
+	results->cpu_load = zperf_cpu_load_get();
+	results->nb_packets_rcvd = 0U;
+	results->nb_packets_lost = 0U;
+	results->nb_packets_outorder = 0U;
+	results->total_len = 0U;
+	results->time_in_us = 0U;
+	results->jitter_in_us = 0U;
+
+	for (i = 0; i < num_socks; i++) {
+		struct zperf_results stream_results = { 0 };
+		uint32_t stream_packets = (nb_packets + num_socks - 1 - i) / num_socks;
+
+		ret = zperf_upload_fin(socks[i], stream_packets, usecs64, packet_size,
+				       &stream_results, is_mcast_pkt);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Aggregate the server reports of all streams */
+		results->nb_packets_rcvd += stream_results.nb_packets_rcvd;
+		results->nb_packets_lost += stream_results.nb_packets_lost;
+		results->nb_packets_outorder += stream_results.nb_packets_outorder;
+		results->total_len += stream_results.total_len;
+		results->time_in_us = MAX(results->time_in_us, stream_results.time_in_us);
+		results->jitter_in_us = MAX(results->jitter_in_us, stream_results.jitter_in_us);
 	}
 
 	/* Add result coming from the client */
 	results->nb_packets_sent = nb_packets;
+	results->nb_streams = num_socks;
 	results->client_time_in_us =
 				k_ticks_to_us_ceil64(end_time - start_time);
 	results->packet_size = packet_size;
@@ -306,8 +335,9 @@ static int udp_upload(int sock, int port,
 int zperf_udp_upload(const struct zperf_upload_params *param,
 		     struct zperf_results *result)
 {
+	int socks[CONFIG_NET_ZPERF_MAX_STREAMS];
+	int num_socks;
 	int port = 0;
-	int sock;
 	int ret;
 	struct ifreq req;
 
@@ -325,10 +355,9 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 		return -EINVAL;
 	}
 
-	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
-					 param->options.priority, 0, IPPROTO_UDP);
-	if (sock < 0) {
-		return sock;
+	num_socks = zperf_prepare_upload_socks(param, IPPROTO_UDP, socks);
+	if (num_socks < 0) {
+		return num_socks;
 	}
 
 	if (param->if_name[0]) {
@@ -336,15 +365,20 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 		strncpy(req.ifr_name, param->if_name, IFNAMSIZ);
 		req.ifr_name[IFNAMSIZ - 1] = 0;
 
-		if (zsock_setsockopt(sock, SOL_SOCKET, SO_BINDTODEVICE, &req,
-				     sizeof(struct ifreq)) != 0) {
-			NET_WARN("setsockopt SO_BINDTODEVICE error (%d)", -errno);
+		for (int i = 0; i < num_socks; i++) {
+			if (zsock_setsockopt(socks[i], SOL_SOCKET, SO_BINDTODEVICE, &req,
+					     sizeof(struct ifreq)) != 0) {
+				NET_WARN("setsockopt SO_BINDTODEVICE error (%d)", -errno);
+			}
 		}
 	}
 
-	ret = udp_upload(sock, port, param, result);
+	/* Reset the CPU load measurement so it covers the upload only */
+	(void)zperf_cpu_load_get();
+
+	ret = udp_upload(socks, num_socks, port, param, result);
 
-	zsock_close(sock);
+	zperf_close_upload_socks(socks, num_socks);
 
 	return ret;
 }
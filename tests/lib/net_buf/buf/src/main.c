@@ -71,6 +71,7 @@ static void var_destroy(struct net_buf *buf);
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, FIXED_BUFFER_SIZE, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_POOL_FIXED_DEFINE(bulk_pool, 8, FIXED_BUFFER_SIZE, USER_DATA_FIXED, NULL);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -980,5 +981,53 @@ ZTEST(net_buf_tests, test_net_buf_fixed_append)
 	net_buf_unref(buf);
 }
 
+ZTEST(net_buf_tests, test_net_buf_bulk)
+{
+	struct net_buf *buf, *frag, *middle;
+	int count = 0;
+
+	buf = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, 9, K_NO_WAIT);
+	zassert_is_null(buf, "Allocated more buffers than the pool has");
+
+	buf = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, 8, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffers");
+
+	for (frag = buf; frag; frag = frag->frags) {
+		zassert_equal(frag->size, FIXED_BUFFER_SIZE, "Invalid buffer size");
+		zassert_equal(frag->len, 0, "Invalid buffer length");
+		zassert_equal(frag->ref, 1, "Invalid buffer reference count");
+		count++;
+	}
+
+	zassert_equal(count, 8, "Invalid number of buffers in chain");
+
+	zassert_is_null(net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, 1,
+					   K_NO_WAIT),
+			"Pool should be empty");
+
+	net_buf_unref_chain(buf);
+
+	/* All the buffers must be back in the pool */
+	buf = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, 8, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffers");
+
+	/* Releasing a chain stops at a buffer that is still referenced */
+	middle = buf->frags->frags;
+	net_buf_ref(middle);
+
+	net_buf_unref_chain(buf);
+
+	zassert_equal(middle->ref, 1, "Invalid buffer reference count");
+	zassert_is_null(net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, 7,
+					   K_NO_WAIT),
+			"Buffers after the referenced one must not be freed");
+
+	net_buf_unref_chain(middle);
+
+	buf = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, 8, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffers");
+
+	net_buf_unref_chain(buf);
+}
 
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
@@ -694,4 +694,76 @@ ZTEST(arp_fn_tests, test_arp)
 	}
 }
 
+static void arp_count_cb(struct arp_entry *entry, void *user_data)
+{
+	int *count = user_data;
+
+	ARG_UNUSED(entry);
+
+	(*count)++;
+}
+
+static bool arp_entry_exists(struct in_addr *addr, struct net_eth_addr *hwaddr)
+{
+	entry_found = false;
+	expected_hwaddr = hwaddr;
+	net_arp_foreach(arp_cb, addr);
+
+	return entry_found;
+}
+
+ZTEST(arp_fn_tests, test_arp_table_full)
+{
+	struct in_addr first = { { { 198, 51, 100, 1 } } };
+	struct net_eth_addr hwaddr = { { 0x02, 0x00, 0x5e, 0x00, 0x00, 0x00 } };
+	struct net_if *iface;
+	struct in_addr addr;
+	int count;
+
+	net_arp_init();
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+	net_arp_clear_cache(iface);
+
+	/* Fill the table, then add one more entry which must replace the
+	 * least recently used one.
+	 */
+	for (int i = 0; i <= CONFIG_NET_ARP_TABLE_SIZE; i++) {
+		addr.s_addr = htonl(ntohl(first.s_addr) + i);
+		hwaddr.addr[5] = i;
+
+		net_arp_update(iface, &addr, &hwaddr, false, true);
+	}
+
+	count = 0;
+	net_arp_foreach(arp_count_cb, &count);
+	zassert_equal(count, CONFIG_NET_ARP_TABLE_SIZE, "Invalid entry count %d", count);
+
+	hwaddr.addr[5] = 0;
+	zassert_false(arp_entry_exists(&first, &hwaddr), "Oldest entry not replaced");
+
+	for (int i = 1; i <= CONFIG_NET_ARP_TABLE_SIZE; i++) {
+		addr.s_addr = htonl(ntohl(first.s_addr) + i);
+		hwaddr.addr[5] = i;
+
+		zassert_true(arp_entry_exists(&addr, &hwaddr), "Entry %d not found", i);
+	}
+
+	/* Updating an existing entry must not create a new one */
+	addr.s_addr = htonl(ntohl(first.s_addr) + 1);
+	hwaddr.addr[5] = 0xaa;
+	net_arp_update(iface, &addr, &hwaddr, false, true);
+	zassert_true(arp_entry_exists(&addr, &hwaddr), "Entry not updated");
+
+	count = 0;
+	net_arp_foreach(arp_count_cb, &count);
+	zassert_equal(count, CONFIG_NET_ARP_TABLE_SIZE, "Invalid entry count %d", count);
+
+	net_arp_clear_cache(iface);
+
+	count = 0;
+	net_arp_foreach(arp_count_cb, &count);
+	zassert_equal(count, 0, "ARP table not cleared (%d)", count);
+}
+
 ZTEST_SUITE(arp_fn_tests, NULL, NULL, NULL, NULL, NULL);
@@ -946,6 +946,169 @@ ZTEST(net_iface, test_v6_addr_add_rm)
 	v6_addr_rm();
 }
 
+ZTEST(net_iface, test_addr_lookup_add_rm_many)
+{
+	struct net_if *ifaces[] = { iface1, iface2 };
+	struct in6_addr addr6[ARRAY_SIZE(ifaces)][2];
+	struct in_addr addr4[ARRAY_SIZE(ifaces)];
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+
+	/* Addresses differing in a single byte end up in the same area of a
+	 * hashed address index, which exercises removal from the middle of
+	 * a collision chain.
+	 */
+	ARRAY_FOR_EACH(ifaces, i) {
+		ARRAY_FOR_EACH(addr6[i], j) {
+			net_ipv6_addr_create(&addr6[i][j], 0x2001, 0x0db8, 0xaaaa,
+					     0, 0, 0, i, j + 1);
+			ifaddr = net_if_ipv6_addr_add(ifaces[i], &addr6[i][j],
+						      NET_ADDR_MANUAL, 0);
+			zassert_not_null(ifaddr, "Cannot add IPv6 address");
+		}
+
+		/* 198.51.100.1 and up */
+		addr4[i].s_addr = htonl(0xc6336401 + i);
+		ifaddr = net_if_ipv4_addr_add(ifaces[i], &addr4[i],
+					      NET_ADDR_MANUAL, 0);
+		zassert_not_null(ifaddr, "Cannot add IPv4 address");
+	}
+
+	ARRAY_FOR_EACH(ifaces, i) {
+		ARRAY_FOR_EACH(addr6[i], j) {
+			iface = NULL;
+			ifaddr = net_if_ipv6_addr_lookup(&addr6[i][j], &iface);
+			zassert_not_null(ifaddr, "IPv6 address not found");
+			zassert_equal_ptr(iface, ifaces[i], "Wrong interface");
+		}
+
+		iface = NULL;
+		ifaddr = net_if_ipv4_addr_lookup(&addr4[i], &iface);
+		zassert_not_null(ifaddr, "IPv4 address not found");
+		zassert_equal_ptr(iface, ifaces[i], "Wrong interface");
+	}
+
+	/* Remove the first address of each interface and check that the
+	 * others can still be found.
+	 */
+	ARRAY_FOR_EACH(ifaces, i) {
+		zassert_true(net_if_ipv6_addr_rm(ifaces[i], &addr6[i][0]),
+			     "Cannot remove IPv6 address");
+	}
+
+	zassert_true(net_if_ipv4_addr_rm(iface1, &addr4[0]),
+		     "Cannot remove IPv4 address");
+
+	ARRAY_FOR_EACH(ifaces, i) {
+		ARRAY_FOR_EACH(addr6[i], j) {
+			ifaddr = net_if_ipv6_addr_lookup(&addr6[i][j], NULL);
+			if (j == 0) {
+				zassert_is_null(ifaddr, "Removed IPv6 address found");
+			} else {
+				zassert_not_null(ifaddr, "IPv6 address not found");
+			}
+		}
+	}
+
+	zassert_is_null(net_if_ipv4_addr_lookup(&addr4[0], NULL),
+			"Removed IPv4 address found");
+	zassert_not_null(net_if_ipv4_addr_lookup(&addr4[1], NULL),
+			 "IPv4 address not found");
+
+	ARRAY_FOR_EACH(ifaces, i) {
+		zassert_true(net_if_ipv6_addr_rm(ifaces[i], &addr6[i][1]),
+			     "Cannot remove IPv6 address");
+	}
+
+	zassert_true(net_if_ipv4_addr_rm(iface2, &addr4[1]),
+		     "Cannot remove IPv4 address");
+
+	ARRAY_FOR_EACH(ifaces, i) {
+		ARRAY_FOR_EACH(addr6[i], j) {
+			zassert_is_null(net_if_ipv6_addr_lookup(&addr6[i][j], NULL),
+					"Removed IPv6 address found");
+		}
+	}
+}
+
+ZTEST(net_iface, test_v6_select_src_addr_after_rm)
+{
+	struct in6_addr addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0xca, 0xfe, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr dst = { { { 0x20, 0x01, 0x0d, 0xb8, 0xca, 0xfe, 0, 0,
+				    0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+	const struct in6_addr *src;
+	struct net_if_addr *ifaddr;
+
+	ifaddr = net_if_ipv6_addr_add(iface1, &addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv6 address");
+
+	/* Select twice, the second selection may come from a cache */
+	for (int i = 0; i < 2; i++) {
+		src = net_if_ipv6_select_src_addr(iface1, &dst);
+		zassert_true(net_ipv6_addr_cmp(src, &addr),
+			     "Wrong source address selected");
+	}
+
+	zassert_true(net_if_ipv6_addr_rm(iface1, &addr),
+		     "Cannot remove IPv6 address");
+
+	src = net_if_ipv6_select_src_addr(iface1, &dst);
+	zassert_false(net_ipv6_addr_cmp(src, &addr),
+		      "Removed address selected as source");
+}
+
+ZTEST(net_iface, test_v6_select_src_addr_after_deprecate)
+{
+	struct in6_addr addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0xca, 0xfe, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr addr_longer = { { { 0x20, 0x01, 0x0d, 0xb8, 0xca, 0xfe, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x3 } } };
+	struct in6_addr dst = { { { 0x20, 0x01, 0x0d, 0xb8, 0xca, 0xfe, 0, 0,
+				    0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+	struct net_if_addr *ifaddr, *ifaddr_longer;
+	const struct in6_addr *src;
+
+	ifaddr = net_if_ipv6_addr_add(iface1, &addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv6 address");
+
+	ifaddr_longer = net_if_ipv6_addr_add(iface1, &addr_longer,
+					     NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr_longer, "Cannot add IPv6 address");
+
+	/* Both addresses are preferred, the longer matching prefix wins. The
+	 * second selection may come from a cache.
+	 */
+	for (int i = 0; i < 2; i++) {
+		src = net_if_ipv6_select_src_addr(iface1, &dst);
+		zassert_true(net_ipv6_addr_cmp(src, &addr_longer),
+			     "Wrong source address selected");
+	}
+
+	/* Deprecate the selected address the way the privacy extensions do,
+	 * by changing its state directly. The preferred address must be
+	 * selected instead.
+	 */
+	ifaddr_longer->addr_state = NET_ADDR_DEPRECATED;
+
+	for (int i = 0; i < 2; i++) {
+		src = net_if_ipv6_select_src_addr(iface1, &dst);
+		zassert_true(net_ipv6_addr_cmp(src, &addr),
+			     "Deprecated address selected as source");
+	}
+
+	zassert_true(net_if_ipv6_addr_rm(iface1, &addr),
+		     "Cannot remove IPv6 address");
+
+	/* Without a preferred address, the deprecated one is used */
+	src = net_if_ipv6_select_src_addr(iface1, &dst);
+	zassert_true(net_ipv6_addr_cmp(src, &addr_longer),
+		     "Deprecated address not selected as source");
+
+	zassert_true(net_if_ipv6_addr_rm(iface1, &addr_longer),
+		     "Cannot remove IPv6 address");
+}
+
 ZTEST(net_iface, test_v6_addr_add_rm_solicited)
 {
 	const struct in6_addr prefix = { { { 0x20, 0x01, 0x1b, 0x98, 0x24, 0xb8, 0x7e, 0xbb,
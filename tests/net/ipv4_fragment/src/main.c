@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_ipv4_test, CONFIG_NET_IPV4_LOG_LEVEL);
 #include <errno.h>
 #include <zephyr/linker/sections.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/ztest.h>
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/dummy.h>
@@ -34,6 +35,18 @@ LOG_MODULE_REGISTER(net_ipv4_test, CONFIG_NET_IPV4_LOG_LEVEL);
 #define WAIT_TIME K_MSEC(1100)
 #define ALLOC_TIMEOUT K_MSEC(500)
 
+/* Fragment payload size for the out of order reassembly test. Every fragment fits into one
+ * data buffer and the reassembled datagram fits into the IPv4 total length field.
+ */
+#define REASSEMBLY_FRAG_LEN ROUND_DOWN(MIN(CONFIG_NET_BUF_DATA_SIZE - NET_IPV4H_LEN,	\
+					   (UINT16_MAX - NET_IPV4H_LEN) /		\
+					   CONFIG_NET_IPV4_FRAGMENT_MAX_PKT), 8)
+#define REASSEMBLY_FRAG_COUNT CONFIG_NET_IPV4_FRAGMENT_MAX_PKT
+#define REASSEMBLY_UDP_LEN (REASSEMBLY_FRAG_LEN * REASSEMBLY_FRAG_COUNT)
+#define REASSEMBLY_ROUNDS 8
+#define REASSEMBLY_SRC_PORT 5000
+#define REASSEMBLY_DST_PORT 5001
+
 /* Dummy network addresses, 192.168.8.1 and 192.168.8.2 */
 static struct in_addr my_addr1 = { { { 0xc0, 0xa8, 0x08, 0x01 } } };
 static struct in_addr my_addr2 = { { { 0xc0, 0xa8, 0x08, 0x02 } } };
@@ -135,6 +148,7 @@ static struct net_if *iface1;
 
 static struct k_sem wait_data;
 static struct k_sem wait_received_data;
+static struct k_sem wait_reassembled_data;
 
 static bool test_started;
 static uint16_t pkt_id;
@@ -544,6 +558,22 @@ static void setup_udp_handler(const struct in_addr *raddr, const struct in_addr
 	zassert_equal(ret, 0, "Cannot register UDP connection");
 }
 
+static enum net_verdict reassembled_data_received(struct net_conn *conn, struct net_pkt *pkt,
+						  union net_ip_header *ip_hdr,
+						  union net_proto_header *proto_hdr,
+						  void *user_data)
+{
+	zassert_true(net_pkt_is_ip_reassembled(pkt), "Expected a reassembled packet");
+	zassert_equal(net_pkt_get_len(pkt), NET_IPV4H_LEN + REASSEMBLY_UDP_LEN,
+		      "Reassembled packet length mismatch");
+
+	net_pkt_unref(pkt);
+
+	k_sem_give(&wait_reassembled_data);
+
+	return NET_OK;
+}
+
 static void setup_tcp_handler(const struct in_addr *raddr, const struct in_addr *laddr,
 			      uint16_t remote_port, uint16_t local_port)
 {
@@ -567,11 +597,14 @@ static void setup_tcp_handler(const struct in_addr *raddr, const struct in_addr
 
 static void *test_setup(void)
 {
+	static struct net_conn_handle *reassembly_handle;
 	struct net_if_addr *ifaddr;
+	int ret;
 
 	/* The semaphore is there to wait the data to be received. */
 	k_sem_init(&wait_data, 0, UINT_MAX);
 	k_sem_init(&wait_received_data, 0, UINT_MAX);
+	k_sem_init(&wait_reassembled_data, 0, UINT_MAX);
 
 	iface1 = net_if_get_by_index(1);
 	zassert_not_null(iface1, "Network interface is null");
@@ -590,6 +623,10 @@ static void *test_setup(void)
 	setup_udp_handler(&my_addr1, &my_addr2, 4352, 25348);
 	setup_tcp_handler(&my_addr1, &my_addr2, 4092, 19551);
 
+	ret = net_udp_register(AF_INET, NULL, NULL, REASSEMBLY_SRC_PORT, REASSEMBLY_DST_PORT,
+			       NULL, reassembled_data_received, NULL, &reassembly_handle);
+	zassert_equal(ret, 0, "Cannot register UDP connection");
+
 	/* Generate test data */
 	generate_dummy_data(test_tmp_buf, sizeof(test_tmp_buf));
 
@@ -874,6 +911,152 @@ ZTEST(net_ipv4_fragment, test_do_not_fragment)
 	zassert_equal(pkt_recv_size, pkt_recv_expected_size, "Packet size mismatch");
 }
 
+/* Byte at the given offset of the IPv4 payload of the reassembly test datagram */
+static uint8_t reassembly_payload_byte(uint32_t offset)
+{
+	uint8_t udp_hdr[NET_UDPH_LEN];
+
+	if (offset >= NET_UDPH_LEN) {
+		return (uint8_t)(offset - NET_UDPH_LEN);
+	}
+
+	sys_put_be16(REASSEMBLY_SRC_PORT, &udp_hdr[0]);
+	sys_put_be16(REASSEMBLY_DST_PORT, &udp_hdr[2]);
+	sys_put_be16(REASSEMBLY_UDP_LEN, &udp_hdr[4]);
+	sys_put_be16(0, &udp_hdr[6]);
+
+	return udp_hdr[offset];
+}
+
+static uint16_t reassembly_udp_chksum(void)
+{
+	uint32_t sum = IPPROTO_UDP + REASSEMBLY_UDP_LEN;
+	uint32_t i;
+
+	sum += sys_get_be16(&my_addr2.s4_addr[0]) + sys_get_be16(&my_addr2.s4_addr[2]);
+	sum += sys_get_be16(&my_addr1.s4_addr[0]) + sys_get_be16(&my_addr1.s4_addr[2]);
+
+	for (i = 0; i < REASSEMBLY_UDP_LEN; i += 2) {
+		sum += (reassembly_payload_byte(i) << 8) | reassembly_payload_byte(i + 1);
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	sum = ~sum & 0xffff;
+
+	return sum == 0 ? 0xffff : sum;
+}
+
+static struct net_pkt *reassembly_fragment(uint16_t id, int index, uint16_t chksum)
+{
+	uint32_t offset = index * REASSEMBLY_FRAG_LEN;
+	struct net_ipv4_hdr hdr = { 0 };
+	struct net_pkt *pkt;
+	uint16_t flags;
+	uint32_t i;
+	int ret;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface1, NET_IPV4H_LEN + REASSEMBLY_FRAG_LEN, AF_INET,
+					   IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Packet creation failure");
+
+	flags = offset / 8;
+	if (index < REASSEMBLY_FRAG_COUNT - 1) {
+		flags |= NET_IPV4_MORE_FRAG_MASK;
+	}
+
+	hdr.vhl = 0x45;
+	hdr.len = htons(NET_IPV4H_LEN + REASSEMBLY_FRAG_LEN);
+	hdr.ttl = 64;
+	hdr.proto = IPPROTO_UDP;
+	sys_put_be16(id, hdr.id);
+	sys_put_be16(flags, hdr.offset);
+	net_ipv4_addr_copy_raw(hdr.src, my_addr2.s4_addr);
+	net_ipv4_addr_copy_raw(hdr.dst, my_addr1.s4_addr);
+
+	ret = net_pkt_write(pkt, &hdr, sizeof(hdr));
+	zassert_equal(ret, 0, "IPv4 header append failed");
+
+	for (i = offset; i < offset + REASSEMBLY_FRAG_LEN; i++) {
+		uint8_t byte = reassembly_payload_byte(i);
+
+		/* The checksum is not known when the UDP header is generated */
+		if (i == offsetof(struct net_udp_hdr, chksum)) {
+			byte = chksum >> 8;
+		} else if (i == offsetof(struct net_udp_hdr, chksum) + 1) {
+			byte = chksum & 0xff;
+		}
+
+		ret = net_pkt_write_u8(pkt, byte);
+		zassert_equal(ret, 0, "IPv4 data append failed");
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+	net_pkt_set_overwrite(pkt, false);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+/* Feed the fragments of large datagrams in random order and measure how long it takes to get
+ * the reassembled datagrams to the upper layer.
+ */
+ZTEST(net_ipv4_fragment, test_reassembly_random_order)
+{
+	static struct net_pkt *frags[REASSEMBLY_FRAG_COUNT];
+	uint16_t chksum = reassembly_udp_chksum();
+	uint64_t total_cycles = 0;
+	uint8_t packets;
+	int round;
+	int ret;
+	int i;
+
+	for (round = 0; round < REASSEMBLY_ROUNDS; round++) {
+		uint32_t start;
+
+		for (i = 0; i < REASSEMBLY_FRAG_COUNT; i++) {
+			frags[i] = reassembly_fragment(0x4000 + round, i, chksum);
+		}
+
+		/* Fisher-Yates shuffle */
+		for (i = REASSEMBLY_FRAG_COUNT - 1; i > 0; i--) {
+			int j = sys_rand32_get() % (i + 1);
+			struct net_pkt *tmp = frags[i];
+
+			frags[i] = frags[j];
+			frags[j] = tmp;
+		}
+
+		start = k_cycle_get_32();
+
+		for (i = 0; i < REASSEMBLY_FRAG_COUNT; i++) {
+			ret = net_recv_data(iface1, frags[i]);
+			zassert_equal(ret, 0, "Cannot receive data (%d)", ret);
+		}
+
+		zassert_equal(k_sem_take(&wait_reassembled_data, WAIT_TIME), 0,
+			      "Timeout waiting for reassembled packet");
+
+		total_cycles += k_cycle_get_32() - start;
+	}
+
+	TC_PRINT("Reassembled %d datagrams of %d bytes from %d fragments, "
+		 "%u us per datagram\n", REASSEMBLY_ROUNDS, REASSEMBLY_UDP_LEN,
+		 REASSEMBLY_FRAG_COUNT,
+		 (uint32_t)k_cyc_to_us_floor64(total_cycles / REASSEMBLY_ROUNDS));
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, 0, "Expected no pending reassembly");
+}
+
 static void test_pre(void *ptr)
 {
 	k_sem_reset(&wait_data);
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/capture.h>
+
+#include "capture_internal.h"
+
+#define SLOTS CONFIG_NET_CAPTURE_RING_SLOTS
+#define SNAPLEN CONFIG_NET_CAPTURE_RING_SNAPLEN
+
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_EPB_FLAGS 2
+#define PCAPNG_EPB_FLAG_INBOUND 1
+#define PCAPNG_EPB_FLAG_OUTBOUND 2
+#define LINKTYPE_RAW 101
+
+#define SHB_LEN 28
+#define IDB_LEN 20
+#define EPB_HDR_LEN 28
+#define EPB_TRAILER_LEN 16
+
+#define BLOCK_MAX_LEN (EPB_HDR_LEN + ROUND_UP(SNAPLEN, 4) + EPB_TRAILER_LEN)
+#define MAX_BLOCKS (2 * SLOTS + 8)
+
+static uint8_t blocks[MAX_BLOCKS][BLOCK_MAX_LEN];
+static size_t blocks_len[MAX_BLOCKS];
+/* Number of blocks written by the sink and read by the test */
+static size_t blocks_written;
+static size_t blocks_read;
+static K_SEM_DEFINE(blocks_sem, 0, K_SEM_MAX_LIMIT);
+
+static struct net_if *test_iface;
+static int iface_count;
+
+static int test_sink(const uint8_t *data, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (blocks_written < MAX_BLOCKS) {
+		memcpy(blocks[blocks_written], data, MIN(len, BLOCK_MAX_LEN));
+		blocks_len[blocks_written] = len;
+	}
+
+	blocks_written++;
+	k_sem_give(&blocks_sem);
+
+	return 0;
+}
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int test_iface_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api test_iface_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_iface_send,
+};
+
+NET_DEVICE_INIT(capture_ring_test, "capture_ring_test",
+		NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&test_iface_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static uint32_t get_u32(const uint8_t *block, size_t offset)
+{
+	uint32_t val;
+
+	memcpy(&val, &block[offset], sizeof(val));
+
+	return val;
+}
+
+static uint16_t get_u16(const uint8_t *block, size_t offset)
+{
+	uint16_t val;
+
+	memcpy(&val, &block[offset], sizeof(val));
+
+	return val;
+}
+
+static const uint8_t *next_block(size_t *len)
+{
+	zassert_ok(k_sem_take(&blocks_sem, K_SECONDS(1)), "Sink not called");
+	zassert_true(blocks_read < MAX_BLOCKS, "Too many blocks");
+
+	*len = blocks_len[blocks_read];
+
+	return blocks[blocks_read++];
+}
+
+/* Only call when the consumer has passed all the captured packets to the sink */
+static void reset_blocks(void)
+{
+	blocks_written = 0;
+	blocks_read = 0;
+	k_sem_reset(&blocks_sem);
+}
+
+static int put_pkt(size_t len, uint8_t seq, bool outbound)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	if (outbound) {
+		pkt = net_pkt_alloc_with_buffer(test_iface, len, AF_UNSPEC, 0,
+						K_NO_WAIT);
+	} else {
+		pkt = net_pkt_rx_alloc_with_buffer(test_iface, len, AF_UNSPEC,
+						   0, K_NO_WAIT);
+	}
+
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, (uint8_t)(seq + i)),
+			   "Cannot write pkt");
+	}
+
+	ret = net_capture_ring_put(test_iface, pkt, false);
+
+	net_pkt_unref(pkt);
+
+	return ret;
+}
+
+static void check_epb(size_t caplen, size_t orig_len, uint8_t seq, bool outbound)
+{
+	size_t padded = ROUND_UP(caplen, 4);
+	const uint8_t *block;
+	size_t len;
+
+	block = next_block(&len);
+
+	zassert_equal(len, EPB_HDR_LEN + padded + EPB_TRAILER_LEN,
+		      "Invalid EPB length (%zu)", len);
+	zassert_equal(get_u32(block, 0), PCAPNG_EPB, "Not an EPB");
+	zassert_equal(get_u32(block, 4), len, "Invalid block length");
+	zassert_equal(get_u32(block, 8), net_if_get_by_iface(test_iface) - 1,
+		      "Invalid interface id");
+	zassert_equal(get_u32(block, 20), caplen, "Invalid captured length");
+	zassert_equal(get_u32(block, 24), orig_len, "Invalid original length");
+
+	for (size_t i = 0; i < caplen; i++) {
+		zassert_equal(block[EPB_HDR_LEN + i], (uint8_t)(seq + i),
+			      "Invalid data at %zu", i);
+	}
+
+	for (size_t i = caplen; i < padded; i++) {
+		zassert_equal(block[EPB_HDR_LEN + i], 0, "Invalid padding at %zu", i);
+	}
+
+	zassert_equal(get_u16(block, EPB_HDR_LEN + padded), PCAPNG_OPT_EPB_FLAGS,
+		      "Invalid option code");
+	zassert_equal(get_u16(block, EPB_HDR_LEN + padded + 2), sizeof(uint32_t),
+		      "Invalid option length");
+	zassert_equal(get_u32(block, EPB_HDR_LEN + padded + 4),
+		      outbound ? PCAPNG_EPB_FLAG_OUTBOUND : PCAPNG_EPB_FLAG_INBOUND,
+		      "Invalid direction");
+	zassert_equal(get_u32(block, EPB_HDR_LEN + padded + 8), 0,
+		      "Missing end of options");
+	zassert_equal(get_u32(block, len - 4), len, "Invalid trailing block length");
+}
+
+ZTEST(net_capture_ring, test_pcapng_header)
+{
+	const uint8_t *block = blocks[0];
+
+	zassert_equal(blocks_len[0], SHB_LEN, "Invalid SHB length");
+	zassert_equal(get_u32(block, 0), PCAPNG_SHB, "Not a SHB");
+	zassert_equal(get_u32(block, 4), SHB_LEN, "Invalid block length");
+	zassert_equal(get_u32(block, 8), PCAPNG_BYTE_ORDER_MAGIC,
+		      "Invalid byte order magic");
+	zassert_equal(get_u16(block, 12), 1, "Invalid major version");
+	zassert_equal(get_u16(block, 14), 0, "Invalid minor version");
+	zassert_equal(get_u32(block, SHB_LEN - 4), SHB_LEN,
+		      "Invalid trailing block length");
+
+	for (int i = 0; i < iface_count; i++) {
+		block = blocks[1 + i];
+
+		zassert_equal(blocks_len[1 + i], IDB_LEN, "Invalid IDB length");
+		zassert_equal(get_u32(block, 0), PCAPNG_IDB, "Not an IDB");
+		zassert_equal(get_u32(block, 4), IDB_LEN, "Invalid block length");
+		zassert_equal(get_u32(block, 12), SNAPLEN, "Invalid snapshot length");
+		zassert_equal(get_u32(block, IDB_LEN - 4), IDB_LEN,
+			      "Invalid trailing block length");
+	}
+
+	block = blocks[net_if_get_by_iface(test_iface)];
+	zassert_equal(get_u16(block, 8), LINKTYPE_RAW, "Invalid link type");
+}
+
+ZTEST(net_capture_ring, test_put_padding)
+{
+	struct net_capture_ring_stats before, after;
+
+	net_capture_ring_stats_get(&before);
+
+	zassert_ok(put_pkt(45, 0x10, true), "Cannot capture pkt");
+	check_epb(45, 45, 0x10, true);
+
+	zassert_ok(put_pkt(48, 0x20, false), "Cannot capture pkt");
+	check_epb(48, 48, 0x20, false);
+
+	net_capture_ring_stats_get(&after);
+	zassert_equal(after.captured - before.captured, 2, "Invalid captured count");
+	zassert_equal(after.truncated - before.truncated, 0, "Invalid truncated count");
+	zassert_equal(after.dropped - before.dropped, 0, "Invalid dropped count");
+}
+
+ZTEST(net_capture_ring, test_put_truncated)
+{
+	struct net_capture_ring_stats before, after;
+
+	net_capture_ring_stats_get(&before);
+
+	zassert_ok(put_pkt(SNAPLEN, 0x30, true), "Cannot capture pkt");
+	check_epb(SNAPLEN, SNAPLEN, 0x30, true);
+
+	net_capture_ring_stats_get(&after);
+	zassert_equal(after.truncated - before.truncated, 0, "Invalid truncated count");
+
+	zassert_ok(put_pkt(SNAPLEN + 20, 0x40, true), "Cannot capture pkt");
+	check_epb(SNAPLEN, SNAPLEN + 20, 0x40, true);
+
+	net_capture_ring_stats_get(&after);
+	zassert_equal(after.captured - before.captured, 2, "Invalid captured count");
+	zassert_equal(after.truncated - before.truncated, 1, "Invalid truncated count");
+}
+
+ZTEST(net_capture_ring, test_ring_full)
+{
+	struct net_capture_ring_stats before, after;
+
+	net_capture_ring_stats_get(&before);
+
+	/* Keep the consumer from draining the ring */
+	k_sched_lock();
+
+	for (int i = 0; i < SLOTS; i++) {
+		zassert_ok(put_pkt(32, i, true), "Cannot capture pkt %d", i);
+	}
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(put_pkt(32, SLOTS + i, true), -ENOBUFS,
+			      "Full ring accepted pkt %d", i);
+	}
+
+	k_sched_unlock();
+
+	for (int i = 0; i < SLOTS; i++) {
+		check_epb(32, 32, i, true);
+	}
+
+	net_capture_ring_stats_get(&after);
+	zassert_equal(after.captured - before.captured, SLOTS, "Invalid captured count");
+	zassert_equal(after.dropped - before.dropped, 3, "Invalid dropped count");
+
+	/* The ring is usable again once drained */
+	zassert_ok(put_pkt(32, 0x50, true), "Cannot capture pkt");
+	check_epb(32, 32, 0x50, true);
+}
+
+ZTEST(net_capture_ring, test_ring_wrap_around)
+{
+	struct net_capture_ring_stats before, after;
+	uint8_t seq = 0;
+
+	net_capture_ring_stats_get(&before);
+
+	/* Go around the ring several times in batches that almost fill it */
+	for (int round = 0; round < 4; round++) {
+		k_sched_lock();
+
+		for (int i = 0; i < SLOTS - 1; i++) {
+			zassert_ok(put_pkt(16 + i, seq + i, i % 2), "Cannot capture pkt");
+		}
+
+		k_sched_unlock();
+
+		for (int i = 0; i < SLOTS - 1; i++) {
+			check_epb(16 + i, 16 + i, seq + i, i % 2);
+		}
+
+		seq += SLOTS - 1;
+		reset_blocks();
+	}
+
+	net_capture_ring_stats_get(&after);
+	zassert_equal(after.captured - before.captured, 4 * (SLOTS - 1),
+		      "Invalid captured count");
+	zassert_equal(after.dropped - before.dropped, 0, "Invalid dropped count");
+}
+
+static void *test_setup(void)
+{
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(test_iface, "No test interface");
+
+	NET_IFACE_COUNT(&iface_count);
+	zassert_true(1 + iface_count + SLOTS + 1 <= MAX_BLOCKS, "Too many interfaces");
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	size_t len;
+
+	ARG_UNUSED(fixture);
+
+	reset_blocks();
+
+	zassert_ok(net_capture_ring_start(test_iface, test_sink, NULL),
+		   "Cannot start sink");
+
+	/* Section header block and one interface description block per interface */
+	for (int i = 0; i < 1 + iface_count; i++) {
+		(void)next_block(&len);
+	}
+}
+
+static void test_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(net_capture_ring_stop(), "Cannot stop sink");
+}
+
+ZTEST_SUITE(net_capture_ring, NULL, test_setup, test_before, test_after, NULL);
@@ -8,6 +8,14 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/net/coap_service.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/socket.h>
+
+#define TEST_OBSERVERS CONFIG_COAP_SERVICE_OBSERVERS
+#define TEST_OBSERVER_PORT 5683
+#define TEST_ROUTING_PORT 5700
+#define TEST_RECV_TIMEOUT_MS 1000
+#define BENCH_ROUNDS 20
 
 static int coap_method1(struct coap_resource *resource, struct coap_packet *request,
 			struct sockaddr *addr, socklen_t addr_len)
@@ -81,6 +89,54 @@ COAP_RESOURCE_DEFINE(resource_4, service_C, {
 	.get = coap_method1,
 });
 
+static struct coap_resource *routed_resource;
+
+static int coap_route(struct coap_resource *resource, struct coap_packet *request,
+		      struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(request);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addr_len);
+
+	routed_resource = resource;
+
+	return COAP_RESPONSE_CODE_CONTENT;
+}
+
+static const uint16_t service_D_port = TEST_ROUTING_PORT;
+COAP_SERVICE_DEFINE(service_D, "::1", &service_D_port, 0);
+
+/* Resources are linked sorted by name, the names keep them in the order listed here */
+static const char * const route_0_path[] = { "route", "+", NULL };
+COAP_RESOURCE_DEFINE(route_0_wildcard, service_D, {
+	.path = route_0_path,
+	.get = coap_route,
+});
+
+static const char * const route_1_path[] = { "route", "literal", NULL };
+COAP_RESOURCE_DEFINE(route_1_shadowed, service_D, {
+	.path = route_1_path,
+	.get = coap_route,
+});
+
+static const char * const route_2_path[] = { "exact", "literal", NULL };
+COAP_RESOURCE_DEFINE(route_2_literal, service_D, {
+	.path = route_2_path,
+	.get = coap_route,
+});
+
+static const char * const route_3_path[] = { "exact", "+", NULL };
+COAP_RESOURCE_DEFINE(route_3_wildcard, service_D, {
+	.path = route_3_path,
+	.get = coap_route,
+});
+
+static const char * const route_4_path[] = { "plain", NULL };
+COAP_RESOURCE_DEFINE(route_4_plain, service_D, {
+	.path = route_4_path,
+	.get = coap_route,
+});
+
 ZTEST(coap_service, test_COAP_SERVICE_DEFINE)
 {
 	zassert_ok(strcmp(service_A.host, "a.service.com"));
@@ -114,7 +170,7 @@ ZTEST(coap_service, test_COAP_SERVICE_COUNT)
 
 	n_svc = 4273;
 	COAP_SERVICE_COUNT(&n_svc);
-	zassert_equal(n_svc, 3);
+	zassert_equal(n_svc, 4);
 }
 
 ZTEST(coap_service, test_COAP_SERVICE_RESOURCE_COUNT)
@@ -122,6 +178,7 @@ ZTEST(coap_service, test_COAP_SERVICE_RESOURCE_COUNT)
 	zassert_equal(COAP_SERVICE_RESOURCE_COUNT(&service_A), 2);
 	zassert_equal(COAP_SERVICE_RESOURCE_COUNT(&service_B), 2);
 	zassert_equal(COAP_SERVICE_RESOURCE_COUNT(&service_C), 1);
+	zassert_equal(COAP_SERVICE_RESOURCE_COUNT(&service_D), 5);
 }
 
 ZTEST(coap_service, test_COAP_SERVICE_HAS_RESOURCE)
@@ -146,6 +203,7 @@ ZTEST(coap_service, test_COAP_SERVICE_FOREACH)
 	size_t have_service_A = 0;
 	size_t have_service_B = 0;
 	size_t have_service_C = 0;
+	size_t have_service_D = 0;
 
 	COAP_SERVICE_FOREACH(svc) {
 		if (svc == &service_A) {
@@ -157,17 +215,20 @@ ZTEST(coap_service, test_COAP_SERVICE_FOREACH)
 		} else if (svc == &service_C) {
 			have_service_C = 1;
 			zassert_equal(svc->flags & COAP_SERVICE_AUTOSTART, 0);
+		} else if (svc == &service_D) {
+			have_service_D = 1;
+			zassert_equal(svc->flags & COAP_SERVICE_AUTOSTART, 0);
 		} else {
 			zassert_unreachable("svc (%p) not equal to &service_A (%p), &service_B "
-					    "(%p), or &service_C (%p)",
-					    svc, &service_A, &service_B, &service_C);
+					    "(%p), &service_C (%p) or &service_D (%p)",
+					    svc, &service_A, &service_B, &service_C, &service_D);
 		}
 
 		n_svc++;
 	}
 
-	zassert_equal(n_svc, 3);
-	zassert_equal(have_service_A + have_service_B + have_service_C, n_svc);
+	zassert_equal(n_svc, 4);
+	zassert_equal(have_service_A + have_service_B + have_service_C + have_service_D, n_svc);
 }
 
 ZTEST(coap_service, test_COAP_RESOURCE_FOREACH)
@@ -340,3 +401,310 @@ ZTEST(coap_service, test_COAP_RESOURCE_DEFINE)
 }
 
 ZTEST_SUITE(coap_service, NULL, NULL, NULL, NULL, NULL);
+
+static const uint8_t test_payload[] = "notification";
+
+static void test_recv(int sock, struct coap_packet *cpkt, uint8_t *buf, size_t len)
+{
+	struct coap_option options[4];
+	struct zsock_pollfd fds = {
+		.fd = sock,
+		.events = ZSOCK_POLLIN,
+	};
+	ssize_t received;
+
+	zassert_equal(zsock_poll(&fds, 1, TEST_RECV_TIMEOUT_MS), 1, "No datagram received");
+
+	received = zsock_recv(sock, buf, len, 0);
+	zassert_true(received > 0, "Receive failed (%d)", errno);
+
+	zassert_ok(coap_packet_parse(cpkt, buf, received, options, ARRAY_SIZE(options)));
+}
+
+static void test_observer_token(uint8_t *token, int i)
+{
+	token[0] = 0xc0;
+	token[1] = 0xa9;
+	token[2] = i >> 8;
+	token[3] = i;
+}
+
+static void test_add_observers(struct coap_resource *resource)
+{
+	for (int i = 0; i < TEST_OBSERVERS; i++) {
+		uint8_t buf[64];
+		uint8_t token[4];
+		struct coap_packet request;
+		struct sockaddr_in6 addr = {
+			.sin6_family = AF_INET6,
+			.sin6_port = htons(TEST_OBSERVER_PORT + i),
+			.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+		};
+
+		test_observer_token(token, i);
+
+		zassert_ok(coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1,
+					    COAP_TYPE_CON, sizeof(token), token, COAP_METHOD_GET,
+					    coap_next_id()));
+		zassert_ok(coap_append_option_int(&request, COAP_OPTION_OBSERVE, 0));
+		zassert_ok(coap_packet_append_option(&request, COAP_OPTION_URI_PATH,
+						     (const uint8_t *)resource->path[0],
+						     strlen(resource->path[0])));
+
+		zassert_equal(coap_resource_parse_observe(resource, &request,
+							  (struct sockaddr *)&addr), 0,
+			      "Cannot add observer %d", i);
+	}
+}
+
+static void test_remove_observers(struct coap_resource *resource)
+{
+	for (int i = 0; i < TEST_OBSERVERS; i++) {
+		uint8_t token[4];
+
+		test_observer_token(token, i);
+		zassert_ok(coap_resource_remove_observer_by_token(resource, token, sizeof(token)));
+	}
+
+	zassert_true(sys_slist_is_empty(&resource->observers));
+}
+
+static void test_open_observers(int *socks)
+{
+	for (int i = 0; i < TEST_OBSERVERS; i++) {
+		struct sockaddr_in6 addr = {
+			.sin6_family = AF_INET6,
+			.sin6_port = htons(TEST_OBSERVER_PORT + i),
+			.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+		};
+
+		socks[i] = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+		zassert_true(socks[i] >= 0, "Cannot create socket (%d)", errno);
+		zassert_ok(zsock_bind(socks[i], (struct sockaddr *)&addr, sizeof(addr)),
+			   "Cannot bind observer %d (%d)", i, errno);
+	}
+}
+
+static void test_close_observers(int *socks)
+{
+	for (int i = 0; i < TEST_OBSERVERS; i++) {
+		zassert_ok(zsock_close(socks[i]));
+	}
+}
+
+static int test_encode_notification(struct coap_resource *resource, struct coap_packet *cpkt,
+				    void *user_data)
+{
+	int *calls = user_data;
+	int ret;
+
+	(*calls)++;
+
+	ret = coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, resource->age);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_packet_append_payload_marker(cpkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_packet_append_payload(cpkt, test_payload, sizeof(test_payload) - 1);
+}
+
+static void *coap_service_observe_setup(void)
+{
+	int ret = coap_service_start(&service_A);
+
+	zassert_true(ret == 0 || ret == -EALREADY, "Cannot start service (%d)", ret);
+
+	return NULL;
+}
+
+ZTEST(coap_service_observe, test_notify_observers)
+{
+	int socks[TEST_OBSERVERS];
+	uint16_t ids[TEST_OBSERVERS];
+	uint8_t token[4];
+	int calls = 0;
+	int age;
+	int ret;
+
+	test_open_observers(socks);
+	test_add_observers(&resource_0);
+	age = resource_0.age;
+
+	ret = coap_resource_notify_observers(&resource_0, COAP_TYPE_NON_CON,
+					     test_encode_notification, &calls, NULL);
+	zassert_equal(ret, TEST_OBSERVERS, "Not all observers notified (%d)", ret);
+	zassert_equal(calls, 1, "Notification encoded more than once");
+	zassert_equal(resource_0.age, age + 1, "Resource age not incremented");
+
+	/* Every observer gets its own token and message ID around the shared
+	 * options and payload.
+	 */
+	for (int i = 0; i < TEST_OBSERVERS; i++) {
+		uint8_t buf[64];
+		uint8_t expected[4];
+		uint8_t tkl;
+		uint16_t payload_len;
+		const uint8_t *payload;
+		struct coap_packet notification;
+
+		test_recv(socks[i], &notification, buf, sizeof(buf));
+
+		zassert_equal(coap_header_get_type(&notification), COAP_TYPE_NON_CON);
+		zassert_equal(coap_header_get_code(&notification), COAP_RESPONSE_CODE_CONTENT);
+
+		test_observer_token(expected, i);
+		tkl = coap_header_get_token(&notification, token);
+		zassert_equal(tkl, sizeof(expected), "Wrong token length for observer %d", i);
+		zassert_mem_equal(token, expected, tkl, "Wrong token for observer %d", i);
+
+		ids[i] = coap_header_get_id(&notification);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(ids[i], ids[j], "Message ID %u reused for observer %d",
+					  ids[i], i);
+		}
+
+		zassert_equal(coap_get_option_int(&notification, COAP_OPTION_OBSERVE),
+			      resource_0.age, "Wrong Observe value for observer %d", i);
+
+		payload = coap_packet_get_payload(&notification, &payload_len);
+		zassert_not_null(payload, "No payload for observer %d", i);
+		zassert_equal(payload_len, sizeof(test_payload) - 1);
+		zassert_mem_equal(payload, test_payload, payload_len,
+				  "Wrong payload for observer %d", i);
+	}
+
+	test_remove_observers(&resource_0);
+	test_close_observers(socks);
+
+	/* Observers are gone from the token lookup as well */
+	test_observer_token(token, 0);
+	zassert_equal(coap_resource_remove_observer_by_token(&resource_0, token, sizeof(token)),
+		      -ENOENT);
+
+	ret = coap_resource_notify_observers(&resource_0, COAP_TYPE_NON_CON,
+					     test_encode_notification, &calls, NULL);
+	zassert_equal(ret, 0, "Notified without observers (%d)", ret);
+	zassert_equal(calls, 1, "Notification encoded without observers");
+}
+
+ZTEST(coap_service_observe, test_notify_benchmark)
+{
+	uint32_t start, cycles = 0;
+	uint32_t sent = 0;
+	uint32_t us;
+	int calls = 0;
+	int ret;
+
+	test_add_observers(&resource_0);
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		start = k_cycle_get_32();
+		ret = coap_resource_notify_observers(&resource_0, COAP_TYPE_NON_CON,
+						     test_encode_notification, &calls, NULL);
+		cycles += k_cycle_get_32() - start;
+
+		zassert_true(ret >= 0, "Notification failed (%d)", ret);
+		sent += ret;
+
+		/* Let the loopback interface drain */
+		k_msleep(10);
+	}
+
+	test_remove_observers(&resource_0);
+
+	us = MAX(k_cyc_to_us_floor32(cycles), 1U);
+
+	TC_PRINT("%u notifications to %d observers in %u us, %u notifications per second\n",
+		 sent, TEST_OBSERVERS, us, (uint32_t)((uint64_t)sent * USEC_PER_SEC / us));
+}
+
+ZTEST_SUITE(coap_service_observe, NULL, coap_service_observe_setup, NULL, NULL, NULL);
+
+static int test_route_request(int sock, const char * const *path)
+{
+	uint8_t buf[64];
+	uint8_t token[] = { 0x70, 0x61, 0x74, 0x68 };
+	uint16_t id = coap_next_id();
+	struct coap_packet request;
+	struct coap_packet response;
+
+	zassert_ok(coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				    sizeof(token), token, COAP_METHOD_GET, id));
+	for (; *path != NULL; path++) {
+		zassert_ok(coap_packet_append_option(&request, COAP_OPTION_URI_PATH,
+						     (const uint8_t *)*path, strlen(*path)));
+	}
+
+	routed_resource = NULL;
+	zassert_equal(zsock_send(sock, request.data, request.offset, 0), request.offset,
+		      "Cannot send request (%d)", errno);
+
+	test_recv(sock, &response, buf, sizeof(buf));
+	zassert_equal(coap_header_get_type(&response), COAP_TYPE_ACK);
+	zassert_equal(coap_header_get_id(&response), id);
+
+	return coap_header_get_code(&response);
+}
+
+static void *coap_service_routing_setup(void)
+{
+	int ret = coap_service_start(&service_D);
+
+	zassert_true(ret == 0 || ret == -EALREADY, "Cannot start service (%d)", ret);
+
+	return NULL;
+}
+
+ZTEST(coap_service_routing, test_route_requests)
+{
+	static const char * const plain[] = { "plain", NULL };
+	static const char * const shadowed[] = { "route", "literal", NULL };
+	static const char * const other[] = { "route", "other", NULL };
+	static const char * const literal[] = { "exact", "literal", NULL };
+	static const char * const exact_other[] = { "exact", "other", NULL };
+	static const char * const missing[] = { "missing", NULL };
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(TEST_ROUTING_PORT),
+		.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+	};
+	int sock;
+
+	/* The routing below relies on the resources being linked in this order */
+	zassert_true(&route_0_wildcard < &route_1_shadowed);
+	zassert_true(&route_2_literal < &route_3_wildcard);
+
+	sock = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+	zassert_ok(zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+	/* Literal path without any wildcard defined before it */
+	zassert_equal(test_route_request(sock, plain), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal_ptr(routed_resource, &route_4_plain);
+
+	/* A wildcard defined before a literal path wins */
+	zassert_equal(test_route_request(sock, shadowed), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal_ptr(routed_resource, &route_0_wildcard);
+
+	zassert_equal(test_route_request(sock, other), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal_ptr(routed_resource, &route_0_wildcard);
+
+	/* A literal path defined before a wildcard wins */
+	zassert_equal(test_route_request(sock, literal), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal_ptr(routed_resource, &route_2_literal);
+
+	zassert_equal(test_route_request(sock, exact_other), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal_ptr(routed_resource, &route_3_wildcard);
+
+	zassert_equal(test_route_request(sock, missing), COAP_RESPONSE_CODE_NOT_FOUND);
+	zassert_is_null(routed_resource);
+
+	zassert_ok(zsock_close(sock));
+}
+
+ZTEST_SUITE(coap_service_routing, NULL, coap_service_routing_setup, NULL, NULL, NULL);
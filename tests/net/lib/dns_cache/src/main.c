@@ -174,3 +174,122 @@ ZTEST(net_dns_cache_test, test_only_expected_type_returned)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type_b, &info_read, 1));
 	zassert_equal(AF_INET6, info_read.ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "nonexistent.example.com";
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, query_type,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_equal(-ENOENT,
+		      dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					&info_read, 1));
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+	zassert_equal(AF_INET, info_read.ai_family);
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry_expires)
+{
+	struct dns_addrinfo info_read = {0};
+	const char *query = "nonexistent.example.com";
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, query_type,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_least_recently_used_evicted)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	char query[sizeof("example-00.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example-%02zu.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	/* Touch the oldest entry so that the second one becomes the LRU */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example-00.com", query_type,
+					&info_read, 1));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example-00.com", query_type,
+					&info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example-01.com", query_type,
+					&info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example.com", query_type,
+					&info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_stats)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	struct dns_resolve_cache_stats before;
+	struct dns_resolve_cache_stats stats;
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+
+	dns_cache_stats_get(&test_dns_cache, &before);
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, "nonexistent.example.com",
+					  query_type, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+
+	dns_cache_find(&test_dns_cache, "example.com", query_type, &info_read, 1);
+	dns_cache_find(&test_dns_cache, "example.com", query_type, &info_read, 1);
+	dns_cache_find(&test_dns_cache, "nonexistent.example.com", query_type, &info_read, 1);
+	dns_cache_find(&test_dns_cache, "example2.com", query_type, &info_read, 1);
+
+	dns_cache_stats_get(&test_dns_cache, &stats);
+	zassert_equal(2, stats.hits - before.hits);
+	zassert_equal(1, stats.negative_hits - before.negative_hits);
+	zassert_equal(1, stats.misses - before.misses);
+	zassert_equal(2, stats.entries);
+	zassert_equal(TEST_DNS_CACHE_SIZE, stats.size);
+}
+
+ZTEST(net_dns_cache_test, test_prefetch_hot_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, 2),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+	zassert_false(dns_cache_prefetch_needed(&test_dns_cache, query, query_type),
+		      "Fresh entry should not be prefetched.");
+
+	/* Prefetch percent is 50, so the refresh point is after 1 second */
+	k_sleep(K_MSEC(1100));
+	zassert_true(dns_cache_prefetch_needed(&test_dns_cache, query, query_type),
+		     "Hot entry close to expiry should be prefetched.");
+	zassert_false(dns_cache_prefetch_needed(&test_dns_cache, query, query_type),
+		      "Entry should be prefetched only once.");
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, 2),
+		   "Cache entry adding should work.");
+	zassert_false(dns_cache_prefetch_needed(&test_dns_cache, query, query_type),
+		      "Refreshed entry should not be prefetched.");
+}
@@ -1534,6 +1534,92 @@ ZTEST(dns_packet, test_dns_invalid_compress_bits_cname)
 	net_buf_unref(dns_cname);
 }
 
+/* NXDOMAIN for foo.example with the SOA record in the authority section */
+static uint8_t name_error_resp_soa[] = {
+	/* DNS msg header (12 bytes) */
+	0x12, 0x34, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* Query foo.example A IN */
+	0x03, 0x66, 0x6f, 0x6f, 0x07, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65,
+	0x00, 0x00, 0x01, 0x00, 0x01,
+	/* Authority: example SOA IN TTL 3600 */
+	0xc0, 0x10, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x0e, 0x10, 0x00, 0x21,
+	/* MNAME ns.example, RNAME admin.example */
+	0x02, 0x6e, 0x73, 0xc0, 0x10,
+	0x05, 0x61, 0x64, 0x6d, 0x69, 0x6e, 0xc0, 0x10,
+	/* Serial, refresh, retry, expire, minimum 300 */
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x1c, 0x20, 0x00, 0x00, 0x0e, 0x10,
+	0x00, 0x09, 0x3a, 0x80, 0x00, 0x00, 0x01, 0x2c,
+};
+
+ZTEST(dns_packet, test_dns_soa_negative_ttl)
+{
+	struct dns_msg_t dns_msg = { 0 };
+	uint32_t ttl = 0;
+	int ret;
+
+	dns_msg.msg = name_error_resp_soa;
+	dns_msg.msg_size = sizeof(name_error_resp_soa);
+
+	ret = dns_unpack_response_query(&dns_msg);
+	zassert_equal(ret, 0, "Cannot parse query (%d)", ret);
+
+	ret = dns_unpack_soa_ttl(&dns_msg, &ttl);
+	zassert_equal(ret, 0, "Cannot parse SOA record (%d)", ret);
+	zassert_equal(ttl, 300, "Invalid negative TTL (%u)", ttl);
+
+	/* Without an authority section there is no SOA record */
+	name_error_resp_soa[9] = 0x00;
+	ret = dns_unpack_soa_ttl(&dns_msg, &ttl);
+	name_error_resp_soa[9] = 0x01;
+	zassert_equal(ret, -ENOENT, "SOA record found (%d)", ret);
+}
+
+static void resolve_status_cb(enum dns_resolve_status status,
+			      struct dns_addrinfo *info,
+			      void *user_data)
+{
+	ARG_UNUSED(info);
+
+	*(enum dns_resolve_status *)user_data = status;
+}
+
+ZTEST(dns_packet, test_dns_name_error_cached)
+{
+	static const char query[] = "foo.example";
+	enum dns_resolve_status status = DNS_EAI_INPROGRESS;
+	struct dns_msg_t dns_msg = { 0 };
+	uint16_t dns_id = 0;
+	int query_idx = -1;
+	uint16_t query_hash = 0;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_DNS_RESOLVER_CACHE);
+
+	dns_msg.msg = name_error_resp_soa;
+	dns_msg.msg_size = sizeof(name_error_resp_soa);
+
+	dns_id = dns_unpack_header_id(dns_msg.msg);
+
+	/* The query hash covers the labels, \0 and the query type */
+	setup_dns_context(&dns_ctx, 0, dns_id, &name_error_resp_soa[DNS_HEADER_SIZE],
+			  strlen((const char *)&name_error_resp_soa[DNS_HEADER_SIZE]) + 1 + 2,
+			  DNS_QUERY_TYPE_A);
+	dns_ctx.queries[0].query = query;
+
+	ret = dns_validate_msg(&dns_ctx, &dns_msg, &dns_id, &query_idx,
+			       NULL, &query_hash);
+	zassert_equal(ret, DNS_EAI_NODATA, "NXDOMAIN response not handled (%d)", ret);
+	zassert_equal(query_idx, 0, "Wrong query index (%d)", query_idx);
+
+	/* The second lookup is answered from the cache */
+	ret = dns_resolve_name(&dns_ctx, query, DNS_QUERY_TYPE_A, NULL,
+			       resolve_status_cb, &status, 1000);
+	zassert_equal(ret, 0, "Cannot resolve (%d)", ret);
+	zassert_equal(status, DNS_EAI_NODATA, "Negative answer not cached (%d)", status);
+
+	dns_ctx.queries[0].cb = NULL;
+}
+
 ZTEST_SUITE(dns_packet, NULL, NULL, NULL, NULL, NULL);
 /* TODO:
  *	1) add malformed DNS data (mostly done)
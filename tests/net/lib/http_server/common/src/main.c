@@ -396,6 +396,53 @@ ZTEST(http_service, test_HTTP_RESOURCE_WILDCARD)
 	zassert_equal(res, RES(3), "Resource mismatch");
 }
 
+ZTEST(http_service, test_HTTP_RESOURCE_LOOKUP)
+{
+	struct http_resource_detail *res;
+	int len;
+
+	res = CHECK_PATH(service_B, "/bar/baz.php", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, sizeof("/bar/baz.php") - 1, "Length incorrect");
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	/* With wildcards enabled, resources also match the paths below them */
+	res = CHECK_PATH(service_B, "/bar/baz.php/extra?param=value", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, sizeof("/bar/baz.php/extra") - 1, "Length incorrect");
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	res = CHECK_PATH(service_B, "/bar", &len);
+	zassert_is_null(res, "Resource found");
+
+	res = CHECK_PATH(service_B, "/bar/baz.ph", &len);
+	zassert_is_null(res, "Resource found");
+
+	res = CHECK_PATH(service_B, "/bar/baz.php?param=value", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, sizeof("/bar/baz.php") - 1, "Length incorrect");
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	/* Websocket resources are only returned for websocket requests */
+	res = CHECK_PATH(service_B, "/foo.htm", &len);
+	zassert_is_null(res, "Resource found");
+
+	len = 0;
+	res = get_resource_detail(&service_B, "/foo.htm", &len, true);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(res, RES(2), "Resource mismatch");
+
+	res = CHECK_PATH(service_A, "/index.html", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	res = CHECK_PATH(service_A, "/fs", &len);
+	zassert_is_null(res, "Resource found");
+
+	res = CHECK_PATH(service_C, "/index.html", &len);
+	zassert_is_null(res, "Resource found");
+}
+
 ZTEST(http_service, test_HTTP_RESOURCE_DEFAULT)
 {
 #define NON_EXISTING_PATH "/this_path_is_not_registered"
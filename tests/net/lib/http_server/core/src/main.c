@@ -2781,6 +2781,199 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 }
 #endif /* DT_HAS_COMPAT_STATUS_OKAY(zephyr_ram_disk) */
 
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+#define WORKER_SERVER_PORT 8081
+#define TEST_BLOCKING_PAYLOAD "Test blocking GET"
+
+static K_SEM_DEFINE(blocking_entered, 0, 1);
+static K_SEM_DEFINE(blocking_release, 0, 1);
+
+/* Separate service, so that two clients can be served at the same time */
+static uint16_t test_worker_service_port = WORKER_SERVER_PORT;
+HTTP_SERVICE_DEFINE(test_worker_service, SERVER_IPV4_ADDR,
+		    &test_worker_service_port, 2, 10, NULL, NULL);
+
+HTTP_RESOURCE_DEFINE(worker_static_resource, test_worker_service, "/static",
+		     &static_resource_detail);
+
+static int blocking_cb(struct http_client_ctx *client, enum http_data_status status,
+		       const struct http_request_ctx *request_ctx,
+		       struct http_response_ctx *response_ctx, void *user_data)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	/* Keep the worker busy until the test lets it go */
+	k_sem_give(&blocking_entered);
+	if (k_sem_take(&blocking_release, K_SECONDS(5 * TIMEOUT_S)) < 0) {
+		return -ETIMEDOUT;
+	}
+
+	response_ctx->body = (const uint8_t *)TEST_BLOCKING_PAYLOAD;
+	response_ctx->body_len = strlen(TEST_BLOCKING_PAYLOAD);
+	response_ctx->final_chunk = true;
+
+	return 0;
+}
+
+struct http_resource_detail_dynamic blocking_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "text/plain",
+	},
+	.cb = blocking_cb,
+	.user_data = NULL,
+};
+
+HTTP_RESOURCE_DEFINE(blocking_resource, test_worker_service, "/blocking",
+		     &blocking_detail);
+
+static const char worker_static_request[] =
+	"GET /static HTTP/1.1\r\n"
+	"Host: 127.0.0.1:8081\r\n"
+	"\r\n";
+static const char worker_static_response[] =
+	"HTTP/1.1 200 OK\r\n"
+	"Content-Type: text/html\r\n"
+	"Content-Length: 13\r\n"
+	"\r\n"
+	TEST_STATIC_PAYLOAD;
+static const char worker_blocking_request[] =
+	"GET /blocking HTTP/1.1\r\n"
+	"Host: 127.0.0.1:8081\r\n"
+	"\r\n";
+static const char worker_blocking_response[] =
+	"HTTP/1.1 200\r\n"
+	"Transfer-Encoding: chunked\r\n"
+	"Content-Type: text/plain\r\n"
+	"\r\n"
+	"11\r\n" TEST_BLOCKING_PAYLOAD "\r\n"
+	"0\r\n\r\n";
+
+static int test_worker_connect(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(WORKER_SERVER_PORT),
+	};
+	struct timeval optval = {
+		.tv_sec = TIMEOUT_S,
+		.tv_usec = 0,
+	};
+	int fd;
+
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr), 1);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "Failed to create client socket (%d)", errno);
+	zassert_ok(zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval)),
+		   "Failed to set timeout (%d)", errno);
+	zassert_ok(zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa)),
+		   "Failed to connect (%d)", errno);
+
+	return fd;
+}
+
+static void test_worker_request(int fd, const char *request)
+{
+	int ret;
+
+	ret = zsock_send(fd, request, strlen(request), 0);
+	zassert_equal(ret, strlen(request), "send() failed (%d)", errno);
+}
+
+static void test_worker_expect_response(int fd, const char *expected)
+{
+	uint8_t response[128];
+	size_t len = strlen(expected);
+	size_t offset = 0;
+	int ret;
+
+	zassert_true(len <= sizeof(response));
+
+	while (offset < len) {
+		ret = zsock_recv(fd, response + offset, len - offset, 0);
+		zassert_true(ret > 0, "recv() failed (%d)", ret < 0 ? errno : 0);
+		offset += ret;
+	}
+
+	zassert_mem_equal(response, expected, len,
+			  "Received data doesn't match expected response");
+}
+
+ZTEST(server_function_tests, test_worker_pool_blocking_handler)
+{
+	int blocked_fd, fd;
+
+	k_sem_reset(&blocking_entered);
+	k_sem_reset(&blocking_release);
+
+	blocked_fd = test_worker_connect();
+	fd = test_worker_connect();
+
+	test_worker_request(blocked_fd, worker_blocking_request);
+	zassert_ok(k_sem_take(&blocking_entered, K_SECONDS(TIMEOUT_S)),
+		   "Blocking handler not called");
+
+	/* One worker is stuck in the handler, the other one serves the second
+	 * client meanwhile.
+	 */
+	test_worker_request(fd, worker_static_request);
+	test_worker_expect_response(fd, worker_static_response);
+
+	k_sem_give(&blocking_release);
+	test_worker_expect_response(blocked_fd, worker_blocking_response);
+
+	zassert_ok(zsock_close(fd));
+	zassert_ok(zsock_close(blocked_fd));
+}
+
+ZTEST(server_function_tests, test_worker_pool_disconnect_while_busy)
+{
+	int fd1, fd2;
+
+	k_sem_reset(&blocking_entered);
+	k_sem_reset(&blocking_release);
+
+	fd1 = test_worker_connect();
+	test_worker_request(fd1, worker_blocking_request);
+	zassert_ok(k_sem_take(&blocking_entered, K_SECONDS(TIMEOUT_S)),
+		   "Blocking handler not called");
+
+	/* The client goes away while a worker owns the connection. Closing
+	 * and releasing the client is left to the server thread once the
+	 * worker is done with it.
+	 */
+	zassert_ok(zsock_close(fd1));
+	k_sem_give(&blocking_release);
+
+	/* Both client slots must be free again, otherwise the second
+	 * connection is never accepted.
+	 */
+	fd1 = test_worker_connect();
+	fd2 = test_worker_connect();
+
+	test_worker_request(fd2, worker_static_request);
+	test_worker_expect_response(fd2, worker_static_response);
+
+	/* The dynamic resource must have been released as well */
+	test_worker_request(fd1, worker_blocking_request);
+	zassert_ok(k_sem_take(&blocking_entered, K_SECONDS(TIMEOUT_S)),
+		   "Blocking handler not called after the disconnect");
+	k_sem_give(&blocking_release);
+	test_worker_expect_response(fd1, worker_blocking_response);
+
+	zassert_ok(zsock_close(fd2));
+	zassert_ok(zsock_close(fd1));
+}
+#endif /* CONFIG_HTTP_SERVER_WORKER_POOL */
+
 static void http_server_tests_before(void *fixture)
 {
 	struct sockaddr_in sa;
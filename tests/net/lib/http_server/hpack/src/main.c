@@ -494,4 +494,185 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+static struct http_hpack_dynamic_table test_table;
+
+static void test_hpack_verify_decode_table(struct http_hpack_dynamic_table *table,
+					   const uint8_t *encoded, size_t encoded_len,
+					   const struct example_headers *example,
+					   size_t num_examples, uint32_t table_size)
+{
+	int i = 0;
+
+	while (encoded_len > 0) {
+		struct http_hpack_header_buf hdr;
+		int ret;
+
+		ret = http_hpack_decode_header_table(encoded, encoded_len, table, &hdr);
+		zassert_true(ret > 0, "Failed to decode header (%d)", ret);
+
+		encoded += ret;
+		encoded_len -= ret;
+
+		zassert_true(i < num_examples, "Too many headers decoded");
+		zassert_equal(hdr.name_len, strlen(example[i].name),
+			      "Wrong decoded header name length");
+		zassert_equal(hdr.value_len, strlen(example[i].value),
+			      "Wrong decoded header value length");
+		zassert_mem_equal(hdr.name, example[i].name, hdr.name_len,
+				  "Header name wrongly decoded");
+		zassert_mem_equal(hdr.value, example[i].value, hdr.value_len,
+				  "Header value wrongly decoded");
+		i++;
+	}
+
+	zassert_equal(i, num_examples, "Wrong number of headers decoded");
+	zassert_equal(table->size, table_size, "Wrong dynamic table size");
+}
+
+/* Request examples with Huffman coding from RFC7541, ch. C.4 */
+static const uint8_t test_dynamic_request1[] = {
+	0x82, 0x86, 0x84, 0x41, 0x8c, 0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a, 0x6b,
+	0xa0, 0xab, 0x90, 0xf4, 0xff,
+};
+
+static const uint8_t test_dynamic_request2[] = {
+	0x82, 0x86, 0x84, 0xbe, 0x58, 0x86, 0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf,
+};
+
+static const uint8_t test_dynamic_request3[] = {
+	0x82, 0x87, 0x85, 0xbf, 0x40, 0x88, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xa9,
+	0x7d, 0x7f, 0x89, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf,
+};
+
+static const struct example_headers test_dynamic_headers1[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "http" },
+	{ ":path", "/" },
+	{ ":authority", "www.example.com" },
+};
+
+static const struct example_headers test_dynamic_headers2[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "http" },
+	{ ":path", "/" },
+	{ ":authority", "www.example.com" },
+	{ "cache-control", "no-cache" },
+};
+
+static const struct example_headers test_dynamic_headers3[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "https" },
+	{ ":path", "/index.html" },
+	{ ":authority", "www.example.com" },
+	{ "custom-key", "custom-value" },
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_decode)
+{
+	http_hpack_table_init(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+
+	test_hpack_verify_decode_table(&test_table, test_dynamic_request1,
+				       sizeof(test_dynamic_request1),
+				       test_dynamic_headers1,
+				       ARRAY_SIZE(test_dynamic_headers1), 57);
+	test_hpack_verify_decode_table(&test_table, test_dynamic_request2,
+				       sizeof(test_dynamic_request2),
+				       test_dynamic_headers2,
+				       ARRAY_SIZE(test_dynamic_headers2), 110);
+	test_hpack_verify_decode_table(&test_table, test_dynamic_request3,
+				       sizeof(test_dynamic_request3),
+				       test_dynamic_headers3,
+				       ARRAY_SIZE(test_dynamic_headers3), 164);
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_size_update)
+{
+	static const uint8_t size_update[] = { 0x3f, 0x19 }; /* 56 */
+	static const uint8_t size_update_invalid[] = { 0x3f, 0xe1, 0xff, 0x03 };
+	struct http_hpack_header_buf hdr;
+	int ret;
+
+	http_hpack_table_init(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	test_hpack_verify_decode_table(&test_table, test_dynamic_request1,
+				       sizeof(test_dynamic_request1),
+				       test_dynamic_headers1,
+				       ARRAY_SIZE(test_dynamic_headers1), 57);
+
+	/* Shrinking the table below the entry size evicts it. */
+	ret = http_hpack_decode_header_table(size_update, sizeof(size_update),
+					     &test_table, &hdr);
+	zassert_equal(ret, sizeof(size_update), "Failed to decode size update");
+	zassert_equal(hdr.name_len, 0, "Size update should not decode a header");
+	zassert_equal(test_table.size, 0, "Entry not evicted");
+	zassert_equal(test_table.count, 0, "Entry not evicted");
+
+	/* Referencing the evicted entry is an error. */
+	ret = http_hpack_decode_header_table(test_dynamic_request2 + 3, 1,
+					     &test_table, &hdr);
+	zassert_equal(ret, -EBADMSG, "Evicted entry should not be found");
+
+	/* Cannot grow past the advertised size. */
+	ret = http_hpack_decode_header_table(size_update_invalid,
+					     sizeof(size_update_invalid),
+					     &test_table, &hdr);
+	zassert_equal(ret, -EBADMSG, "Size update above the limit accepted");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_encode)
+{
+	static struct http_hpack_dynamic_table decoder;
+	static const struct example_headers headers[] = {
+		{ ":status", "302" },
+		{ "cache-control", "private" },
+		{ "location", "https://www.example.com" },
+		{ "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU" },
+	};
+	struct http_hpack_header_buf literal = {
+		.name = headers[3].name,
+		.value = headers[3].value,
+		.name_len = strlen(headers[3].name),
+		.value_len = strlen(headers[3].value)
+	};
+	int literal_len;
+
+	literal_len = http_hpack_encode_header(test_buf, sizeof(test_buf), &literal);
+	zassert_true(literal_len > 0, "Failed to encode header (%d)", literal_len);
+
+	http_hpack_table_init(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	http_hpack_table_init(&decoder, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+
+	for (int round = 0; round < 2; round++) {
+		size_t len = 0;
+
+		for (int i = 0; i < ARRAY_SIZE(headers); i++) {
+			struct http_hpack_header_buf hdr = {
+				.name = headers[i].name,
+				.value = headers[i].value,
+				.name_len = strlen(headers[i].name),
+				.value_len = strlen(headers[i].value)
+			};
+			int ret;
+
+			ret = http_hpack_encode_header_table(test_buf + len,
+							     sizeof(test_buf) - len,
+							     &test_table, &hdr);
+			zassert_true(ret > 0, "Failed to encode header (%d)", ret);
+			len += ret;
+		}
+
+		/* Sensitive headers are never added to the table. */
+		zassert_equal(test_table.count, 3, "Wrong number of table entries");
+
+		test_hpack_verify_decode_table(&decoder, test_buf, len, headers,
+					       ARRAY_SIZE(headers), test_table.size);
+
+		if (round > 0) {
+			/* Only the never indexed header is sent as a literal,
+			 * the others take a single byte each.
+			 */
+			zassert_equal(len, 3 + literal_len, "Indexed headers not reused");
+		}
+	}
+}
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
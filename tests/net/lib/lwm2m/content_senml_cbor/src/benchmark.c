@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_observation.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_util.h"
+
+/* Object resembling a gateway hosting many IPSO sensor instances */
+#define BENCH_OBJ_ID 0xFFFE
+#define BENCH_INST_COUNT 8
+#define BENCH_RES_COUNT 6
+#define BENCH_RES_ID_BASE 5700
+#define BENCH_ROUNDS 50
+
+static struct lwm2m_engine_obj bench_obj;
+static struct lwm2m_engine_obj_field bench_fields[BENCH_RES_COUNT];
+static struct lwm2m_engine_obj_inst bench_inst[BENCH_INST_COUNT];
+static struct lwm2m_engine_res bench_res[BENCH_INST_COUNT][BENCH_RES_COUNT];
+static struct lwm2m_engine_res_inst bench_res_inst[BENCH_INST_COUNT][BENCH_RES_COUNT];
+static int32_t bench_data[BENCH_INST_COUNT][BENCH_RES_COUNT];
+
+static struct lwm2m_message bench_msg;
+
+static struct lwm2m_engine_obj_inst *bench_obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	if (obj_inst_id >= BENCH_INST_COUNT) {
+		return NULL;
+	}
+
+	init_res_instance(bench_res_inst[obj_inst_id], BENCH_RES_COUNT);
+
+	for (int r = 0; r < BENCH_RES_COUNT; r++) {
+		INIT_OBJ_RES_DATA(BENCH_RES_ID_BASE + r, bench_res[obj_inst_id], i,
+				  bench_res_inst[obj_inst_id], j,
+				  &bench_data[obj_inst_id][r], sizeof(int32_t));
+	}
+
+	bench_inst[obj_inst_id].resources = bench_res[obj_inst_id];
+	bench_inst[obj_inst_id].resource_count = i;
+
+	return &bench_inst[obj_inst_id];
+}
+
+static void *bench_obj_init(void)
+{
+	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+
+	for (int r = 0; r < BENCH_RES_COUNT; r++) {
+		bench_fields[r] = (struct lwm2m_engine_obj_field)
+			OBJ_FIELD_DATA(BENCH_RES_ID_BASE + r, RW, S32);
+	}
+
+	bench_obj.obj_id = BENCH_OBJ_ID;
+	bench_obj.version_major = 1;
+	bench_obj.version_minor = 0;
+	bench_obj.fields = bench_fields;
+	bench_obj.field_count = ARRAY_SIZE(bench_fields);
+	bench_obj.max_instance_count = BENCH_INST_COUNT;
+	bench_obj.create_cb = bench_obj_create;
+
+	lwm2m_register_obj(&bench_obj);
+
+	for (int i = 0; i < BENCH_INST_COUNT; i++) {
+		(void)lwm2m_create_obj_inst(BENCH_OBJ_ID, i, &obj_inst);
+	}
+
+	return NULL;
+}
+
+static void bench_msg_reset(void)
+{
+	memset(&bench_msg, 0, sizeof(bench_msg));
+
+	bench_msg.out.writer = &senml_cbor_writer;
+	bench_msg.out.out_cpkt = &bench_msg.cpkt;
+
+	bench_msg.cpkt.data = bench_msg.msg_data;
+	bench_msg.cpkt.max_len = sizeof(bench_msg.msg_data);
+}
+
+ZTEST(net_content_senml_cbor_benchmark, test_registry_lookup)
+{
+	uint32_t start, cycles;
+	int32_t value;
+	int ret;
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		for (int i = 0; i < BENCH_INST_COUNT; i++) {
+			for (int r = 0; r < BENCH_RES_COUNT; r++) {
+				bench_data[i][r] = i * BENCH_RES_COUNT + r;
+
+				ret = lwm2m_get_s32(&LWM2M_OBJ(BENCH_OBJ_ID, i,
+							       BENCH_RES_ID_BASE + r),
+						    &value);
+				zassert_equal(ret, 0, "Cannot read resource (%d)", ret);
+				zassert_equal(value, bench_data[i][r], "Wrong resource value");
+			}
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%d resource reads: %u cycles, %u cycles per read\n",
+		 BENCH_ROUNDS * BENCH_INST_COUNT * BENCH_RES_COUNT, cycles,
+		 cycles / (BENCH_ROUNDS * BENCH_INST_COUNT * BENCH_RES_COUNT));
+}
+
+ZTEST(net_content_senml_cbor_benchmark, test_composite_read)
+{
+	struct lwm2m_obj_path_list path_list_buf[1];
+	sys_slist_t path_list;
+	sys_slist_t free_list;
+	uint32_t start, cycles = 0;
+	uint16_t len = 0;
+	int ret;
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		lwm2m_engine_path_list_init(&path_list, &free_list, path_list_buf,
+					    ARRAY_SIZE(path_list_buf));
+		ret = lwm2m_engine_add_path_to_list(&path_list, &free_list,
+						    &LWM2M_OBJ(BENCH_OBJ_ID));
+		zassert_equal(ret, 0, "Cannot add path (%d)", ret);
+
+		bench_msg_reset();
+
+		start = k_cycle_get_32();
+		ret = do_composite_read_op_for_parsed_path_senml_cbor(&bench_msg, &path_list);
+		cycles += k_cycle_get_32() - start;
+
+		zassert_equal(ret, 0, "Composite read failed (%d)", ret);
+		zassert_true(len == 0 || len == bench_msg.cpkt.offset,
+			     "Payload length changed");
+		len = bench_msg.cpkt.offset;
+	}
+
+	TC_PRINT("Composite read of %d resources, %u bytes: %u cycles per read\n",
+		 BENCH_INST_COUNT * BENCH_RES_COUNT, len, cycles / BENCH_ROUNDS);
+}
+
+ZTEST_SUITE(net_content_senml_cbor_benchmark, NULL, bench_obj_init, NULL, NULL, NULL);
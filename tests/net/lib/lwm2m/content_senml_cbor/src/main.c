@@ -7,6 +7,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 
+#include <zcbor_decode.h>
+
 #include "lwm2m_util.h"
 #include "lwm2m_rw_senml_cbor.h"
 #include "lwm2m_engine.h"
@@ -955,6 +957,34 @@ ZTEST(net_content_senml_cbor_nomem, test_put_time_nomem)
 	zassert_equal(ret, -ENOMEM, "Invalid error code returned");
 }
 
+ZTEST(net_content_senml_cbor, test_put_object_instance)
+{
+	uint8_t *payload = test_msg.msg_data + TEST_PAYLOAD_OFFSET;
+	int records = 0;
+	int ret;
+
+	/* All resources end up in one array, regardless of how many records
+	 * the encoder holds at a time.
+	 */
+	test_msg.path.level = LWM2M_PATH_LEVEL_OBJECT_INST;
+
+	ret = do_read_op_senml_cbor(&test_msg);
+	zassert_true(ret >= 0, "Error reported");
+
+	ZCBOR_STATE_D(state, 1, payload, test_msg.cpkt.offset - TEST_PAYLOAD_OFFSET, 1, 0);
+
+	zassert_true(zcbor_list_start_decode(state), "Invalid array header");
+	while (!zcbor_array_at_end(state)) {
+		zassert_true(zcbor_any_skip(state, NULL), "Invalid record");
+		records++;
+	}
+	zassert_true(zcbor_list_end_decode(state), "Invalid array end");
+
+	zassert_equal(records, TEST_OBJ_RES_MAX_ID, "Invalid number of records");
+	zassert_equal_ptr(state->payload, test_msg.msg_data + test_msg.cpkt.offset,
+			  "Trailing data in payload");
+}
+
 ZTEST(net_content_senml_cbor, test_get_s32)
 {
 	int ret;
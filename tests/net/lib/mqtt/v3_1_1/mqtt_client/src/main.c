@@ -801,6 +801,63 @@ ZTEST(mqtt_client, test_mqtt_pubsub_long)
 	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
 }
 
+ZTEST(mqtt_client, test_mqtt_publish_inflight_window)
+{
+	struct mqtt_publish_param param = { 0 };
+	int ret;
+
+	if (CONFIG_MQTT_INFLIGHT_WINDOW != 2) {
+		ztest_test_skip();
+	}
+
+	test_ctx.payload = payload_short;
+
+	test_connect();
+
+	param.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size = strlen(param.message.topic.topic.utf8);
+	param.message.payload.data = (uint8_t *)test_ctx.payload;
+	param.message.payload.len = strlen(test_ctx.payload);
+
+	/* Message ids are assigned by the client. */
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+
+	param.message_id = 1;
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_equal(ret, -EBUSY, "Message id should be in use (%d)", ret);
+
+	param.message_id = 0;
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_equal(ret, -EAGAIN, "In-flight window should be full (%d)", ret);
+
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	for (test_ctx.msg_id = 1; test_ctx.msg_id <= 2; test_ctx.msg_id++) {
+		client_wait(false);
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	}
+
+	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+
+	/* Acknowledged messages free the window. */
+	test_ctx.msg_id = 3;
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	client_wait(false);
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+
+	test_disconnect();
+}
+
 static void mqtt_tests_before(void *fixture)
 {
 	ARG_UNUSED(fixture);
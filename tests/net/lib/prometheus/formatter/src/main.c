@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/collector.h>
 #include <zephyr/net/prometheus/formatter.h>
 
@@ -19,6 +20,13 @@ PROMETHEUS_COUNTER_DEFINE(test_counter2, "Test counter 2",
 
 PROMETHEUS_COLLECTOR_DEFINE(test_custom_collector);
 
+PROMETHEUS_COUNTER_DEFINE(stream_counter, "Stream counter",
+			  ({ .key = "stream", .value = "counter" }), NULL);
+PROMETHEUS_GAUGE_DEFINE(stream_gauge, "Stream gauge",
+			({ .key = "stream", .value = "gauge" }), NULL);
+
+PROMETHEUS_COLLECTOR_DEFINE(test_stream_collector);
+
 /**
  * @brief Test Prometheus formatter
  * @details The test shall increment the counter value by 1 and check if the
@@ -63,4 +71,55 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
+/**
+ * @brief Test Prometheus streaming formatter
+ * @details The test shall format the exposition in chunks smaller than a
+ * line and check that the concatenated chunks match the buffer formatter,
+ * and that the collector is unlocked once the stream is complete.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_stream)
+{
+	static struct prometheus_format_stream stream;
+	char formatted[MAX_BUFFER_SIZE] = { 0 };
+	char streamed[MAX_BUFFER_SIZE] = { 0 };
+	size_t len = 0;
+	int ret;
+	char exposed[] = "# HELP stream_gauge Stream gauge\n"
+			 "# TYPE stream_gauge gauge\n"
+			 "stream_gauge{stream=\"gauge\"} 12.250000\n"
+			 "# HELP stream_counter Stream counter\n"
+			 "# TYPE stream_counter counter\n"
+			 "stream_counter{stream=\"counter\"} 18446744073709551615\n";
+
+	prometheus_collector_register_metric(&test_stream_collector, &stream_counter.base);
+	prometheus_collector_register_metric(&test_stream_collector, &stream_gauge.base);
+
+	ret = prometheus_counter_set(&stream_counter, UINT64_MAX);
+	zassert_ok(ret, "Error setting counter");
+
+	ret = prometheus_gauge_set(&stream_gauge, 12.25);
+	zassert_ok(ret, "Error setting gauge");
+
+	ret = prometheus_format_stream_init(&stream, &test_stream_collector);
+	zassert_ok(ret, "Error initializing stream");
+
+	while (!prometheus_format_stream_done(&stream)) {
+		/* Chunks shorter than a line */
+		ret = prometheus_format_stream(&stream, &streamed[len],
+					       MIN(7, sizeof(streamed) - 1 - len));
+		zassert_true(ret >= 0, "Error formatting chunk (%d)", ret);
+		len += ret;
+	}
+
+	zassert_equal(len, strlen(exposed), "Invalid exposition length %zu", len);
+	zassert_equal(strcmp(streamed, exposed), 0,
+		      "Exposition format is not as expected (expected\n\"%s\", got\n\"%s\")",
+		      exposed, streamed);
+
+	/* Buffer formatter gives the same output and can take the lock again */
+	ret = prometheus_format_exposition(&test_stream_collector, formatted, sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+	zassert_equal(strcmp(formatted, exposed), 0, "Formatters do not agree");
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/data/json.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/zperf.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#define TEST_UPLOAD_PORT 5001
+#define TEST_ECHO_PORT 4242
+#define TEST_STREAMS 2
+#define TEST_PACKET_SIZE 100
+
+/* On native_sim the upload loop is paced by a 1 ms busy wait, so ask for
+ * one TEST_PACKET_SIZE datagram per millisecond over all the streams.
+ */
+#define TEST_RATE_KBPS 800
+
+/* Simulated time only moves when the CPU idles, so the echo server sleeps
+ * before answering to give every round trip a known lower bound.
+ */
+#define TEST_ECHO_DELAY_US 500
+
+#define TEST_LINE_MAX 512
+
+struct test_summary {
+	char *type;
+	char *proto;
+	uint32_t streams;
+	uint32_t packet_size;
+	uint32_t packets_sent;
+	uint32_t errors;
+	uint64_t client_rate_kbps;
+	uint32_t packets_rcvd;
+	uint32_t packets_lost;
+	uint32_t packets_outorder;
+};
+
+static const struct json_obj_descr test_summary_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct test_summary, type, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, proto, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, streams, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, packet_size, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, packets_sent, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, errors, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, client_rate_kbps, JSON_TOK_UINT64),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, packets_rcvd, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, packets_lost, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_summary, packets_outorder, JSON_TOK_UINT),
+};
+
+struct test_latency {
+	char *type;
+	char *proto;
+	uint32_t packet_size;
+	uint32_t requests;
+	uint32_t responses;
+	uint32_t timeouts;
+	uint32_t min_us;
+	uint32_t avg_us;
+	uint32_t max_us;
+	uint32_t p50_us;
+	uint32_t p90_us;
+	uint32_t p99_us;
+};
+
+static const struct json_obj_descr test_latency_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct test_latency, type, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, proto, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, packet_size, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, requests, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, responses, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, timeouts, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, min_us, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, avg_us, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, max_us, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, p50_us, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, p90_us, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct test_latency, p99_us, JSON_TOK_UINT),
+};
+
+static K_THREAD_STACK_DEFINE(echo_stack, 2048);
+static struct k_thread echo_thread;
+static uint8_t echo_buf[CONFIG_NET_ZPERF_MAX_PACKET_SIZE];
+static int echo_sock = -1;
+
+static atomic_t sessions_finished;
+static char line[TEST_LINE_MAX];
+
+static void echo_handler(void *p1, void *p2, void *p3)
+{
+	struct sockaddr peer;
+	socklen_t peer_len;
+	ssize_t len;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		peer_len = sizeof(peer);
+		len = zsock_recvfrom(echo_sock, echo_buf, sizeof(echo_buf), 0,
+				     &peer, &peer_len);
+		if (len < 0) {
+			break;
+		}
+
+		k_sleep(K_USEC(TEST_ECHO_DELAY_US));
+
+		(void)zsock_sendto(echo_sock, echo_buf, len, 0, &peer, peer_len);
+	}
+}
+
+static void udp_session_cb(enum zperf_status status,
+			   struct zperf_results *result,
+			   void *user_data)
+{
+	ARG_UNUSED(result);
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		atomic_inc(&sessions_finished);
+	}
+}
+
+/* Run a zperf shell command and copy its JSON line of the given type */
+static void test_run_json(const char *cmd, const char *type)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	char prefix[32];
+	const char *output;
+	const char *start;
+	size_t size;
+	size_t len;
+	int ret;
+
+	shell_backend_dummy_clear_output(sh);
+
+	ret = shell_execute_cmd(sh, cmd);
+	zassert_equal(ret, 0, "\"%s\" failed (%d)", cmd, ret);
+
+	output = shell_backend_dummy_get_output(sh, &size);
+
+	snprintk(prefix, sizeof(prefix), "{\"type\":\"%s\"", type);
+	start = strstr(output, prefix);
+	zassert_not_null(start, "No %s line in \"%s\"", type, output);
+
+	len = strcspn(start, "\r\n");
+	zassert_true(len < sizeof(line), "JSON line too long");
+
+	memcpy(line, start, len);
+	line[len] = '\0';
+}
+
+ZTEST(net_zperf, test_udp_upload_streams)
+{
+	struct zperf_download_params param = {
+		.port = TEST_UPLOAD_PORT,
+	};
+	struct test_summary summary = { 0 };
+	int ret;
+
+	atomic_clear(&sessions_finished);
+
+	ret = zperf_udp_download(&param, udp_session_cb, NULL);
+	zassert_equal(ret, 0, "Cannot start the UDP server (%d)", ret);
+
+	test_run_json("zperf udp upload -j -P " STRINGIFY(TEST_STREAMS)
+		      " 127.0.0.1 " STRINGIFY(TEST_UPLOAD_PORT) " 1 "
+		      STRINGIFY(TEST_PACKET_SIZE) " " STRINGIFY(TEST_RATE_KBPS) "K",
+		      "summary");
+
+	(void)zperf_udp_download_stop();
+
+	ret = json_obj_parse(line, strlen(line), test_summary_descr,
+			     ARRAY_SIZE(test_summary_descr), &summary);
+	zassert_equal(ret, BIT_MASK(ARRAY_SIZE(test_summary_descr)),
+		      "Cannot parse \"%s\" (%d)", line, ret);
+
+	zassert_str_equal(summary.proto, "udp");
+	zassert_equal(summary.streams, TEST_STREAMS);
+	zassert_equal(summary.packet_size, TEST_PACKET_SIZE);
+	zassert_equal(summary.errors, 0U);
+	zassert_equal(atomic_get(&sessions_finished), TEST_STREAMS,
+		      "Every stream should be a server session");
+
+	/* The requested rate is the total over all the streams */
+	zassert_true(summary.client_rate_kbps <= TEST_RATE_KBPS * 5U / 4U,
+		     "Offered %llu kbps, requested %u kbps",
+		     summary.client_rate_kbps, TEST_RATE_KBPS);
+	zassert_true(summary.client_rate_kbps >= TEST_RATE_KBPS / 2U,
+		     "Offered %llu kbps, requested %u kbps",
+		     summary.client_rate_kbps, TEST_RATE_KBPS);
+
+	/* Each stream numbers its own datagrams, the first one of a stream
+	 * only opens the server session and is not counted.
+	 */
+	zassert_equal(summary.packets_lost, 0U);
+	zassert_equal(summary.packets_outorder, 0U);
+	zassert_equal(summary.packets_rcvd, summary.packets_sent - TEST_STREAMS,
+		      "Sent %u, received %u", summary.packets_sent,
+		      summary.packets_rcvd);
+}
+
+ZTEST(net_zperf, test_udp_latency)
+{
+	struct test_latency latency = { 0 };
+	int ret;
+
+	test_run_json("zperf udp upload -j -L 127.0.0.1 "
+		      STRINGIFY(TEST_ECHO_PORT) " 1 64", "latency");
+
+	ret = json_obj_parse(line, strlen(line), test_latency_descr,
+			     ARRAY_SIZE(test_latency_descr), &latency);
+	zassert_equal(ret, BIT_MASK(ARRAY_SIZE(test_latency_descr)),
+		      "Cannot parse \"%s\" (%d)", line, ret);
+
+	zassert_str_equal(latency.proto, "udp");
+	zassert_equal(latency.packet_size, 64U);
+	zassert_true(latency.requests > 0U);
+	zassert_equal(latency.responses, latency.requests);
+	zassert_equal(latency.timeouts, 0U);
+
+	zassert_true(latency.min_us >= TEST_ECHO_DELAY_US,
+		     "RTT %u us below the echo delay", latency.min_us);
+	zassert_true(latency.max_us < CONFIG_NET_ZPERF_LATENCY_TIMEOUT_MS * USEC_PER_MSEC,
+		     "RTT %u us above the timeout", latency.max_us);
+	zassert_true(latency.min_us <= latency.avg_us && latency.avg_us <= latency.max_us);
+	zassert_true(latency.min_us <= latency.p50_us);
+	zassert_true(latency.p50_us <= latency.p90_us);
+	zassert_true(latency.p90_us <= latency.p99_us);
+	zassert_true(latency.p99_us <= latency.max_us);
+}
+
+static void *zperf_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_ECHO_PORT),
+	};
+	int ret;
+
+	/* Let the shell backend initialize */
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr), 1);
+
+	echo_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(echo_sock >= 0, "Cannot create the echo socket (%d)", errno);
+
+	ret = zsock_bind(echo_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "Cannot bind the echo socket (%d)", errno);
+
+	k_thread_create(&echo_thread, echo_stack, K_THREAD_STACK_SIZEOF(echo_stack),
+			echo_handler, NULL, NULL, NULL, K_PRIO_PREEMPT(5), 0,
+			K_NO_WAIT);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_zperf, NULL, zperf_setup, NULL, NULL, NULL);
@@ -14,6 +14,7 @@
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/ethernet.h>
+#include <zephyr/net/udp.h>
 #include <zephyr/random/random.h>
 
 #include <zephyr/ztest.h>
@@ -1291,4 +1292,155 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+NET_PKT_PAGE_POOL_DEFINE(test_page_pool, 2, 128);
+
+ZTEST(net_pkt_test_suite, test_net_pkt_rx_page_pool)
+{
+	static const uint8_t frame[] = "page pool test frame";
+	uint8_t data[sizeof(frame)];
+	uint8_t *page1, *page2;
+	struct net_pkt *pkt;
+
+	page1 = net_pkt_page_get(&test_page_pool, K_NO_WAIT);
+	zassert_not_null(page1, "Cannot get page");
+
+	page2 = net_pkt_page_get(&test_page_pool, K_NO_WAIT);
+	zassert_not_null(page2, "Cannot get page");
+
+	zassert_is_null(net_pkt_page_get(&test_page_pool, K_NO_WAIT),
+			"Got more pages than the pool has");
+
+	zassert_is_null(net_pkt_rx_alloc_on_page(&test_page_pool, eth_if, page2,
+						 test_page_pool.page_size + 1,
+						 K_NO_WAIT),
+			"Too long frame accepted");
+
+	net_pkt_page_put(&test_page_pool, page2);
+
+	/* Frame is received straight into the page */
+	memcpy(page1, frame, sizeof(frame));
+
+	pkt = net_pkt_rx_alloc_on_page(&test_page_pool, eth_if, page1,
+				       sizeof(frame), K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+	zassert_equal(net_pkt_get_len(pkt), sizeof(frame), "Invalid length");
+	zassert_equal(pkt->buffer->data, page1, "Data was copied");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read(pkt, data, sizeof(data)), "Read failed");
+	zassert_mem_equal(data, frame, sizeof(frame), "Invalid data");
+
+	/* Freeing the packet recycles the page */
+	net_pkt_unref(pkt);
+
+	page2 = net_pkt_page_get(&test_page_pool, K_NO_WAIT);
+	zassert_not_null(page2, "Page was not recycled");
+	zassert_equal(page2, page1, "Most recently freed page not reused");
+
+	net_pkt_page_put(&test_page_pool, page2);
+}
+
+#define HDR_BENCH_ROUNDS 1000
+#define HDR_BENCH_LEN (sizeof(struct net_ipv4_hdr) + sizeof(struct net_udp_hdr))
+#define HDR_BENCH_PAYLOAD 32
+
+NET_BUF_POOL_VAR_DEFINE(test_net_pkt_hdr_pool, 3, 256, 4, NULL);
+
+static struct net_pkt *hdr_bench_pkt(size_t first_len)
+{
+	struct net_ipv4_hdr ipv4 = { .vhl = 0x45, .ttl = 64, .proto = IPPROTO_UDP };
+	struct net_udp_hdr udp = { .src_port = htons(4242), .dst_port = htons(5353) };
+	size_t total = HDR_BENCH_LEN + HDR_BENCH_PAYLOAD;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+
+	pkt = net_pkt_alloc_on_iface(eth_if, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	buf = net_buf_alloc_len(&test_net_pkt_hdr_pool, first_len, K_NO_WAIT);
+	zassert_not_null(buf, "Buf not allocated");
+	net_pkt_append_buffer(pkt, buf);
+
+	if (first_len < total) {
+		buf = net_buf_alloc_len(&test_net_pkt_hdr_pool, total - first_len,
+					K_NO_WAIT);
+		zassert_not_null(buf, "Buf not allocated");
+		net_pkt_append_buffer(pkt, buf);
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv4_hdr));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_write(pkt, &ipv4, sizeof(ipv4)), "Write failed");
+	zassert_ok(net_pkt_write(pkt, &udp, sizeof(udp)), "Write failed");
+	zassert_ok(net_pkt_memset(pkt, 'z', HDR_BENCH_PAYLOAD), "Write failed");
+
+	net_pkt_set_overwrite(pkt, true);
+
+	return pkt;
+}
+
+static uint32_t hdr_bench_run(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(udp_access, struct net_udp_hdr);
+	struct net_udp_hdr *udp;
+	uint32_t start;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < HDR_BENCH_ROUNDS; i++) {
+		net_pkt_cursor_init(pkt);
+
+		zassert_not_null(net_pkt_get_data(pkt, &ipv4_access), "No IPv4 header");
+		zassert_ok(net_pkt_set_data(pkt, &ipv4_access), "Cannot skip IPv4 header");
+
+		udp = net_pkt_get_data(pkt, &udp_access);
+		zassert_not_null(udp, "No UDP header");
+		zassert_equal(udp->dst_port, htons(5353), "Invalid UDP header");
+		zassert_ok(net_pkt_set_data(pkt, &udp_access), "Cannot skip UDP header");
+	}
+
+	return (k_cycle_get_32() - start) / HDR_BENCH_ROUNDS;
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_header_fast_path)
+{
+	struct net_pkt *flat, *split;
+	struct net_udp_hdr hdr;
+	struct net_udp_hdr *udp;
+	uint32_t flat_cycles, split_cycles;
+
+	flat = hdr_bench_pkt(HDR_BENCH_LEN + HDR_BENCH_PAYLOAD);
+	split = hdr_bench_pkt(sizeof(struct net_ipv4_hdr) + 2);
+
+	zassert_true(net_pkt_is_single_buf(flat), "Packet is fragmented");
+	zassert_false(net_pkt_is_single_buf(split), "Packet is not fragmented");
+
+	/* Accessors point straight into the first buffer */
+	zassert_equal_ptr(net_pkt_ipv4_hdr(flat), flat->buffer->data,
+			  "Invalid IPv4 header");
+	udp = net_pkt_udp_hdr(flat);
+	zassert_equal_ptr(udp, flat->buffer->data + sizeof(struct net_ipv4_hdr),
+			  "Invalid UDP header");
+	zassert_equal_ptr(net_udp_get_hdr(flat, &hdr), udp, "Header was copied");
+	zassert_equal(udp->src_port, htons(4242), "Invalid UDP header");
+
+	/* A header crossing buffers is not handed out, the copy is used */
+	zassert_not_null(net_pkt_ipv4_hdr(split), "Invalid IPv4 header");
+	zassert_is_null(net_pkt_udp_hdr(split), "Split header returned");
+	zassert_equal_ptr(net_udp_get_hdr(split, &hdr), &hdr, "Header not copied");
+	zassert_equal(hdr.src_port, htons(4242), "Invalid UDP header");
+
+	flat_cycles = hdr_bench_run(flat);
+	split_cycles = hdr_bench_run(split);
+
+	TC_PRINT("IPv4/UDP header parse: %u cycles/pkt single buffer, "
+		 "%u cycles/pkt fragmented\n", flat_cycles, split_cycles);
+
+	net_pkt_unref(flat);
+	net_pkt_unref(split);
+}
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
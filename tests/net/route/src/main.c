@@ -544,6 +544,47 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix_match(void)
+{
+	struct in6_addr prefix = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr other_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0xd, 0xe, 0x5, 0x8 } } };
+	struct net_route_entry *prefix_route, *host_route, *entry;
+
+	prefix_route = net_route_add(my_iface, &prefix, 64, &peer_addr,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(prefix_route, "Prefix route add failed");
+
+	host_route = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+				   NET_IPV6_ND_INFINITE_LIFETIME,
+				   NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(host_route, "Host route add failed");
+	zassert_not_equal(host_route, prefix_route,
+			  "Host route replaced the prefix route");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, host_route, "Longest prefix not matched");
+
+	/* Lookup again so that the answer comes from the route cache */
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, host_route, "Cached route mismatch");
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(entry, prefix_route, "Prefix route not matched");
+
+	zassert_ok(net_route_del(host_route), "Host route del failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, prefix_route,
+			  "Stale route returned after delete");
+
+	zassert_ok(net_route_del(prefix_route), "Prefix route del failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(entry, "Route found after delete");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +607,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix_match();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -180,4 +180,22 @@ ZTEST(net_socket_service, test_service_sync)
 			 &tcp_service_sync);
 }
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_THREADS)
+NET_SOCKET_SERVICE_THREAD_DEFINE(udp_service_thread, server_handler, 2,
+				 CONFIG_NET_SOCKETS_SERVICE_STACK_SIZE,
+				 CONFIG_NET_SOCKETS_SERVICE_THREAD_PRIO);
+NET_SOCKET_SERVICE_THREAD_DEFINE(tcp_service_small_thread, tcp_server_handler, 1,
+				 CONFIG_NET_SOCKETS_SERVICE_STACK_SIZE,
+				 CONFIG_NET_SOCKETS_SERVICE_THREAD_PRIO);
+NET_SOCKET_SERVICE_THREAD_DEFINE_STATIC(tcp_service_thread, tcp_server_handler, 2,
+					CONFIG_NET_SOCKETS_SERVICE_STACK_SIZE,
+					CONFIG_NET_SOCKETS_SERVICE_THREAD_PRIO);
+
+ZTEST(net_socket_service, test_service_thread)
+{
+	run_test_service(&udp_service_thread, &tcp_service_small_thread,
+			 &tcp_service_thread);
+}
+#endif
+
 ZTEST_SUITE(net_socket_service, NULL, NULL, NULL, NULL, NULL);
@@ -25,6 +25,11 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define SERVER_PORT 4242
 
 #define PSK_TAG 1
+#define CERT_TAG 2
+#define CA_CERT_TAG 3
+
+/* Host name in the server certificate */
+#define CERT_HOSTNAME "zephyr.local"
 
 #define MAX_CONNS 5
 
@@ -85,6 +90,68 @@ static void test_config_psk(int s_sock, int c_sock)
 	}
 }
 
+#if defined(CONFIG_MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED)
+static const unsigned char ca_cert[] = {
+#include "ca.inc"
+};
+
+static const unsigned char server_cert[] = {
+#include "server.inc"
+};
+
+static const unsigned char server_privkey[] = {
+#include "server_privkey.inc"
+};
+
+/* Configure the server with an ECDSA certificate, and the client with the
+ * CA certificate and an ECDHE-ECDSA ciphersuite.
+ */
+static void test_config_cert(int s_sock, int c_sock)
+{
+	static const int ciphersuites[] = {
+		MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256
+	};
+	sec_tag_t server_tag_list[] = {
+		CERT_TAG
+	};
+	sec_tag_t client_tag_list[] = {
+		CA_CERT_TAG
+	};
+
+	(void)tls_credential_delete(CA_CERT_TAG, TLS_CREDENTIAL_CA_CERTIFICATE);
+	(void)tls_credential_delete(CERT_TAG, TLS_CREDENTIAL_PUBLIC_CERTIFICATE);
+	(void)tls_credential_delete(CERT_TAG, TLS_CREDENTIAL_PRIVATE_KEY);
+
+	zassert_equal(tls_credential_add(CA_CERT_TAG, TLS_CREDENTIAL_CA_CERTIFICATE,
+					 ca_cert, sizeof(ca_cert)),
+		      0, "Failed to register CA certificate");
+	zassert_equal(tls_credential_add(CERT_TAG, TLS_CREDENTIAL_PUBLIC_CERTIFICATE,
+					 server_cert, sizeof(server_cert)),
+		      0, "Failed to register server certificate");
+	zassert_equal(tls_credential_add(CERT_TAG, TLS_CREDENTIAL_PRIVATE_KEY,
+					 server_privkey, sizeof(server_privkey)),
+		      0, "Failed to register server private key");
+
+	if (s_sock >= 0) {
+		zassert_equal(zsock_setsockopt(s_sock, SOL_TLS, TLS_SEC_TAG_LIST,
+					 server_tag_list, sizeof(server_tag_list)),
+			      0, "Failed to set certificate on server socket");
+	}
+
+	if (c_sock >= 0) {
+		zassert_equal(zsock_setsockopt(c_sock, SOL_TLS, TLS_SEC_TAG_LIST,
+					 client_tag_list, sizeof(client_tag_list)),
+			      0, "Failed to set CA certificate on client socket");
+		zassert_equal(zsock_setsockopt(c_sock, SOL_TLS, TLS_HOSTNAME,
+					 CERT_HOSTNAME, sizeof(CERT_HOSTNAME)),
+			      0, "Failed to set hostname on client socket");
+		zassert_equal(zsock_setsockopt(c_sock, SOL_TLS, TLS_CIPHERSUITE_LIST,
+					 ciphersuites, sizeof(ciphersuites)),
+			      0, "Failed to set ciphersuite on client socket");
+	}
+}
+#endif /* CONFIG_MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED */
+
 static void test_fcntl(int sock, int cmd, int val)
 {
 	zassert_equal(zsock_fcntl(sock, cmd, val), 0, "fcntl failed");
@@ -1814,6 +1881,179 @@ ZTEST(net_socket_tls, test_poll_dtls_pollerr)
 	k_msleep(10);
 }
 
+#define HANDSHAKE_RATE_ROUNDS 10
+
+/* Length of the TLS 1.2 master secret */
+#define MASTER_SECRET_LEN 48
+
+static void test_set_session_opt(int sock, int optname, int val)
+{
+	zassert_equal(zsock_setsockopt(sock, SOL_TLS, optname, &val, sizeof(val)),
+		      0, "Failed to set session option %d", optname);
+}
+
+/* Certificates with ECDHE are used when available, as this is the
+ * handshake cost that session resumption saves.
+ */
+static void test_config_handshake(int s_sock, int c_sock)
+{
+#if defined(CONFIG_MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED)
+	test_config_cert(s_sock, c_sock);
+#else
+	test_config_psk(s_sock, c_sock);
+#endif
+}
+
+/* Run a series of loopback handshakes against a single listening socket and
+ * report the handshake rate. The first handshake is always a full one, the
+ * following ones must be resumed if the session cache or session tickets are
+ * enabled. A resumed TLS 1.2 session keeps the master secret of the session
+ * it resumes, while a full handshake derives a new one.
+ */
+static void test_tls_handshake_rate(const char *mode, bool cache, bool tickets)
+{
+	struct sockaddr_in s_saddr;
+	struct sockaddr_in c_saddr;
+	struct connect_data test_data;
+	uint8_t master[MASTER_SECRET_LEN];
+	bool resume = cache || tickets;
+	uint64_t elapsed_us = 0;
+	int optval;
+	socklen_t optlen = sizeof(optval);
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_handshake(s_sock, -1);
+
+	/* Start from an empty cache and fresh ticket keys. */
+	test_set_session_opt(s_sock, TLS_SESSION_CACHE_PURGE, 0);
+	test_set_session_opt(s_sock, TLS_SESSION_CACHE,
+			     cache ? TLS_SESSION_CACHE_ENABLED :
+				     TLS_SESSION_CACHE_DISABLED);
+	if (tickets) {
+		test_set_session_opt(s_sock, TLS_SESSION_TICKETS,
+				     TLS_SESSION_TICKETS_ENABLED);
+		zassert_equal(zsock_getsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKETS,
+					       &optval, &optlen),
+			      0, "getsockopt failed");
+		zassert_equal(optval, TLS_SESSION_TICKETS_ENABLED,
+			      "Session tickets not enabled");
+	}
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	for (int i = 0; i < HANDSHAKE_RATE_ROUNDS; i++) {
+		mbedtls_ssl_context *ssl_ctx;
+		const uint8_t *session_master;
+		int64_t start;
+
+		prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr,
+				    IPPROTO_TLS_1_2);
+		test_config_handshake(-1, c_sock);
+
+		/* The client needs its own cache to offer the session ID or
+		 * the ticket on reconnect.
+		 */
+		if (resume) {
+			test_set_session_opt(c_sock, TLS_SESSION_CACHE,
+					     TLS_SESSION_CACHE_ENABLED);
+		}
+
+		if (tickets) {
+			test_set_session_opt(c_sock, TLS_SESSION_TICKETS,
+					     TLS_SESSION_TICKETS_ENABLED);
+		}
+
+		test_data.sock = c_sock;
+		test_data.addr = (struct sockaddr *)&s_saddr;
+		k_work_init_delayable(&test_data.work, client_connect_work_handler);
+
+		start = k_uptime_ticks();
+		test_work_reschedule(&test_data.work, K_NO_WAIT);
+		test_accept(s_sock, &new_sock, NULL, NULL);
+		test_work_wait(&test_data.work);
+		elapsed_us += k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+
+		ssl_ctx = ztls_get_mbedtls_ssl_context(c_sock);
+		zassert_not_null(ssl_ctx, "No TLS context");
+		session_master = ssl_ctx->MBEDTLS_PRIVATE(session)->MBEDTLS_PRIVATE(master);
+
+		if (i == 0) {
+			memcpy(master, session_master, sizeof(master));
+		} else if (resume) {
+			zassert_mem_equal(session_master, master, sizeof(master),
+					  "%s: handshake %d was not resumed", mode, i);
+		} else {
+			zassert_true(memcmp(session_master, master, sizeof(master)) != 0,
+				     "%s: handshake %d was resumed", mode, i);
+		}
+
+		test_close(new_sock);
+		new_sock = -1;
+		test_close(c_sock);
+		c_sock = -1;
+
+		/* Let the connection tear down before the next round */
+		k_sleep(TCP_TEARDOWN_TIMEOUT);
+	}
+
+	TC_PRINT("%s: %d handshakes in %llu us, %llu handshakes/s\n", mode,
+		 HANDSHAKE_RATE_ROUNDS, elapsed_us,
+		 elapsed_us > 0 ? (uint64_t)HANDSHAKE_RATE_ROUNDS * USEC_PER_SEC /
+					  elapsed_us : 0);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_session_resumption_rate)
+{
+	test_tls_handshake_rate("full handshake", false, false);
+
+	if (IS_ENABLED(CONFIG_MBEDTLS_SSL_CACHE_C)) {
+		test_tls_handshake_rate("session cache", true, false);
+	}
+
+	if (IS_ENABLED(CONFIG_MBEDTLS_TLS_SESSION_TICKETS)) {
+		test_tls_handshake_rate("session tickets", false, true);
+	}
+}
+
+ZTEST(net_socket_tls, test_session_tickets_option)
+{
+	struct sockaddr_in s_saddr;
+	int optval = TLS_SESSION_TICKETS_ENABLED;
+	socklen_t optlen = sizeof(optval);
+	int ret;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+
+	ret = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKETS, &optval,
+			       sizeof(optval));
+	if (!IS_ENABLED(CONFIG_MBEDTLS_TLS_SESSION_TICKETS)) {
+		zassert_equal(ret, -1, "setsockopt should fail");
+		zassert_equal(errno, ENOPROTOOPT, "Unexpected errno value: %d", errno);
+		return;
+	}
+
+	zassert_equal(ret, 0, "setsockopt failed");
+
+	optval = 2;
+	ret = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKETS, &optval,
+			       sizeof(optval));
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, EINVAL, "Unexpected errno value: %d", errno);
+
+	ret = zsock_getsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKETS, &optval,
+			       &optlen);
+	zassert_equal(ret, 0, "getsockopt failed");
+	zassert_equal(optval, TLS_SESSION_TICKETS_ENABLED,
+		      "Invalid value should not change the option");
+}
+
 static void *tls_tests_setup(void)
 {
 	k_work_queue_init(&tls_test_work_queue);
@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include "ipv6.h"
 #include "net_private.h"
+#include "net_stats.h"
 #include "../../socket_helpers.h"
 
 #if defined(CONFIG_NET_SOCKETS_LOG_LEVEL_DBG)
@@ -3106,6 +3107,184 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+#define STATS_COST_PACKETS 200
+
+/* Measure the per packet cost of a loopback UDP send/receive round. Run the
+ * same test with statistics disabled, with shared statistics and with per
+ * CPU statistics to compare the overhead of the statistics counters.
+ */
+ZTEST(net_socket_udp, test_41_stats_per_packet_cost)
+{
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	uint64_t cycles = 0U;
+	ssize_t ret;
+#if defined(CONFIG_NET_STATISTICS_UDP) && defined(CONFIG_NET_STATISTICS_USER_API)
+	struct net_stats_udp udp_before, udp_after;
+#endif
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	ret = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			 sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+#if defined(CONFIG_NET_STATISTICS_UDP) && defined(CONFIG_NET_STATISTICS_USER_API)
+	ret = net_mgmt(NET_REQUEST_STATS_GET_UDP, NULL, &udp_before,
+		       sizeof(udp_before));
+	zassert_equal(ret, 0, "Cannot get UDP statistics (%d)", ret);
+#endif
+
+	for (int i = 0; i < STATS_COST_PACKETS; i++) {
+		uint32_t start = k_cycle_get_32();
+
+		ret = zsock_sendto(client_sock, TEST_STR_SMALL,
+				   STRLEN(TEST_STR_SMALL), 0,
+				   (struct sockaddr *)&server_addr,
+				   sizeof(server_addr));
+		zassert_equal(ret, STRLEN(TEST_STR_SMALL), "sendto failed (%d)",
+			      -errno);
+
+		ret = zsock_recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+		zassert_equal(ret, STRLEN(TEST_STR_SMALL), "recv failed (%d)",
+			      -errno);
+
+		cycles += k_cycle_get_32() - start;
+	}
+
+	TC_PRINT("UDP loopback, statistics %s: %u cycles (%u ns) per packet\n",
+		 !IS_ENABLED(CONFIG_NET_STATISTICS) ? "disabled" :
+		 IS_ENABLED(CONFIG_NET_STATISTICS_PER_CPU) ? "per CPU" : "shared",
+		 (uint32_t)(cycles / STATS_COST_PACKETS),
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / STATS_COST_PACKETS));
+
+#if defined(CONFIG_NET_STATISTICS_UDP) && defined(CONFIG_NET_STATISTICS_USER_API)
+	/* Wherever the counters are kept, they must add up when read */
+	ret = net_mgmt(NET_REQUEST_STATS_GET_UDP, NULL, &udp_after,
+		       sizeof(udp_after));
+	zassert_equal(ret, 0, "Cannot get UDP statistics (%d)", ret);
+
+	zassert_equal(udp_after.sent - udp_before.sent, STATS_COST_PACKETS,
+		      "UDP sent statistics not updated (%u)",
+		      udp_after.sent - udp_before.sent);
+	zassert_equal(udp_after.recv - udp_before.recv, STATS_COST_PACKETS,
+		      "UDP recv statistics not updated (%u)",
+		      udp_after.recv - udp_before.recv);
+#endif
+
+	ret = zsock_close(client_sock);
+	zassert_equal(ret, 0, "close failed");
+	ret = zsock_close(server_sock);
+	zassert_equal(ret, 0, "close failed");
+}
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU) && defined(CONFIG_NET_STATISTICS_UDP) && \
+	defined(CONFIG_NET_STATISTICS_USER_API) && defined(CONFIG_SCHED_CPU_MASK)
+#define STATS_CPU_UPDATES 100
+
+static K_THREAD_STACK_ARRAY_DEFINE(stats_cpu_stacks, CONFIG_MP_MAX_NUM_CPUS, 1024);
+static struct k_thread stats_cpu_threads[CONFIG_MP_MAX_NUM_CPUS];
+static int stats_cpu_seen[CONFIG_MP_MAX_NUM_CPUS];
+
+static void stats_cpu_update(void *p1, void *p2, void *p3)
+{
+	struct net_if *iface = p1;
+	int idx = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < STATS_CPU_UPDATES; i++) {
+		net_stats_update_udp_sent(iface);
+	}
+
+	stats_cpu_seen[idx] = arch_curr_cpu()->id;
+}
+
+static void stats_check_udp_sent(struct net_if *iface, net_stats_t expected)
+{
+	struct net_stats_udp udp;
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_STATS_GET_UDP, iface, &udp, sizeof(udp));
+	zassert_equal(ret, 0, "Cannot get UDP statistics (%d)", ret);
+	zassert_equal(udp.sent, expected, "UDP sent %u, expected %u",
+		      udp.sent, expected);
+}
+#endif
+
+/* Update the same counter from threads pinned to different CPUs and check
+ * that reading the statistics sums up the per CPU copies, and that a reset
+ * clears them.
+ */
+ZTEST(net_socket_udp, test_42_stats_per_cpu_sync)
+{
+#if defined(CONFIG_NET_STATISTICS_PER_CPU) && defined(CONFIG_NET_STATISTICS_UDP) && \
+	defined(CONFIG_NET_STATISTICS_USER_API) && defined(CONFIG_SCHED_CPU_MASK)
+	struct net_if *iface = net_if_get_default();
+	int num_cpus = arch_num_cpus();
+
+	if (num_cpus < 2) {
+		ztest_test_skip();
+	}
+
+	net_stats_reset(NULL);
+
+	for (int cpu = 0; cpu < num_cpus; cpu++) {
+		stats_cpu_seen[cpu] = -1;
+
+		k_thread_create(&stats_cpu_threads[cpu], stats_cpu_stacks[cpu],
+				K_THREAD_STACK_SIZEOF(stats_cpu_stacks[cpu]),
+				stats_cpu_update, iface, INT_TO_POINTER(cpu), NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&stats_cpu_threads[cpu], cpu));
+	}
+
+	for (int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_start(&stats_cpu_threads[cpu]);
+	}
+
+	for (int cpu = 0; cpu < num_cpus; cpu++) {
+		zassert_ok(k_thread_join(&stats_cpu_threads[cpu], K_FOREVER));
+		zassert_equal(stats_cpu_seen[cpu], cpu, "Thread %d ran on CPU %d",
+			      cpu, stats_cpu_seen[cpu]);
+
+		/* Each CPU counted into its own copy */
+		zassert_equal(net_stats_per_cpu[cpu].stats.udp.sent, STATS_CPU_UPDATES);
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+		zassert_equal(iface->stats_per_cpu[cpu].stats.udp.sent, STATS_CPU_UPDATES);
+#endif
+	}
+
+	stats_check_udp_sent(NULL, num_cpus * STATS_CPU_UPDATES);
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+	stats_check_udp_sent(iface, num_cpus * STATS_CPU_UPDATES);
+#endif
+
+	net_stats_reset(NULL);
+
+	for (int cpu = 0; cpu < num_cpus; cpu++) {
+		zassert_equal(net_stats_per_cpu[cpu].stats.udp.sent, 0);
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+		zassert_equal(iface->stats_per_cpu[cpu].stats.udp.sent, 0);
+#endif
+	}
+
+	stats_check_udp_sent(NULL, 0);
+
+	/* Counting starts from zero again, the old total must not come back */
+	net_stats_update_udp_sent(iface);
+	stats_check_udp_sent(NULL, 1);
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+	stats_check_udp_sent(iface, 1);
+#endif
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
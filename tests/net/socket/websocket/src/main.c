@@ -379,6 +379,40 @@ ZTEST(net_websocket, test_send_and_recv_lorem_ipsum)
 	zvfs_free_fd(fd);
 }
 
+ZTEST(net_websocket, test_sendmsg_masked_in_place)
+{
+	static struct websocket_context ctx;
+	static uint8_t payload[sizeof(lorem_ipsum)];
+	struct iovec io_vector;
+	struct msghdr msg = { 0 };
+	int fd, ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.recv_buf.buf = temp_recv_buf;
+	ctx.recv_buf.size = sizeof(temp_recv_buf);
+
+	test_msg_len = sizeof(lorem_ipsum) - 1;
+
+	/* Start unaligned to exercise the bytewise head of the masking. */
+	memcpy(payload + 1, lorem_ipsum, test_msg_len);
+	io_vector.iov_base = payload + 1;
+	io_vector.iov_len = test_msg_len;
+	msg.msg_iov = &io_vector;
+	msg.msg_iovlen = 1;
+
+	fd = test_fd_alloc(&ctx);
+	ret = websocket_sendmsg(fd, &msg, WEBSOCKET_OPCODE_DATA_TEXT, true, true,
+				SYS_FOREVER_MS);
+	zassert_equal(ret, test_msg_len,
+		      "Should have sent %zd bytes but sent %d instead",
+		      test_msg_len, ret);
+	zassert_true(memcmp(payload + 1, lorem_ipsum, test_msg_len) != 0,
+		     "Payload should have been masked in place");
+
+	zvfs_free_fd(fd);
+}
+
 ZTEST(net_websocket, test_recv_two_large_split_msg)
 {
 	static struct websocket_context ctx;
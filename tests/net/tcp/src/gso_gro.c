@@ -0,0 +1,472 @@
+/* gso_gro.c - TCP segmentation and receive offload tests
+ *
+ * Feed crafted TCP segments to the GRO merge logic and check how a GSO
+ * super-segment is split by the Ethernet L2 into MSS sized segments.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv6.h"
+#include "net_private.h"
+#include "tcp_internal.h"
+
+#include <zephyr/ztest.h>
+
+#define GRO_SRC_PORT 5001
+#define GRO_DST_PORT 4242
+#define GRO_SEQ 1000U
+#define GRO_ACK 5000U
+#define GRO_WINDOW 8192U
+#define GRO_DATA_MAX_LEN 512
+
+#define GSO_MSS 256U
+#define GSO_DATA_LEN 700U
+#define GSO_SEQ 0xfffffe00U
+#define GSO_MAX_FRAMES 4
+
+struct gro_frame {
+	struct net_eth_hdr eth;
+	struct net_ipv4_hdr ipv4;
+	struct net_tcp_hdr tcp;
+	uint8_t data[GRO_DATA_MAX_LEN];
+} __packed;
+
+struct gso_frame {
+	struct net_eth_hdr eth;
+	struct net_ipv6_hdr ipv6;
+	struct net_tcp_hdr tcp;
+	uint8_t data[GSO_MSS];
+} __packed;
+
+struct eth_fake_context {
+	uint8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+static struct eth_fake_context eth_fake_data = {
+	.mac_addr = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+};
+
+static const struct net_eth_addr peer_mac = {
+	{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 }
+};
+
+static const struct in_addr gro_src_addr = { { { 192, 0, 2, 2 } } };
+static const struct in_addr gro_dst_addr = { { { 192, 0, 2, 1 } } };
+
+static const struct in6_addr gso_src_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+						  0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static const struct in6_addr gso_dst_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+						  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_if *eth_iface;
+static K_FIFO_DEFINE(gro_fifo);
+
+static struct gso_frame gso_frames[GSO_MAX_FRAMES];
+static size_t gso_frame_len[GSO_MAX_FRAMES];
+static int gso_frame_count;
+static int gso_frame_max;
+
+static void eth_fake_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_fake_context *ctx = dev->data;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+/* Store the frames passed to the driver so that the test can check them */
+static int eth_fake_send(const struct device *dev, struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+
+	ARG_UNUSED(dev);
+
+	if (gso_frame_count >= gso_frame_max) {
+		return -EIO;
+	}
+
+	if (len > sizeof(struct gso_frame)) {
+		return -EMSGSIZE;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_read(pkt, &gso_frames[gso_frame_count], len)) {
+		return -ENOBUFS;
+	}
+
+	gso_frame_len[gso_frame_count++] = len;
+
+	return 0;
+}
+
+static const struct ethernet_api eth_fake_api_funcs = {
+	.iface_api.init = eth_fake_iface_init,
+	.send = eth_fake_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_fake_gso_gro, "eth_fake_gso_gro", NULL, NULL,
+		    &eth_fake_data, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &eth_fake_api_funcs, NET_ETH_MTU);
+
+/* One's complement sum of a TCP segment and of its pseudo header */
+static uint16_t tcp_sum(const uint8_t *addrs, size_t addr_len,
+			const uint8_t *tcp, size_t tcp_len)
+{
+	uint16_t sum = tcp_len + IPPROTO_TCP;
+
+	sum = calc_chksum(sum, addrs, 2 * addr_len);
+
+	return calc_chksum(sum, tcp, tcp_len);
+}
+
+/* Payload byte at a given offset from the start of the flow */
+static uint8_t flow_data(uint32_t offset)
+{
+	return (uint8_t)(offset * 7U);
+}
+
+/* Create an Ethernet frame carrying an IPv4 TCP segment with valid
+ * checksums, received on the fake Ethernet interface.
+ */
+static struct net_pkt *gro_segment(uint32_t seq_no, uint32_t ack_no,
+				   uint8_t flags, uint16_t src_port, size_t len)
+{
+	size_t tcp_len = sizeof(struct net_tcp_hdr) + len;
+	size_t frame_len = sizeof(struct net_eth_hdr) +
+			   sizeof(struct net_ipv4_hdr) + tcp_len;
+	struct gro_frame frame = { 0 };
+	struct net_pkt *pkt;
+	uint16_t sum;
+
+	zassert_true(len <= GRO_DATA_MAX_LEN, "Too long payload");
+
+	memcpy(&frame.eth.dst, eth_fake_data.mac_addr, sizeof(frame.eth.dst));
+	memcpy(&frame.eth.src, &peer_mac, sizeof(frame.eth.src));
+	frame.eth.type = htons(NET_ETH_PTYPE_IP);
+
+	frame.ipv4.vhl = 0x45;
+	frame.ipv4.len = htons(sizeof(struct net_ipv4_hdr) + tcp_len);
+	frame.ipv4.ttl = 64U;
+	frame.ipv4.proto = IPPROTO_TCP;
+	memcpy(frame.ipv4.src, &gro_src_addr, sizeof(frame.ipv4.src));
+	memcpy(frame.ipv4.dst, &gro_dst_addr, sizeof(frame.ipv4.dst));
+
+	sum = calc_chksum(0, (uint8_t *)&frame.ipv4, sizeof(frame.ipv4));
+	sys_put_be16(~sum, (uint8_t *)&frame.ipv4.chksum);
+
+	frame.tcp.src_port = htons(src_port);
+	frame.tcp.dst_port = htons(GRO_DST_PORT);
+	sys_put_be32(seq_no, frame.tcp.seq);
+	sys_put_be32(ack_no, frame.tcp.ack);
+	frame.tcp.offset = (sizeof(struct net_tcp_hdr) / 4U) << 4;
+	frame.tcp.flags = flags;
+	sys_put_be16(GRO_WINDOW, frame.tcp.wnd);
+
+	for (size_t i = 0; i < len; i++) {
+		frame.data[i] = flow_data(seq_no - GRO_SEQ + i);
+	}
+
+	sum = tcp_sum(frame.ipv4.src, NET_IPV4_ADDR_SIZE,
+		      (uint8_t *)&frame.tcp, tcp_len);
+	sys_put_be16(~sum, (uint8_t *)&frame.tcp.chksum);
+
+	pkt = net_pkt_rx_alloc_with_buffer(eth_iface, frame_len, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	zassert_ok(net_pkt_write(pkt, &frame, frame_len), "Cannot write pkt");
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void gro_check_merged(struct net_pkt *pkt, uint32_t seq_no,
+			     uint32_t ack_no, uint8_t flags, size_t len)
+{
+	size_t tcp_len = sizeof(struct net_tcp_hdr) + len;
+	size_t frame_len = sizeof(struct net_eth_hdr) +
+			   sizeof(struct net_ipv4_hdr) + tcp_len;
+	struct gro_frame frame;
+
+	zassert_equal(net_pkt_get_len(pkt), frame_len,
+		      "Invalid merged length (%zu vs %zu)",
+		      net_pkt_get_len(pkt), frame_len);
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read(pkt, &frame, frame_len), "Cannot read pkt");
+	net_pkt_cursor_init(pkt);
+
+	zassert_equal(ntohs(frame.ipv4.len), sizeof(struct net_ipv4_hdr) + tcp_len,
+		      "Invalid IPv4 length");
+	zassert_equal(calc_chksum(0, (uint8_t *)&frame.ipv4, sizeof(frame.ipv4)),
+		      0xffff, "Invalid IPv4 header checksum");
+
+	zassert_equal(sys_get_be32(frame.tcp.seq), seq_no, "Invalid seq");
+	zassert_equal(sys_get_be32(frame.tcp.ack), ack_no, "Invalid ack");
+	zassert_equal(frame.tcp.flags, flags, "Invalid flags");
+	zassert_equal(tcp_sum(frame.ipv4.src, NET_IPV4_ADDR_SIZE,
+			      (uint8_t *)&frame.tcp, tcp_len),
+		      0xffff, "Invalid TCP checksum");
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_equal(frame.data[i], flow_data(seq_no - GRO_SEQ + i),
+			      "Invalid payload at offset %zu", i);
+	}
+}
+
+static void gro_check_not_merged(struct net_pkt *held, struct net_pkt *next)
+{
+	size_t len = net_pkt_get_len(held);
+	struct net_pkt *pkt;
+
+	k_fifo_put(&gro_fifo, next);
+
+	pkt = net_tcp_gro_receive(&gro_fifo, held, NULL);
+	zassert_equal_ptr(pkt, held, "Invalid pkt returned");
+	zassert_equal(net_pkt_get_len(pkt), len, "Held segment was modified");
+	zassert_equal_ptr(k_fifo_get(&gro_fifo, K_NO_WAIT), next,
+			  "Next segment was dequeued");
+
+	net_pkt_unref(held);
+	net_pkt_unref(next);
+}
+
+ZTEST(net_tcp_gso_gro, test_gro_merge)
+{
+	struct net_pkt *seg[4];
+	struct net_pkt *pkt;
+	struct k_sem slots;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	k_sem_init(&slots, 0, K_SEM_MAX_LIMIT);
+
+	seg[0] = gro_segment(GRO_SEQ, GRO_ACK, ACK, GRO_SRC_PORT, 100);
+	seg[1] = gro_segment(GRO_SEQ + 100, GRO_ACK, ACK, GRO_SRC_PORT, 100);
+	/* Only the last merged payload may have an odd length */
+	seg[2] = gro_segment(GRO_SEQ + 200, GRO_ACK + 10, ACK | PSH,
+			     GRO_SRC_PORT, 101);
+	/* Nothing is merged after a segment with PSH */
+	seg[3] = gro_segment(GRO_SEQ + 301, GRO_ACK + 10, ACK, GRO_SRC_PORT, 100);
+
+	for (size_t i = 1; i < ARRAY_SIZE(seg); i++) {
+		k_fifo_put(&gro_fifo, seg[i]);
+	}
+
+	pkt = net_tcp_gro_receive(&gro_fifo, seg[0], &slots);
+	zassert_equal_ptr(pkt, seg[0], "Invalid pkt returned");
+	zassert_equal(k_sem_count_get(&slots), 2, "Invalid number of merged segments");
+
+	gro_check_merged(pkt, GRO_SEQ, GRO_ACK + 10, ACK | PSH, 301);
+
+	zassert_equal_ptr(k_fifo_get(&gro_fifo, K_NO_WAIT), seg[3],
+			  "Segment after PSH was dequeued");
+
+	net_pkt_unref(seg[3]);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gso_gro, test_gro_no_merge_odd_payload)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	gro_check_not_merged(gro_segment(GRO_SEQ, GRO_ACK, ACK, GRO_SRC_PORT, 101),
+			     gro_segment(GRO_SEQ + 101, GRO_ACK, ACK, GRO_SRC_PORT, 100));
+}
+
+ZTEST(net_tcp_gso_gro, test_gro_no_merge_seq_gap)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	gro_check_not_merged(gro_segment(GRO_SEQ, GRO_ACK, ACK, GRO_SRC_PORT, 100),
+			     gro_segment(GRO_SEQ + 102, GRO_ACK, ACK, GRO_SRC_PORT, 100));
+}
+
+ZTEST(net_tcp_gso_gro, test_gro_no_merge_older_ack)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	gro_check_not_merged(gro_segment(GRO_SEQ, GRO_ACK, ACK, GRO_SRC_PORT, 100),
+			     gro_segment(GRO_SEQ + 100, GRO_ACK - 1, ACK, GRO_SRC_PORT, 100));
+}
+
+ZTEST(net_tcp_gso_gro, test_gro_no_merge_psh)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	gro_check_not_merged(gro_segment(GRO_SEQ, GRO_ACK, ACK | PSH, GRO_SRC_PORT, 100),
+			     gro_segment(GRO_SEQ + 100, GRO_ACK, ACK, GRO_SRC_PORT, 100));
+}
+
+ZTEST(net_tcp_gso_gro, test_gro_no_merge_other_port)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	gro_check_not_merged(gro_segment(GRO_SEQ, GRO_ACK, ACK, GRO_SRC_PORT, 100),
+			     gro_segment(GRO_SEQ + 100, GRO_ACK, ACK, GRO_SRC_PORT + 1, 100));
+}
+
+/* Send an IPv6 super-segment through the Ethernet L2 */
+static int gso_send(void)
+{
+	struct net_tcp_hdr tcp = { 0 };
+	struct net_pkt *pkt;
+	size_t offset;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(eth_iface, sizeof(tcp) + GSO_DATA_LEN,
+					AF_INET6, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	net_pkt_set_gso_size(pkt, GSO_MSS);
+	(void)net_linkaddr_set(net_pkt_lladdr_src(pkt), eth_fake_data.mac_addr,
+			       sizeof(eth_fake_data.mac_addr));
+	(void)net_linkaddr_set(net_pkt_lladdr_dst(pkt), peer_mac.addr,
+			       sizeof(peer_mac.addr));
+
+	zassert_ok(net_ipv6_create(pkt, &gso_src_addr, &gso_dst_addr),
+		   "Cannot create IPv6 header");
+
+	tcp.src_port = htons(GRO_DST_PORT);
+	tcp.dst_port = htons(GRO_SRC_PORT);
+	sys_put_be32(GSO_SEQ, tcp.seq);
+	sys_put_be32(GRO_ACK, tcp.ack);
+	tcp.offset = (sizeof(struct net_tcp_hdr) / 4U) << 4;
+	tcp.flags = ACK | PSH;
+	sys_put_be16(GRO_WINDOW, tcp.wnd);
+
+	zassert_ok(net_pkt_write(pkt, &tcp, sizeof(tcp)), "Cannot write TCP header");
+
+	for (offset = 0; offset < GSO_DATA_LEN; offset++) {
+		zassert_ok(net_pkt_write_u8(pkt, flow_data(offset)),
+			   "Cannot write data");
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv6_finalize(pkt, IPPROTO_TCP), "Cannot finalize pkt");
+
+	ret = net_if_l2(eth_iface)->send(eth_iface, pkt);
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+ZTEST(net_tcp_gso_gro, test_gso_split)
+{
+	size_t offset, len, total = 0;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GSO);
+
+	ret = gso_send();
+	zassert_true(ret > 0, "Cannot send super-segment (%d)", ret);
+	zassert_equal(gso_frame_count, DIV_ROUND_UP(GSO_DATA_LEN, GSO_MSS),
+		      "Invalid number of segments (%d)", gso_frame_count);
+
+	for (int i = 0; i < gso_frame_count; i++) {
+		struct gso_frame *frame = &gso_frames[i];
+		size_t tcp_len;
+
+		offset = i * GSO_MSS;
+		len = MIN(GSO_MSS, GSO_DATA_LEN - offset);
+		tcp_len = sizeof(struct net_tcp_hdr) + len;
+
+		zassert_equal(gso_frame_len[i], sizeof(struct net_eth_hdr) +
+			      sizeof(struct net_ipv6_hdr) + tcp_len,
+			      "Invalid length of segment %d", i);
+		zassert_equal(ntohs(frame->eth.type), NET_ETH_PTYPE_IPV6,
+			      "Invalid Ethernet type");
+		zassert_mem_equal(&frame->eth.dst, &peer_mac, sizeof(peer_mac),
+				  "Invalid destination MAC");
+		zassert_equal(ntohs(frame->ipv6.len), tcp_len,
+			      "Invalid IPv6 payload length");
+		zassert_equal(sys_get_be32(frame->tcp.seq), (uint32_t)(GSO_SEQ + offset),
+			      "Invalid seq in segment %d", i);
+
+		/* PSH is only set in the last segment */
+		zassert_equal(frame->tcp.flags,
+			      offset + len < GSO_DATA_LEN ? ACK : (ACK | PSH),
+			      "Invalid flags in segment %d", i);
+
+		zassert_equal(tcp_sum(frame->ipv6.src, NET_IPV6_ADDR_SIZE,
+				      (uint8_t *)&frame->tcp, tcp_len),
+			      0xffff, "Invalid TCP checksum in segment %d", i);
+
+		for (size_t j = 0; j < len; j++) {
+			zassert_equal(frame->data[j], flow_data(offset + j),
+				      "Invalid payload in segment %d", i);
+		}
+
+		total += gso_frame_len[i];
+	}
+
+	zassert_equal(ret, total, "Invalid number of bytes sent");
+}
+
+ZTEST(net_tcp_gso_gro, test_gso_partial_send)
+{
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GSO);
+
+	/* The driver fails on the second segment, the first one is sent */
+	gso_frame_max = 1;
+
+	ret = gso_send();
+	zassert_equal(gso_frame_count, 1, "Invalid number of segments (%d)",
+		      gso_frame_count);
+	zassert_equal(ret, gso_frame_len[0], "Sent segment not reported (%d)", ret);
+
+	/* Nothing is reported as sent if the first segment fails */
+	gso_frame_count = 0;
+	gso_frame_max = 0;
+
+	ret = gso_send();
+	zassert_true(ret < 0, "Failure not reported (%d)", ret);
+}
+
+static void *gso_gro_setup(void)
+{
+	eth_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(eth_iface, "Ethernet interface not available");
+
+	return NULL;
+}
+
+static void gso_gro_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	gso_frame_count = 0;
+	gso_frame_max = GSO_MAX_FRAMES;
+}
+
+static void gso_gro_after(void *fixture)
+{
+	struct net_pkt *pkt;
+
+	ARG_UNUSED(fixture);
+
+	while ((pkt = k_fifo_get(&gro_fifo, K_NO_WAIT)) != NULL) {
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST_SUITE(net_tcp_gso_gro, NULL, gso_gro_setup, gso_gro_before, gso_gro_after, NULL);
@@ -780,8 +780,225 @@ ZTEST(modem_chat, test_runtime_script)
 	zassert_equal(ret, -EINVAL, "Should have failed to set abort matches");
 }
 
+/*************************************************************************************************/
+/*                                  Unsolicited matches parsing                                  */
+/*************************************************************************************************/
+#define TEST_MODEM_CHAT_PARSE_ITERATIONS (200)
+
+static struct modem_chat parse_cmd;
+static uint8_t parse_cmd_receive_buf[128];
+static uint8_t *parse_cmd_argv[32];
+
+static struct modem_backend_mock parse_mock;
+static uint8_t parse_mock_rx_buf[1024];
+static uint8_t parse_mock_tx_buf[128];
+static struct modem_pipe *parse_mock_pipe;
+
+static K_SEM_DEFINE(parse_matched_sem, 0, K_SEM_MAX_LIMIT);
+static char parse_matched[128];
+
+static void on_parse_unsol(struct modem_chat *cmd, char **argv, uint16_t argc, void *user_data)
+{
+	strncpy(parse_matched, argv[0], sizeof(parse_matched) - 1);
+	k_sem_give(&parse_matched_sem);
+}
+
+MODEM_CHAT_MATCHES_DEFINE(
+	parse_unsol_matches,
+	MODEM_CHAT_MATCH("RDY", "", on_parse_unsol),
+	MODEM_CHAT_MATCH("APP RDY", "", on_parse_unsol),
+	MODEM_CHAT_MATCH("POWERED DOWN", "", on_parse_unsol),
+	MODEM_CHAT_MATCH("RING", "", on_parse_unsol),
+	MODEM_CHAT_MATCH("NO CARRIER", "", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CREG: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CGREG: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CEREG: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+C5GREG: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CSQ: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CESQ: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CMTI: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CMT: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CDSI: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CBM: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CUSD: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CGEV: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CPIN: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CTZV: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CTZE: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CLIP: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+CCWA: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+QIND: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+QIOPEN: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+QSSLURC: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+QMTSTAT: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+QMTRECV: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+QPSMTIMER: ", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH_WILDCARD("+QIURC: \"????\",", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH_WILDCARD("+QIURC: \"?????\",", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+QIURC: \"closed\",", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH_WILDCARD("+URC: ?????X", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH_WILDCARD("+URC: A????Y", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH_WILDCARD("+URC: AB???Z", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH_WILDCARD("+URC: ABC??W", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH_WILDCARD("+URC: ABCD?V", ",", on_parse_unsol),
+	MODEM_CHAT_MATCH("+URC: ABCDEU", ",", on_parse_unsol));
+
+static const char parse_lines[] = "+CEREG: 5,\"1A2B\",\"01A2B3C4\",7\r\n"
+				  "+CSQ: 23,99\r\n"
+				  "RING\r\n"
+				  "+CLIP: \"+4512345678\",145,,,,0\r\n"
+				  "+CMTI: \"SM\",3\r\n"
+				  "+QIURC: \"recv\",0,512\r\n"
+				  "+QIURC: \"closed\",0\r\n"
+				  "+QIND: \"csq\",20,99\r\n"
+				  "+QMTRECV: 0,1,\"topic\",\"payload\"\r\n"
+				  "+CGEV: ME PDN ACT 1\r\n";
+
+static void *test_modem_chat_parse_setup(void)
+{
+	const struct modem_chat_config cmd_config = {
+		.user_data = NULL,
+		.receive_buf = parse_cmd_receive_buf,
+		.receive_buf_size = ARRAY_SIZE(parse_cmd_receive_buf),
+		.delimiter = cmd_delimiter,
+		.delimiter_size = ARRAY_SIZE(cmd_delimiter),
+		.filter = NULL,
+		.filter_size = 0,
+		.argv = parse_cmd_argv,
+		.argv_size = ARRAY_SIZE(parse_cmd_argv),
+		.unsol_matches = parse_unsol_matches,
+		.unsol_matches_size = ARRAY_SIZE(parse_unsol_matches),
+	};
+
+	zassert(modem_chat_init(&parse_cmd, &cmd_config) == 0, "Failed to init modem CMD");
+
+	const struct modem_backend_mock_config mock_config = {
+		.rx_buf = parse_mock_rx_buf,
+		.rx_buf_size = ARRAY_SIZE(parse_mock_rx_buf),
+		.tx_buf = parse_mock_tx_buf,
+		.tx_buf_size = ARRAY_SIZE(parse_mock_tx_buf),
+		.limit = ARRAY_SIZE(parse_mock_rx_buf),
+	};
+
+	parse_mock_pipe = modem_backend_mock_init(&parse_mock, &mock_config);
+	zassert(modem_pipe_open(parse_mock_pipe, K_SECONDS(10)) == 0, "Failed to open mock pipe");
+	zassert(modem_chat_attach(&parse_cmd, parse_mock_pipe) == 0,
+		"Failed to attach pipe mock to modem CMD");
+	return NULL;
+}
+
+static void test_modem_chat_parse_before(void *f)
+{
+	k_sem_reset(&parse_matched_sem);
+	memset(parse_matched, 0, sizeof(parse_matched));
+	modem_backend_mock_reset(&parse_mock);
+}
+
+static void test_modem_chat_parse_expect(const char *line, const char *match)
+{
+	modem_backend_mock_put(&parse_mock, line, strlen(line));
+
+	if (match == NULL) {
+		zassert_equal(k_sem_take(&parse_matched_sem, K_MSEC(100)), -EAGAIN,
+			      "Unexpected match for %s", line);
+		return;
+	}
+
+	zassert_ok(k_sem_take(&parse_matched_sem, K_MSEC(100)), "No match for %s", line);
+	zassert_ok(strcmp(parse_matched, match), "Wrong match %s for %s", parse_matched, line);
+}
+
+ZTEST(modem_chat_parse, test_unsol_matches)
+{
+	test_modem_chat_parse_expect("RDY\r\n", "RDY");
+	test_modem_chat_parse_expect("APP RDY\r\n", "APP RDY");
+	test_modem_chat_parse_expect("+CREG: 1,2\r\n", "+CREG: ");
+	test_modem_chat_parse_expect("+CEREG: 5\r\n", "+CEREG: ");
+	test_modem_chat_parse_expect("+CMT: \"+4512345678\",,\r\n", "+CMT: ");
+	test_modem_chat_parse_expect("+CMTI: \"SM\",3\r\n", "+CMTI: ");
+	test_modem_chat_parse_expect("+QMTRECV: 0,1\r\n", "+QMTRECV: ");
+	test_modem_chat_parse_expect("+CRE: 1\r\n", NULL);
+	test_modem_chat_parse_expect("RIN\r\n", NULL);
+	test_modem_chat_parse_expect("+UUSORD: 0,32\r\n", NULL);
+}
+
+ZTEST(modem_chat_parse, test_unsol_matches_wildcards)
+{
+	test_modem_chat_parse_expect("+QIURC: \"recv\",0\r\n", "+QIURC: \"recv\",");
+	test_modem_chat_parse_expect("+QIURC: \"incoming\",0\r\n", NULL);
+	test_modem_chat_parse_expect("+QIURC: \"close\",0\r\n", "+QIURC: \"close\",");
+	test_modem_chat_parse_expect("+QIURC: \"closed\",0\r\n", "+QIURC: \"closed\",");
+	test_modem_chat_parse_expect("+QIURC: \"????\",0\r\n", "+QIURC: \"????\",");
+}
+
+ZTEST(modem_chat_parse, test_unsol_matches_wildcards_overrun)
+{
+	/* Every "+URC: " match stays a candidate for "ABCD", which is more paths than
+	 * the trie tracks at once, so these lines are matched linearly.
+	 */
+	test_modem_chat_parse_expect("+URC: ABCDEX\r\n", "+URC: ABCDEX");
+	test_modem_chat_parse_expect("+URC: ABCDEZ\r\n", "+URC: ABCDEZ");
+	test_modem_chat_parse_expect("+URC: ABCDEV\r\n", "+URC: ABCDEV");
+	test_modem_chat_parse_expect("+URC: ABCDEU\r\n", "+URC: ABCDEU");
+	test_modem_chat_parse_expect("+URC: ABCDEQ\r\n", NULL);
+	test_modem_chat_parse_expect("+URC: ZBCDEY\r\n", NULL);
+	test_modem_chat_parse_expect("+URC: ZZZZZX\r\n", "+URC: ZZZZZX");
+
+	/* The next line starts from the root again */
+	test_modem_chat_parse_expect("+QIURC: \"recv\",0\r\n", "+QIURC: \"recv\",");
+}
+
+ZTEST(modem_chat_parse, test_unsol_trie_nodes)
+{
+#if CONFIG_MODEM_CHAT_UNSOL_TRIE
+	/* Each match ends in a node of its own besides the root, and the whole
+	 * parse table fits in less than 256 nodes.
+	 */
+	if (CONFIG_MODEM_CHAT_UNSOL_TRIE_NODES <= ARRAY_SIZE(parse_unsol_matches)) {
+		zassert_equal(parse_cmd.unsol_trie_size, 0,
+			      "Trie should not fit, matching must fall back to linear");
+	} else if (CONFIG_MODEM_CHAT_UNSOL_TRIE_NODES >= 256) {
+		zassert_true(parse_cmd.unsol_trie_size > 0, "Trie should fit");
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(modem_chat_parse, test_unsol_matches_throughput)
+{
+	uint32_t lines = 0;
+	uint32_t start;
+	uint64_t usec;
+
+	for (size_t i = 0; i < strlen(parse_lines); i++) {
+		if (parse_lines[i] == '\n') {
+			lines++;
+		}
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < TEST_MODEM_CHAT_PARSE_ITERATIONS; i++) {
+		modem_backend_mock_put(&parse_mock, parse_lines, strlen(parse_lines));
+
+		for (uint32_t u = 0; u < lines; u++) {
+			zassert_ok(k_sem_take(&parse_matched_sem, K_SECONDS(1)),
+				   "Received line not matched");
+		}
+	}
+
+	usec = k_cyc_to_us_ceil64(k_cycle_get_32() - start);
+	TC_PRINT("Parsed %u lines (%u bytes) in %llu us (%llu lines/s)\n",
+		 lines * TEST_MODEM_CHAT_PARSE_ITERATIONS,
+		 (uint32_t)strlen(parse_lines) * TEST_MODEM_CHAT_PARSE_ITERATIONS, usec,
+		 ((uint64_t)lines * TEST_MODEM_CHAT_PARSE_ITERATIONS * 1000000U) / MAX(usec, 1U));
+}
+
 /*************************************************************************************************/
 /*                                         Test suite                                            */
 /*************************************************************************************************/
 ZTEST_SUITE(modem_chat, NULL, test_modem_chat_setup, test_modem_chat_before, test_modem_chat_after,
 	    NULL);
+ZTEST_SUITE(modem_chat_parse, NULL, test_modem_chat_parse_setup, test_modem_chat_parse_before,
+	    NULL, NULL);
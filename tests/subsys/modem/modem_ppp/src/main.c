@@ -20,6 +20,11 @@
 #include <zephyr/modem/ppp.h>
 #include <modem_backend_mock.h>
 
+#if defined(CONFIG_MODEM_BACKEND_UART)
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/modem/backend/uart.h>
+#endif
+
 #define TEST_MODEM_PPP_BUF_SIZE		     (16)
 #define TEST_MODEM_PPP_TX_PKT_BUF_SIZE	     (5)
 #define TEST_MODEM_PPP_MOCK_PIPE_RX_BUF_SIZE (4096)
@@ -29,6 +34,10 @@
 #define TEST_MODEM_PPP_IP_FRAME_SEND_LARGE_N	(2048)
 #define TEST_MODEM_PPP_IP_FRAME_RECEIVE_LARGE_N (2048)
 
+#define TEST_MODEM_PPP_LOOPBACK_BUF_SIZE	(1024)
+#define TEST_MODEM_PPP_LOOPBACK_FRAME_SIZE	(1500)
+#define TEST_MODEM_PPP_LOOPBACK_FRAME_N		(64)
+
 /*************************************************************************************************/
 /*                                          Mock pipe                                            */
 /*************************************************************************************************/
@@ -74,6 +83,7 @@ static size_t received_packets_len;
 static uint8_t buffer[4096];
 static uint8_t unwrapped_buffer[4096];
 static uint8_t wrapped_buffer[4096];
+K_SEM_DEFINE(received_packets_sem, 0, 1);
 
 /*************************************************************************************************/
 /*                                  Mock network interface                                       */
@@ -87,6 +97,7 @@ static enum net_verdict test_net_l2_recv(struct net_if *iface, struct net_pkt *p
 	/* Store pointer to received packet */
 	received_packets[received_packets_len] = pkt;
 	received_packets_len++;
+	k_sem_give(&received_packets_sem);
 	return NET_OK;
 }
 
@@ -519,3 +530,117 @@ ZTEST(modem_ppp, test_ip_frame_receive_large)
 }
 
 ZTEST_SUITE(modem_ppp, NULL, test_modem_ppp_setup, test_modem_ppp_before, NULL, NULL);
+
+#if defined(CONFIG_MODEM_BACKEND_UART)
+/*************************************************************************************************/
+/*                         Loopback through UART backend and emulated UART                       */
+/*************************************************************************************************/
+static const struct device *loopback_uart = DEVICE_DT_GET(DT_NODELABEL(ppp_uart));
+static struct modem_backend_uart loopback_backend;
+static uint8_t loopback_backend_receive_buf[8192];
+static uint8_t loopback_backend_transmit_buf[4096];
+static struct modem_pipe *loopback_pipe;
+
+static uint8_t ppp_loopback_receive_buf[TEST_MODEM_PPP_LOOPBACK_BUF_SIZE];
+static uint8_t ppp_loopback_transmit_buf[TEST_MODEM_PPP_LOOPBACK_BUF_SIZE];
+
+static struct modem_ppp ppp_loopback = {
+	.iface = &test_iface,
+	.receive_buf = ppp_loopback_receive_buf,
+	.transmit_buf = ppp_loopback_transmit_buf,
+	.buf_size = TEST_MODEM_PPP_LOOPBACK_BUF_SIZE,
+};
+
+static const struct device ppp_loopback_net_dev = {.data = &ppp_loopback};
+
+static void test_modem_ppp_loopback_tx_data_ready(const struct device *dev, size_t size,
+						  void *user_data)
+{
+	/* Transmitted data has already been looped back to the receiver */
+	uart_emul_flush_tx_data(dev);
+}
+
+static void *test_modem_ppp_loopback_setup(void)
+{
+	const struct modem_backend_uart_config config = {
+		.uart = loopback_uart,
+		.receive_buf = loopback_backend_receive_buf,
+		.receive_buf_size = sizeof(loopback_backend_receive_buf),
+		.transmit_buf = loopback_backend_transmit_buf,
+		.transmit_buf_size = sizeof(loopback_backend_transmit_buf),
+	};
+
+	zassert_true(modem_ppp_init_internal(&ppp_loopback_net_dev) == 0,
+		     "Failed to run internal init");
+	net_if_flag_set(modem_ppp_get_iface(&ppp_loopback), NET_IF_UP);
+
+	uart_emul_callback_tx_data_ready_set(loopback_uart, test_modem_ppp_loopback_tx_data_ready,
+					     NULL);
+
+	loopback_pipe = modem_backend_uart_init(&loopback_backend, &config);
+	zassert_true(modem_pipe_open(loopback_pipe, K_SECONDS(10)) == 0,
+		     "Failed to open UART backend pipe");
+	modem_ppp_attach(&ppp_loopback, loopback_pipe);
+	return NULL;
+}
+
+static void test_modem_ppp_loopback_teardown(void *f)
+{
+	modem_ppp_release(&ppp_loopback);
+	modem_pipe_close(loopback_pipe, K_SECONDS(10));
+}
+
+ZTEST(modem_ppp_loopback, test_ip_frame_loopback_throughput)
+{
+	struct net_pkt *pkt;
+	uint32_t start;
+	uint64_t usec;
+	size_t size;
+	int ret;
+
+	k_sem_reset(&received_packets_sem);
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < TEST_MODEM_PPP_LOOPBACK_FRAME_N; i++) {
+		pkt = net_pkt_alloc_with_buffer(&test_iface, TEST_MODEM_PPP_LOOPBACK_FRAME_SIZE,
+						AF_UNSPEC, 0, K_NO_WAIT);
+		zassert_true(pkt != NULL, "Failed to allocate network packet");
+
+		net_pkt_cursor_init(pkt);
+		net_pkt_set_family(pkt, AF_INET);
+		size = test_modem_ppp_fill_net_pkt(pkt, TEST_MODEM_PPP_LOOPBACK_FRAME_SIZE);
+		zassert_true(size == TEST_MODEM_PPP_LOOPBACK_FRAME_SIZE, "Failed to fill net pkt");
+
+		ret = modem_ppp_ppp_api.send(&ppp_loopback_net_dev, pkt);
+		net_pkt_unref(pkt);
+		zassert_true(ret == 0, "Failed to send PPP pkt");
+
+		zassert_true(k_sem_take(&received_packets_sem, K_SECONDS(1)) == 0,
+			     "Frame %d was not looped back", i);
+		zassert_true(received_packets_len == 1, "Expected to receive one network packet");
+
+		/* Data + protocol */
+		pkt = received_packets[0];
+		size = net_pkt_get_len(pkt);
+		zassert_true(size == (TEST_MODEM_PPP_LOOPBACK_FRAME_SIZE + 2),
+			     "Incorrect length of net packet received");
+
+		net_pkt_cursor_init(pkt);
+		net_pkt_read(pkt, buffer, size);
+		zassert_true(test_modem_ppp_validate_fill(&buffer[2], (size - 2)) == true,
+			     "Incorrect data received");
+
+		net_pkt_unref(pkt);
+		received_packets_len = 0;
+	}
+
+	usec = k_cyc_to_us_ceil64(k_cycle_get_32() - start);
+	TC_PRINT("Looped back %u frames of %u bytes in %llu us (%llu kbit/s)\n",
+		 TEST_MODEM_PPP_LOOPBACK_FRAME_N, TEST_MODEM_PPP_LOOPBACK_FRAME_SIZE, usec,
+		 ((uint64_t)TEST_MODEM_PPP_LOOPBACK_FRAME_N * TEST_MODEM_PPP_LOOPBACK_FRAME_SIZE *
+		  8U * 1000U) / MAX(usec, 1U));
+}
+
+ZTEST_SUITE(modem_ppp_loopback, NULL, test_modem_ppp_loopback_setup, NULL, NULL,
+	    test_modem_ppp_loopback_teardown);
+#endif